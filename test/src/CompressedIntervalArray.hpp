@@ -0,0 +1,557 @@
+#ifndef COMPRESSEDINTERVALARRAY_HPP_
+#define COMPRESSEDINTERVALARRAY_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "IntervalArray.hpp"
+#include "IntervalFile.hpp"
+#include "IntervalNumber.hpp"
+#include "IntervalReduction.hpp"
+
+// Compressed interval columns.
+//
+// The intervals are encoded in independent blocks of blockSize. Each
+// interval gets a 4-bit class: point [x, x], Ω, -Ω, [-∞, ∞] and NaN need
+// at most one value, other intervals two. The stored values are XORed with
+// a prediction -- a lower bound with the previous stored lower bound, an
+// upper bound with its own lower bound -- so repeated and near-equal
+// endpoints leave mostly zero bytes. A control byte per value gives the
+// number of leading and trailing zero bytes of the XOR, and only the bytes
+// between them are kept:
+//
+//     u32 count | u32 values | u32 payload bytes | u32 zero
+//     classes[(count + 1) / 2] | controls[values] | payload | 8 zero bytes
+//
+// The padding lets the decoder load every value with one unaligned 8-byte
+// read. Classes compare bits, so -0, signalling NaN and every other bit
+// pattern round-trip exactly. Decoding a block needs no other block, so
+// blocks decompress in parallel, or one at a time into buffers for the
+// batch kernels:
+//
+//     std::vector<double> lower(column.blockSize()), upper(column.blockSize());
+//     for (std::size_t b = 0u; b < column.blockCount(); b++)
+//     {
+//         column.decompressBlock(b, lower.data(), upper.data());
+//         intervalKernels().multiply(lower.data(), upper.data(), ...);
+//     }
+
+/**
+ * Classes of compressed intervals.
+ */
+enum class CompressedIntervalClass : std::uint8_t {
+    General = 0u,       // Two stored values.
+    Point = 1u,         // [x, x]; one stored value.
+    Omega = 2u,         // [0, ∞]
+    NegativeOmega = 3u, // [-∞, 0]
+    OmegaTilde = 4u,    // [-∞, ∞]
+    NaN = 5u            // [NaN, NaN] with the bits of QUIET_NAN.
+};
+
+// Default number of intervals per block: 64 KiB decompressed.
+static constexpr std::size_t COMPRESSED_INTERVAL_BLOCK_SIZE = 4096u;
+
+// Most intervals per block, so the 32-bit counts of a block header cannot
+// overflow: the payload takes up to 16 bytes per interval.
+static constexpr std::size_t COMPRESSED_INTERVAL_MAX_BLOCK_SIZE = 0x0FFFFFFFu;
+
+// Bytes of the block header.
+static constexpr std::size_t COMPRESSED_INTERVAL_BLOCK_HEADER = 16u;
+
+// Zero bytes after the payload of a block.
+static constexpr std::size_t COMPRESSED_INTERVAL_PADDING = 8u;
+
+// First eight bytes of every compressed interval file.
+static constexpr char COMPRESSED_INTERVAL_MAGIC[8u] = {'Z', 'I', 'N', 'T', 'V', 'L', 'C', '\n'};
+
+// Current compressed format version. Readers reject other versions.
+static constexpr std::uint32_t COMPRESSED_INTERVAL_VERSION = 1u;
+
+/**
+ * Header at the start of a compressed interval file. It is followed by
+ * blockCount + 1 block offsets relative to the first block, then the
+ * blocks.
+ */
+struct CompressedIntervalFileHeader
+{
+    char magic[8u];
+    std::uint32_t version;
+    std::uint32_t byteOrder;        // INTERVAL_FILE_BYTE_ORDER
+    std::uint64_t count;            // Number of intervals.
+    std::uint64_t blockSize;        // Intervals per block.
+    std::uint64_t blockCount;       // Number of blocks.
+    std::uint64_t dataBytes;        // Bytes of all blocks.
+    std::uint8_t reserved[16u];     // Zero.
+};
+
+static_assert(sizeof(CompressedIntervalFileHeader) == 64u, "the offsets start on a 64-byte boundary");
+
+/**
+ * Column of intervals in compressed blocks.
+ */
+class CompressedIntervalArray {
+
+private:
+
+    // Bits of the fixed endpoints of each class; unused for General and Point.
+    static constexpr std::uint64_t POSITIVE_ZERO_BITS = 0x0000000000000000u;
+    static constexpr std::uint64_t POSITIVE_INF_BITS = 0x7FF0000000000000u;
+    static constexpr std::uint64_t NEGATIVE_INF_BITS = 0xFFF0000000000000u;
+
+    // Intervals per block.
+    std::size_t m_blockSize{};
+
+    // Number of intervals.
+    std::size_t m_count{0u};
+
+    // All blocks, one after another.
+    std::vector<std::uint8_t> m_data{};
+
+    // Offset of each block in m_data, and the total size last.
+    std::vector<std::uint64_t> m_offsets{0u};
+
+    static std::uint64_t bitsOf(double x) noexcept
+    {
+        std::uint64_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+
+        return bits;
+    }
+
+    static double valueOf(std::uint64_t bits) noexcept
+    {
+        double x;
+        std::memcpy(&x, &bits, sizeof(x));
+
+        return x;
+    }
+
+    static std::uint64_t quietNanBits() noexcept
+    {
+        return bitsOf(QUIET_NAN);
+    }
+
+    static std::uint32_t load32(const std::uint8_t* p) noexcept
+    {
+        std::uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+
+        return value;
+    }
+
+    static CompressedIntervalClass classify(std::uint64_t x0, std::uint64_t x1) noexcept
+    {
+        if (x0 == x1)
+        {
+            return (x0 == quietNanBits()) ? CompressedIntervalClass::NaN : CompressedIntervalClass::Point;
+        }
+        if (x0 == POSITIVE_ZERO_BITS && x1 == POSITIVE_INF_BITS)
+        {
+            return CompressedIntervalClass::Omega;
+        }
+        if (x0 == NEGATIVE_INF_BITS && x1 == POSITIVE_ZERO_BITS)
+        {
+            return CompressedIntervalClass::NegativeOmega;
+        }
+        if (x0 == NEGATIVE_INF_BITS && x1 == POSITIVE_INF_BITS)
+        {
+            return CompressedIntervalClass::OmegaTilde;
+        }
+
+        return CompressedIntervalClass::General;
+    }
+
+    // Appends a value: its control byte, and the bytes between the leading
+    // and trailing zero bytes to the payload.
+    static void encodeValue(std::uint64_t x, std::vector<std::uint8_t>& controls, std::vector<std::uint8_t>& payload)
+    {
+        unsigned leading = 0u;
+        while (leading < 8u && ((x >> (56u - 8u * leading)) & 0xFFu) == 0u)
+        {
+            leading++;
+        }
+        unsigned trailing = 0u;
+        while (leading + trailing < 8u && ((x >> (8u * trailing)) & 0xFFu) == 0u)
+        {
+            trailing++;
+        }
+        const unsigned bytes = 8u - leading - trailing;
+
+        controls.push_back(static_cast<std::uint8_t>((leading << 4u) | trailing));
+        x >>= 8u * trailing;
+        for (unsigned i = 0u; i < bytes; i++)
+        {
+            payload.push_back(static_cast<std::uint8_t>(x >> (8u * i)));
+        }
+    }
+
+    // Reads the value of a control byte from the payload and advances it.
+    static std::uint64_t decodeValue(std::uint8_t control, const std::uint8_t*& payload) noexcept
+    {
+        const unsigned trailing = control & 15u;
+        const unsigned bytes = 8u - (control >> 4u) - trailing;
+        // The payload is in little-endian byte order.
+        std::uint64_t x;
+        std::memcpy(&x, payload, sizeof(x));
+        payload += bytes;
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        x = __builtin_bswap64(x);
+#endif
+        const std::uint64_t mask = (bytes == 0u) ? 0u : (~std::uint64_t{0u} >> (64u - 8u * bytes));
+
+        return (x & mask) << (8u * trailing);
+    }
+
+    /**
+     * Encodes one block.
+     *
+     * @param lower count lower bounds
+     * @param upper count upper bounds
+     * @param count Number of intervals
+     * @param block The encoded block; replaced
+     */
+    static void encodeBlock(const double* lower, const double* upper, std::size_t count, std::vector<std::uint8_t>& block)
+    {
+        std::vector<std::uint8_t> classes((count + 1u) / 2u, 0u);
+        std::vector<std::uint8_t> controls{};
+        std::vector<std::uint8_t> payload{};
+        controls.reserve(2u * count);
+        payload.reserve(16u * count);
+
+        std::uint64_t previous = 0u;
+        for (std::size_t i = 0u; i < count; i++)
+        {
+            const std::uint64_t x0 = bitsOf(lower[i]);
+            const std::uint64_t x1 = bitsOf(upper[i]);
+            const CompressedIntervalClass k = classify(x0, x1);
+
+            classes[i / 2u] |= static_cast<std::uint8_t>(static_cast<unsigned>(k) << (4u * (i % 2u)));
+            if (k == CompressedIntervalClass::General || k == CompressedIntervalClass::Point)
+            {
+                encodeValue(x0 ^ previous, controls, payload);
+                previous = x0;
+            }
+            if (k == CompressedIntervalClass::General)
+            {
+                encodeValue(x1 ^ x0, controls, payload);
+            }
+        }
+
+        const std::uint32_t header[4u] = {static_cast<std::uint32_t>(count), static_cast<std::uint32_t>(controls.size()),
+                                          static_cast<std::uint32_t>(payload.size()), 0u};
+        block.resize(COMPRESSED_INTERVAL_BLOCK_HEADER);
+        std::memcpy(block.data(), header, sizeof(header));
+        block.insert(block.end(), classes.begin(), classes.end());
+        block.insert(block.end(), controls.begin(), controls.end());
+        block.insert(block.end(), payload.begin(), payload.end());
+        block.insert(block.end(), COMPRESSED_INTERVAL_PADDING, 0u);
+    }
+
+    /**
+     * Checks that a block is well formed, so decoding it stays within it.
+     *
+     * @param block Start of the block
+     * @param bytes Size of the block
+     * @param count Expected number of intervals
+     * @return true if the block decodes to count intervals
+     */
+    static bool validateBlock(const std::uint8_t* block, std::size_t bytes, std::size_t count) noexcept
+    {
+        if (bytes < COMPRESSED_INTERVAL_BLOCK_HEADER + COMPRESSED_INTERVAL_PADDING || load32(block) != count)
+        {
+            return false;
+        }
+        const std::uint64_t values = load32(block + 4u);
+        const std::uint64_t payloadBytes = load32(block + 8u);
+        const std::uint64_t classBytes = (count + 1u) / 2u;
+        if (COMPRESSED_INTERVAL_BLOCK_HEADER + classBytes + values + payloadBytes + COMPRESSED_INTERVAL_PADDING != bytes)
+        {
+            return false;
+        }
+
+        const std::uint8_t* classes = block + COMPRESSED_INTERVAL_BLOCK_HEADER;
+        std::uint64_t expectedValues = 0u;
+        for (std::size_t i = 0u; i < count; i++)
+        {
+            const unsigned k = (classes[i / 2u] >> (4u * (i % 2u))) & 15u;
+            if (k > static_cast<unsigned>(CompressedIntervalClass::NaN))
+            {
+                return false;
+            }
+            expectedValues += (k == 0u) ? 2u : ((k == 1u) ? 1u : 0u);
+        }
+
+        const std::uint8_t* controls = classes + classBytes;
+        std::uint64_t expectedPayload = 0u;
+        for (std::uint64_t v = 0u; v < values; v++)
+        {
+            const unsigned leading = controls[v] >> 4u;
+            const unsigned trailing = controls[v] & 15u;
+            if (leading + trailing > 8u || (leading + trailing == 8u && controls[v] != 0x80u))
+            {
+                return false;
+            }
+            expectedPayload += 8u - leading - trailing;
+        }
+
+        return expectedValues == values && expectedPayload == payloadBytes;
+    }
+
+public:
+
+    /**
+     * Constructor. Creates an empty column.
+     *
+     * @param blockSize Intervals per block; clamped to
+     *        [1, COMPRESSED_INTERVAL_MAX_BLOCK_SIZE]
+     */
+    explicit CompressedIntervalArray(std::size_t blockSize = COMPRESSED_INTERVAL_BLOCK_SIZE) :
+        m_blockSize{std::min(std::max<std::size_t>(blockSize, 1u), COMPRESSED_INTERVAL_MAX_BLOCK_SIZE)}
+    {
+    }
+
+    /**
+     * Compresses intervals from endpoint arrays, one block per task.
+     *
+     * @param lower count lower bounds
+     * @param upper count upper bounds
+     * @param count Number of intervals
+     * @param threads Number of threads; 0 selects std::thread::hardware_concurrency()
+     */
+    void compress(const double* lower, const double* upper, std::size_t count, std::size_t threads = 0u)
+    {
+        const std::size_t blocks = count / m_blockSize + ((count % m_blockSize != 0u) ? 1u : 0u);
+        std::vector<std::vector<std::uint8_t>> encoded(blocks);
+        parallelFor(blocks, threads, [&](std::size_t b) {
+            const std::size_t begin = b * m_blockSize;
+            encodeBlock(lower + begin, upper + begin, std::min(m_blockSize, count - begin), encoded[b]);
+        });
+
+        m_count = count;
+        m_offsets.assign(1u, 0u);
+        for (const auto& block : encoded)
+        {
+            m_offsets.push_back(m_offsets.back() + block.size());
+        }
+        m_data.clear();
+        m_data.reserve(static_cast<std::size_t>(m_offsets.back()));
+        for (const auto& block : encoded)
+        {
+            m_data.insert(m_data.end(), block.begin(), block.end());
+        }
+    }
+
+    /**
+     * Compresses an array of intervals.
+     *
+     * @param x The intervals
+     * @param threads Number of threads; 0 selects std::thread::hardware_concurrency()
+     */
+    void compress(const IntervalArray& x, std::size_t threads = 0u)
+    {
+        compress(x.lower(), x.upper(), x.size(), threads);
+    }
+
+    /**
+     * Gets the number of intervals.
+     *
+     * @return Number of intervals
+     */
+    std::size_t size() const noexcept
+    {
+        return m_count;
+    }
+
+    /**
+     * Gets the number of intervals per block.
+     *
+     * @return The block size
+     */
+    std::size_t blockSize() const noexcept
+    {
+        return m_blockSize;
+    }
+
+    /**
+     * Gets the number of blocks.
+     *
+     * @return Number of blocks
+     */
+    std::size_t blockCount() const noexcept
+    {
+        return m_offsets.size() - 1u;
+    }
+
+    /**
+     * Gets the number of intervals in a block; only the last block may be
+     * partial.
+     *
+     * @param block Index of the block
+     * @return Number of intervals
+     */
+    std::size_t blockLength(std::size_t block) const noexcept
+    {
+        return std::min(m_blockSize, m_count - block * m_blockSize);
+    }
+
+    /**
+     * Gets the size of the compressed blocks.
+     *
+     * @return Bytes of all blocks, without the offset table
+     */
+    std::size_t compressedBytes() const noexcept
+    {
+        return m_data.size();
+    }
+
+    /**
+     * Decompresses a block into endpoint arrays.
+     *
+     * @param block Index of the block
+     * @param lower blockLength(block) lower bounds
+     * @param upper blockLength(block) upper bounds
+     */
+    void decompressBlock(std::size_t block, double* lower, double* upper) const noexcept
+    {
+        // Fixed endpoints of each class, by class.
+        static const std::uint64_t CLASS_LOWER[6u] = {0u, 0u, POSITIVE_ZERO_BITS, NEGATIVE_INF_BITS, NEGATIVE_INF_BITS, quietNanBits()};
+        static const std::uint64_t CLASS_UPPER[6u] = {0u, 0u, POSITIVE_INF_BITS, POSITIVE_ZERO_BITS, POSITIVE_INF_BITS, quietNanBits()};
+
+        const std::uint8_t* data = m_data.data() + m_offsets[block];
+        const std::size_t count = load32(data);
+        const std::uint8_t* classes = data + COMPRESSED_INTERVAL_BLOCK_HEADER;
+        const std::uint8_t* controls = classes + (count + 1u) / 2u;
+        const std::uint8_t* payload = controls + load32(data + 4u);
+
+        // Without branches on the class, so mixed classes decode at the
+        // same speed. An interval without a stored value decodes the zero
+        // control byte 0x80 and advances by nothing; the padding keeps the
+        // reads of controls[1] and of the payload within the block.
+        std::uint64_t previous = 0u;
+        for (std::size_t i = 0u; i < count; i++)
+        {
+            const unsigned k = (classes[i / 2u] >> (4u * (i % 2u))) & 15u;
+            const unsigned values = (k == 0u) ? 2u : ((k == 1u) ? 1u : 0u);
+            const std::uint8_t control0 = (values >= 1u) ? controls[0] : std::uint8_t{0x80u};
+            const std::uint8_t control1 = (values == 2u) ? controls[1] : std::uint8_t{0x80u};
+            controls += values;
+
+            previous ^= decodeValue(control0, payload);
+            const std::uint64_t width = decodeValue(control1, payload);
+            lower[i] = valueOf((values != 0u) ? previous : CLASS_LOWER[k]);
+            upper[i] = valueOf((values != 0u) ? previous ^ width : CLASS_UPPER[k]);
+        }
+    }
+
+    /**
+     * Decompresses every block, one block per task.
+     *
+     * @param result The intervals; resized
+     * @param threads Number of threads; 0 selects std::thread::hardware_concurrency()
+     */
+    void decompress(IntervalArray& result, std::size_t threads = 0u) const
+    {
+        result.resize(m_count);
+        parallelFor(blockCount(), threads, [&](std::size_t b) {
+            decompressBlock(b, result.lower() + b * m_blockSize, result.upper() + b * m_blockSize);
+        });
+    }
+
+    /**
+     * Writes the column to a file.
+     *
+     * @param path Path of the file; created or truncated
+     * @return true on success
+     */
+    bool write(const char* path) const
+    {
+        std::FILE* file = std::fopen(path, "wb");
+        if (file == nullptr)
+        {
+            return false;
+        }
+
+        CompressedIntervalFileHeader header{};
+        std::memcpy(header.magic, COMPRESSED_INTERVAL_MAGIC, sizeof(header.magic));
+        header.version = COMPRESSED_INTERVAL_VERSION;
+        header.byteOrder = INTERVAL_FILE_BYTE_ORDER;
+        header.count = m_count;
+        header.blockSize = m_blockSize;
+        header.blockCount = blockCount();
+        header.dataBytes = m_data.size();
+
+        bool good = (std::fwrite(&header, sizeof(header), 1u, file) == 1u);
+        good = good && (std::fwrite(m_offsets.data(), sizeof(std::uint64_t), m_offsets.size(), file) == m_offsets.size());
+        good = good && (std::fwrite(m_data.data(), 1u, m_data.size(), file) == m_data.size());
+
+        return (std::fclose(file) == 0) && good;
+    }
+
+    /**
+     * Reads a column from a file and validates every block.
+     *
+     * @param path Path of the file
+     * @return false if the file cannot be read, is not a compressed interval
+     *         file of version COMPRESSED_INTERVAL_VERSION in the byte order
+     *         of this machine, or is damaged; the column is then empty
+     */
+    bool read(const char* path)
+    {
+        m_count = 0u;
+        m_data.clear();
+        m_offsets.assign(1u, 0u);
+
+        std::FILE* file = std::fopen(path, "rb");
+        if (file == nullptr)
+        {
+            return false;
+        }
+
+        CompressedIntervalFileHeader header{};
+        bool good = (std::fread(&header, sizeof(header), 1u, file) == 1u) &&
+                    std::memcmp(header.magic, COMPRESSED_INTERVAL_MAGIC, sizeof(header.magic)) == 0 &&
+                    header.version == COMPRESSED_INTERVAL_VERSION && header.byteOrder == INTERVAL_FILE_BYTE_ORDER && header.blockSize != 0u &&
+                    header.blockSize <= COMPRESSED_INTERVAL_MAX_BLOCK_SIZE &&
+                    header.blockCount == header.count / header.blockSize + ((header.count % header.blockSize != 0u) ? 1u : 0u);
+
+        // The block count is rounded up without overflow, so count fits the
+        // blocks, and each block must hold blockLength() intervals. Sizes are
+        // checked against the file before anything is allocated.
+        const bool sized = good && (std::fseek(file, 0L, SEEK_END) == 0);
+        const long fileSize = sized ? std::ftell(file) : -1L;
+        good = sized && fileSize >= 0L && std::fseek(file, static_cast<long>(sizeof(header)), SEEK_SET) == 0 &&
+               header.blockCount < static_cast<std::uint64_t>(fileSize) / sizeof(std::uint64_t) && header.dataBytes <= static_cast<std::uint64_t>(fileSize) &&
+               sizeof(header) + (header.blockCount + 1u) * sizeof(std::uint64_t) + header.dataBytes == static_cast<std::uint64_t>(fileSize);
+        if (good)
+        {
+            m_offsets.resize(static_cast<std::size_t>(header.blockCount + 1u));
+            m_data.resize(static_cast<std::size_t>(header.dataBytes));
+            good = (std::fread(m_offsets.data(), sizeof(std::uint64_t), m_offsets.size(), file) == m_offsets.size()) &&
+                   (std::fread(m_data.data(), 1u, m_data.size(), file) == m_data.size());
+        }
+        std::fclose(file);
+
+        m_blockSize = good ? static_cast<std::size_t>(header.blockSize) : m_blockSize;
+        m_count = good ? static_cast<std::size_t>(header.count) : 0u;
+        good = good && m_offsets.front() == 0u && m_offsets.back() == header.dataBytes;
+        for (std::size_t b = 0u; good && b < blockCount(); b++)
+        {
+            good = m_offsets[b] <= m_offsets[b + 1u] && validateBlock(m_data.data() + m_offsets[b], static_cast<std::size_t>(m_offsets[b + 1u] - m_offsets[b]), blockLength(b));
+        }
+        if (!good)
+        {
+            m_count = 0u;
+            m_data.clear();
+            m_offsets.assign(1u, 0u);
+        }
+
+        return good;
+    }
+
+};
+
+#endif /* COMPRESSEDINTERVALARRAY_HPP_ */
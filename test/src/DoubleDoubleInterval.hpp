@@ -0,0 +1,869 @@
+#ifndef DOUBLEDOUBLEINTERVAL_HPP_
+#define DOUBLEDOUBLEINTERVAL_HPP_
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <string>
+
+#include "IntervalNumber.hpp"
+
+// Intervals with double-double endpoints.
+//
+// A double-double value is the unevaluated sum hi + lo of two doubles with
+// |lo| <= ulp(hi)/2, which carries about 106 significand bits. Sums and
+// products are formed from error-free transformations -- TwoSum, and
+// TwoProd through a fused multiply-add -- following Joldes, Muller and
+// Popescu, "Tight and rigorous error bounds for basic building blocks of
+// double-word arithmetic" (2017). Their relative error is below 2^-100, so
+// DoubleDoubleInterval widens every inexact endpoint by that bound, plus an
+// absolute 2^-1060 for results near the subnormal range. Sums and products
+// of plain doubles are exact and are not widened.
+//
+// The kernels apply the indeterminate form rules of IntervalNumberT to the
+// high parts: 0·∞ gives [0, ∞] or [-∞, 0], ∞-∞ gives [-∞, ∞], and the
+// reciprocal follows the same case analysis, including the hull [-∞, ∞] for
+// a divisor spanning zero. The kernels use selects rather than branches, so
+// the batch loops of DoubleDoubleIntervalArray vectorize.
+//
+// The error-free transformations need every product rounded as written.
+// The CMake build passes -ffp-contract=off, so the compiler never fuses a
+// product and a sum on its own.
+
+/**
+ * Double-double number hi + lo, normalized so that |lo| <= ulp(hi)/2.
+ * Infinite and NaN values have lo = 0.
+ */
+class DoubleDouble {
+
+private:
+
+    // High part: the double nearest to the value.
+    double m_hi{};
+
+    // Low part: the remainder.
+    double m_lo{};
+
+public:
+
+    /**
+     * Default constructor.
+     * Initializes the value to 0.
+     */
+    DoubleDouble() noexcept = default;
+
+    /**
+     * Double constructor; exact.
+     *
+     * @param x The value
+     */
+    DoubleDouble(double x) noexcept :
+        m_hi{x}, m_lo{0.0}
+    {
+    }
+
+    /**
+     * Creates a double-double from parts that are already normalized, such
+     * as parts read back from getHi() and getLo().
+     *
+     * @param hi High part
+     * @param lo Low part
+     * @return The value hi + lo
+     */
+    static DoubleDouble fromParts(double hi, double lo) noexcept
+    {
+        return DoubleDouble(hi, lo, true);
+    }
+
+    /**
+     * Gets the high part.
+     *
+     * @return The double nearest to the value
+     */
+    double getHi() const noexcept
+    {
+        return m_hi;
+    }
+
+    /**
+     * Gets the low part.
+     *
+     * @return The remainder value - getHi()
+     */
+    double getLo() const noexcept
+    {
+        return m_lo;
+    }
+
+    /**
+     * Gets the largest double not above the value.
+     *
+     * @return The value rounded toward -∞
+     */
+    double toLower() const noexcept
+    {
+        return (m_lo < 0.0) ? std::nextafter(m_hi, -std::numeric_limits<double>::infinity()) : m_hi;
+    }
+
+    /**
+     * Gets the smallest double not below the value.
+     *
+     * @return The value rounded toward +∞
+     */
+    double toUpper() const noexcept
+    {
+        return (m_lo > 0.0) ? std::nextafter(m_hi, std::numeric_limits<double>::infinity()) : m_hi;
+    }
+
+    /**
+     * Converts the value to a string representation.
+     *
+     * @return String in format "hi+lo" with 17 significant digits per part
+     */
+    std::string toString() const noexcept
+    {
+        char buffer[64u];
+        std::snprintf(buffer, sizeof(buffer), "%.17g%+.17g", m_hi, m_lo);
+
+        return buffer;
+    }
+
+    /**
+     * Equality operator.
+     *
+     * @param other The value to compare with
+     * @return true if both parts match exactly
+     */
+    bool operator==(const DoubleDouble& other) const noexcept
+    {
+        return (m_hi == other.m_hi) && (m_lo == other.m_lo);
+    }
+
+    /**
+     * Inequality operator.
+     *
+     * @param other The value to compare with
+     * @return true if a part differs
+     */
+    bool operator!=(const DoubleDouble& other) const noexcept
+    {
+        return (m_hi != other.m_hi) || (m_lo != other.m_lo);
+    }
+
+    /**
+     * Less-than for normalized values, without branches.
+     *
+     * @param other The value to compare with
+     * @return true if this value is smaller
+     */
+    bool operator<(const DoubleDouble& other) const noexcept
+    {
+        return (m_hi < other.m_hi) | ((m_hi == other.m_hi) & (m_lo < other.m_lo));
+    }
+
+    /**
+     * Negation; exact.
+     *
+     * @return -value
+     */
+    DoubleDouble operator-() const noexcept
+    {
+        return DoubleDouble(-m_hi, -m_lo, true);
+    }
+
+    // Error-free transformations and double-double arithmetic on finite
+    // values. Overflow and infinite operands are left to the callers.
+
+    /**
+     * TwoSum: s + e = a + b exactly, with s = a + b rounded to nearest.
+     *
+     * @param a Left operand
+     * @param b Right operand
+     * @return The pair (s, e)
+     */
+    static DoubleDouble sum(double a, double b) noexcept
+    {
+        const double s = a + b;
+        const double aVirtual = s - b;
+        const double bVirtual = s - aVirtual;
+
+        return DoubleDouble(s, (a - aVirtual) + (b - bVirtual), true);
+    }
+
+    /**
+     * Fast2Sum: s + e = a + b exactly, for |a| >= |b| or a = 0.
+     *
+     * @param a Left operand
+     * @param b Right operand
+     * @return The pair (s, e)
+     */
+    static DoubleDouble fastSum(double a, double b) noexcept
+    {
+        const double s = a + b;
+
+        return DoubleDouble(s, b - (s - a), true);
+    }
+
+    /**
+     * TwoProd: p + e = a * b exactly, with p = a * b rounded to nearest,
+     * unless |p| < 2^-968, where e may underflow.
+     *
+     * @param a Left operand
+     * @param b Right operand
+     * @return The pair (p, e)
+     */
+    static DoubleDouble product(double a, double b) noexcept
+    {
+        const double p = a * b;
+
+        return DoubleDouble(p, std::fma(a, b, -p), true);
+    }
+
+    /**
+     * Sum of two double-doubles (AccurateDWPlusDW); relative error below
+     * 3·2^-106.
+     *
+     * @param x Left operand
+     * @param y Right operand
+     * @return x + y
+     */
+    static DoubleDouble add(const DoubleDouble& x, const DoubleDouble& y) noexcept
+    {
+        const DoubleDouble s = sum(x.m_hi, y.m_hi);
+        const DoubleDouble t = sum(x.m_lo, y.m_lo);
+        const DoubleDouble v = fastSum(s.m_hi, s.m_lo + t.m_hi);
+
+        return fastSum(v.m_hi, t.m_lo + v.m_lo);
+    }
+
+    /**
+     * Product of two double-doubles (DWTimesDW2); relative error below
+     * 5·2^-106.
+     *
+     * @param x Left operand
+     * @param y Right operand
+     * @return x * y
+     */
+    static DoubleDouble multiply(const DoubleDouble& x, const DoubleDouble& y) noexcept
+    {
+        const DoubleDouble c = product(x.m_hi, y.m_hi);
+        const double cross = std::fma(x.m_lo, y.m_hi, x.m_hi * y.m_lo);
+
+        return fastSum(c.m_hi, c.m_lo + cross);
+    }
+
+    /**
+     * Reciprocal of a double-double by one Newton step from 1/hi; relative
+     * error below 9·2^-106.
+     *
+     * @param y Divisor, finite and nonzero
+     * @return 1 / y
+     */
+    static DoubleDouble reciprocal(const DoubleDouble& y) noexcept
+    {
+        const double q = 1.0 / y.m_hi;
+
+        // 1 - y·q; the part 1 - hi·q is exact.
+        const double residual = std::fma(-y.m_lo, q, std::fma(-y.m_hi, q, 1.0));
+
+        return fastSum(q, residual * q);
+    }
+
+private:
+
+    /**
+     * Parts constructor for results that are normalized by construction.
+     *
+     * @param hi High part
+     * @param lo Low part
+     */
+    DoubleDouble(double hi, double lo, bool) noexcept :
+        m_hi{hi}, m_lo{lo}
+    {
+    }
+
+};
+
+/**
+ * Interval [x0, x1]in with double-double endpoints whose operations round
+ * outward, so the result encloses the exact extended-real result of the
+ * operation on the stored endpoints.
+ *
+ * Indeterminate forms follow the same rules as IntervalNumber.
+ */
+class DoubleDoubleInterval {
+
+public:
+
+    // Endpoint type.
+    using value_type = DoubleDouble;
+
+    // Relative error bound of the double-double operations, with room for
+    // the rounding of the widening itself.
+    static constexpr double RELATIVE_ERROR = 0x1p-100;
+
+    // Absolute error bound of results whose parts reach the subnormal range.
+    static constexpr double ABSOLUTE_ERROR = 0x1p-1060;
+
+private:
+
+    static constexpr double INF = std::numeric_limits<double>::infinity();
+    static constexpr double QUIET_NAN = std::numeric_limits<double>::quiet_NaN();
+    static constexpr double MAX = std::numeric_limits<double>::max();
+
+    // A finite result whose high part overflows exceeds this bound, 15 ulps
+    // below the largest double.
+    static constexpr double OVERFLOW_BOUND = 0x1.ffffffffffff0p+1023;
+
+    // Below this magnitude the low part of TwoProd may underflow.
+    static constexpr double EXACT_PRODUCT_MIN = 0x1p-968;
+
+    // Lower bound x0.
+    DoubleDouble m_x0{};
+
+    // Upper bound x1.
+    DoubleDouble m_x1{};
+
+    /**
+     * Validates and normalizes the interval to ensure x0 <= x1.
+     * If either bound is NaN, the entire interval becomes NaN.
+     */
+    void check() noexcept
+    {
+        if (m_x1 < m_x0)
+        {
+            const DoubleDouble x = m_x0;
+            m_x0 = m_x1;
+            m_x1 = x;
+        }
+
+        if (std::isnan(m_x0.getHi()) || std::isnan(m_x1.getHi()))
+        {
+            m_x0 = DoubleDouble(QUIET_NAN);
+            m_x1 = DoubleDouble(QUIET_NAN);
+        }
+    }
+
+public:
+
+    /**
+     * Default constructor.
+     * Initializes interval to [0, 0]in.
+     */
+    DoubleDoubleInterval() noexcept = default;
+
+    /**
+     * Single value constructor.
+     * Creates a point interval [x0, x0]in.
+     *
+     * @param x0 The single value for both endpoints
+     */
+    DoubleDoubleInterval(double x0) noexcept :
+        m_x0{x0}, m_x1{x0}
+    {
+        check();
+    }
+
+    /**
+     * Interval constructor.
+     * Creates an interval [x0, x1]in. Automatically ensures x0 <= x1.
+     *
+     * @param x0 Lower bound
+     * @param x1 Upper bound
+     */
+    DoubleDoubleInterval(double x0, double x1) noexcept :
+        m_x0{x0}, m_x1{x1}
+    {
+        check();
+    }
+
+    /**
+     * Double-double constructor.
+     * Creates an interval [x0, x1]in. Automatically ensures x0 <= x1.
+     *
+     * @param x0 Lower bound
+     * @param x1 Upper bound
+     */
+    DoubleDoubleInterval(const DoubleDouble& x0, const DoubleDouble& x1) noexcept :
+        m_x0{x0}, m_x1{x1}
+    {
+        check();
+    }
+
+    /**
+     * Conversion constructor from a round-to-nearest interval; exact.
+     *
+     * @param other The interval to convert
+     */
+    explicit DoubleDoubleInterval(const IntervalNumber& other) noexcept :
+        m_x0{other.getX0()}, m_x1{other.getX1()}
+    {
+    }
+
+    /**
+     * Converts to the tightest interval with double endpoints that encloses
+     * this interval.
+     *
+     * @return The enclosing IntervalNumber
+     */
+    IntervalNumber toNearest() const noexcept
+    {
+        return IntervalNumber(m_x0.toLower(), m_x1.toUpper());
+    }
+
+    /**
+     * Gets the lower bound of the interval.
+     *
+     * @return The value x0
+     */
+    DoubleDouble getX0() const noexcept
+    {
+        return m_x0;
+    }
+
+    /**
+     * Gets the upper bound of the interval.
+     *
+     * @return The value x1
+     */
+    DoubleDouble getX1() const noexcept
+    {
+        return m_x1;
+    }
+
+    /**
+     * Converts the interval to a string representation.
+     *
+     * @return String in format "[x0, x1]in", each endpoint as "hi+lo"
+     */
+    std::string toString() const noexcept
+    {
+        return "[" + m_x0.toString() + ", " + m_x1.toString() + "]in";
+    }
+
+    /**
+     * Equality operator.
+     * Two intervals are equal if both endpoints match exactly.
+     *
+     * @param other The interval to compare with
+     * @return true if intervals are equal, false otherwise
+     */
+    bool operator==(const DoubleDoubleInterval& other) const noexcept
+    {
+        return (m_x0 == other.m_x0) && (m_x1 == other.m_x1);
+    }
+
+    /**
+     * Inequality operator.
+     *
+     * @param other The interval to compare with
+     * @return true if intervals are not equal, false otherwise
+     */
+    bool operator!=(const DoubleDoubleInterval& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    /**
+     * Interval multiplication with outward rounding.
+     *
+     * @param other The interval to multiply by
+     * @return Resulting interval
+     */
+    DoubleDoubleInterval operator*(const DoubleDoubleInterval& other) const noexcept
+    {
+        DoubleDouble r0{};
+        DoubleDouble r1{};
+        multiplyBounds(m_x0, m_x1, other.m_x0, other.m_x1, r0, r1);
+
+        return DoubleDoubleInterval(r0, r1);
+    }
+
+    /**
+     * Scalar multiplication operator.
+     *
+     * @param x Scalar value
+     * @return Resulting interval
+     */
+    DoubleDoubleInterval operator*(double x) const noexcept
+    {
+        return *this * DoubleDoubleInterval(x);
+    }
+
+    /**
+     * Interval addition with outward rounding.
+     *
+     * @param other The interval to add
+     * @return Resulting interval
+     */
+    DoubleDoubleInterval operator+(const DoubleDoubleInterval& other) const noexcept
+    {
+        DoubleDouble r0{};
+        DoubleDouble r1{};
+        addBounds(m_x0, m_x1, other.m_x0, other.m_x1, r0, r1);
+
+        return DoubleDoubleInterval(r0, r1);
+    }
+
+    /**
+     * Scalar addition operator.
+     *
+     * @param x Scalar value
+     * @return Resulting interval
+     */
+    DoubleDoubleInterval operator+(double x) const noexcept
+    {
+        return *this + DoubleDoubleInterval(x);
+    }
+
+    /**
+     * Interval subtraction with outward rounding.
+     *
+     * @param other The interval to subtract
+     * @return Resulting interval
+     */
+    DoubleDoubleInterval operator-(const DoubleDoubleInterval& other) const noexcept
+    {
+        DoubleDouble r0{};
+        DoubleDouble r1{};
+        subtractBounds(m_x0, m_x1, other.m_x0, other.m_x1, r0, r1);
+
+        return DoubleDoubleInterval(r0, r1);
+    }
+
+    /**
+     * Scalar subtraction operator.
+     *
+     * @param x Scalar value
+     * @return Resulting interval
+     */
+    DoubleDoubleInterval operator-(double x) const noexcept
+    {
+        return *this - DoubleDoubleInterval(x);
+    }
+
+    /**
+     * Interval division with outward rounding.
+     *
+     * @param other The interval to divide by
+     * @return Resulting interval
+     */
+    DoubleDoubleInterval operator/(const DoubleDoubleInterval& other) const noexcept
+    {
+        DoubleDouble r0{};
+        DoubleDouble r1{};
+        divideBounds(m_x0, m_x1, other.m_x0, other.m_x1, r0, r1);
+
+        return DoubleDoubleInterval(r0, r1);
+    }
+
+    /**
+     * Scalar division operator.
+     *
+     * @param x Scalar value
+     * @return Resulting interval
+     */
+    DoubleDoubleInterval operator/(double x) const noexcept
+    {
+        return *this / DoubleDoubleInterval(x);
+    }
+
+    // Directed rounding. Each function receives a double-double result of
+    // finite operands and widens it by the error bound unless the result is
+    // known to be exact. A high part that overflowed becomes the finite
+    // bound on the inner side and ±∞ on the outer side.
+
+    /**
+     * Rounds a double-double result toward -∞.
+     *
+     * @param r The result of finite operands
+     * @param exact true if r is exact
+     * @param estimate The double result, for the sign of an overflow
+     * @return Lower bound of the exact result
+     */
+    static DoubleDouble roundDown(const DoubleDouble& r, bool exact, double estimate) noexcept
+    {
+        const bool finite = std::fabs(r.getHi()) <= MAX;
+        const double margin = exact ? 0.0 : std::fabs(r.getHi()) * RELATIVE_ERROR + ABSOLUTE_ERROR;
+        const DoubleDouble widened = DoubleDouble::sum(r.getHi(), r.getLo() - margin);
+
+        return finite ? widened : DoubleDouble((estimate > 0.0) ? OVERFLOW_BOUND : -INF);
+    }
+
+    /**
+     * Rounds a double-double result toward +∞.
+     *
+     * @param r The result of finite operands
+     * @param exact true if r is exact
+     * @param estimate The double result, for the sign of an overflow
+     * @return Upper bound of the exact result
+     */
+    static DoubleDouble roundUp(const DoubleDouble& r, bool exact, double estimate) noexcept
+    {
+        const bool finite = std::fabs(r.getHi()) <= MAX;
+        const double margin = exact ? 0.0 : std::fabs(r.getHi()) * RELATIVE_ERROR + ABSOLUTE_ERROR;
+        const DoubleDouble widened = DoubleDouble::sum(r.getHi(), r.getLo() + margin);
+
+        return finite ? widened : DoubleDouble((estimate < 0.0) ? -OVERFLOW_BOUND : INF);
+    }
+
+    // Endpoint kernels, with the signatures of the IntervalNumberT kernels.
+
+    /**
+     * Folds the candidate bounds [vlo, vhi] into the running hull [lo, hi];
+     * among equal candidates the first one folded wins.
+     *
+     * @param lo Running lower bound
+     * @param hi Running upper bound
+     * @param vlo Candidate lower bound
+     * @param vhi Candidate upper bound
+     */
+    static void includeBounds(DoubleDouble& lo, DoubleDouble& hi, const DoubleDouble& vlo, const DoubleDouble& vhi) noexcept
+    {
+        lo = (vlo < lo) ? vlo : lo;
+        hi = (hi < vhi) ? vhi : hi;
+    }
+
+    /**
+     * Outward-rounded product of two endpoints as a pair of candidate bounds.
+     * A zero or infinite operand makes the product exact: ±0, ±∞, or the
+     * Rule I / Rule II candidates [0, ∞] and [-∞, 0] for 0·±∞.
+     *
+     * @param a Left endpoint
+     * @param b Right endpoint
+     * @param lo Candidate lower bound
+     * @param hi Candidate upper bound
+     */
+    static void productBounds(const DoubleDouble& a, const DoubleDouble& b, DoubleDouble& lo, DoubleDouble& hi) noexcept
+    {
+        const double p = a.getHi() * b.getHi();
+        const bool special = !(std::fabs(a.getHi()) <= MAX) | !(std::fabs(b.getHi()) <= MAX) | (a.getHi() == 0.0) | (b.getHi() == 0.0);
+        const bool zeroInf = (p != p);
+        const bool positive = (a.getHi() + b.getHi()) > 0.0;
+        // The low parts are tested through their sum; a separate test of each
+        // is folded into the selects of the caller, and the loops then do not
+        // vectorize.
+        const bool exact = (std::fabs(a.getLo()) + std::fabs(b.getLo()) == 0.0) & (std::fabs(p) >= EXACT_PRODUCT_MIN);
+
+        const DoubleDouble r = DoubleDouble::multiply(a, b);
+        const DoubleDouble down = roundDown(r, exact, p);
+        const DoubleDouble up = roundUp(r, exact, p);
+
+        lo = special ? DoubleDouble(zeroInf ? (positive ? 0.0 : -INF) : p) : down;
+        hi = special ? DoubleDouble(zeroInf ? (positive ? INF : 0.0) : p) : up;
+    }
+
+    /**
+     * Outward-rounded reciprocal of an endpoint. 1/±∞ = ±0 and 1/±0 = ±∞
+     * are exact.
+     *
+     * @param y Divisor endpoint
+     * @param up true to round toward +∞, false toward -∞
+     * @return Bound of 1 / y
+     */
+    static DoubleDouble reciprocalBound(const DoubleDouble& y, bool up) noexcept
+    {
+        const double q = 1.0 / y.getHi();
+        const bool special = !(std::fabs(y.getHi()) <= MAX) | (y.getHi() == 0.0);
+        const bool exact = (y.getLo() == 0.0) & (std::fma(-y.getHi(), q, 1.0) == 0.0);
+
+        const DoubleDouble r = DoubleDouble::reciprocal(y);
+        const DoubleDouble bound = up ? roundUp(r, exact, q) : roundDown(r, exact, q);
+
+        return special ? DoubleDouble(q) : bound;
+    }
+
+    /**
+     * Hull of the four corner products, folded in the order of
+     * IntervalNumberT::productHull.
+     *
+     * @param x0 Lower bound of the left operand
+     * @param x1 Upper bound of the left operand
+     * @param y0 Lower bound of the right operand
+     * @param y1 Upper bound of the right operand
+     * @param lo Lower bound of the hull
+     * @param hi Upper bound of the hull
+     */
+    static void productHull(const DoubleDouble& x0, const DoubleDouble& x1, const DoubleDouble& y0, const DoubleDouble& y1, DoubleDouble& lo,
+                            DoubleDouble& hi) noexcept
+    {
+        DoubleDouble clo{};
+        DoubleDouble chi{};
+
+        productBounds(x0, y0, lo, hi);
+        productBounds(x0, y1, clo, chi);
+        includeBounds(lo, hi, clo, chi);
+        productBounds(x1, y0, clo, chi);
+        includeBounds(lo, hi, clo, chi);
+        productBounds(x1, y1, clo, chi);
+        includeBounds(lo, hi, clo, chi);
+    }
+
+    /**
+     * Multiplication kernel: [x0,x1]in * [y0,y1]in -> [r0,r1]in.
+     *
+     * @param x0 Lower bound of the left operand
+     * @param x1 Upper bound of the left operand
+     * @param y0 Lower bound of the right operand
+     * @param y1 Upper bound of the right operand
+     * @param r0 Lower bound of the result
+     * @param r1 Upper bound of the result
+     */
+    static void multiplyBounds(const DoubleDouble& x0, const DoubleDouble& x1, const DoubleDouble& y0, const DoubleDouble& y1, DoubleDouble& r0,
+                               DoubleDouble& r1) noexcept
+    {
+        DoubleDouble lo{};
+        DoubleDouble hi{};
+        productHull(x0, x1, y0, y1, lo, hi);
+
+        const bool isNaN = (x0.getHi() != x0.getHi()) | (x1.getHi() != x1.getHi()) | (y0.getHi() != y0.getHi()) | (y1.getHi() != y1.getHi());
+
+        r0 = isNaN ? DoubleDouble(QUIET_NAN) : lo;
+        r1 = isNaN ? DoubleDouble(QUIET_NAN) : hi;
+    }
+
+    /**
+     * Addition kernel: [x0,x1]in + [y0,y1]in -> [r0,r1]in. An ∞-∞ corner
+     * gives the hull [-∞, ∞].
+     *
+     * @param x0 Lower bound of the left operand
+     * @param x1 Upper bound of the left operand
+     * @param y0 Lower bound of the right operand
+     * @param y1 Upper bound of the right operand
+     * @param r0 Lower bound of the result
+     * @param r1 Upper bound of the result
+     */
+    static void addBounds(const DoubleDouble& x0, const DoubleDouble& x1, const DoubleDouble& y0, const DoubleDouble& y1, DoubleDouble& r0,
+                          DoubleDouble& r1) noexcept
+    {
+        const double s0 = x0.getHi() + y0.getHi();
+        const double s1 = x1.getHi() + y1.getHi();
+        const bool special0 = !(std::fabs(x0.getHi()) <= MAX) | !(std::fabs(y0.getHi()) <= MAX);
+        const bool special1 = !(std::fabs(x1.getHi()) <= MAX) | !(std::fabs(y1.getHi()) <= MAX);
+        const bool indeterminate0 = (s0 != s0);
+        const bool indeterminate1 = (s1 != s1);
+        const bool exact0 = (x0.getLo() == 0.0) & (y0.getLo() == 0.0);
+        const bool exact1 = (x1.getLo() == 0.0) & (y1.getLo() == 0.0);
+
+        const DoubleDouble lo = roundDown(DoubleDouble::add(x0, y0), exact0, s0);
+        const DoubleDouble hi = roundUp(DoubleDouble::add(x1, y1), exact1, s1);
+
+        const bool isNaN = (x0.getHi() != x0.getHi()) | (x1.getHi() != x1.getHi()) | (y0.getHi() != y0.getHi()) | (y1.getHi() != y1.getHi());
+        const bool lowerInf = indeterminate0 | indeterminate1;
+
+        r0 = isNaN ? DoubleDouble(QUIET_NAN) : (lowerInf ? DoubleDouble(-INF) : (special0 ? DoubleDouble(s0) : lo));
+        r1 = isNaN ? DoubleDouble(QUIET_NAN) : (lowerInf ? DoubleDouble(INF) : (special1 ? DoubleDouble(s1) : hi));
+    }
+
+    /**
+     * Subtraction kernel: [x0,x1]in - [y0,y1]in -> [r0,r1]in, the sum with
+     * [-y1, -y0]in.
+     *
+     * @param x0 Lower bound of the left operand
+     * @param x1 Upper bound of the left operand
+     * @param y0 Lower bound of the right operand
+     * @param y1 Upper bound of the right operand
+     * @param r0 Lower bound of the result
+     * @param r1 Upper bound of the result
+     */
+    static void subtractBounds(const DoubleDouble& x0, const DoubleDouble& x1, const DoubleDouble& y0, const DoubleDouble& y1, DoubleDouble& r0,
+                               DoubleDouble& r1) noexcept
+    {
+        addBounds(x0, x1, -y1, -y0, r0, r1);
+    }
+
+    /**
+     * Division kernel: [x0,x1]in / [y0,y1]in -> [r0,r1]in.
+     * Multiplies by the outward-rounded reciprocal, formed by the case
+     * analysis of IntervalNumberT::divideBounds.
+     *
+     * @param x0 Lower bound of the dividend
+     * @param x1 Upper bound of the dividend
+     * @param y0 Lower bound of the divisor
+     * @param y1 Upper bound of the divisor
+     * @param r0 Lower bound of the result
+     * @param r1 Upper bound of the result
+     */
+    static void divideBounds(const DoubleDouble& x0, const DoubleDouble& x1, const DoubleDouble& y0, const DoubleDouble& y1, DoubleDouble& r0,
+                             DoubleDouble& r1) noexcept
+    {
+        const bool finiteLo = (y0.getHi() >= 0.0) | (y1.getHi() < 0.0);
+        const bool finiteHi = (y1.getHi() <= 0.0) | (y0.getHi() > 0.0);
+
+        // As in IntervalNumberT, the reciprocal of a signed zero yields the
+        // infinite bounds: for a divisor [y0, 0] the sign of y1 is forced to
+        // minus, for [0, y1] the sign of y0 to plus. This also flips a
+        // divisor spanning zero, whose result is replaced by the full hull,
+        // like that of the point [0, 0]. Forcing signs rather than selecting
+        // the divisor keeps the kernel vectorizable.
+        const bool hull = (!(finiteLo | finiteHi)) | ((y0.getHi() == 0.0) & (y1.getHi() == 0.0));
+        const double sign1 = finiteLo ? y1.getHi() : -1.0;
+        const double sign0 = finiteHi ? y0.getHi() : 1.0;
+        const DoubleDouble d1 = DoubleDouble::fromParts(std::copysign(y1.getHi(), sign1), y1.getLo() * (finiteLo ? 1.0 : -1.0));
+        const DoubleDouble d0 = DoubleDouble::fromParts(std::copysign(y0.getHi(), sign0), y0.getLo() * (finiteHi ? 1.0 : -1.0));
+        const DoubleDouble q0 = reciprocalBound(d1, false);
+        const DoubleDouble q1 = reciprocalBound(d0, true);
+
+        // The reciprocal bounds are never NaN, so the hull needs no NaN check
+        // of its own.
+        DoubleDouble lo{};
+        DoubleDouble hi{};
+        productHull(x0, x1, q0, q1, lo, hi);
+
+        const bool isNaN = (x0.getHi() != x0.getHi()) | (x1.getHi() != x1.getHi()) | (y0.getHi() != y0.getHi()) | (y1.getHi() != y1.getHi());
+
+        r0 = isNaN ? DoubleDouble(QUIET_NAN) : (hull ? DoubleDouble(-INF) : lo);
+        r1 = isNaN ? DoubleDouble(QUIET_NAN) : (hull ? DoubleDouble(INF) : hi);
+    }
+
+};
+
+/**
+ * Global multiplication operator (scalar * interval).
+ *
+ * @param x Scalar value
+ * @param other Interval
+ * @return Resulting interval
+ */
+inline DoubleDoubleInterval operator*(double x, const DoubleDoubleInterval& other) noexcept
+{
+    return DoubleDoubleInterval(x) * other;
+}
+
+/**
+ * Global addition operator (scalar + interval).
+ *
+ * @param x Scalar value
+ * @param other Interval
+ * @return Resulting interval
+ */
+inline DoubleDoubleInterval operator+(double x, const DoubleDoubleInterval& other) noexcept
+{
+    return DoubleDoubleInterval(x) + other;
+}
+
+/**
+ * Global subtraction operator (scalar - interval).
+ *
+ * @param x Scalar value
+ * @param other Interval
+ * @return Resulting interval
+ */
+inline DoubleDoubleInterval operator-(double x, const DoubleDoubleInterval& other) noexcept
+{
+    return DoubleDoubleInterval(x) - other;
+}
+
+/**
+ * Global division operator (scalar / interval).
+ *
+ * @param x Scalar value
+ * @param other Interval
+ * @return Resulting interval
+ */
+inline DoubleDoubleInterval operator/(double x, const DoubleDoubleInterval& other) noexcept
+{
+    return DoubleDoubleInterval(x) / other;
+}
+
+#endif /* DOUBLEDOUBLEINTERVAL_HPP_ */
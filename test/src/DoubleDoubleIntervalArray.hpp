@@ -0,0 +1,504 @@
+#ifndef DOUBLEDOUBLEINTERVALARRAY_HPP_
+#define DOUBLEDOUBLEINTERVALARRAY_HPP_
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+#include "DoubleDoubleInterval.hpp"
+#include "IntervalArray.hpp"
+#include "IntervalDispatch.hpp"
+
+/**
+ * Structure-of-arrays container of double-double intervals.
+ *
+ * The high and low parts of both bounds are kept in four separate, 64-byte
+ * aligned arrays. Element i is the interval
+ * [lowerHi()[i] + lowerLo()[i], upperHi()[i] + upperLo()[i]]in.
+ */
+class DoubleDoubleIntervalArray {
+
+private:
+
+    using Storage = std::vector<double, AlignedAllocator<double>>;
+
+    // High parts of the lower bounds.
+    Storage m_lowerHi{};
+
+    // Low parts of the lower bounds.
+    Storage m_lowerLo{};
+
+    // High parts of the upper bounds.
+    Storage m_upperHi{};
+
+    // Low parts of the upper bounds.
+    Storage m_upperLo{};
+
+public:
+
+    /**
+     * Default constructor.
+     * Creates an empty array.
+     */
+    DoubleDoubleIntervalArray() = default;
+
+    /**
+     * Size constructor.
+     * Creates count intervals initialized to [0, 0]in.
+     *
+     * @param count Number of intervals
+     */
+    explicit DoubleDoubleIntervalArray(std::size_t count) :
+        m_lowerHi(count, 0.0), m_lowerLo(count, 0.0), m_upperHi(count, 0.0), m_upperLo(count, 0.0)
+    {
+    }
+
+    /**
+     * List constructor.
+     *
+     * @param intervals Intervals to store
+     */
+    DoubleDoubleIntervalArray(std::initializer_list<DoubleDoubleInterval> intervals)
+    {
+        reserve(intervals.size());
+        for (const auto& interval : intervals)
+        {
+            pushBack(interval);
+        }
+    }
+
+    /**
+     * Conversion constructor from an IntervalArray; exact.
+     *
+     * @param other The intervals to convert
+     */
+    explicit DoubleDoubleIntervalArray(const IntervalArray& other) :
+        m_lowerHi(other.lower(), other.lower() + other.size()), m_lowerLo(other.size(), 0.0), m_upperHi(other.upper(), other.upper() + other.size()),
+        m_upperLo(other.size(), 0.0)
+    {
+    }
+
+    /**
+     * Gets the number of intervals.
+     *
+     * @return Number of intervals
+     */
+    std::size_t size() const noexcept
+    {
+        return m_lowerHi.size();
+    }
+
+    /**
+     * Resizes the array. New intervals are [0, 0]in.
+     *
+     * @param count New number of intervals
+     */
+    void resize(std::size_t count)
+    {
+        m_lowerHi.resize(count, 0.0);
+        m_lowerLo.resize(count, 0.0);
+        m_upperHi.resize(count, 0.0);
+        m_upperLo.resize(count, 0.0);
+    }
+
+    /**
+     * Reserves storage for count intervals.
+     *
+     * @param count Number of intervals
+     */
+    void reserve(std::size_t count)
+    {
+        m_lowerHi.reserve(count);
+        m_lowerLo.reserve(count);
+        m_upperHi.reserve(count);
+        m_upperLo.reserve(count);
+    }
+
+    /**
+     * Appends an interval.
+     *
+     * @param interval The interval to append
+     */
+    void pushBack(const DoubleDoubleInterval& interval)
+    {
+        m_lowerHi.push_back(interval.getX0().getHi());
+        m_lowerLo.push_back(interval.getX0().getLo());
+        m_upperHi.push_back(interval.getX1().getHi());
+        m_upperLo.push_back(interval.getX1().getLo());
+    }
+
+    /**
+     * Gets an interval.
+     *
+     * @param index Position of the interval
+     * @return The interval at index
+     */
+    DoubleDoubleInterval get(std::size_t index) const noexcept
+    {
+        return DoubleDoubleInterval(DoubleDouble::fromParts(m_lowerHi[index], m_lowerLo[index]), DoubleDouble::fromParts(m_upperHi[index], m_upperLo[index]));
+    }
+
+    /**
+     * Sets an interval.
+     *
+     * @param index Position of the interval
+     * @param interval The new value
+     */
+    void set(std::size_t index, const DoubleDoubleInterval& interval) noexcept
+    {
+        m_lowerHi[index] = interval.getX0().getHi();
+        m_lowerLo[index] = interval.getX0().getLo();
+        m_upperHi[index] = interval.getX1().getHi();
+        m_upperLo[index] = interval.getX1().getLo();
+    }
+
+    /**
+     * Gets the high parts of the lower bounds.
+     *
+     * @return Pointer to size() values
+     */
+    double* lowerHi() noexcept
+    {
+        return m_lowerHi.data();
+    }
+
+    /**
+     * Gets the high parts of the lower bounds.
+     *
+     * @return Pointer to size() values
+     */
+    const double* lowerHi() const noexcept
+    {
+        return m_lowerHi.data();
+    }
+
+    /**
+     * Gets the low parts of the lower bounds.
+     *
+     * @return Pointer to size() values
+     */
+    double* lowerLo() noexcept
+    {
+        return m_lowerLo.data();
+    }
+
+    /**
+     * Gets the low parts of the lower bounds.
+     *
+     * @return Pointer to size() values
+     */
+    const double* lowerLo() const noexcept
+    {
+        return m_lowerLo.data();
+    }
+
+    /**
+     * Gets the high parts of the upper bounds.
+     *
+     * @return Pointer to size() values
+     */
+    double* upperHi() noexcept
+    {
+        return m_upperHi.data();
+    }
+
+    /**
+     * Gets the high parts of the upper bounds.
+     *
+     * @return Pointer to size() values
+     */
+    const double* upperHi() const noexcept
+    {
+        return m_upperHi.data();
+    }
+
+    /**
+     * Gets the low parts of the upper bounds.
+     *
+     * @return Pointer to size() values
+     */
+    double* upperLo() noexcept
+    {
+        return m_upperLo.data();
+    }
+
+    /**
+     * Gets the low parts of the upper bounds.
+     *
+     * @return Pointer to size() values
+     */
+    const double* upperLo() const noexcept
+    {
+        return m_upperLo.data();
+    }
+
+};
+
+// Batch kernels. Like batchFma(), each loop computes a block of results
+// into local buffers before storing them, so the compiler needs no alias
+// checks between the eight input and four output arrays, and the result may
+// be one of the operands.
+
+/**
+ * Signature of the double-double batch kernels: result[i] = x[i] op y[i]
+ * for the first x.size() intervals; result must already hold that many.
+ */
+using DoubleDoubleBatchKernel = void (*)(const DoubleDoubleIntervalArray& x, const DoubleDoubleIntervalArray& y, DoubleDoubleIntervalArray& result);
+
+/**
+ * Applies an endpoint kernel of DoubleDoubleInterval to every element.
+ *
+ * @param x Left operands
+ * @param y Right operands
+ * @param result Results
+ */
+template<void (*Kernel)(const DoubleDouble&, const DoubleDouble&, const DoubleDouble&, const DoubleDouble&, DoubleDouble&, DoubleDouble&)>
+inline void batchDoubleDouble(const DoubleDoubleIntervalArray& x, const DoubleDoubleIntervalArray& y, DoubleDoubleIntervalArray& result) noexcept
+{
+    constexpr std::size_t BLOCK = 64u;
+
+    const double* x0Hi = x.lowerHi();
+    const double* x0Lo = x.lowerLo();
+    const double* x1Hi = x.upperHi();
+    const double* x1Lo = x.upperLo();
+    const double* y0Hi = y.lowerHi();
+    const double* y0Lo = y.lowerLo();
+    const double* y1Hi = y.upperHi();
+    const double* y1Lo = y.upperLo();
+    double* r0Hi = result.lowerHi();
+    double* r0Lo = result.lowerLo();
+    double* r1Hi = result.upperHi();
+    double* r1Lo = result.upperLo();
+    const std::size_t count = x.size();
+
+    double lowerHi[BLOCK];
+    double lowerLo[BLOCK];
+    double upperHi[BLOCK];
+    double upperLo[BLOCK];
+    for (std::size_t begin = 0u; begin < count; begin += BLOCK)
+    {
+        const std::size_t size = (count - begin < BLOCK) ? count - begin : BLOCK;
+        for (std::size_t i = 0u; i < size; i++)
+        {
+            const std::size_t j = begin + i;
+
+            DoubleDouble r0{};
+            DoubleDouble r1{};
+            Kernel(DoubleDouble::fromParts(x0Hi[j], x0Lo[j]), DoubleDouble::fromParts(x1Hi[j], x1Lo[j]), DoubleDouble::fromParts(y0Hi[j], y0Lo[j]),
+                   DoubleDouble::fromParts(y1Hi[j], y1Lo[j]), r0, r1);
+            lowerHi[i] = r0.getHi();
+            lowerLo[i] = r0.getLo();
+            upperHi[i] = r1.getHi();
+            upperLo[i] = r1.getLo();
+        }
+        for (std::size_t i = 0u; i < size; i++)
+        {
+            r0Hi[begin + i] = lowerHi[i];
+            r0Lo[begin + i] = lowerLo[i];
+            r1Hi[begin + i] = upperHi[i];
+            r1Lo[begin + i] = upperLo[i];
+        }
+    }
+}
+
+/**
+ * The double-double kernel variants compiled for one instruction set.
+ */
+struct DoubleDoubleKernelTable
+{
+    IntervalIsa isa;
+    DoubleDoubleBatchKernel add;
+    DoubleDoubleBatchKernel subtract;
+    DoubleDoubleBatchKernel multiply;
+    DoubleDoubleBatchKernel divide;
+};
+
+// Scalar fallback: one DoubleDoubleInterval operation per element.
+
+template<typename Operation>
+inline void scalarDoubleDouble(const DoubleDoubleIntervalArray& x, const DoubleDoubleIntervalArray& y, DoubleDoubleIntervalArray& result, Operation operation)
+{
+    for (std::size_t i = 0u; i < x.size(); i++)
+    {
+        result.set(i, operation(x.get(i), y.get(i)));
+    }
+}
+
+inline void scalarDoubleDoubleAdd(const DoubleDoubleIntervalArray& x, const DoubleDoubleIntervalArray& y, DoubleDoubleIntervalArray& result)
+{
+    scalarDoubleDouble(x, y, result, [](const DoubleDoubleInterval& a, const DoubleDoubleInterval& b) { return a + b; });
+}
+
+inline void scalarDoubleDoubleSubtract(const DoubleDoubleIntervalArray& x, const DoubleDoubleIntervalArray& y, DoubleDoubleIntervalArray& result)
+{
+    scalarDoubleDouble(x, y, result, [](const DoubleDoubleInterval& a, const DoubleDoubleInterval& b) { return a - b; });
+}
+
+inline void scalarDoubleDoubleMultiply(const DoubleDoubleIntervalArray& x, const DoubleDoubleIntervalArray& y, DoubleDoubleIntervalArray& result)
+{
+    scalarDoubleDouble(x, y, result, [](const DoubleDoubleInterval& a, const DoubleDoubleInterval& b) { return a * b; });
+}
+
+inline void scalarDoubleDoubleDivide(const DoubleDoubleIntervalArray& x, const DoubleDoubleIntervalArray& y, DoubleDoubleIntervalArray& result)
+{
+    scalarDoubleDouble(x, y, result, [](const DoubleDoubleInterval& a, const DoubleDoubleInterval& b) { return a / b; });
+}
+
+// Baseline: the batch loops as compiled for the build target. Without
+// hardware FMA, as on plain x86-64, std::fma is a library call and the
+// loops do not vectorize.
+
+inline void baselineDoubleDoubleAdd(const DoubleDoubleIntervalArray& x, const DoubleDoubleIntervalArray& y, DoubleDoubleIntervalArray& result)
+{
+    batchDoubleDouble<DoubleDoubleInterval::addBounds>(x, y, result);
+}
+
+inline void baselineDoubleDoubleSubtract(const DoubleDoubleIntervalArray& x, const DoubleDoubleIntervalArray& y, DoubleDoubleIntervalArray& result)
+{
+    batchDoubleDouble<DoubleDoubleInterval::subtractBounds>(x, y, result);
+}
+
+inline void baselineDoubleDoubleMultiply(const DoubleDoubleIntervalArray& x, const DoubleDoubleIntervalArray& y, DoubleDoubleIntervalArray& result)
+{
+    batchDoubleDouble<DoubleDoubleInterval::multiplyBounds>(x, y, result);
+}
+
+inline void baselineDoubleDoubleDivide(const DoubleDoubleIntervalArray& x, const DoubleDoubleIntervalArray& y, DoubleDoubleIntervalArray& result)
+{
+    batchDoubleDouble<DoubleDoubleInterval::divideBounds>(x, y, result);
+}
+
+#if ZEROINFINITY_DISPATCH_X86
+
+// Wider variants. Unlike the IntervalNumber variants these enable FMA, which
+// the error-free products need; it is safe because the build disables
+// floating-point contraction, so only the explicit std::fma calls fuse.
+
+#define ZEROINFINITY_DOUBLEDOUBLE_VARIANT(isa, name, kernel) \
+    __attribute__((target(isa), flatten)) inline void name(const DoubleDoubleIntervalArray& x, const DoubleDoubleIntervalArray& y, DoubleDoubleIntervalArray& result) \
+    { \
+        batchDoubleDouble<DoubleDoubleInterval::kernel>(x, y, result); \
+    }
+
+ZEROINFINITY_DOUBLEDOUBLE_VARIANT("avx2,fma", avx2DoubleDoubleAdd, addBounds)
+ZEROINFINITY_DOUBLEDOUBLE_VARIANT("avx2,fma", avx2DoubleDoubleSubtract, subtractBounds)
+ZEROINFINITY_DOUBLEDOUBLE_VARIANT("avx2,fma", avx2DoubleDoubleMultiply, multiplyBounds)
+ZEROINFINITY_DOUBLEDOUBLE_VARIANT("avx2,fma", avx2DoubleDoubleDivide, divideBounds)
+ZEROINFINITY_DOUBLEDOUBLE_VARIANT("avx512f", avx512DoubleDoubleAdd, addBounds)
+ZEROINFINITY_DOUBLEDOUBLE_VARIANT("avx512f", avx512DoubleDoubleSubtract, subtractBounds)
+ZEROINFINITY_DOUBLEDOUBLE_VARIANT("avx512f", avx512DoubleDoubleMultiply, multiplyBounds)
+ZEROINFINITY_DOUBLEDOUBLE_VARIANT("avx512f", avx512DoubleDoubleDivide, divideBounds)
+
+#undef ZEROINFINITY_DOUBLEDOUBLE_VARIANT
+
+#endif
+
+/**
+ * Gets the double-double kernel table of an instruction set.
+ * The AVX2 variant also needs FMA; unsupported instruction sets yield the
+ * baseline table.
+ *
+ * @param isa The instruction set
+ * @return The kernel variants for isa
+ */
+inline const DoubleDoubleKernelTable& doubleDoubleKernels(IntervalIsa isa) noexcept
+{
+    static const DoubleDoubleKernelTable scalar{IntervalIsa::Scalar, scalarDoubleDoubleAdd, scalarDoubleDoubleSubtract, scalarDoubleDoubleMultiply,
+                                                scalarDoubleDoubleDivide};
+    static const DoubleDoubleKernelTable baseline{IntervalIsa::Baseline, baselineDoubleDoubleAdd, baselineDoubleDoubleSubtract, baselineDoubleDoubleMultiply,
+                                                  baselineDoubleDoubleDivide};
+#if ZEROINFINITY_DISPATCH_X86
+    static const DoubleDoubleKernelTable avx2{IntervalIsa::Avx2, avx2DoubleDoubleAdd, avx2DoubleDoubleSubtract, avx2DoubleDoubleMultiply,
+                                              avx2DoubleDoubleDivide};
+    static const DoubleDoubleKernelTable avx512{IntervalIsa::Avx512, avx512DoubleDoubleAdd, avx512DoubleDoubleSubtract, avx512DoubleDoubleMultiply,
+                                                avx512DoubleDoubleDivide};
+#endif
+
+    if (!isIntervalIsaSupported(isa))
+    {
+        return baseline;
+    }
+
+    switch (isa)
+    {
+        case IntervalIsa::Scalar:
+            return scalar;
+#if ZEROINFINITY_DISPATCH_X86
+        case IntervalIsa::Avx2:
+            return __builtin_cpu_supports("fma") ? avx2 : baseline;
+        case IntervalIsa::Avx512:
+            return avx512;
+#endif
+        default:
+            return baseline;
+    }
+}
+
+/**
+ * Gets the double-double kernel table for the instruction set selected for
+ * the IntervalArray operations (see selectIntervalIsa()).
+ *
+ * @return The active kernel variants
+ */
+inline const DoubleDoubleKernelTable& doubleDoubleKernels() noexcept
+{
+    return doubleDoubleKernels(intervalKernels().isa);
+}
+
+// Batch operations on DoubleDoubleIntervalArray, with the conventions of the
+// IntervalArray operations: the result is resized to the size of the left
+// operand and may be one of the operands.
+
+/**
+ * Element-wise addition.
+ *
+ * @param x Left operands
+ * @param y Right operands
+ * @param result Sums
+ */
+inline void add(const DoubleDoubleIntervalArray& x, const DoubleDoubleIntervalArray& y, DoubleDoubleIntervalArray& result)
+{
+    result.resize(x.size());
+    doubleDoubleKernels().add(x, y, result);
+}
+
+/**
+ * Element-wise subtraction.
+ *
+ * @param x Left operands
+ * @param y Right operands
+ * @param result Differences
+ */
+inline void subtract(const DoubleDoubleIntervalArray& x, const DoubleDoubleIntervalArray& y, DoubleDoubleIntervalArray& result)
+{
+    result.resize(x.size());
+    doubleDoubleKernels().subtract(x, y, result);
+}
+
+/**
+ * Element-wise multiplication.
+ *
+ * @param x Left operands
+ * @param y Right operands
+ * @param result Products
+ */
+inline void multiply(const DoubleDoubleIntervalArray& x, const DoubleDoubleIntervalArray& y, DoubleDoubleIntervalArray& result)
+{
+    result.resize(x.size());
+    doubleDoubleKernels().multiply(x, y, result);
+}
+
+/**
+ * Element-wise division.
+ *
+ * @param x Dividends
+ * @param y Divisors
+ * @param result Quotients
+ */
+inline void divide(const DoubleDoubleIntervalArray& x, const DoubleDoubleIntervalArray& y, DoubleDoubleIntervalArray& result)
+{
+    result.resize(x.size());
+    doubleDoubleKernels().divide(x, y, result);
+}
+
+#endif /* DOUBLEDOUBLEINTERVALARRAY_HPP_ */
@@ -0,0 +1,414 @@
+#ifndef EXPRESSIONPARSER_HPP_
+#define EXPRESSIONPARSER_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "ExpressionTape.hpp"
+#include "IntervalNumber.hpp"
+
+// Formulas given as text, compiled to an ExpressionTape.
+//
+//     expression := term { ('+' | '-') term }
+//     term       := factor { ('*' | '/') factor }
+//     factor     := ('-' | '+') factor | primary [ '^' factor ]
+//     primary    := number | 'inf' | 'nan' | input
+//                 | 'abs' '(' expression ')' | 'sqr' '(' expression ')'
+//                 | 'pow' '(' expression ',' expression ')'
+//                 | '(' expression ')'
+//     input      := 'x' | 'x0' | 'x1' | ...
+//
+// Operators of the same precedence group left to right, as in C++, and '^'
+// groups right to left and binds tighter than a sign, so -x^2 = -(x^2).
+// Every operation is the IntervalNumber operation of the same name, so the
+// tape evaluates the formula bit-identically to the operators: a^b is
+// pow(a, b), sqr(a) is pow(a, 2), and -a is -1 * a. Numbers are point
+// intervals, read like IntervalNumber::endpointFromChars(). 'x' is x0. The
+// tape has one input more than the highest input index, and at least one.
+// Parentheses, signs and powers nest at most EXPRESSION_MAX_DEPTH deep, so
+// the recursive parser cannot exhaust the stack.
+
+// Deepest nesting of factors a formula may have.
+static constexpr std::size_t EXPRESSION_MAX_DEPTH = 256u;
+
+/**
+ * Recursive-descent parser of formulas.
+ */
+class ExpressionParser {
+
+private:
+
+    /**
+     * Token kinds.
+     */
+    enum class Kind {
+        Number,
+        Input,
+        Function,
+        Symbol,
+        End
+    };
+
+    /**
+     * Token of the formula.
+     */
+    struct Token
+    {
+        Kind kind;
+        char symbol;            // Operator or parenthesis; first letter of a function.
+        std::size_t column;     // Position in the text, from 1.
+        double value;           // Value of a number.
+        std::uint32_t input;    // Index of an input.
+    };
+
+    std::vector<Token> m_tokens{};
+    std::size_t m_next{0u};
+    std::string m_error{};
+
+    // Factors being parsed, one per nesting level.
+    std::size_t m_depth{0u};
+
+    // Inputs while the tape is recorded.
+    const std::vector<TapeValue>* m_inputs{nullptr};
+
+    bool fail(const std::string& message, std::size_t column)
+    {
+        if (m_error.empty())
+        {
+            m_error = message + " at column " + std::to_string(column);
+        }
+
+        return false;
+    }
+
+    bool unexpected(const Token& token)
+    {
+        switch (token.kind)
+        {
+            case Kind::Number:
+                return fail("unexpected number", token.column);
+            case Kind::Input:
+                return fail("unexpected input", token.column);
+            case Kind::Function:
+                return fail("unexpected function", token.column);
+            case Kind::Symbol:
+                return fail(std::string("unexpected '") + token.symbol + "'", token.column);
+            case Kind::End:
+                break;
+        }
+
+        return fail("unexpected end", token.column);
+    }
+
+    /**
+     * Splits the text into tokens.
+     *
+     * @param text The formula
+     * @return false on an unknown character or name
+     */
+    bool tokenize(const std::string& text)
+    {
+        const char* first = text.data();
+        const char* last = first + text.size();
+        const char* p = first;
+
+        while (true)
+        {
+            while (p != last && (*p == ' ' || *p == '\t'))
+            {
+                p++;
+            }
+            const std::size_t column = static_cast<std::size_t>(p - first) + 1u;
+            if (p == last)
+            {
+                m_tokens.push_back(Token{Kind::End, '\0', column, 0.0, 0u});
+
+                return true;
+            }
+
+            if ((*p >= '0' && *p <= '9') || *p == '.')
+            {
+                double value{};
+                const std::from_chars_result read = IntervalNumber::endpointFromChars(p, last, value);
+                if (read.ec != std::errc{})
+                {
+                    return fail("invalid number", column);
+                }
+                m_tokens.push_back(Token{Kind::Number, '\0', column, value, 0u});
+                p = read.ptr;
+            }
+            else if ((*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z'))
+            {
+                const char* begin = p;
+                while (p != last && ((*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z') || (*p >= '0' && *p <= '9') || *p == '_'))
+                {
+                    p++;
+                }
+                const std::string name(begin, p);
+
+                if (name == "inf" || name == "nan")
+                {
+                    m_tokens.push_back(Token{Kind::Number, '\0', column, (name == "inf") ? INF : QUIET_NAN, 0u});
+                }
+                else if (name == "abs" || name == "sqr" || name == "pow")
+                {
+                    m_tokens.push_back(Token{Kind::Function, name[0u], column, 0.0, 0u});
+                }
+                else if (name == "x")
+                {
+                    m_tokens.push_back(Token{Kind::Input, '\0', column, 0.0, 0u});
+                }
+                else if (name.size() > 1u && name.size() <= 5u && name[0u] == 'x' && name.find_first_not_of("0123456789", 1u) == std::string::npos &&
+                         (name.size() == 2u || name[1u] != '0'))
+                {
+                    m_tokens.push_back(Token{Kind::Input, '\0', column, 0.0, static_cast<std::uint32_t>(std::stoul(name.substr(1u)))});
+                }
+                else
+                {
+                    return fail("unknown name '" + name + "'", column);
+                }
+            }
+            else if (std::string("+-*/^(),").find(*p) != std::string::npos)
+            {
+                m_tokens.push_back(Token{Kind::Symbol, *p, column, 0.0, 0u});
+                p++;
+            }
+            else
+            {
+                return fail(std::string("unexpected '") + *p + "'", column);
+            }
+        }
+    }
+
+    const Token& peek() const noexcept
+    {
+        return m_tokens[m_next];
+    }
+
+    bool accept(char symbol) noexcept
+    {
+        if (peek().kind == Kind::Symbol && peek().symbol == symbol)
+        {
+            m_next++;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    bool expect(char symbol)
+    {
+        return accept(symbol) || fail(std::string("expected '") + symbol + "'", peek().column);
+    }
+
+    TapeValue constant(double value) const
+    {
+        return (*m_inputs)[0u].m_tape->constant(value);
+    }
+
+    bool expression(TapeValue& result)
+    {
+        if (!term(result))
+        {
+            return false;
+        }
+        while (peek().kind == Kind::Symbol && (peek().symbol == '+' || peek().symbol == '-'))
+        {
+            const bool add = (m_tokens[m_next++].symbol == '+');
+            TapeValue right = result;
+            if (!term(right))
+            {
+                return false;
+            }
+            result = add ? result + right : result - right;
+        }
+
+        return true;
+    }
+
+    bool term(TapeValue& result)
+    {
+        if (!factor(result))
+        {
+            return false;
+        }
+        while (peek().kind == Kind::Symbol && (peek().symbol == '*' || peek().symbol == '/'))
+        {
+            const bool multiply = (m_tokens[m_next++].symbol == '*');
+            TapeValue right = result;
+            if (!factor(right))
+            {
+                return false;
+            }
+            result = multiply ? result * right : result / right;
+        }
+
+        return true;
+    }
+
+    bool factor(TapeValue& result)
+    {
+        if (m_depth == EXPRESSION_MAX_DEPTH)
+        {
+            return fail("formula nested too deeply", peek().column);
+        }
+        m_depth++;
+        const bool good = signedFactor(result);
+        m_depth--;
+
+        return good;
+    }
+
+    bool signedFactor(TapeValue& result)
+    {
+        if (accept('-'))
+        {
+            if (!factor(result))
+            {
+                return false;
+            }
+            result = constant(-1.0) * result;
+
+            return true;
+        }
+        if (accept('+'))
+        {
+            return factor(result);
+        }
+        if (!primary(result))
+        {
+            return false;
+        }
+        if (accept('^'))
+        {
+            TapeValue exponent = result;
+            if (!factor(exponent))
+            {
+                return false;
+            }
+            result = result.pow(exponent);
+        }
+
+        return true;
+    }
+
+    bool primary(TapeValue& result)
+    {
+        const Token token = peek();
+
+        switch (token.kind)
+        {
+            case Kind::Number:
+                m_next++;
+                result = constant(token.value);
+                return true;
+            case Kind::Input:
+                m_next++;
+                result = (*m_inputs)[token.input];
+                return true;
+            case Kind::Function:
+            {
+                m_next++;
+                if (!expect('(') || !expression(result))
+                {
+                    return false;
+                }
+                if (token.symbol == 'p')
+                {
+                    TapeValue exponent = result;
+                    if (!expect(',') || !expression(exponent))
+                    {
+                        return false;
+                    }
+                    result = result.pow(exponent);
+                }
+                else if (token.symbol == 's')
+                {
+                    result = result.pow(constant(2.0));
+                }
+                else
+                {
+                    result = result.abs();
+                }
+                return expect(')');
+            }
+            case Kind::Symbol:
+                if (accept('('))
+                {
+                    return expression(result) && expect(')');
+                }
+                break;
+            case Kind::End:
+                break;
+        }
+
+        return unexpected(token);
+    }
+
+public:
+
+    /**
+     * Parses a formula and records it.
+     *
+     * @param text The formula
+     * @param tape The compiled tape; unchanged on failure
+     * @param error Description of the first error, with its column
+     * @return false if the text is not a formula
+     */
+    static bool parse(const std::string& text, ExpressionTape& tape, std::string& error)
+    {
+        ExpressionParser parser{};
+        if (!parser.tokenize(text))
+        {
+            error = parser.m_error;
+
+            return false;
+        }
+
+        std::size_t inputs = 1u;
+        for (const auto& token : parser.m_tokens)
+        {
+            inputs = (token.kind == Kind::Input) ? std::max<std::size_t>(inputs, token.input + 1u) : inputs;
+        }
+
+        bool good = false;
+        ExpressionTape recorded = ExpressionTape::record(inputs, [&parser, &good](const std::vector<TapeValue>& x) {
+            parser.m_inputs = &x;
+            TapeValue result = x[0u];
+            good = parser.expression(result) && ((parser.peek().kind == Kind::End) || parser.unexpected(parser.peek()));
+
+            return result;
+        });
+        if (!good)
+        {
+            error = parser.m_error;
+
+            return false;
+        }
+        tape = std::move(recorded);
+
+        return true;
+    }
+
+};
+
+/**
+ * Parses a formula and records it; see ExpressionParser.
+ *
+ * @param text The formula
+ * @param tape The compiled tape; unchanged on failure
+ * @param error Description of the first error, with its column
+ * @return false if the text is not a formula
+ */
+inline bool parseExpression(const std::string& text, ExpressionTape& tape, std::string& error)
+{
+    return ExpressionParser::parse(text, tape, error);
+}
+
+#endif /* EXPRESSIONPARSER_HPP_ */
@@ -0,0 +1,644 @@
+#ifndef EXPRESSIONTAPE_HPP_
+#define EXPRESSIONTAPE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "IntervalArray.hpp"
+#include "IntervalDispatch.hpp"
+#include "IntervalKernels.hpp"
+#include "IntervalNumber.hpp"
+
+// Expression tapes: a formula recorded once and evaluated over batches.
+//
+// ExpressionTape::record() calls the formula once with TapeValue operands.
+// Their operators do not compute anything; they append nodes to the tape.
+// The formula is typically a generic lambda over a vector of operands, so
+// the same code also runs on IntervalNumber:
+//
+//     auto formula = [](const auto& x) { return x[0] * x[1] / pow(x[0], 2.0); };
+//     const auto tape = ExpressionTape::record(2u, formula);
+//     tape.evaluate({a, b}, result);       // IntervalArray a, b, result
+//
+// Recording compiles the nodes into a list of three-address instructions
+// on registers. A register is freed after the last instruction that reads
+// it, so a formula needs only as many registers as values are live at once.
+// evaluate() then runs the batch in chunks of CHUNK_SIZE lanes; each
+// instruction runs over all lanes of a chunk through the batch kernels
+// before the next one starts, so no IntervalNumber temporaries are created
+// and the registers of a chunk stay in the L1 cache. Multiplication,
+// division and power use the kernel variant selected for the CPU (see
+// IntervalDispatch.hpp); every result is bit-identical to the operators.
+
+class ExpressionParser;
+
+class ExpressionTape;
+
+/**
+ * Operand of a formula while it is recorded; a node of an ExpressionTape.
+ */
+class TapeValue {
+
+    friend class ExpressionParser;
+
+    friend class ExpressionTape;
+
+    friend TapeValue operator+(double x, const TapeValue& other);
+
+    friend TapeValue operator-(double x, const TapeValue& other);
+
+    friend TapeValue operator*(double x, const TapeValue& other);
+
+    friend TapeValue operator/(double x, const TapeValue& other);
+
+private:
+
+    // Tape under construction.
+    ExpressionTape* m_tape{nullptr};
+
+    // Index of the node.
+    std::uint32_t m_node{0u};
+
+    TapeValue(ExpressionTape* tape, std::uint32_t node) noexcept :
+        m_tape{tape}, m_node{node}
+    {
+    }
+
+public:
+
+    TapeValue operator+(const TapeValue& other) const;
+
+    TapeValue operator-(const TapeValue& other) const;
+
+    TapeValue operator*(const TapeValue& other) const;
+
+    TapeValue operator/(const TapeValue& other) const;
+
+    TapeValue operator+(double x) const;
+
+    TapeValue operator-(double x) const;
+
+    TapeValue operator*(double x) const;
+
+    TapeValue operator/(double x) const;
+
+    TapeValue abs() const;
+
+    TapeValue pow(const TapeValue& exponent) const;
+
+    TapeValue pow(double exponent) const;
+
+};
+
+/**
+ * A recorded formula, compiled to instructions on registers.
+ */
+class ExpressionTape {
+
+    friend class ExpressionParser;
+
+    friend class TapeValue;
+
+    friend TapeValue operator+(double x, const TapeValue& other);
+
+    friend TapeValue operator-(double x, const TapeValue& other);
+
+    friend TapeValue operator*(double x, const TapeValue& other);
+
+    friend TapeValue operator/(double x, const TapeValue& other);
+
+public:
+
+    /**
+     * Operations of the tape.
+     */
+    enum class OpCode : std::uint8_t {
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Pow,
+        Abs
+    };
+
+    /**
+     * Instruction: result = left op right. Operands are slots: the inputs
+     * come first, then the constants, then the registers. The result slot
+     * is a register, or NONE for the output of the formula.
+     */
+    struct Instruction
+    {
+        OpCode op;
+        std::uint32_t result;
+        std::uint32_t left;
+        std::uint32_t right;    // Unused by Abs.
+    };
+
+    /**
+     * Lanes per chunk of evaluate().
+     */
+    static constexpr std::size_t CHUNK_SIZE = 256u;
+
+    /**
+     * Result slot of the last instruction, which writes the output.
+     */
+    static constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+
+private:
+
+    /**
+     * Node recorded by a TapeValue operation.
+     */
+    struct Node
+    {
+        bool constant;          // Constant node; the others are inputs or operations.
+        OpCode op;
+        std::uint32_t left;
+        std::uint32_t right;
+        double value;           // Value of a constant node.
+    };
+
+    // Recorded nodes; the first m_inputs are the inputs.
+    std::vector<Node> m_nodes{};
+
+    // Compiled program.
+    std::vector<Instruction> m_instructions{};
+    std::vector<double> m_constants{};
+    std::size_t m_inputs{0u};
+    std::size_t m_registers{0u};
+
+    // Slot of the output if the formula is a bare input or constant, and
+    // m_instructions is empty.
+    std::uint32_t m_outputSlot{0u};
+
+    TapeValue append(OpCode op, std::uint32_t left, std::uint32_t right)
+    {
+        m_nodes.push_back(Node{false, op, left, right, 0.0});
+
+        return TapeValue(this, static_cast<std::uint32_t>(m_nodes.size() - 1u));
+    }
+
+    TapeValue constant(double value)
+    {
+        m_nodes.push_back(Node{true, OpCode::Add, 0u, 0u, value});
+
+        return TapeValue(this, static_cast<std::uint32_t>(m_nodes.size() - 1u));
+    }
+
+    /**
+     * Compiles the nodes that the output depends on into instructions.
+     *
+     * @param output Node of the result
+     */
+    void compile(std::uint32_t output)
+    {
+        const std::size_t count = m_nodes.size();
+
+        // Nodes the output depends on, and the last instruction reading each.
+        std::vector<bool> used(count, false);
+        used[output] = true;
+        for (std::size_t i = count; i-- > m_inputs;)
+        {
+            if (used[i] && !m_nodes[i].constant)
+            {
+                used[m_nodes[i].left] = true;
+                used[m_nodes[i].right] = true;
+            }
+        }
+        std::vector<std::size_t> lastUse(count, 0u);
+        for (std::size_t i = m_inputs; i < count; i++)
+        {
+            if (used[i] && !m_nodes[i].constant)
+            {
+                lastUse[m_nodes[i].left] = i;
+                lastUse[m_nodes[i].right] = i;
+            }
+        }
+
+        // Slots of the inputs and constants.
+        std::vector<std::uint32_t> slot(count, NONE);
+        for (std::size_t i = 0u; i < m_inputs; i++)
+        {
+            slot[i] = static_cast<std::uint32_t>(i);
+        }
+        for (std::size_t i = m_inputs; i < count; i++)
+        {
+            if (used[i] && m_nodes[i].constant)
+            {
+                m_constants.push_back(m_nodes[i].value);
+            }
+        }
+        const std::uint32_t firstRegister = static_cast<std::uint32_t>(m_inputs + m_constants.size());
+        std::uint32_t nextConstant = static_cast<std::uint32_t>(m_inputs);
+        for (std::size_t i = m_inputs; i < count; i++)
+        {
+            if (used[i] && m_nodes[i].constant)
+            {
+                slot[i] = nextConstant++;
+            }
+        }
+
+        // Linear scan: operands in their last use free their register
+        // before the result takes one, so results can overwrite operands.
+        std::vector<std::uint32_t> freeRegisters{};
+        for (std::size_t i = m_inputs; i < count; i++)
+        {
+            const Node& node = m_nodes[i];
+            if (!used[i] || node.constant)
+            {
+                continue;
+            }
+
+            for (std::uint32_t operand : {node.left, node.right})
+            {
+                if (lastUse[operand] == i && slot[operand] >= firstRegister &&
+                    std::find(freeRegisters.begin(), freeRegisters.end(), slot[operand]) == freeRegisters.end())
+                {
+                    freeRegisters.push_back(slot[operand]);
+                }
+            }
+
+            std::uint32_t result = NONE;
+            if (i != output)
+            {
+                if (freeRegisters.empty())
+                {
+                    result = firstRegister + static_cast<std::uint32_t>(m_registers++);
+                }
+                else
+                {
+                    // The lowest free register, so the allocation is deterministic.
+                    auto lowest = std::min_element(freeRegisters.begin(), freeRegisters.end());
+                    result = *lowest;
+                    freeRegisters.erase(lowest);
+                }
+            }
+            slot[i] = result;
+            m_instructions.push_back(Instruction{node.op, result, slot[node.left], slot[node.right]});
+        }
+
+        m_outputSlot = slot[output];
+        m_nodes.clear();
+        m_nodes.shrink_to_fit();
+    }
+
+public:
+
+    /**
+     * Records a formula.
+     *
+     * @param inputs Number of inputs
+     * @param formula Callable TapeValue(const std::vector<TapeValue>&) that
+     *                combines the inputs with the operators of TapeValue;
+     *                the result must be a node of this recording
+     * @return The compiled tape
+     */
+    template<typename Formula>
+    static ExpressionTape record(std::size_t inputs, const Formula& formula)
+    {
+        ExpressionTape tape{};
+        tape.m_inputs = inputs;
+
+        std::vector<TapeValue> x{};
+        for (std::size_t i = 0u; i < inputs; i++)
+        {
+            tape.m_nodes.push_back(Node{false, OpCode::Add, 0u, 0u, 0.0});
+            x.push_back(TapeValue(&tape, static_cast<std::uint32_t>(i)));
+        }
+
+        const TapeValue output = formula(x);
+        tape.compile(output.m_node);
+
+        return tape;
+    }
+
+    /**
+     * Gets the compiled instructions.
+     *
+     * @return Instructions in execution order
+     */
+    const std::vector<Instruction>& instructions() const noexcept
+    {
+        return m_instructions;
+    }
+
+    /**
+     * Gets the number of registers the instructions use.
+     *
+     * @return Number of registers
+     */
+    std::size_t registers() const noexcept
+    {
+        return m_registers;
+    }
+
+    /**
+     * Gets the number of inputs.
+     *
+     * @return Number of inputs
+     */
+    std::size_t inputs() const noexcept
+    {
+        return m_inputs;
+    }
+
+    /**
+     * Evaluates the formula element-wise: result[i] = f(inputs[0][i], ...).
+     *
+     * @param inputs One array per input, all of the same size
+     * @param result The results; may not be one of the inputs
+     */
+    void evaluate(const std::vector<IntervalArray>& inputs, IntervalArray& result) const
+    {
+        const std::size_t count = inputs.empty() ? 0u : inputs[0u].size();
+        result.resize(count);
+
+        // Per slot: lower bounds, upper bounds at lower + CHUNK_SIZE.
+        // Constants are filled once, registers are overwritten per chunk.
+        const std::size_t slots = m_inputs + m_constants.size() + m_registers;
+        std::vector<double, AlignedAllocator<double>> scratch((slots - m_inputs) * 2u * CHUNK_SIZE);
+        auto scratchSlot = [&scratch, this](std::uint32_t slot) {
+            return scratch.data() + (slot - m_inputs) * 2u * CHUNK_SIZE;
+        };
+        std::vector<const double*> lower(slots);
+        std::vector<const double*> upper(slots);
+        for (std::size_t i = m_inputs; i < slots; i++)
+        {
+            lower[i] = scratchSlot(static_cast<std::uint32_t>(i));
+            upper[i] = lower[i] + CHUNK_SIZE;
+        }
+        for (std::size_t c = 0u; c < m_constants.size(); c++)
+        {
+            double* constant = scratchSlot(static_cast<std::uint32_t>(m_inputs + c));
+            std::fill(constant, constant + 2u * CHUNK_SIZE, m_constants[c]);
+        }
+
+        const IntervalKernelTable& kernels = intervalKernels();
+
+        for (std::size_t begin = 0u; begin < count; begin += CHUNK_SIZE)
+        {
+            const std::size_t lanes = std::min(CHUNK_SIZE, count - begin);
+            for (std::size_t i = 0u; i < m_inputs; i++)
+            {
+                lower[i] = inputs[i].lower() + begin;
+                upper[i] = inputs[i].upper() + begin;
+            }
+
+            if (m_instructions.empty())
+            {
+                std::copy(lower[m_outputSlot], lower[m_outputSlot] + lanes, result.lower() + begin);
+                std::copy(upper[m_outputSlot], upper[m_outputSlot] + lanes, result.upper() + begin);
+                continue;
+            }
+
+            for (const auto& instruction : m_instructions)
+            {
+                double* r0 = (instruction.result == NONE) ? result.lower() + begin : scratchSlot(instruction.result);
+                double* r1 = (instruction.result == NONE) ? result.upper() + begin : scratchSlot(instruction.result) + CHUNK_SIZE;
+                const double* x0 = lower[instruction.left];
+                const double* x1 = upper[instruction.left];
+                const double* y0 = lower[instruction.right];
+                const double* y1 = upper[instruction.right];
+
+                switch (instruction.op)
+                {
+                    case OpCode::Add:
+                        batchAdd(x0, x1, y0, y1, r0, r1, lanes);
+                        break;
+                    case OpCode::Subtract:
+                        batchSubtract(x0, x1, y0, y1, r0, r1, lanes);
+                        break;
+                    case OpCode::Multiply:
+                        kernels.multiply(x0, x1, y0, y1, r0, r1, lanes);
+                        break;
+                    case OpCode::Divide:
+                        kernels.divide(x0, x1, y0, y1, r0, r1, lanes);
+                        break;
+                    case OpCode::Pow:
+                        kernels.pow(x0, x1, y0, y1, r0, r1, lanes);
+                        break;
+                    case OpCode::Abs:
+                        batchAbs(x0, x1, r0, r1, lanes);
+                        break;
+                }
+            }
+        }
+    }
+
+    /**
+     * Evaluates the formula for a single set of inputs.
+     *
+     * @param x One interval per input
+     * @return The result
+     */
+    IntervalNumber evaluate(const std::vector<IntervalNumber>& x) const
+    {
+        std::vector<IntervalArray> inputs{};
+        for (const auto& interval : x)
+        {
+            inputs.push_back(IntervalArray{interval});
+        }
+        IntervalArray result{};
+        evaluate(inputs, result);
+
+        return result.get(0u);
+    }
+
+    /**
+     * Lists the instructions, one per line, e.g. "r0 = x0 * c0".
+     *
+     * @return The listing
+     */
+    std::string toString() const
+    {
+        auto name = [this](std::uint32_t slot) {
+            if (slot == NONE)
+            {
+                return std::string("out");
+            }
+            if (slot < m_inputs)
+            {
+                return "x" + std::to_string(slot);
+            }
+            if (slot < m_inputs + m_constants.size())
+            {
+                return "c" + std::to_string(slot - m_inputs);
+            }
+            return "r" + std::to_string(slot - m_inputs - m_constants.size());
+        };
+
+        std::string listing{};
+        for (const auto& instruction : m_instructions)
+        {
+            listing += name(instruction.result) + " = ";
+            switch (instruction.op)
+            {
+                case OpCode::Add:
+                    listing += name(instruction.left) + " + " + name(instruction.right);
+                    break;
+                case OpCode::Subtract:
+                    listing += name(instruction.left) + " - " + name(instruction.right);
+                    break;
+                case OpCode::Multiply:
+                    listing += name(instruction.left) + " * " + name(instruction.right);
+                    break;
+                case OpCode::Divide:
+                    listing += name(instruction.left) + " / " + name(instruction.right);
+                    break;
+                case OpCode::Pow:
+                    listing += "pow(" + name(instruction.left) + ", " + name(instruction.right) + ")";
+                    break;
+                case OpCode::Abs:
+                    listing += "abs(" + name(instruction.left) + ")";
+                    break;
+            }
+            listing += "\n";
+        }
+
+        return listing;
+    }
+
+};
+
+inline TapeValue TapeValue::operator+(const TapeValue& other) const
+{
+    return m_tape->append(ExpressionTape::OpCode::Add, m_node, other.m_node);
+}
+
+inline TapeValue TapeValue::operator-(const TapeValue& other) const
+{
+    return m_tape->append(ExpressionTape::OpCode::Subtract, m_node, other.m_node);
+}
+
+inline TapeValue TapeValue::operator*(const TapeValue& other) const
+{
+    return m_tape->append(ExpressionTape::OpCode::Multiply, m_node, other.m_node);
+}
+
+inline TapeValue TapeValue::operator/(const TapeValue& other) const
+{
+    return m_tape->append(ExpressionTape::OpCode::Divide, m_node, other.m_node);
+}
+
+inline TapeValue TapeValue::operator+(double x) const
+{
+    return *this + m_tape->constant(x);
+}
+
+inline TapeValue TapeValue::operator-(double x) const
+{
+    return *this - m_tape->constant(x);
+}
+
+inline TapeValue TapeValue::operator*(double x) const
+{
+    return *this * m_tape->constant(x);
+}
+
+inline TapeValue TapeValue::operator/(double x) const
+{
+    return *this / m_tape->constant(x);
+}
+
+inline TapeValue TapeValue::abs() const
+{
+    return m_tape->append(ExpressionTape::OpCode::Abs, m_node, m_node);
+}
+
+inline TapeValue TapeValue::pow(const TapeValue& exponent) const
+{
+    return m_tape->append(ExpressionTape::OpCode::Pow, m_node, exponent.m_node);
+}
+
+inline TapeValue TapeValue::pow(double exponent) const
+{
+    return pow(m_tape->constant(exponent));
+}
+
+/**
+ * Global addition operator (scalar + value).
+ *
+ * @param x Scalar value
+ * @param other Recorded value
+ * @return Recorded sum
+ */
+inline TapeValue operator+(double x, const TapeValue& other)
+{
+    return other.m_tape->constant(x) + other;
+}
+
+/**
+ * Global subtraction operator (scalar - value).
+ *
+ * @param x Scalar value
+ * @param other Recorded value
+ * @return Recorded difference
+ */
+inline TapeValue operator-(double x, const TapeValue& other)
+{
+    return other.m_tape->constant(x) - other;
+}
+
+/**
+ * Global multiplication operator (scalar * value).
+ *
+ * @param x Scalar value
+ * @param other Recorded value
+ * @return Recorded product
+ */
+inline TapeValue operator*(double x, const TapeValue& other)
+{
+    return other.m_tape->constant(x) * other;
+}
+
+/**
+ * Global division operator (scalar / value).
+ *
+ * @param x Scalar value
+ * @param other Recorded value
+ * @return Recorded quotient
+ */
+inline TapeValue operator/(double x, const TapeValue& other)
+{
+    return other.m_tape->constant(x) / other;
+}
+
+/**
+ * Global absolute value function.
+ *
+ * @param other Recorded value
+ * @return Recorded absolute value
+ */
+inline TapeValue abs(const TapeValue& other)
+{
+    return other.abs();
+}
+
+/**
+ * Global power function (value ^ value).
+ *
+ * @param base Recorded base
+ * @param exponent Recorded exponent
+ * @return Recorded power
+ */
+inline TapeValue pow(const TapeValue& base, const TapeValue& exponent)
+{
+    return base.pow(exponent);
+}
+
+/**
+ * Global power function (value ^ scalar).
+ *
+ * @param base Recorded base
+ * @param exponent Scalar exponent
+ * @return Recorded power
+ */
+inline TapeValue pow(const TapeValue& base, double exponent)
+{
+    return base.pow(exponent);
+}
+
+#endif /* EXPRESSIONTAPE_HPP_ */
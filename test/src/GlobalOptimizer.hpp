@@ -0,0 +1,243 @@
+#ifndef GLOBALOPTIMIZER_HPP_
+#define GLOBALOPTIMIZER_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "IntervalNumber.hpp"
+#include "WorkStealingPool.hpp"
+
+// Branch-and-bound global minimization.
+//
+// minimizeGlobal() encloses min f(x) over a box x[0] × x[1] × ... of
+// intervals. The objective is written with IntervalNumber operators, so
+// f(box) encloses f over the whole box, and f at a point gives an upper
+// bound of the minimum. Boxes whose lower bound exceeds the best upper bound
+// are pruned; the others are bisected along their widest coordinate.
+//
+// Lower bounds follow the indeterminate form rules. Ω = [0, ∞] from 0·∞ is a
+// valid lower bound of 0; -Ω = [-∞, 0] and [-∞, ∞] never prune; a NaN result
+// counts as [-∞, ∞] for the lower bound and gives no upper bound.
+//
+// The search runs in rounds. Every round takes the batchSize boxes with the
+// lowest lower bounds (ties by creation order), bisects them on the
+// work-stealing pool, and then, on the calling thread and in a fixed order,
+// updates the best upper bound and prunes. Pruning only ever sees the bound
+// of the previous round, so the result, the minimizer and all counts are
+// identical for every thread count and every schedule.
+
+/**
+ * Parameters of minimizeGlobal().
+ */
+struct OptimizerOptions
+{
+    double tolerance{1e-6};         // Boxes no wider than this in every coordinate are not bisected.
+    std::size_t batchSize{256u};    // Boxes bisected per round. Part of the search order, unlike threads.
+    std::size_t maxBoxes{1000000u}; // Limit of bisected boxes.
+    std::size_t threads{0u};        // Threads of the pool; 0 selects std::thread::hardware_concurrency().
+};
+
+/**
+ * Result of minimizeGlobal().
+ */
+struct OptimizerResult
+{
+    IntervalNumber minimum{};           // [lower bound, best upper bound] of the global minimum.
+    std::vector<double> minimizer{};    // Point at which the best upper bound was found.
+    std::size_t bisectedBoxes{0u};
+    std::size_t prunedBoxes{0u};
+    std::size_t rounds{0u};
+    bool complete{false};               // false if maxBoxes stopped the search.
+};
+
+// Helpers of minimizeGlobal().
+
+/**
+ * Box of the search, with the lower bound of the objective over it.
+ */
+struct OptimizerBox
+{
+    std::vector<IntervalNumber> box{};
+    double lower{0.0};
+    std::uint64_t id{0u};
+};
+
+// Lower bound of an objective value; NaN gives no information.
+inline double optimizerLowerBound(const IntervalNumber& f) noexcept
+{
+    return (f.getX0() != f.getX0()) ? -INF : f.getX0();
+}
+
+// Upper bound of an objective value at a point; NaN gives no information.
+inline double optimizerUpperBound(const IntervalNumber& f) noexcept
+{
+    return (f.getX1() != f.getX1()) ? INF : f.getX1();
+}
+
+// Heap order: the box with the lowest lower bound, then the oldest, on top.
+inline bool isLaterBox(const OptimizerBox& a, const OptimizerBox& b) noexcept
+{
+    return (a.lower > b.lower) || (a.lower == b.lower && a.id > b.id);
+}
+
+inline std::vector<double> boxMidpoint(const std::vector<IntervalNumber>& box)
+{
+    std::vector<double> midpoint(box.size());
+    for (std::size_t i = 0u; i < box.size(); i++)
+    {
+        midpoint[i] = box[i].getX0() + 0.5 * (box[i].getX1() - box[i].getX0());
+    }
+
+    return midpoint;
+}
+
+/**
+ * Encloses the global minimum of objective over box by branch and bound.
+ *
+ * @param objective Callable IntervalNumber(const std::vector<IntervalNumber>&)
+ *                  that encloses the objective over a box. It is called
+ *                  concurrently and must be thread-safe.
+ * @param box The search box; all bounds finite
+ * @param options Search parameters
+ * @return Enclosure of the minimum, minimizer and search statistics
+ */
+template<typename Objective>
+OptimizerResult minimizeGlobal(const Objective& objective, const std::vector<IntervalNumber>& box, const OptimizerOptions& options = OptimizerOptions{})
+{
+    // Evaluates the objective at a point; the upper bound of the minimum.
+    auto evaluatePoint = [&objective](const std::vector<double>& point) {
+        const std::vector<IntervalNumber> degenerate(point.begin(), point.end());
+        return optimizerUpperBound(objective(degenerate));
+    };
+
+    OptimizerResult result{};
+    result.minimizer = boxMidpoint(box);
+    double best = evaluatePoint(result.minimizer);
+
+    std::vector<OptimizerBox> heap{};
+    heap.push_back(OptimizerBox{box, optimizerLowerBound(objective(box)), 0u});
+    std::uint64_t nextId = 1u;
+
+    // Lowest lower bound of the boxes that were too small to bisect.
+    double finishedLower = INF;
+
+    /**
+     * One bisected box: both halves with their bounds.
+     */
+    struct Bisection
+    {
+        OptimizerBox halves[2u];
+        double upper[2u];
+        std::vector<double> midpoint[2u];
+    };
+
+    WorkStealingPool pool(options.threads);
+    const std::size_t batchSize = std::max<std::size_t>(options.batchSize, 1u);
+    std::vector<OptimizerBox> batch{};
+    std::vector<Bisection> bisections{};
+
+    while (!heap.empty() && result.bisectedBoxes < options.maxBoxes)
+    {
+        batch.clear();
+        const std::size_t limit = std::min(batchSize, options.maxBoxes - result.bisectedBoxes);
+        while (!heap.empty() && batch.size() < limit)
+        {
+            std::pop_heap(heap.begin(), heap.end(), isLaterBox);
+            OptimizerBox candidate = std::move(heap.back());
+            heap.pop_back();
+
+            if (candidate.lower > best)
+            {
+                result.prunedBoxes++;
+                continue;
+            }
+
+            bool small = true;
+            for (const auto& x : candidate.box)
+            {
+                small = small && (x.getX1() - x.getX0() <= options.tolerance);
+            }
+            if (small)
+            {
+                finishedLower = std::min(finishedLower, candidate.lower);
+                continue;
+            }
+
+            batch.push_back(std::move(candidate));
+        }
+        if (batch.empty())
+        {
+            continue;
+        }
+
+        bisections.resize(batch.size());
+        pool.run(batch.size(), [&](std::size_t task) {
+            const auto& parent = batch[task].box;
+            std::size_t widest = 0u;
+            for (std::size_t i = 1u; i < parent.size(); i++)
+            {
+                if (parent[i].getX1() - parent[i].getX0() > parent[widest].getX1() - parent[widest].getX0())
+                {
+                    widest = i;
+                }
+            }
+            const double split = parent[widest].getX0() + 0.5 * (parent[widest].getX1() - parent[widest].getX0());
+
+            Bisection& bisection = bisections[task];
+            for (std::size_t half = 0u; half < 2u; half++)
+            {
+                auto& child = bisection.halves[half].box;
+                child = parent;
+                child[widest] = (half == 0u) ? IntervalNumber(parent[widest].getX0(), split) : IntervalNumber(split, parent[widest].getX1());
+                bisection.halves[half].lower = optimizerLowerBound(objective(child));
+                bisection.midpoint[half] = boxMidpoint(child);
+                bisection.upper[half] = evaluatePoint(bisection.midpoint[half]);
+            }
+        });
+
+        result.rounds++;
+        result.bisectedBoxes += batch.size();
+
+        for (auto& bisection : bisections)
+        {
+            for (std::size_t half = 0u; half < 2u; half++)
+            {
+                if (bisection.upper[half] < best)
+                {
+                    best = bisection.upper[half];
+                    result.minimizer = bisection.midpoint[half];
+                }
+            }
+        }
+        for (auto& bisection : bisections)
+        {
+            for (auto& half : bisection.halves)
+            {
+                if (half.lower > best)
+                {
+                    result.prunedBoxes++;
+                    continue;
+                }
+                half.id = nextId++;
+                heap.push_back(std::move(half));
+                std::push_heap(heap.begin(), heap.end(), isLaterBox);
+            }
+        }
+    }
+
+    result.complete = heap.empty();
+
+    double lower = std::min(finishedLower, best);
+    for (const auto& open : heap)
+    {
+        lower = std::min(lower, open.lower);
+    }
+    result.minimum = IntervalNumber(lower, best);
+
+    return result;
+}
+
+#endif /* GLOBALOPTIMIZER_HPP_ */
@@ -0,0 +1,350 @@
+#ifndef INTERVALARRAY_HPP_
+#define INTERVALARRAY_HPP_
+
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <vector>
+
+#include "IntervalDispatch.hpp"
+#include "IntervalKernels.hpp"
+#include "IntervalNumber.hpp"
+
+/**
+ * Minimal allocator returning storage aligned to Alignment bytes.
+ * Used so that the endpoint arrays of IntervalArray start on a cache line
+ * and can be loaded with aligned vector instructions.
+ */
+template<typename T, std::size_t Alignment = 64u>
+class AlignedAllocator {
+
+public:
+
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept
+    {
+    }
+
+    T* allocate(std::size_t count)
+    {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* pointer, std::size_t) noexcept
+    {
+        ::operator delete(pointer, std::align_val_t(Alignment));
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept
+    {
+        return true;
+    }
+
+    template<typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept
+    {
+        return false;
+    }
+
+};
+
+/**
+ * Structure-of-arrays container of interval numbers.
+ *
+ * Lower and upper bounds are kept in two separate, contiguous and 64-byte
+ * aligned arrays, so the batch kernels stream through memory and the
+ * compiler can vectorize them. Element i is the interval
+ * [lower()[i], upper()[i]]in.
+ */
+class IntervalArray {
+
+private:
+
+    using Storage = std::vector<double, AlignedAllocator<double>>;
+
+    // Lower bounds x0 of all intervals.
+    Storage m_lower{};
+
+    // Upper bounds x1 of all intervals.
+    Storage m_upper{};
+
+public:
+
+    /**
+     * Default constructor.
+     * Creates an empty array.
+     */
+    IntervalArray() = default;
+
+    /**
+     * Size constructor.
+     * Creates count intervals initialized to [0, 0]in.
+     *
+     * @param count Number of intervals
+     */
+    explicit IntervalArray(std::size_t count) :
+        m_lower(count, 0.0), m_upper(count, 0.0)
+    {
+    }
+
+    /**
+     * List constructor.
+     *
+     * @param intervals Intervals to store
+     */
+    IntervalArray(std::initializer_list<IntervalNumber> intervals)
+    {
+        reserve(intervals.size());
+        for (const auto& interval : intervals)
+        {
+            pushBack(interval);
+        }
+    }
+
+    /**
+     * Gets the number of intervals.
+     *
+     * @return Number of intervals
+     */
+    std::size_t size() const noexcept
+    {
+        return m_lower.size();
+    }
+
+    /**
+     * Resizes the array. New intervals are [0, 0]in.
+     *
+     * @param count New number of intervals
+     */
+    void resize(std::size_t count)
+    {
+        m_lower.resize(count, 0.0);
+        m_upper.resize(count, 0.0);
+    }
+
+    /**
+     * Reserves storage for count intervals.
+     *
+     * @param count Number of intervals
+     */
+    void reserve(std::size_t count)
+    {
+        m_lower.reserve(count);
+        m_upper.reserve(count);
+    }
+
+    /**
+     * Appends an interval.
+     *
+     * @param interval The interval to append
+     */
+    void pushBack(const IntervalNumber& interval)
+    {
+        m_lower.push_back(interval.getX0());
+        m_upper.push_back(interval.getX1());
+    }
+
+    /**
+     * Gets an interval.
+     *
+     * @param index Position of the interval
+     * @return The interval at index
+     */
+    IntervalNumber get(std::size_t index) const noexcept
+    {
+        return IntervalNumber(m_lower[index], m_upper[index]);
+    }
+
+    /**
+     * Sets an interval.
+     *
+     * @param index Position of the interval
+     * @param interval The new value
+     */
+    void set(std::size_t index, const IntervalNumber& interval) noexcept
+    {
+        m_lower[index] = interval.getX0();
+        m_upper[index] = interval.getX1();
+    }
+
+    /**
+     * Gets the lower bounds.
+     *
+     * @return Pointer to size() lower bounds
+     */
+    double* lower() noexcept
+    {
+        return m_lower.data();
+    }
+
+    /**
+     * Gets the lower bounds.
+     *
+     * @return Pointer to size() lower bounds
+     */
+    const double* lower() const noexcept
+    {
+        return m_lower.data();
+    }
+
+    /**
+     * Gets the upper bounds.
+     *
+     * @return Pointer to size() upper bounds
+     */
+    double* upper() noexcept
+    {
+        return m_upper.data();
+    }
+
+    /**
+     * Gets the upper bounds.
+     *
+     * @return Pointer to size() upper bounds
+     */
+    const double* upper() const noexcept
+    {
+        return m_upper.data();
+    }
+
+};
+
+// Batch operations on IntervalArray. The result is resized to the size of
+// the left operand; the right operand must hold at least as many intervals.
+// The result may be one of the operands. Multiplication, division, power,
+// square, fused multiply-add and the dot product run through the kernel
+// variant selected for the executing CPU (see IntervalDispatch.hpp).
+
+/**
+ * Element-wise multiplication.
+ *
+ * @param x Left operands
+ * @param y Right operands
+ * @param result Products
+ */
+inline void multiply(const IntervalArray& x, const IntervalArray& y, IntervalArray& result)
+{
+    result.resize(x.size());
+    intervalKernels().multiply(x.lower(), x.upper(), y.lower(), y.upper(), result.lower(), result.upper(), x.size());
+}
+
+/**
+ * Element-wise addition.
+ *
+ * @param x Left operands
+ * @param y Right operands
+ * @param result Sums
+ */
+inline void add(const IntervalArray& x, const IntervalArray& y, IntervalArray& result)
+{
+    result.resize(x.size());
+    batchAdd(x.lower(), x.upper(), y.lower(), y.upper(), result.lower(), result.upper(), x.size());
+}
+
+/**
+ * Element-wise subtraction.
+ *
+ * @param x Left operands
+ * @param y Right operands
+ * @param result Differences
+ */
+inline void subtract(const IntervalArray& x, const IntervalArray& y, IntervalArray& result)
+{
+    result.resize(x.size());
+    batchSubtract(x.lower(), x.upper(), y.lower(), y.upper(), result.lower(), result.upper(), x.size());
+}
+
+/**
+ * Element-wise division.
+ *
+ * @param x Dividends
+ * @param y Divisors
+ * @param result Quotients
+ */
+inline void divide(const IntervalArray& x, const IntervalArray& y, IntervalArray& result)
+{
+    result.resize(x.size());
+    intervalKernels().divide(x.lower(), x.upper(), y.lower(), y.upper(), result.lower(), result.upper(), x.size());
+}
+
+/**
+ * Element-wise absolute value.
+ *
+ * @param x Operands
+ * @param result Absolute values
+ */
+inline void abs(const IntervalArray& x, IntervalArray& result)
+{
+    result.resize(x.size());
+    batchAbs(x.lower(), x.upper(), result.lower(), result.upper(), x.size());
+}
+
+/**
+ * Element-wise square, tighter than multiply(x, x, result) for intervals
+ * spanning zero.
+ *
+ * @param x Operands
+ * @param result Squares
+ */
+inline void sqr(const IntervalArray& x, IntervalArray& result)
+{
+    result.resize(x.size());
+    intervalKernels().sqr(x.lower(), x.upper(), result.lower(), result.upper(), x.size());
+}
+
+/**
+ * Element-wise fused multiply-add x[i] * y[i] + z[i], bit-identical to
+ * multiply() followed by add() in a single pass.
+ *
+ * @param x Left factors
+ * @param y Right factors
+ * @param z Addends
+ * @param result Results
+ */
+inline void fma(const IntervalArray& x, const IntervalArray& y, const IntervalArray& z, IntervalArray& result)
+{
+    result.resize(x.size());
+    intervalKernels().fma(x.lower(), x.upper(), y.lower(), y.upper(), z.lower(), z.upper(), result.lower(), result.upper(), x.size());
+}
+
+/**
+ * Dot product of x and y; see dot() over IntervalNumber for the bracketing.
+ *
+ * @param x Left operands
+ * @param y Right operands; at least x.size() intervals
+ * @return The dot product; [0, 0]in for an empty array
+ */
+inline IntervalNumber dot(const IntervalArray& x, const IntervalArray& y) noexcept
+{
+    double r0{};
+    double r1{};
+    intervalKernels().dot(x.lower(), x.upper(), y.lower(), y.upper(), x.size(), r0, r1);
+
+    return IntervalNumber(r0, r1);
+}
+
+/**
+ * Element-wise power.
+ *
+ * @param x Bases
+ * @param y Exponents
+ * @param result Powers
+ */
+inline void pow(const IntervalArray& x, const IntervalArray& y, IntervalArray& result)
+{
+    result.resize(x.size());
+    intervalKernels().pow(x.lower(), x.upper(), y.lower(), y.upper(), result.lower(), result.upper(), x.size());
+}
+
+#endif /* INTERVALARRAY_HPP_ */
@@ -0,0 +1,400 @@
+#ifndef INTERVALDISPATCH_HPP_
+#define INTERVALDISPATCH_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+#include "IntervalKernels.hpp"
+#include "IntervalNumber.hpp"
+
+// Runtime CPU dispatch for the batch kernels.
+//
+// One binary carries several compilations of the multiplication, division,
+// power, square, fused multiply-add and dot product loops, each built for a
+// different instruction set with the GCC/Clang target attribute. The widest
+// variant the executing CPU supports is selected on first use; the
+// selection can be overridden through the ZEROINFINITY_INTERVAL_ISA
+// environment variable (scalar, baseline, avx2 or avx512) or with
+// selectIntervalIsa(), so every variant can be checked against the scalar
+// operators on a single machine. All variants produce bit-identical
+// results.
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define ZEROINFINITY_DISPATCH_X86 1
+#else
+#define ZEROINFINITY_DISPATCH_X86 0
+#endif
+
+/**
+ * Instruction sets with a dedicated kernel variant.
+ */
+enum class IntervalIsa {
+    Scalar,     // Element-wise IntervalNumber operators, no batch loops.
+    Baseline,   // Batch loops built for the compilation target (SSE2 on x86-64).
+    Avx2,       // Batch loops built for AVX2.
+    Avx512      // Batch loops built for AVX-512F.
+};
+
+/**
+ * Signature shared by all binary batch kernels: r[i] = x[i] op y[i].
+ */
+using BatchKernel = void (*)(const double* x0, const double* x1, const double* y0, const double* y1, double* r0, double* r1, std::size_t count);
+
+/**
+ * Signature of the unary batch kernels: r[i] = op x[i].
+ */
+using UnaryBatchKernel = void (*)(const double* x0, const double* x1, double* r0, double* r1, std::size_t count);
+
+/**
+ * Signature of the fused multiply-add batch kernels: r[i] = x[i] * y[i] + z[i].
+ */
+using FmaBatchKernel = void (*)(const double* x0, const double* x1, const double* y0, const double* y1, const double* z0, const double* z1, double* r0,
+                                double* r1, std::size_t count);
+
+/**
+ * Signature of the dot product batch kernels: [r0,r1]in = sum of x[i] * y[i].
+ */
+using DotBatchKernel = void (*)(const double* x0, const double* x1, const double* y0, const double* y1, std::size_t count, double& r0, double& r1);
+
+/**
+ * The kernel variants compiled for one instruction set.
+ */
+struct IntervalKernelTable
+{
+    IntervalIsa isa;
+    BatchKernel multiply;
+    BatchKernel divide;
+    BatchKernel pow;
+    UnaryBatchKernel sqr;
+    FmaBatchKernel fma;
+    DotBatchKernel dot;
+};
+
+// Scalar fallback: one IntervalNumber operation per element.
+
+inline void scalarMultiply(const double* x0, const double* x1, const double* y0, const double* y1, double* r0, double* r1, std::size_t count)
+{
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        const auto r = IntervalNumber(x0[i], x1[i]) * IntervalNumber(y0[i], y1[i]);
+        r0[i] = r.getX0();
+        r1[i] = r.getX1();
+    }
+}
+
+inline void scalarDivide(const double* x0, const double* x1, const double* y0, const double* y1, double* r0, double* r1, std::size_t count)
+{
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        const auto r = IntervalNumber(x0[i], x1[i]) / IntervalNumber(y0[i], y1[i]);
+        r0[i] = r.getX0();
+        r1[i] = r.getX1();
+    }
+}
+
+inline void scalarPow(const double* x0, const double* x1, const double* y0, const double* y1, double* r0, double* r1, std::size_t count)
+{
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        const auto r = IntervalNumber(x0[i], x1[i]).pow(IntervalNumber(y0[i], y1[i]));
+        r0[i] = r.getX0();
+        r1[i] = r.getX1();
+    }
+}
+
+inline void scalarSqr(const double* x0, const double* x1, double* r0, double* r1, std::size_t count)
+{
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        const auto r = IntervalNumber(x0[i], x1[i]).sqr();
+        r0[i] = r.getX0();
+        r1[i] = r.getX1();
+    }
+}
+
+inline void scalarFma(const double* x0, const double* x1, const double* y0, const double* y1, const double* z0, const double* z1, double* r0, double* r1,
+                      std::size_t count)
+{
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        const auto r = IntervalNumber(x0[i], x1[i]) * IntervalNumber(y0[i], y1[i]) + IntervalNumber(z0[i], z1[i]);
+        r0[i] = r.getX0();
+        r1[i] = r.getX1();
+    }
+}
+
+// The lane bracketing of dot(), spelled out with the operators.
+inline void scalarDot(const double* x0, const double* x1, const double* y0, const double* y1, std::size_t count, double& r0, double& r1)
+{
+    IntervalNumber partial[IntervalNumber::DOT_LANES]{};
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        auto& sum = partial[i % IntervalNumber::DOT_LANES];
+        sum = sum + IntervalNumber(x0[i], x1[i]) * IntervalNumber(y0[i], y1[i]);
+    }
+
+    IntervalNumber r = partial[0u];
+    for (std::size_t lane = 1u; lane < IntervalNumber::DOT_LANES; lane++)
+    {
+        r = r + partial[lane];
+    }
+    r0 = r.getX0();
+    r1 = r.getX1();
+}
+
+// Baseline: the batch loops as compiled for the build target.
+
+inline void baselineMultiply(const double* x0, const double* x1, const double* y0, const double* y1, double* r0, double* r1, std::size_t count)
+{
+    batchMultiply(x0, x1, y0, y1, r0, r1, count);
+}
+
+inline void baselineDivide(const double* x0, const double* x1, const double* y0, const double* y1, double* r0, double* r1, std::size_t count)
+{
+    batchDivide(x0, x1, y0, y1, r0, r1, count);
+}
+
+inline void baselinePow(const double* x0, const double* x1, const double* y0, const double* y1, double* r0, double* r1, std::size_t count)
+{
+    batchPow(x0, x1, y0, y1, r0, r1, count);
+}
+
+inline void baselineSqr(const double* x0, const double* x1, double* r0, double* r1, std::size_t count)
+{
+    batchSqr(x0, x1, r0, r1, count);
+}
+
+inline void baselineFma(const double* x0, const double* x1, const double* y0, const double* y1, const double* z0, const double* z1, double* r0, double* r1,
+                        std::size_t count)
+{
+    batchFma(x0, x1, y0, y1, z0, z1, r0, r1, count);
+}
+
+inline void baselineDot(const double* x0, const double* x1, const double* y0, const double* y1, std::size_t count, double& r0, double& r1)
+{
+    batchDot(x0, x1, y0, y1, count, r0, r1);
+}
+
+#if ZEROINFINITY_DISPATCH_X86
+
+// Wider variants. The loop bodies are spelled out rather than calling the
+// batch* functions so the endpoint kernels are inlined into, and compiled
+// for, the target of each variant. FMA is deliberately not enabled: the
+// compiler could contract products and sums and change rounding.
+
+#define ZEROINFINITY_DISPATCH_VARIANT(isa, name, kernel) \
+    __attribute__((target(isa))) inline void name(const double* x0, const double* x1, const double* y0, const double* y1, double* r0, double* r1, std::size_t count) \
+    { \
+        for (std::size_t i = 0u; i < count; i++) \
+        { \
+            IntervalNumber::kernel(x0[i], x1[i], y0[i], y1[i], r0[i], r1[i]); \
+        } \
+    }
+
+ZEROINFINITY_DISPATCH_VARIANT("avx2", avx2Multiply, multiplyBounds)
+ZEROINFINITY_DISPATCH_VARIANT("avx2", avx2Divide, divideBounds)
+ZEROINFINITY_DISPATCH_VARIANT("avx2", avx2Pow, powBounds)
+ZEROINFINITY_DISPATCH_VARIANT("avx512f", avx512Multiply, multiplyBounds)
+ZEROINFINITY_DISPATCH_VARIANT("avx512f", avx512Divide, divideBounds)
+ZEROINFINITY_DISPATCH_VARIANT("avx512f", avx512Pow, powBounds)
+
+#undef ZEROINFINITY_DISPATCH_VARIANT
+
+// The unary and blocked loops are not repeated here; flatten inlines
+// batchSqr(), batchFma() and batchDot(), with the endpoint kernels, into the
+// variant, so they are compiled for its target.
+
+__attribute__((target("avx2"), flatten)) inline void avx2Sqr(const double* x0, const double* x1, double* r0, double* r1, std::size_t count)
+{
+    batchSqr(x0, x1, r0, r1, count);
+}
+
+__attribute__((target("avx2"), flatten)) inline void avx2Fma(const double* x0, const double* x1, const double* y0, const double* y1, const double* z0,
+                                                             const double* z1, double* r0, double* r1, std::size_t count)
+{
+    batchFma(x0, x1, y0, y1, z0, z1, r0, r1, count);
+}
+
+__attribute__((target("avx2"), flatten)) inline void avx2Dot(const double* x0, const double* x1, const double* y0, const double* y1, std::size_t count, double& r0,
+                                                             double& r1)
+{
+    batchDot(x0, x1, y0, y1, count, r0, r1);
+}
+
+__attribute__((target("avx512f"), flatten)) inline void avx512Sqr(const double* x0, const double* x1, double* r0, double* r1, std::size_t count)
+{
+    batchSqr(x0, x1, r0, r1, count);
+}
+
+__attribute__((target("avx512f"), flatten)) inline void avx512Fma(const double* x0, const double* x1, const double* y0, const double* y1, const double* z0,
+                                                                  const double* z1, double* r0, double* r1, std::size_t count)
+{
+    batchFma(x0, x1, y0, y1, z0, z1, r0, r1, count);
+}
+
+__attribute__((target("avx512f"), flatten)) inline void avx512Dot(const double* x0, const double* x1, const double* y0, const double* y1, std::size_t count,
+                                                                  double& r0, double& r1)
+{
+    batchDot(x0, x1, y0, y1, count, r0, r1);
+}
+
+#endif
+
+/**
+ * Checks whether the executing CPU can run a kernel variant.
+ *
+ * @param isa The instruction set
+ * @return true if the variant exists in this build and the CPU supports it
+ */
+inline bool isIntervalIsaSupported(IntervalIsa isa) noexcept
+{
+    switch (isa)
+    {
+        case IntervalIsa::Scalar:
+        case IntervalIsa::Baseline:
+            return true;
+#if ZEROINFINITY_DISPATCH_X86
+        case IntervalIsa::Avx2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+        case IntervalIsa::Avx512:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return false;
+    }
+}
+
+/**
+ * Gets the kernel table of an instruction set.
+ * Unsupported instruction sets yield the baseline table.
+ *
+ * @param isa The instruction set
+ * @return The kernel variants for isa
+ */
+inline const IntervalKernelTable& intervalKernels(IntervalIsa isa) noexcept
+{
+    static const IntervalKernelTable scalar{IntervalIsa::Scalar, scalarMultiply, scalarDivide, scalarPow, scalarSqr, scalarFma, scalarDot};
+    static const IntervalKernelTable baseline{IntervalIsa::Baseline, baselineMultiply, baselineDivide, baselinePow, baselineSqr, baselineFma, baselineDot};
+#if ZEROINFINITY_DISPATCH_X86
+    static const IntervalKernelTable avx2{IntervalIsa::Avx2, avx2Multiply, avx2Divide, avx2Pow, avx2Sqr, avx2Fma, avx2Dot};
+    static const IntervalKernelTable avx512{IntervalIsa::Avx512, avx512Multiply, avx512Divide, avx512Pow, avx512Sqr, avx512Fma, avx512Dot};
+#endif
+
+    if (!isIntervalIsaSupported(isa))
+    {
+        return baseline;
+    }
+
+    switch (isa)
+    {
+        case IntervalIsa::Scalar:
+            return scalar;
+#if ZEROINFINITY_DISPATCH_X86
+        case IntervalIsa::Avx2:
+            return avx2;
+        case IntervalIsa::Avx512:
+            return avx512;
+#endif
+        default:
+            return baseline;
+    }
+}
+
+/**
+ * Gets the widest instruction set supported by the executing CPU.
+ *
+ * @return The widest supported instruction set
+ */
+inline IntervalIsa bestIntervalIsa() noexcept
+{
+    if (isIntervalIsaSupported(IntervalIsa::Avx512))
+    {
+        return IntervalIsa::Avx512;
+    }
+    if (isIntervalIsaSupported(IntervalIsa::Avx2))
+    {
+        return IntervalIsa::Avx2;
+    }
+    return IntervalIsa::Baseline;
+}
+
+/**
+ * Gets the name of an instruction set, as accepted by
+ * ZEROINFINITY_INTERVAL_ISA.
+ *
+ * @param isa The instruction set
+ * @return Lower-case name
+ */
+inline const char* toString(IntervalIsa isa) noexcept
+{
+    switch (isa)
+    {
+        case IntervalIsa::Scalar:
+            return "scalar";
+        case IntervalIsa::Avx2:
+            return "avx2";
+        case IntervalIsa::Avx512:
+            return "avx512";
+        default:
+            return "baseline";
+    }
+}
+
+// Holds the active kernel table. Initialized on first use from the
+// environment override or, failing that, from bestIntervalIsa().
+inline std::atomic<const IntervalKernelTable*>& activeIntervalKernels() noexcept
+{
+    static std::atomic<const IntervalKernelTable*> active{[]() {
+        IntervalIsa isa = bestIntervalIsa();
+
+        const char* requested = std::getenv("ZEROINFINITY_INTERVAL_ISA");
+        if (requested != nullptr)
+        {
+            for (auto candidate : {IntervalIsa::Scalar, IntervalIsa::Baseline, IntervalIsa::Avx2, IntervalIsa::Avx512})
+            {
+                if (std::strcmp(requested, toString(candidate)) == 0 && isIntervalIsaSupported(candidate))
+                {
+                    isa = candidate;
+                }
+            }
+        }
+
+        return &intervalKernels(isa);
+    }()};
+
+    return active;
+}
+
+/**
+ * Gets the active kernel table used by the IntervalArray operations.
+ *
+ * @return The active kernel variants
+ */
+inline const IntervalKernelTable& intervalKernels() noexcept
+{
+    return *activeIntervalKernels().load(std::memory_order_acquire);
+}
+
+/**
+ * Forces the kernel variant used by the IntervalArray operations.
+ *
+ * @param isa The instruction set to use
+ * @return false if the CPU does not support isa; the selection is unchanged
+ */
+inline bool selectIntervalIsa(IntervalIsa isa) noexcept
+{
+    if (!isIntervalIsaSupported(isa))
+    {
+        return false;
+    }
+
+    activeIntervalKernels().store(&intervalKernels(isa), std::memory_order_release);
+
+    return true;
+}
+
+#endif /* INTERVALDISPATCH_HPP_ */
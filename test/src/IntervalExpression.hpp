@@ -0,0 +1,530 @@
+#ifndef INTERVALEXPRESSION_HPP_
+#define INTERVALEXPRESSION_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+#include "IntervalArray.hpp"
+#include "IntervalNumber.hpp"
+
+// Expression templates over IntervalNumber and IntervalArray.
+//
+// lazy(x) wraps an interval, or an array of intervals, into an expression;
+// the operators on expressions build a tree instead of computing. The tree
+// is the one the compiler parses, so the bracketing is exactly the one of
+// the same code on IntervalNumber -- which matters, as multiplication is
+// not associative. Evaluation runs the endpoint kernels directly on
+// endpoint pairs held in registers: no intermediate IntervalNumber is
+// created and check() runs once, on the final result.
+//
+//     IntervalNumber r = (lazy(a) * b + c) / d;       // bit-identical to (a * b + c) / d
+//     assign((lazy(x) * y + z) / w, result);           // IntervalArray x, y, z, w, result
+//
+// With arrays, assign() makes a single pass over the arrays, one block of
+// EXPRESSION_BLOCK elements at a time. Within a block every node runs its
+// endpoint kernel as one loop over stack buffers, which stay in the L1
+// cache and cannot alias the arrays, so each loop vectorizes like the batch
+// kernels. Interleaving all kernels lane by lane would not: the NaN tests of
+// consecutive kernels fold into selects compilers cannot vectorize. Every
+// lane reads only element i of its operands, so the result may be one of
+// them; scalars and intervals in the tree are broadcast.
+
+/**
+ * Lanes per block of assign().
+ */
+static constexpr std::size_t EXPRESSION_BLOCK = 64u;
+
+/**
+ * Base of all expressions (CRTP).
+ */
+template<typename Derived>
+class IntervalExpression {
+
+public:
+
+    /**
+     * Gets the expression as its concrete type.
+     *
+     * @return The expression
+     */
+    const Derived& derived() const noexcept
+    {
+        return static_cast<const Derived&>(*this);
+    }
+
+    /**
+     * Evaluates the expression; for array expressions, element 0.
+     *
+     * @return The interval
+     */
+    template<typename T, typename D = Derived, typename = typename std::enable_if<std::is_same<T, typename D::value_type>::value>::type>
+    operator IntervalNumberT<T>() const noexcept
+    {
+        T r0{};
+        T r1{};
+        derived().bounds(0u, r0, r1);
+
+        return IntervalNumberT<T>(r0, r1);
+    }
+
+};
+
+/**
+ * Leaf holding an interval; the same value in every lane.
+ */
+template<typename T>
+class IntervalTerminal : public IntervalExpression<IntervalTerminal<T>> {
+
+public:
+
+    using value_type = T;
+
+private:
+
+    T m_x0{};
+    T m_x1{};
+
+public:
+
+    explicit IntervalTerminal(const IntervalNumberT<T>& x) noexcept :
+        m_x0{x.getX0()}, m_x1{x.getX1()}
+    {
+    }
+
+    std::size_t size() const noexcept
+    {
+        return 0u;
+    }
+
+    void bounds(std::size_t, T& r0, T& r1) const noexcept
+    {
+        r0 = m_x0;
+        r1 = m_x1;
+    }
+
+    void block(std::size_t, std::size_t lanes, T* r0, T* r1) const noexcept
+    {
+        std::fill(r0, r0 + lanes, m_x0);
+        std::fill(r1, r1 + lanes, m_x1);
+    }
+
+};
+
+/**
+ * Leaf referring to an IntervalArray; element i in lane i. The array must
+ * outlive the expression.
+ */
+class ArrayTerminal : public IntervalExpression<ArrayTerminal> {
+
+public:
+
+    using value_type = double;
+
+private:
+
+    const double* m_lower{nullptr};
+    const double* m_upper{nullptr};
+    std::size_t m_size{0u};
+
+public:
+
+    explicit ArrayTerminal(const IntervalArray& x) noexcept :
+        m_lower{x.lower()}, m_upper{x.upper()}, m_size{x.size()}
+    {
+    }
+
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    void bounds(std::size_t i, double& r0, double& r1) const noexcept
+    {
+        r0 = m_lower[i];
+        r1 = m_upper[i];
+    }
+
+    void block(std::size_t begin, std::size_t lanes, double* r0, double* r1) const noexcept
+    {
+        std::copy(m_lower + begin, m_lower + begin + lanes, r0);
+        std::copy(m_upper + begin, m_upper + begin + lanes, r1);
+    }
+
+};
+
+// Operations of BinaryExpression, forwarding to the endpoint kernels.
+
+struct ExpressionAdd
+{
+    template<typename T>
+    static void apply(T x0, T x1, T y0, T y1, T& r0, T& r1) noexcept
+    {
+        IntervalNumberT<T>::addBounds(x0, x1, y0, y1, r0, r1);
+    }
+};
+
+struct ExpressionSubtract
+{
+    template<typename T>
+    static void apply(T x0, T x1, T y0, T y1, T& r0, T& r1) noexcept
+    {
+        IntervalNumberT<T>::subtractBounds(x0, x1, y0, y1, r0, r1);
+    }
+};
+
+struct ExpressionMultiply
+{
+    template<typename T>
+    static void apply(T x0, T x1, T y0, T y1, T& r0, T& r1) noexcept
+    {
+        IntervalNumberT<T>::multiplyBounds(x0, x1, y0, y1, r0, r1);
+    }
+};
+
+struct ExpressionDivide
+{
+    template<typename T>
+    static void apply(T x0, T x1, T y0, T y1, T& r0, T& r1) noexcept
+    {
+        IntervalNumberT<T>::divideBounds(x0, x1, y0, y1, r0, r1);
+    }
+};
+
+struct ExpressionPow
+{
+    template<typename T>
+    static void apply(T x0, T x1, T y0, T y1, T& r0, T& r1) noexcept
+    {
+        IntervalNumberT<T>::powBounds(x0, x1, y0, y1, r0, r1);
+    }
+};
+
+/**
+ * Node left op right.
+ */
+template<typename Operation, typename Left, typename Right>
+class BinaryExpression : public IntervalExpression<BinaryExpression<Operation, Left, Right>> {
+
+public:
+
+    using value_type = typename Left::value_type;
+
+private:
+
+    Left m_left;
+    Right m_right;
+
+public:
+
+    BinaryExpression(const Left& left, const Right& right) noexcept :
+        m_left{left}, m_right{right}
+    {
+    }
+
+    std::size_t size() const noexcept
+    {
+        return std::max(m_left.size(), m_right.size());
+    }
+
+    void bounds(std::size_t i, value_type& r0, value_type& r1) const noexcept
+    {
+        value_type x0{};
+        value_type x1{};
+        value_type y0{};
+        value_type y1{};
+        m_left.bounds(i, x0, x1);
+        m_right.bounds(i, y0, y1);
+        Operation::apply(x0, x1, y0, y1, r0, r1);
+    }
+
+    void block(std::size_t begin, std::size_t lanes, value_type* r0, value_type* r1) const noexcept
+    {
+        value_type x0[EXPRESSION_BLOCK];
+        value_type x1[EXPRESSION_BLOCK];
+        value_type y0[EXPRESSION_BLOCK];
+        value_type y1[EXPRESSION_BLOCK];
+        m_left.block(begin, lanes, x0, x1);
+        m_right.block(begin, lanes, y0, y1);
+        for (std::size_t lane = 0u; lane < lanes; lane++)
+        {
+            Operation::apply(x0[lane], x1[lane], y0[lane], y1[lane], r0[lane], r1[lane]);
+        }
+    }
+
+};
+
+/**
+ * Node |operand|.
+ */
+template<typename Operand>
+class AbsExpression : public IntervalExpression<AbsExpression<Operand>> {
+
+public:
+
+    using value_type = typename Operand::value_type;
+
+private:
+
+    Operand m_operand;
+
+public:
+
+    explicit AbsExpression(const Operand& operand) noexcept :
+        m_operand{operand}
+    {
+    }
+
+    std::size_t size() const noexcept
+    {
+        return m_operand.size();
+    }
+
+    void bounds(std::size_t i, value_type& r0, value_type& r1) const noexcept
+    {
+        value_type a0{};
+        value_type a1{};
+        m_operand.bounds(i, a0, a1);
+        IntervalNumberT<value_type>::absBounds(a0, a1, r0, r1);
+    }
+
+    void block(std::size_t begin, std::size_t lanes, value_type* r0, value_type* r1) const noexcept
+    {
+        value_type a0[EXPRESSION_BLOCK];
+        value_type a1[EXPRESSION_BLOCK];
+        m_operand.block(begin, lanes, a0, a1);
+        for (std::size_t lane = 0u; lane < lanes; lane++)
+        {
+            IntervalNumberT<value_type>::absBounds(a0[lane], a1[lane], r0[lane], r1[lane]);
+        }
+    }
+
+};
+
+/**
+ * Node operand ^ n for an integer n.
+ */
+template<typename Operand>
+class PownExpression : public IntervalExpression<PownExpression<Operand>> {
+
+public:
+
+    using value_type = typename Operand::value_type;
+
+private:
+
+    Operand m_operand;
+    long long m_n;
+
+public:
+
+    PownExpression(const Operand& operand, long long n) noexcept :
+        m_operand{operand}, m_n{n}
+    {
+    }
+
+    std::size_t size() const noexcept
+    {
+        return m_operand.size();
+    }
+
+    void bounds(std::size_t i, value_type& r0, value_type& r1) const noexcept
+    {
+        value_type b0{};
+        value_type b1{};
+        m_operand.bounds(i, b0, b1);
+        IntervalNumberT<value_type>::pownBounds(b0, b1, m_n, r0, r1);
+    }
+
+    void block(std::size_t begin, std::size_t lanes, value_type* r0, value_type* r1) const noexcept
+    {
+        value_type b0[EXPRESSION_BLOCK];
+        value_type b1[EXPRESSION_BLOCK];
+        m_operand.block(begin, lanes, b0, b1);
+        for (std::size_t lane = 0u; lane < lanes; lane++)
+        {
+            IntervalNumberT<value_type>::pownBounds(b0[lane], b1[lane], m_n, r0[lane], r1[lane]);
+        }
+    }
+
+};
+
+/**
+ * Starts an expression on an interval.
+ *
+ * @param x The interval
+ * @return Leaf expression
+ */
+template<typename T>
+IntervalTerminal<T> lazy(const IntervalNumberT<T>& x) noexcept
+{
+    return IntervalTerminal<T>(x);
+}
+
+/**
+ * Starts an element-wise expression on an array.
+ *
+ * @param x The array; must outlive the expression
+ * @return Leaf expression
+ */
+inline ArrayTerminal lazy(const IntervalArray& x) noexcept
+{
+    return ArrayTerminal(x);
+}
+
+// Operators on expressions; intervals, arrays and scalars become leaves.
+
+#define ZEROINFINITY_EXPRESSION_OPERATOR(op, Operation) \
+    template<typename L, typename R> \
+    BinaryExpression<Operation, L, R> operator op(const IntervalExpression<L>& left, const IntervalExpression<R>& right) noexcept \
+    { \
+        return BinaryExpression<Operation, L, R>(left.derived(), right.derived()); \
+    } \
+    template<typename L> \
+    BinaryExpression<Operation, L, IntervalTerminal<typename L::value_type>> operator op(const IntervalExpression<L>& left, const IntervalNumberT<typename L::value_type>& right) noexcept \
+    { \
+        return {left.derived(), IntervalTerminal<typename L::value_type>(right)}; \
+    } \
+    template<typename R> \
+    BinaryExpression<Operation, IntervalTerminal<typename R::value_type>, R> operator op(const IntervalNumberT<typename R::value_type>& left, const IntervalExpression<R>& right) noexcept \
+    { \
+        return {IntervalTerminal<typename R::value_type>(left), right.derived()}; \
+    } \
+    template<typename L> \
+    BinaryExpression<Operation, L, IntervalTerminal<typename L::value_type>> operator op(const IntervalExpression<L>& left, typename L::value_type right) noexcept \
+    { \
+        return {left.derived(), IntervalTerminal<typename L::value_type>(IntervalNumberT<typename L::value_type>(right))}; \
+    } \
+    template<typename R> \
+    BinaryExpression<Operation, IntervalTerminal<typename R::value_type>, R> operator op(typename R::value_type left, const IntervalExpression<R>& right) noexcept \
+    { \
+        return {IntervalTerminal<typename R::value_type>(IntervalNumberT<typename R::value_type>(left)), right.derived()}; \
+    } \
+    template<typename L> \
+    BinaryExpression<Operation, L, ArrayTerminal> operator op(const IntervalExpression<L>& left, const IntervalArray& right) noexcept \
+    { \
+        return {left.derived(), ArrayTerminal(right)}; \
+    } \
+    template<typename R> \
+    BinaryExpression<Operation, ArrayTerminal, R> operator op(const IntervalArray& left, const IntervalExpression<R>& right) noexcept \
+    { \
+        return {ArrayTerminal(left), right.derived()}; \
+    }
+
+ZEROINFINITY_EXPRESSION_OPERATOR(+, ExpressionAdd)
+ZEROINFINITY_EXPRESSION_OPERATOR(-, ExpressionSubtract)
+ZEROINFINITY_EXPRESSION_OPERATOR(*, ExpressionMultiply)
+ZEROINFINITY_EXPRESSION_OPERATOR(/, ExpressionDivide)
+
+#undef ZEROINFINITY_EXPRESSION_OPERATOR
+
+/**
+ * Absolute value of an expression.
+ *
+ * @param x The expression
+ * @return Expression |x|
+ */
+template<typename Derived>
+AbsExpression<Derived> abs(const IntervalExpression<Derived>& x) noexcept
+{
+    return AbsExpression<Derived>(x.derived());
+}
+
+/**
+ * Power of an expression (expression ^ expression).
+ *
+ * @param base Base expression
+ * @param exponent Exponent expression
+ * @return Expression base ^ exponent
+ */
+template<typename L, typename R>
+BinaryExpression<ExpressionPow, L, R> pow(const IntervalExpression<L>& base, const IntervalExpression<R>& exponent) noexcept
+{
+    return BinaryExpression<ExpressionPow, L, R>(base.derived(), exponent.derived());
+}
+
+/**
+ * Power of an expression (expression ^ interval).
+ *
+ * @param base Base expression
+ * @param exponent Exponent interval
+ * @return Expression base ^ exponent
+ */
+template<typename L>
+BinaryExpression<ExpressionPow, L, IntervalTerminal<typename L::value_type>> pow(const IntervalExpression<L>& base, const IntervalNumberT<typename L::value_type>& exponent) noexcept
+{
+    return {base.derived(), IntervalTerminal<typename L::value_type>(exponent)};
+}
+
+/**
+ * Power of an interval (interval ^ expression).
+ *
+ * @param base Base interval
+ * @param exponent Exponent expression
+ * @return Expression base ^ exponent
+ */
+template<typename R>
+BinaryExpression<ExpressionPow, IntervalTerminal<typename R::value_type>, R> pow(const IntervalNumberT<typename R::value_type>& base, const IntervalExpression<R>& exponent) noexcept
+{
+    return {IntervalTerminal<typename R::value_type>(base), exponent.derived()};
+}
+
+/**
+ * Power of an expression (expression ^ scalar).
+ *
+ * @param base Base expression
+ * @param exponent Scalar exponent
+ * @return Expression base ^ exponent
+ */
+template<typename L>
+BinaryExpression<ExpressionPow, L, IntervalTerminal<typename L::value_type>> pow(const IntervalExpression<L>& base, typename L::value_type exponent) noexcept
+{
+    return {base.derived(), IntervalTerminal<typename L::value_type>(IntervalNumberT<typename L::value_type>(exponent))};
+}
+
+/**
+ * Integer power of an expression.
+ *
+ * @param base Base expression
+ * @param n Integer exponent
+ * @return Expression base ^ n
+ */
+template<typename Derived>
+PownExpression<Derived> pown(const IntervalExpression<Derived>& base, long long n) noexcept
+{
+    return PownExpression<Derived>(base.derived(), n);
+}
+
+/**
+ * Evaluates an expression.
+ *
+ * @param x The expression
+ * @return The interval; for array expressions, element 0
+ */
+template<typename Derived>
+IntervalNumberT<typename Derived::value_type> evaluate(const IntervalExpression<Derived>& x) noexcept
+{
+    return x.template operator IntervalNumberT<typename Derived::value_type>();
+}
+
+/**
+ * Evaluates an array expression element-wise in a single pass over the
+ * arrays, EXPRESSION_BLOCK elements at a time.
+ *
+ * @param x The expression; all its arrays must have the same size
+ * @param result The results; may be one of the arrays of x
+ */
+template<typename Derived>
+void assign(const IntervalExpression<Derived>& x, IntervalArray& result)
+{
+    const Derived& expression = x.derived();
+    const std::size_t count = expression.size();
+    result.resize(count);
+
+    for (std::size_t begin = 0u; begin < count; begin += EXPRESSION_BLOCK)
+    {
+        expression.block(begin, std::min(EXPRESSION_BLOCK, count - begin), result.lower() + begin, result.upper() + begin);
+    }
+}
+
+#endif /* INTERVALEXPRESSION_HPP_ */
@@ -0,0 +1,583 @@
+#ifndef INTERVALFILE_HPP_
+#define INTERVALFILE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "IntervalNumber.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ZEROINFINITY_MMAP 1
+#else
+#define ZEROINFINITY_MMAP 0
+#endif
+
+// Binary interval datasets.
+//
+// A file starts with a 64-byte IntervalFileHeader, followed by the
+// intervals in blocks of blockSize. Each block holds the lower bounds of
+// its intervals, then the upper bounds, both starting on a 64-byte
+// boundary, so a mapped block is a pair of endpoint arrays the batch
+// kernels read in place:
+//
+//     header | lower[0..B) upper[0..B) | lower[B..2B) upper[B..2B) | ...
+//
+// Every block but the last is full. The endpoints are stored in the byte
+// order of the writer, which the header records. Bits are copied
+// unchanged, so NaN, -0 and ±∞ round-trip exactly.
+//
+// IntervalFileWriterT streams intervals to a file one block at a time and
+// writes the final count when it is closed. MappedIntervalFileT maps a
+// file read-only; opening validates only the header and the file size, so
+// it takes the same time for any file size. Memory mapping needs a POSIX
+// system; elsewhere opening a file fails. Neither class throws: failures
+// are reported by the return values.
+
+/**
+ * Endpoint types of an interval file.
+ */
+enum class IntervalEndpointType : std::uint32_t {
+    Float32 = 1u,
+    Float64 = 2u
+};
+
+/**
+ * Gets the file endpoint type of T.
+ *
+ * @return The endpoint type
+ */
+template<typename T>
+constexpr IntervalEndpointType intervalEndpointType() noexcept
+{
+    static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value, "interval files store float or double endpoints");
+
+    return std::is_same<T, float>::value ? IntervalEndpointType::Float32 : IntervalEndpointType::Float64;
+}
+
+// First eight bytes of every interval file.
+static constexpr char INTERVAL_FILE_MAGIC[8u] = {'Z', 'I', 'N', 'T', 'V', 'L', '\r', '\n'};
+
+// Current format version. Readers reject other versions.
+static constexpr std::uint32_t INTERVAL_FILE_VERSION = 1u;
+
+// Written in the byte order of the writer; reads back differently on a
+// machine of the other byte order.
+static constexpr std::uint32_t INTERVAL_FILE_BYTE_ORDER = 0x01020304u;
+
+// Alignment of the header end and of every endpoint array, in bytes.
+static constexpr std::size_t INTERVAL_FILE_ALIGNMENT = 64u;
+
+// Default number of intervals per block: 512 KiB of double lower bounds.
+static constexpr std::size_t INTERVAL_FILE_BLOCK_SIZE = 65536u;
+
+/**
+ * Header at the start of an interval file.
+ */
+struct IntervalFileHeader
+{
+    char magic[8u];
+    std::uint32_t version;
+    std::uint32_t endpointType;     // IntervalEndpointType
+    std::uint32_t endpointSize;     // Bytes per endpoint.
+    std::uint32_t byteOrder;        // INTERVAL_FILE_BYTE_ORDER
+    std::uint64_t count;            // Number of intervals.
+    std::uint64_t blockSize;        // Intervals per block; a multiple of 16.
+    std::uint64_t dataOffset;       // Offset of the first block.
+    std::uint8_t reserved[16u];     // Zero.
+};
+
+static_assert(sizeof(IntervalFileHeader) == INTERVAL_FILE_ALIGNMENT, "the first block starts on a 64-byte boundary");
+
+/**
+ * Rounds a byte count up to INTERVAL_FILE_ALIGNMENT.
+ *
+ * @param bytes Byte count
+ * @return The aligned byte count
+ */
+constexpr std::uint64_t alignIntervalFileOffset(std::uint64_t bytes) noexcept
+{
+    return (bytes + INTERVAL_FILE_ALIGNMENT - 1u) / INTERVAL_FILE_ALIGNMENT * INTERVAL_FILE_ALIGNMENT;
+}
+
+/**
+ * Gets the size of an interval file.
+ *
+ * @param count Number of intervals
+ * @param blockSize Intervals per block
+ * @param endpointSize Bytes per endpoint
+ * @return The file size in bytes
+ */
+constexpr std::uint64_t intervalFileSize(std::uint64_t count, std::uint64_t blockSize, std::uint64_t endpointSize) noexcept
+{
+    const std::uint64_t fullBlocks = count / blockSize;
+    const std::uint64_t rest = count % blockSize;
+
+    return sizeof(IntervalFileHeader) + fullBlocks * 2u * blockSize * endpointSize + 2u * alignIntervalFileOffset(rest * endpointSize);
+}
+
+/**
+ * Sequential writer of an interval file.
+ *
+ * Intervals are buffered until a block is full, and each full block is
+ * written with two sequential writes. The header is written with a zero
+ * count on open() and rewritten by close(), so a file that was not closed
+ * reads as empty.
+ */
+template<typename T>
+class IntervalFileWriterT {
+
+private:
+
+    // Output file; nullptr if not open.
+    std::FILE* m_file{nullptr};
+
+    // Intervals per block.
+    std::size_t m_blockSize{};
+
+    // Intervals written, including the buffered ones.
+    std::uint64_t m_count{0u};
+
+    // Lower bounds of the current block.
+    std::vector<T> m_lower{};
+
+    // Upper bounds of the current block.
+    std::vector<T> m_upper{};
+
+    // false once a write failed.
+    bool m_good{true};
+
+    IntervalFileHeader header() const noexcept
+    {
+        IntervalFileHeader header{};
+        std::memcpy(header.magic, INTERVAL_FILE_MAGIC, sizeof(header.magic));
+        header.version = INTERVAL_FILE_VERSION;
+        header.endpointType = static_cast<std::uint32_t>(intervalEndpointType<T>());
+        header.endpointSize = sizeof(T);
+        header.byteOrder = INTERVAL_FILE_BYTE_ORDER;
+        header.count = m_count;
+        header.blockSize = m_blockSize;
+        header.dataOffset = sizeof(IntervalFileHeader);
+
+        return header;
+    }
+
+    void write(const void* data, std::size_t bytes) noexcept
+    {
+        m_good = m_good && (std::fwrite(data, 1u, bytes, m_file) == bytes);
+    }
+
+    // Writes the buffered block, padding both arrays of a partial block.
+    void flush() noexcept
+    {
+        const std::size_t size = m_lower.size();
+        const std::size_t padding = alignIntervalFileOffset(size * sizeof(T)) - size * sizeof(T);
+        const char zeros[INTERVAL_FILE_ALIGNMENT]{};
+
+        write(m_lower.data(), size * sizeof(T));
+        write(zeros, padding);
+        write(m_upper.data(), size * sizeof(T));
+        write(zeros, padding);
+
+        m_lower.clear();
+        m_upper.clear();
+    }
+
+public:
+
+    /**
+     * Constructor. Does not open a file.
+     *
+     * @param blockSize Intervals per block; rounded up to a multiple of 16
+     */
+    explicit IntervalFileWriterT(std::size_t blockSize = INTERVAL_FILE_BLOCK_SIZE) :
+        m_blockSize{(blockSize + 15u) / 16u * 16u}
+    {
+        m_blockSize = (m_blockSize == 0u) ? 16u : m_blockSize;
+    }
+
+    IntervalFileWriterT(const IntervalFileWriterT&) = delete;
+
+    IntervalFileWriterT& operator=(const IntervalFileWriterT&) = delete;
+
+    /**
+     * Destructor. Closes the file.
+     */
+    ~IntervalFileWriterT()
+    {
+        close();
+    }
+
+    /**
+     * Creates or truncates a file and writes the header.
+     *
+     * @param path Path of the file
+     * @return true on success
+     */
+    bool open(const char* path)
+    {
+        close();
+
+        m_file = std::fopen(path, "wb");
+        if (m_file == nullptr)
+        {
+            return false;
+        }
+
+        m_count = 0u;
+        m_good = true;
+        m_lower.reserve(m_blockSize);
+        m_upper.reserve(m_blockSize);
+
+        const IntervalFileHeader initial = header();
+        write(&initial, sizeof(initial));
+
+        return m_good;
+    }
+
+    /**
+     * Appends intervals from endpoint arrays.
+     *
+     * @param lower count lower bounds
+     * @param upper count upper bounds
+     * @param count Number of intervals
+     * @return false if the file is not open or a write failed
+     */
+    bool append(const T* lower, const T* upper, std::size_t count)
+    {
+        if (m_file == nullptr)
+        {
+            return false;
+        }
+
+        std::size_t i = 0u;
+        while (i < count)
+        {
+            const std::size_t size = std::min(count - i, m_blockSize - m_lower.size());
+            m_lower.insert(m_lower.end(), lower + i, lower + i + size);
+            m_upper.insert(m_upper.end(), upper + i, upper + i + size);
+            i += size;
+
+            if (m_lower.size() == m_blockSize)
+            {
+                flush();
+            }
+        }
+        m_count += count;
+
+        return m_good;
+    }
+
+    /**
+     * Appends an interval.
+     *
+     * @param interval The interval
+     * @return false if the file is not open or a write failed
+     */
+    bool append(const IntervalNumberT<T>& interval)
+    {
+        const T lower = interval.getX0();
+        const T upper = interval.getX1();
+
+        return append(&lower, &upper, 1u);
+    }
+
+    /**
+     * Gets the number of intervals appended since open().
+     *
+     * @return Number of intervals
+     */
+    std::uint64_t size() const noexcept
+    {
+        return m_count;
+    }
+
+    /**
+     * Writes the last block and the final header, and closes the file.
+     * Does nothing if no file is open.
+     *
+     * @return true if every write succeeded
+     */
+    bool close() noexcept
+    {
+        if (m_file == nullptr)
+        {
+            return false;
+        }
+
+        if (!m_lower.empty())
+        {
+            flush();
+        }
+
+        const IntervalFileHeader completed = header();
+        m_good = m_good && (std::fseek(m_file, 0L, SEEK_SET) == 0);
+        write(&completed, sizeof(completed));
+        m_good = (std::fclose(m_file) == 0) && m_good;
+        m_file = nullptr;
+
+        return m_good;
+    }
+
+};
+
+/**
+ * Read-only memory mapping of an interval file.
+ *
+ * The endpoint arrays of each block are exposed in place, so they can be
+ * passed straight to the batch kernels (see IntervalDispatch.hpp):
+ *
+ *     MappedIntervalFile file{};
+ *     if (file.open("intervals.zi"))
+ *     {
+ *         for (std::size_t b = 0u; b < file.blockCount(); b++)
+ *         {
+ *             intervalKernels().multiply(file.lower(b), file.upper(b), ...);
+ *         }
+ *     }
+ */
+template<typename T>
+class MappedIntervalFileT {
+
+private:
+
+    // Start of the mapping; nullptr if not open.
+    const unsigned char* m_data{nullptr};
+
+    // Length of the mapping in bytes.
+    std::size_t m_length{0u};
+
+    // Copy of the header.
+    IntervalFileHeader m_header{};
+
+    // Offset of a block from the start of the file.
+    std::size_t blockOffset(std::size_t block) const noexcept
+    {
+        return static_cast<std::size_t>(m_header.dataOffset + block * 2u * m_header.blockSize * sizeof(T));
+    }
+
+    // Validates the header against the file size. The block size must keep
+    // the byte size of a block within 64 bits.
+    bool validate(const IntervalFileHeader& header, std::uint64_t fileSize) const noexcept
+    {
+        return std::memcmp(header.magic, INTERVAL_FILE_MAGIC, sizeof(header.magic)) == 0 && header.version == INTERVAL_FILE_VERSION &&
+               header.byteOrder == INTERVAL_FILE_BYTE_ORDER && header.endpointType == static_cast<std::uint32_t>(intervalEndpointType<T>()) &&
+               header.endpointSize == sizeof(T) && header.blockSize != 0u && header.blockSize % 16u == 0u &&
+               header.blockSize <= UINT64_MAX / (2u * sizeof(T)) &&
+               header.dataOffset == sizeof(IntervalFileHeader) && header.count <= fileSize / (2u * sizeof(T)) &&
+               intervalFileSize(header.count, header.blockSize, sizeof(T)) <= fileSize;
+    }
+
+public:
+
+    /**
+     * Default constructor. Does not open a file.
+     */
+    MappedIntervalFileT() noexcept = default;
+
+    MappedIntervalFileT(const MappedIntervalFileT&) = delete;
+
+    MappedIntervalFileT& operator=(const MappedIntervalFileT&) = delete;
+
+    /**
+     * Move constructor.
+     *
+     * @param other The mapping to take over
+     */
+    MappedIntervalFileT(MappedIntervalFileT&& other) noexcept :
+        m_data{other.m_data}, m_length{other.m_length}, m_header{other.m_header}
+    {
+        other.m_data = nullptr;
+        other.m_length = 0u;
+        other.m_header = IntervalFileHeader{};
+    }
+
+    /**
+     * Destructor. Unmaps the file.
+     */
+    ~MappedIntervalFileT()
+    {
+        close();
+    }
+
+    /**
+     * Maps a file read-only and validates its header.
+     *
+     * @param path Path of the file
+     * @return false if the file cannot be mapped, is not an interval file
+     *         of version INTERVAL_FILE_VERSION with endpoints of type T in
+     *         the byte order of this machine, or is truncated
+     */
+    bool open(const char* path) noexcept
+    {
+        close();
+
+#if ZEROINFINITY_MMAP
+        const int descriptor = ::open(path, O_RDONLY);
+        if (descriptor < 0)
+        {
+            return false;
+        }
+
+        struct stat status{};
+        const bool sized = (fstat(descriptor, &status) == 0) && (static_cast<std::uint64_t>(status.st_size) >= sizeof(IntervalFileHeader));
+        void* mapping = sized ? mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED, descriptor, 0) : MAP_FAILED;
+        ::close(descriptor);
+        if (mapping == MAP_FAILED)
+        {
+            return false;
+        }
+
+        // The mapping stays valid after the descriptor is closed.
+        m_data = static_cast<const unsigned char*>(mapping);
+        m_length = static_cast<std::size_t>(status.st_size);
+        std::memcpy(&m_header, m_data, sizeof(m_header));
+        if (!validate(m_header, m_length))
+        {
+            close();
+            return false;
+        }
+
+        return true;
+#else
+        (void)path;
+
+        return false;
+#endif
+    }
+
+    /**
+     * Unmaps the file. Pointers obtained from lower() and upper() become
+     * invalid.
+     */
+    void close() noexcept
+    {
+#if ZEROINFINITY_MMAP
+        if (m_data != nullptr)
+        {
+            munmap(const_cast<unsigned char*>(m_data), m_length);
+        }
+#endif
+        m_data = nullptr;
+        m_length = 0u;
+        m_header = IntervalFileHeader{};
+    }
+
+    /**
+     * Checks whether a file is mapped.
+     *
+     * @return true if open() succeeded
+     */
+    bool isOpen() const noexcept
+    {
+        return m_data != nullptr;
+    }
+
+    /**
+     * Gets the header of the mapped file.
+     *
+     * @return The header; all zero if no file is mapped
+     */
+    const IntervalFileHeader& header() const noexcept
+    {
+        return m_header;
+    }
+
+    /**
+     * Gets the number of intervals.
+     *
+     * @return Number of intervals
+     */
+    std::size_t size() const noexcept
+    {
+        return static_cast<std::size_t>(m_header.count);
+    }
+
+    /**
+     * Gets the number of intervals per block.
+     *
+     * @return The block size
+     */
+    std::size_t blockSize() const noexcept
+    {
+        return static_cast<std::size_t>(m_header.blockSize);
+    }
+
+    /**
+     * Gets the number of blocks.
+     *
+     * @return Number of blocks
+     */
+    std::size_t blockCount() const noexcept
+    {
+        if (m_header.blockSize == 0u)
+        {
+            return 0u;
+        }
+
+        return static_cast<std::size_t>(m_header.count / m_header.blockSize + ((m_header.count % m_header.blockSize != 0u) ? 1u : 0u));
+    }
+
+    /**
+     * Gets the number of intervals in a block.
+     *
+     * @param block Index of the block
+     * @return blockSize(), or fewer for the last block
+     */
+    std::size_t blockLength(std::size_t block) const noexcept
+    {
+        const std::size_t begin = block * blockSize();
+
+        return std::min(blockSize(), size() - begin);
+    }
+
+    /**
+     * Gets the lower bounds of a block, 64-byte aligned.
+     *
+     * @param block Index of the block
+     * @return Pointer to blockLength(block) lower bounds
+     */
+    const T* lower(std::size_t block) const noexcept
+    {
+        return reinterpret_cast<const T*>(m_data + blockOffset(block));
+    }
+
+    /**
+     * Gets the upper bounds of a block, 64-byte aligned.
+     *
+     * @param block Index of the block
+     * @return Pointer to blockLength(block) upper bounds
+     */
+    const T* upper(std::size_t block) const noexcept
+    {
+        return reinterpret_cast<const T*>(m_data + blockOffset(block) + alignIntervalFileOffset(blockLength(block) * sizeof(T)));
+    }
+
+    /**
+     * Gets an interval.
+     *
+     * @param index Position of the interval
+     * @return The interval at index
+     */
+    IntervalNumberT<T> get(std::size_t index) const noexcept
+    {
+        const std::size_t block = index / blockSize();
+        const std::size_t offset = index % blockSize();
+
+        return IntervalNumberT<T>(lower(block)[offset], upper(block)[offset]);
+    }
+
+};
+
+using IntervalFileWriter = IntervalFileWriterT<double>;
+using MappedIntervalFile = MappedIntervalFileT<double>;
+
+#endif /* INTERVALFILE_HPP_ */
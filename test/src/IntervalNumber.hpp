@@ -3,35 +3,84 @@
 
 #include <algorithm>
 #include <array>
+#include <charconv>
 #include <cmath>
+#include <cstddef>
+#include <cstring>
 #include <limits>
-#include <set>
 #include <string>
+#include <system_error>
+#include <type_traits>
 #include <vector>
 
 // Constants for convenience.
 static constexpr double INF = std::numeric_limits<double>::infinity();
 static constexpr double QUIET_NAN = std::numeric_limits<double>::quiet_NaN();
 
+// True while a constexpr function is evaluated at compile time. Forming a
+// NaN (0·∞, ∞-∞) or dividing by zero is not a constant expression, so the
+// endpoint kernels take a classification path during constant evaluation
+// and keep their branch-free form at run time.
+#if defined(__cpp_lib_is_constant_evaluated)
+#define ZEROINFINITY_IS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#else
+#define ZEROINFINITY_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+
 /**
  * Represents an interval number [x0, x1]in using extended real numbers.
  * 
  * This class implements interval arithmetic for handling indeterminate forms
  * such as 0*∞, 0/0, ∞-∞, etc. according to the mathematical definitions
  * in the ZeroInfinity paper.
+ *
+ * The endpoint type T is float, double or long double; IntervalNumber is the
+ * double instantiation. Every instantiation applies the same indeterminate
+ * form rules, evaluated in T.
  */
-class IntervalNumber {
+template<typename T>
+class IntervalNumberT {
+
+    static_assert(std::is_floating_point<T>::value && std::numeric_limits<T>::has_infinity && std::numeric_limits<T>::has_quiet_NaN,
+                  "IntervalNumberT requires an IEEE floating-point endpoint type");
+
+public:
+
+    // Endpoint type.
+    using value_type = T;
+
+    // Partial sums of dot(), each accumulating every DOT_LANES-th product.
+    static constexpr std::size_t DOT_LANES = 8u;
+
+    // Largest |n| for which pow() evaluates an integer point exponent by
+    // repeated squaring. Squaring loses about one ulp per multiplication
+    // and per doubling of the relative error, so beyond this pow() keeps
+    // std::pow.
+    static constexpr long long POW_SQUARING_LIMIT = 64;
+
+    // Maximum length of an endpoint written by endpointToChars(): sign,
+    // max_digits10 digits, decimal point and an exponent of up to five
+    // digits with its sign.
+    static constexpr std::size_t ENDPOINT_TEXT_LENGTH = static_cast<std::size_t>(std::numeric_limits<T>::max_digits10) + 9u;
+
+    // Maximum length of an interval written by toChars().
+    static constexpr std::size_t TEXT_LENGTH = 2u * ENDPOINT_TEXT_LENGTH + 6u;
 
 private:
 
+    // Constants in the endpoint type. Within the class they hide the double
+    // constants of the same name.
+    static constexpr T INF = std::numeric_limits<T>::infinity();
+    static constexpr T QUIET_NAN = std::numeric_limits<T>::quiet_NaN();
+
     // Internal storage for interval endpoints [x0, x1]
-    std::array<double, 2u> m_interval{0.0, 0.0};
+    std::array<T, 2u> m_interval{};
 
     /**
      * Validates and normalizes the interval to ensure x0 <= x1.
      * If either bound is NaN, the entire interval becomes NaN.
      */
-    void check() noexcept
+    constexpr void check() noexcept
     {
         if (m_interval[0u] > m_interval[1u])
         {
@@ -40,20 +89,32 @@ private:
             m_interval[1u] = x;
         }
 
-        if (std::isnan(m_interval[0u]) || std::isnan(m_interval[1u]))
+        // x != x is the constexpr-friendly std::isnan.
+        if ((m_interval[0u] != m_interval[0u]) || (m_interval[1u] != m_interval[1u]))
         {
-            m_interval[0u] = std::numeric_limits<double>::quiet_NaN();
-            m_interval[1u] = std::numeric_limits<double>::quiet_NaN();
+            m_interval[0u] = std::numeric_limits<T>::quiet_NaN();
+            m_interval[1u] = std::numeric_limits<T>::quiet_NaN();
         }
     }
 
+    // Skips spaces and tabs.
+    static const char* skipBlanks(const char* first, const char* last) noexcept
+    {
+        while (first != last && (*first == ' ' || *first == '\t'))
+        {
+            first++;
+        }
+
+        return first;
+    }
+
 public:
 
     /**
      * Default constructor.
      * Initializes interval to [0, 0]in.
      */
-    IntervalNumber() noexcept
+    constexpr IntervalNumberT() noexcept
     {
         check();
     }
@@ -64,7 +125,7 @@ public:
      * 
      * @param x0 The single value for both endpoints
      */
-    IntervalNumber(double x0) noexcept :
+    constexpr IntervalNumberT(T x0) noexcept :
         m_interval{x0, x0}
     {
         check();
@@ -77,18 +138,33 @@ public:
      * @param x0 Lower bound
      * @param x1 Upper bound
      */
-    IntervalNumber(double x0, double x1) noexcept :
+    constexpr IntervalNumberT(T x0, T x1) noexcept :
         m_interval{x0, x1}
     {
         check();
     }
 
+    /**
+     * Conversion constructor from an interval with another endpoint type.
+     * Bounds not representable in T are rounded outward -- the lower bound
+     * down, the upper bound up -- so the result always encloses other.
+     * Widening conversions are exact.
+     *
+     * @param other The interval to convert
+     */
+    template<typename U>
+    explicit IntervalNumberT(const IntervalNumberT<U>& other) noexcept :
+        m_interval{convertOutward(other.getX0(), true), convertOutward(other.getX1(), false)}
+    {
+        check();
+    }
+
     /**
      * Gets the lower bound of the interval.
      * 
      * @return The value x0
      */
-    double getX0() const noexcept
+    constexpr T getX0() const noexcept
     {
         return m_interval[0u];
     }
@@ -98,19 +174,166 @@ public:
      * 
      * @return The value x1
      */
-    double getX1() const noexcept
+    constexpr T getX1() const noexcept
     {
         return m_interval[1u];
     }
 
     /**
      * Converts the interval to a string representation.
+     * The endpoints are written like toChars(), so fromChars() reads the
+     * string back to the same interval.
      * 
      * @return String in format "[x0, x1]in"
      */
     std::string toString() const noexcept
     {
-        return "[" + std::to_string(m_interval[0u]) + ", " + std::to_string(m_interval[1u]) + "]in";
+        char text[TEXT_LENGTH];
+        const std::to_chars_result result = toChars(text, text + TEXT_LENGTH);
+
+        return std::string(text, result.ptr);
+    }
+
+    /**
+     * Writes the interval as "[x0, x1]in" into a character buffer, without
+     * a terminating null character. Each endpoint is the shortest decimal
+     * that reads back to the same value, "inf", "-inf" or "nan". No memory
+     * is allocated; TEXT_LENGTH characters always suffice.
+     *
+     * @param first Start of the buffer
+     * @param last End of the buffer
+     * @return One past the last character written, or last and
+     *         std::errc::value_too_large if the buffer is too small
+     */
+    std::to_chars_result toChars(char* first, char* last) const noexcept
+    {
+        std::to_chars_result result{last, std::errc::value_too_large};
+        if (last - first < 6)
+        {
+            return result;
+        }
+
+        *first = '[';
+        result = endpointToChars(first + 1, last - 5, m_interval[0u]);
+        if (result.ec != std::errc{})
+        {
+            return {last, std::errc::value_too_large};
+        }
+        result.ptr[0] = ',';
+        result.ptr[1] = ' ';
+        result = endpointToChars(result.ptr + 2, last - 3, m_interval[1u]);
+        if (result.ec != std::errc{})
+        {
+            return {last, std::errc::value_too_large};
+        }
+        std::memcpy(result.ptr, "]in", 3u);
+        result.ptr += 3;
+
+        return result;
+    }
+
+    /**
+     * Reads an interval written as "[x0, x1]in" or as a single endpoint x0,
+     * which gives the point interval [x0, x0]in. Spaces and tabs may
+     * precede the interval and surround the endpoints and the comma; the
+     * suffix "in" is optional. Endpoints are parsed like endpointFromChars().
+     * As for the constructor, swapped endpoints are ordered and a NaN
+     * endpoint makes the interval NaN.
+     *
+     * @param first Start of the text
+     * @param last End of the text
+     * @param result The interval read; unchanged on failure
+     * @return One past the last character read, or first and
+     *         std::errc::invalid_argument or std::errc::result_out_of_range
+     */
+    static std::from_chars_result fromChars(const char* first, const char* last, IntervalNumberT& result) noexcept
+    {
+        const char* p = skipBlanks(first, last);
+        T x0{};
+        T x1{};
+        std::from_chars_result read{};
+
+        if (p != last && *p == '[')
+        {
+            read = endpointFromChars(skipBlanks(p + 1, last), last, x0);
+            p = skipBlanks(read.ptr, last);
+            if (read.ec != std::errc{} || p == last || *p != ',')
+            {
+                return {first, (read.ec != std::errc{}) ? read.ec : std::errc::invalid_argument};
+            }
+            read = endpointFromChars(skipBlanks(p + 1, last), last, x1);
+            p = skipBlanks(read.ptr, last);
+            if (read.ec != std::errc{} || p == last || *p != ']')
+            {
+                return {first, (read.ec != std::errc{}) ? read.ec : std::errc::invalid_argument};
+            }
+            p++;
+            if (last - p >= 2 && p[0] == 'i' && p[1] == 'n')
+            {
+                p += 2;
+            }
+        }
+        else
+        {
+            read = endpointFromChars(p, last, x0);
+            if (read.ec != std::errc{})
+            {
+                return {first, read.ec};
+            }
+            p = read.ptr;
+            x1 = x0;
+        }
+
+        result = IntervalNumberT(x0, x1);
+
+        return {p, std::errc{}};
+    }
+
+    /**
+     * Writes an endpoint as the shortest decimal that reads back to the
+     * same value, or as "inf", "-inf" or "nan". Every NaN is written as
+     * "nan".
+     *
+     * @param first Start of the buffer
+     * @param last End of the buffer
+     * @param x The endpoint
+     * @return As std::to_chars
+     */
+    static std::to_chars_result endpointToChars(char* first, char* last, T x) noexcept
+    {
+        if (x != x)
+        {
+            if (last - first < 3)
+            {
+                return {last, std::errc::value_too_large};
+            }
+            std::memcpy(first, "nan", 3u);
+
+            return {first + 3, std::errc{}};
+        }
+
+        return std::to_chars(first, last, x);
+    }
+
+    /**
+     * Reads an endpoint: a decimal floating-point number with an optional
+     * sign, or "inf", "infinity" or "nan" in any case. The decimal is
+     * rounded to the nearest T, so text written by endpointToChars() reads
+     * back exactly.
+     *
+     * @param first Start of the text
+     * @param last End of the text
+     * @param x The endpoint read; unchanged on failure
+     * @return As std::from_chars; a value beyond the range of T is
+     *         std::errc::result_out_of_range
+     */
+    static std::from_chars_result endpointFromChars(const char* first, const char* last, T& x) noexcept
+    {
+        // std::from_chars accepts a leading minus sign only.
+        const char* p = (first != last && *first == '+' && last - first > 1 && first[1] != '-') ? first + 1 : first;
+        const std::from_chars_result result = std::from_chars(p, last, x);
+
+        return (result.ec == std::errc::invalid_argument) ? std::from_chars_result{first, result.ec} : result;
     }
 
     /**
@@ -120,7 +343,7 @@ public:
      * @param other The interval to compare with
      * @return true if intervals are equal, false otherwise
      */
-    bool operator==(const IntervalNumber& other) const noexcept
+    constexpr bool operator==(const IntervalNumberT& other) const noexcept
     {
         return (getX0() == other.getX0()) && (getX1() == other.getX1());
     }
@@ -131,7 +354,7 @@ public:
      * @param other The interval to compare with
      * @return true if intervals are not equal, false otherwise
      */
-    bool operator!=(const IntervalNumber& other) const noexcept
+    constexpr bool operator!=(const IntervalNumberT& other) const noexcept
     {
         return (getX0() != other.getX0()) || (getX1() != other.getX1());
     }
@@ -144,41 +367,13 @@ public:
      *   - 0 * ∞ = [0, ∞]in (Rule I)
      *   - 0 * -∞ = [-∞, 0]in (Rule II)
      */
-    IntervalNumber operator*(const IntervalNumber& other) const noexcept
+    constexpr IntervalNumberT operator*(const IntervalNumberT& other) const noexcept
     {
-        std::set<double> results{};
-
-        for (std::size_t l = 0u; l < 2u; l++)
-        {
-            for (std::size_t r = 0u; r < 2u; r++)
-            {
-                auto result = m_interval[l] * other.m_interval[r];
-                if (!std::isnan(result))
-                {
-                    results.insert(result);
-                }
-                else
-                {
-                    if ((m_interval[l] == -INF && other.m_interval[r] == 0.0) || (m_interval[l] == 0.0 && other.m_interval[r] == -INF))
-                    {
-                        results.insert(-INF);
-                        results.insert(0.0);
-                    }
-                    if ((m_interval[l] == 0.0 && other.m_interval[r] == INF) || (m_interval[l] == INF && other.m_interval[r] == 0.0))
-                    {
-                        results.insert(0.0);
-                        results.insert(INF);
-                    }
-                }
-            }
-        }
+        T r0{};
+        T r1{};
+        multiplyBounds(m_interval[0u], m_interval[1u], other.m_interval[0u], other.m_interval[1u], r0, r1);
 
-        if (results.empty())
-        {
-            return IntervalNumber(QUIET_NAN);
-        }
-
-        return IntervalNumber(*results.begin(), *results.rbegin());
+        return IntervalNumberT(r0, r1);
     }
 
     /**
@@ -188,9 +383,9 @@ public:
      * @param x Scalar value
      * @return Resulting interval
      */
-    IntervalNumber operator*(double x) const noexcept
+    constexpr IntervalNumberT operator*(T x) const noexcept
     {
-        return *this * IntervalNumber(x);
+        return *this * IntervalNumberT(x);
     }
 
     /**
@@ -202,33 +397,13 @@ public:
      * @param other The interval to add
      * @return Resulting interval
      */
-    IntervalNumber operator+(const IntervalNumber& other) const noexcept
+    constexpr IntervalNumberT operator+(const IntervalNumberT& other) const noexcept
     {
-        std::set<double> results{};
-
-        for (std::size_t i = 0u; i < 2u; i++)
-        {
-            auto result = m_interval[i] + other.m_interval[i];
-            if (!std::isnan(result))
-            {
-                results.insert(result);
-            }
-            else
-            {
-                if ((m_interval[i] == -INF && other.m_interval[i] == INF) || (m_interval[i] == INF && other.m_interval[i] == -INF))
-                {
-                    results.insert(-INF);
-                    results.insert(INF);
-                }
-            }
-        }
+        T r0{};
+        T r1{};
+        addBounds(m_interval[0u], m_interval[1u], other.m_interval[0u], other.m_interval[1u], r0, r1);
 
-        if (results.empty())
-        {
-            return IntervalNumber(QUIET_NAN);
-        }
-
-        return IntervalNumber(*results.begin(), *results.rbegin());
+        return IntervalNumberT(r0, r1);
     }
 
     /**
@@ -238,9 +413,9 @@ public:
      * @param x Scalar value
      * @return Resulting interval
      */
-    IntervalNumber operator+(double x) const noexcept
+    constexpr IntervalNumberT operator+(T x) const noexcept
     {
-        return *this + IntervalNumber(x);
+        return *this + IntervalNumberT(x);
     }
 
     /**
@@ -253,35 +428,13 @@ public:
      * @param other The interval to subtract
      * @return Resulting interval
      */
-    IntervalNumber operator-(const IntervalNumber& other) const noexcept
+    constexpr IntervalNumberT operator-(const IntervalNumberT& other) const noexcept
     {
-        std::set<double> results{};
-
-        for (std::size_t i = 0u; i < 2u; i++)
-        {
-            auto k = (i + 1u) % 2u;
-
-            auto result = m_interval[i] - other.m_interval[k];
-            if (!std::isnan(result))
-            {
-                results.insert(result);
-            }
-            else
-            {
-                if ((m_interval[i] == INF && other.m_interval[k] == INF) || (m_interval[i] == -INF && other.m_interval[k] == -INF))
-                {
-                    results.insert(-INF);
-                    results.insert(INF);
-                }
-            }
-        }
-
-        if (results.empty())
-        {
-            return IntervalNumber(QUIET_NAN);
-        }
+        T r0{};
+        T r1{};
+        subtractBounds(m_interval[0u], m_interval[1u], other.m_interval[0u], other.m_interval[1u], r0, r1);
 
-        return IntervalNumber(*results.begin(), *results.rbegin());
+        return IntervalNumberT(r0, r1);
     }
 
     /**
@@ -291,9 +444,9 @@ public:
      * @param x Scalar value
      * @return Resulting interval
      */
-    IntervalNumber operator-(double x) const noexcept
+    constexpr IntervalNumberT operator-(T x) const noexcept
     {
-        return *this - IntervalNumber(x);
+        return *this - IntervalNumberT(x);
     }
 
     /**
@@ -314,61 +467,13 @@ public:
      * @param other The interval to divide by
      * @return Resulting interval
      */
-    IntervalNumber operator/(const IntervalNumber& other) const noexcept
+    constexpr IntervalNumberT operator/(const IntervalNumberT& other) const noexcept
     {
-        // NaN propagation
-        if (std::isnan(m_interval[0u]) || std::isnan(other.m_interval[0u]))
-        {
-            return IntervalNumber(QUIET_NAN);
-        }
-
-        const double y0 = other.m_interval[0u];
-        const double y1 = other.m_interval[1u];
+        T r0{};
+        T r1{};
+        divideBounds(m_interval[0u], m_interval[1u], other.m_interval[0u], other.m_interval[1u], r0, r1);
 
-        // Divisor is the point [0, 0]: by convention, division returns the full hull.
-        if (y0 == 0.0 && y1 == 0.0)
-        {
-            return IntervalNumber(-INF, INF);
-        }
-
-        double r_lo;
-        double r_hi;
-
-        if (y0 > 0.0)
-        {
-            // Strictly positive divisor.
-            r_lo = 1.0 / y1;
-            r_hi = 1.0 / y0;
-        }
-        else if (y1 < 0.0)
-        {
-            // Strictly negative divisor.
-            r_lo = 1.0 / y1;
-            r_hi = 1.0 / y0;
-        }
-        else if (y0 == 0.0)
-        {
-            // [0, y1] with y1 > 0; lower bound of reciprocal is 1/y1, upper is +∞.
-            r_lo = 1.0 / y1;
-            r_hi = INF;
-        }
-        else if (y1 == 0.0)
-        {
-            // [y0, 0] with y0 < 0; lower bound is -∞, upper is 1/y0 (negative).
-            r_lo = -INF;
-            r_hi = 1.0 / y0;
-        }
-        else
-        {
-            // y0 < 0 < y1: divisor strictly contains zero. The exact reciprocal
-            // is (-∞, 1/y0] ∪ [1/y1, +∞); to preserve closure within \mathcal{I}
-            // we take the convex hull, which is [-∞, +∞]. This is sound but
-            // not tight (paper §4.4, Limitation 2).
-            r_lo = -INF;
-            r_hi = INF;
-        }
-
-        return *this * IntervalNumber(r_lo, r_hi);
+        return IntervalNumberT(r0, r1);
     }
 
     /**
@@ -378,9 +483,9 @@ public:
      * @param x Scalar value
      * @return Resulting interval
      */
-    IntervalNumber operator/(double x) const noexcept
+    constexpr IntervalNumberT operator/(T x) const noexcept
     {
-        return *this / IntervalNumber(x);
+        return *this / IntervalNumberT(x);
     }
 
     /**
@@ -395,25 +500,49 @@ public:
      *
      * @return Absolute value as interval
      */
-    IntervalNumber abs() const noexcept
+    constexpr IntervalNumberT abs() const noexcept
     {
-        const double a0 = m_interval[0u];
-        const double a1 = m_interval[1u];
+        T r0{};
+        T r1{};
+        absBounds(m_interval[0u], m_interval[1u], r0, r1);
 
-        if (std::isnan(a0) || std::isnan(a1))
-        {
-            return IntervalNumber(QUIET_NAN);
-        }
+        return IntervalNumberT(r0, r1);
+    }
 
-        if (a0 >= 0.0)
-        {
-            return IntervalNumber(a0, a1);
-        }
-        if (a1 <= 0.0)
-        {
-            return IntervalNumber(-a1, -a0);
-        }
-        return IntervalNumber(0.0, std::max(-a0, a1));
+    /**
+     * Square of the interval: {x^2 : x in [x0, x1]}, the same as pown(2).
+     * Unlike *this * *this it knows both factors are equal, so a
+     * zero-spanning interval gives [0, max(x0^2, x1^2)] instead of a
+     * negative lower bound: [-1, 2] gives [0, 4], not [-2, 4].
+     *
+     * @return Resulting interval
+     */
+    constexpr IntervalNumberT sqr() const noexcept
+    {
+        T r0{};
+        T r1{};
+        sqrBounds(m_interval[0u], m_interval[1u], r0, r1);
+
+        return IntervalNumberT(r0, r1);
+    }
+
+    /**
+     * Fused multiply-add: *this * factor + addend in one kernel.
+     * Bit-identical to the two operators, including the 0·∞ and ∞-∞ rules,
+     * but the operands are checked for NaN once and no intermediate
+     * interval is formed.
+     *
+     * @param factor The interval to multiply by
+     * @param addend The interval to add to the product
+     * @return Resulting interval
+     */
+    constexpr IntervalNumberT fma(const IntervalNumberT& factor, const IntervalNumberT& addend) const noexcept
+    {
+        T r0{};
+        T r1{};
+        fmaBounds(m_interval[0u], m_interval[1u], factor.m_interval[0u], factor.m_interval[1u], addend.m_interval[0u], addend.m_interval[1u], r0, r1);
+
+        return IntervalNumberT(r0, r1);
     }
 
     /**
@@ -428,18 +557,714 @@ public:
      * 
      * General approach: compute base^exp for all combinations of interval endpoints.
      * Scalar exponents are automatically converted to single-point intervals.
+     *
+     * Point exponents take shorter paths with the same rules: an integer
+     * point [n, n]in with |n| <= POW_SQUARING_LIMIT is evaluated like
+     * pown(n), by repeated squaring, and a real point needs only the two
+     * endpoint powers, because the base is then non-negative and x^e
+     * monotone.
+     */
+    IntervalNumberT pow(const IntervalNumberT& exponent) const noexcept
+    {
+        T r0{};
+        T r1{};
+        powBounds(m_interval[0u], m_interval[1u], exponent.m_interval[0u], exponent.m_interval[1u], r0, r1);
+
+        return IntervalNumberT(r0, r1);
+    }
+
+    /**
+     * Integer power: [x0,x1]in ^ n for an integer exponent n.
+     *
+     * Agrees with pow() for the point exponent [n, n]in -- same admissible
+     * domain, indeterminate corners and even-exponent interior minimum --
+     * and is usable in constant expressions. The corners are evaluated by
+     * repeated squaring, whose rounding error grows with |n|: a few ulps up
+     * to POW_SQUARING_LIMIT, far more for large |n|, where pow() is the
+     * accurate choice.
+     *
+     * @param n Integer exponent
+     * @return Resulting interval
+     */
+    constexpr IntervalNumberT pown(long long n) const noexcept
+    {
+        T r0{};
+        T r1{};
+        pownBounds(m_interval[0u], m_interval[1u], n, r0, r1);
+
+        return IntervalNumberT(r0, r1);
+    }
+
+    /**
+     * Integer power with the exponent fixed at compile time: pown(N), with
+     * the squaring unrolled for the constant exponent.
+     *
+     * @return Resulting interval
+     */
+    template<long long N>
+    constexpr IntervalNumberT pow() const noexcept
+    {
+        T r0{};
+        T r1{};
+        pownBounds(m_interval[0u], m_interval[1u], N, r0, r1);
+
+        return IntervalNumberT(r0, r1);
+    }
+
+    /**
+     * Converts an endpoint to T, rounding toward -∞ or +∞ when it is not
+     * representable. Infinities and NaN convert unchanged; a finite value
+     * beyond the range of T becomes the largest finite value or an infinity.
+     *
+     * @param x Endpoint to convert
+     * @param down true to round toward -∞, false to round toward +∞
+     * @return The converted endpoint
+     */
+    template<typename U>
+    static T convertOutward(U x, bool down) noexcept
+    {
+        using Common = typename std::common_type<T, U>::type;
+        constexpr Common MAX = static_cast<Common>(std::numeric_limits<T>::max());
+
+        if ((x != x) || std::isinf(x))
+        {
+            return static_cast<T>(x);
+        }
+        if (static_cast<Common>(x) > MAX)
+        {
+            return down ? std::numeric_limits<T>::max() : INF;
+        }
+        if (static_cast<Common>(x) < -MAX)
+        {
+            return down ? -INF : -std::numeric_limits<T>::max();
+        }
+
+        T result = static_cast<T>(x);
+        if (down && static_cast<Common>(result) > static_cast<Common>(x))
+        {
+            result = std::nextafter(result, -INF);
+        }
+        else if (!down && static_cast<Common>(result) < static_cast<Common>(x))
+        {
+            result = std::nextafter(result, INF);
+        }
+
+        return result;
+    }
+
+    // Endpoint classes.
+    //
+    // Every endpoint is one of -∞, negative finite, zero, positive finite,
+    // +∞ or NaN. The classes are numbered in the order of the extended reals,
+    // so comparisons of endpoints with 0 and ±∞ become comparisons of class
+    // numbers, and the classes of two operands pack into one table index.
+    // A table indexed this way replaces a chain of comparisons with a single
+    // load. The branch-free kernels below do not need it; kernels whose
+    // per-corner work is expensive, such as the outward-rounded ones of
+    // RigorousIntervalNumberT, use it to skip corners.
+
+    static constexpr unsigned CLASS_NEGATIVE_INF = 0u;
+    static constexpr unsigned CLASS_NEGATIVE = 1u;
+    static constexpr unsigned CLASS_ZERO = 2u;
+    static constexpr unsigned CLASS_POSITIVE = 3u;
+    static constexpr unsigned CLASS_POSITIVE_INF = 4u;
+    static constexpr unsigned CLASS_NAN = 5u;
+    static constexpr unsigned ENDPOINT_CLASSES = 6u;
+
+    /**
+     * Classifies an endpoint without branches.
+     *
+     * @param x Endpoint
+     * @return One of the CLASS_ constants
+     */
+    static constexpr unsigned endpointClass(T x) noexcept
+    {
+        return static_cast<unsigned>(x > -INF) + static_cast<unsigned>(x >= T(0)) + static_cast<unsigned>(x > T(0)) + static_cast<unsigned>(x == INF) +
+               CLASS_NAN * static_cast<unsigned>(x != x);
+    }
+
+    /**
+     * Packs the endpoint classes of two operands into a table index below
+     * ENDPOINT_CLASSES^4. The classes of x0, x1, y0 and y1 are the base-6
+     * digits of the index, most significant first.
+     *
+     * @param x0 Lower bound of the left operand
+     * @param x1 Upper bound of the left operand
+     * @param y0 Lower bound of the right operand
+     * @param y1 Upper bound of the right operand
+     * @return The class index
+     */
+    static constexpr unsigned classIndex(T x0, T x1, T y0, T y1) noexcept
+    {
+        return ((endpointClass(x0) * ENDPOINT_CLASSES + endpointClass(x1)) * ENDPOINT_CLASSES + endpointClass(y0)) * ENDPOINT_CLASSES + endpointClass(y1);
+    }
+
+    // Entry of productCornerTable() for operands that need all four corners.
+    static constexpr unsigned char ALL_CORNERS = 0xFFu;
+
+    /**
+     * Builds the corner selection of a product for every class index of
+     * (x, y). The corners 0 to 3 are x0·y0, x0·y1, x1·y0 and x1·y1. An entry
+     * holds two 2-bit corners for the lower bound in its low nibble and two
+     * for the upper bound in its high nibble; a bound decided by one corner
+     * repeats it.
+     *
+     * With nonzero endpoints the signs alone decide which corners are
+     * extreme, as in the classical nine-case multiplication; only operands
+     * both spanning zero need two different corners per bound. A zero
+     * endpoint may form 0·∞, so its entry is ALL_CORNERS. The entry of NaN
+     * operands is 0.
+     *
+     * @return The corner selections, indexed by classIndex(x0, x1, y0, y1)
+     */
+    static constexpr std::array<unsigned char, 1296u> makeProductCornerTable() noexcept
+    {
+        // Corner pairs and the sign classes of an operand.
+        constexpr unsigned X0Y0 = 0u;
+        constexpr unsigned X0Y1 = 1u | (1u << 2u);
+        constexpr unsigned X1Y0 = 2u | (2u << 2u);
+        constexpr unsigned X1Y1 = 3u | (3u << 2u);
+        constexpr unsigned X0Y1_X1Y0 = 1u | (2u << 2u);
+        constexpr unsigned X0Y0_X1Y1 = 0u | (3u << 2u);
+        constexpr unsigned NEGATIVE = 0u;
+        constexpr unsigned SPANNING = 1u;
+        constexpr unsigned POSITIVE = 2u;
+
+        // Lower and upper bound corners, indexed by the sign classes of x and y.
+        constexpr unsigned LOWER[3u][3u] = {{X1Y1, X0Y1, X0Y1}, {X1Y0, X0Y1_X1Y0, X0Y1}, {X1Y0, X1Y0, X0Y0}};
+        constexpr unsigned UPPER[3u][3u] = {{X0Y0, X0Y0, X1Y0}, {X0Y0, X0Y0_X1Y1, X1Y1}, {X0Y1, X1Y1, X1Y1}};
+
+        std::array<unsigned char, 1296u> table{};
+        for (unsigned index = 0u; index < 1296u; index++)
+        {
+            const unsigned x0 = index / 216u;
+            const unsigned x1 = index / 36u % 6u;
+            const unsigned y0 = index / 6u % 6u;
+            const unsigned y1 = index % 6u;
+            if (x0 == CLASS_NAN || x1 == CLASS_NAN || y0 == CLASS_NAN || y1 == CLASS_NAN)
+            {
+                continue;
+            }
+            if (x0 == CLASS_ZERO || x1 == CLASS_ZERO || y0 == CLASS_ZERO || y1 == CLASS_ZERO || x0 > x1 || y0 > y1)
+            {
+                table[index] = ALL_CORNERS;
+                continue;
+            }
+
+            const unsigned x = (x1 < CLASS_ZERO) ? NEGATIVE : ((x0 > CLASS_ZERO) ? POSITIVE : SPANNING);
+            const unsigned y = (y1 < CLASS_ZERO) ? NEGATIVE : ((y0 > CLASS_ZERO) ? POSITIVE : SPANNING);
+            table[index] = static_cast<unsigned char>(LOWER[x][y] | (UPPER[x][y] << 4u));
+        }
+
+        return table;
+    }
+
+    /**
+     * Gets the corner selection of a product, built at compile time.
+     *
+     * @return The table of makeProductCornerTable()
+     */
+    static const std::array<unsigned char, 1296u>& productCornerTable() noexcept
+    {
+        static constexpr std::array<unsigned char, 1296u> TABLE = makeProductCornerTable();
+
+        return TABLE;
+    }
+
+    // Endpoint kernels.
+    //
+    // The operators above are thin wrappers around the following static
+    // functions, which work directly on endpoint values. They keep every
+    // candidate bound in registers -- no containers, no heap traffic -- and
+    // apply the indeterminate-form fixups (Rule I / Rule II for 0·∞, the hull
+    // for ∞-∞) to each candidate before it is folded into the running
+    // minimum and maximum.
+    //
+    // Candidates are folded in a fixed order and a candidate only replaces the
+    // running bound when it is strictly smaller (larger), so among equal
+    // candidates -- e.g. 0 and -0 -- the first one folded wins.
+
+    /**
+     * Folds the candidate bounds [vlo, vhi] into the running hull [lo, hi].
+     *
+     * @param lo Running lower bound
+     * @param hi Running upper bound
+     * @param vlo Candidate lower bound
+     * @param vhi Candidate upper bound
+     */
+    static constexpr void includeBounds(T& lo, T& hi, T vlo, T vhi) noexcept
+    {
+        lo = (vlo < lo) ? vlo : lo;
+        hi = (vhi > hi) ? vhi : hi;
+    }
+
+    /**
+     * Product of two endpoints as a pair of candidate bounds.
+     * Returns [a*b, a*b] for ordinary operands, [0, ∞] for 0·∞ (Rule I) and
+     * [-∞, 0] for 0·(-∞) (Rule II).
+     *
+     * @param a Left endpoint
+     * @param b Right endpoint
+     * @param lo Candidate lower bound
+     * @param hi Candidate upper bound
+     */
+    static constexpr void productBounds(T a, T b, T& lo, T& hi) noexcept
+    {
+        T p{};
+        bool zeroInf{};
+        bool positive{};
+        if (ZEROINFINITY_IS_CONSTANT_EVALUATED())
+        {
+            // A NaN result is not a constant expression: classify the
+            // operands instead of forming 0·±∞.
+            zeroInf = (a == 0.0 && (b == INF || b == -INF)) || (b == 0.0 && (a == INF || a == -INF));
+            p = zeroInf ? T(0) : a * b;
+            positive = zeroInf && (a + b) > 0.0;
+        }
+        else
+        {
+            // For non-NaN operands the product is NaN exactly for 0·±∞, and
+            // the sign of the infinite operand is then the sign of a + b.
+            p = a * b;
+            zeroInf = (p != p);
+            positive = (a + b) > 0.0;
+        }
+
+        lo = zeroInf ? (positive ? T(0) : -INF) : p;
+        hi = zeroInf ? (positive ? INF : T(0)) : p;
+    }
+
+    /**
+     * Hull of the four endpoint products of [x0,x1]in * [y0,y1]in.
+     * Operands must not be NaN.
+     *
+     * @param x0 Lower bound of the left operand
+     * @param x1 Upper bound of the left operand
+     * @param y0 Lower bound of the right operand
+     * @param y1 Upper bound of the right operand
+     * @param lo Lower bound of the product
+     * @param hi Upper bound of the product
+     */
+    static constexpr void productHull(T x0, T x1, T y0, T y1, T& lo, T& hi) noexcept
+    {
+        T clo{};
+        T chi{};
+
+        productBounds(x0, y0, lo, hi);
+        productBounds(x0, y1, clo, chi);
+        includeBounds(lo, hi, clo, chi);
+        productBounds(x1, y0, clo, chi);
+        includeBounds(lo, hi, clo, chi);
+        productBounds(x1, y1, clo, chi);
+        includeBounds(lo, hi, clo, chi);
+    }
+
+    /**
+     * Hull of the endpoint sums of [x0,x1]in + [y0,y1]in; a sum of opposite
+     * infinities contributes [-∞, ∞]. Operands must not be NaN.
+     *
+     * @param x0 Lower bound of the left operand
+     * @param x1 Upper bound of the left operand
+     * @param y0 Lower bound of the right operand
+     * @param y1 Upper bound of the right operand
+     * @param lo Lower bound of the sum
+     * @param hi Upper bound of the sum
+     */
+    static constexpr void sumHull(T x0, T x1, T y0, T y1, T& lo, T& hi) noexcept
+    {
+        // Bitwise operators keep the hull free of branches when it is
+        // inlined into the accumulation loop of batchDot().
+        const bool indeterminate0 = (x0 == -y0) & ((x0 == INF) | (x0 == -INF));
+        const bool indeterminate1 = (x1 == -y1) & ((x1 == INF) | (x1 == -INF));
+        const bool constant = ZEROINFINITY_IS_CONSTANT_EVALUATED();
+        const T s0 = (constant && indeterminate0) ? T(0) : x0 + y0;
+        const T s1 = (constant && indeterminate1) ? T(0) : x1 + y1;
+
+        lo = indeterminate0 ? -INF : s0;
+        hi = indeterminate0 ? INF : s0;
+        includeBounds(lo, hi, indeterminate1 ? -INF : s1, indeterminate1 ? INF : s1);
+    }
+
+    /**
+     * Multiplication kernel: [x0,x1]in * [y0,y1]in -> [r0,r1]in.
+     *
+     * @param x0 Lower bound of the left operand
+     * @param x1 Upper bound of the left operand
+     * @param y0 Lower bound of the right operand
+     * @param y1 Upper bound of the right operand
+     * @param r0 Lower bound of the result
+     * @param r1 Upper bound of the result
+     */
+    static constexpr void multiplyBounds(T x0, T x1, T y0, T y1, T& r0, T& r1) noexcept
+    {
+        T lo{};
+        T hi{};
+        productHull(x0, x1, y0, y1, lo, hi);
+
+        const bool isNaN = (x0 != x0) || (x1 != x1) || (y0 != y0) || (y1 != y1);
+
+        r0 = isNaN ? QUIET_NAN : lo;
+        r1 = isNaN ? QUIET_NAN : hi;
+    }
+
+    /**
+     * Addition kernel: [x0,x1]in + [y0,y1]in -> [r0,r1]in.
+     * A sum of opposite infinities contributes [-∞, ∞].
+     *
+     * @param x0 Lower bound of the left operand
+     * @param x1 Upper bound of the left operand
+     * @param y0 Lower bound of the right operand
+     * @param y1 Upper bound of the right operand
+     * @param r0 Lower bound of the result
+     * @param r1 Upper bound of the result
+     */
+    static constexpr void addBounds(T x0, T x1, T y0, T y1, T& r0, T& r1) noexcept
+    {
+        T lo{};
+        T hi{};
+        sumHull(x0, x1, y0, y1, lo, hi);
+
+        const bool isNaN = (x0 != x0) || (x1 != x1) || (y0 != y0) || (y1 != y1);
+
+        r0 = isNaN ? QUIET_NAN : lo;
+        r1 = isNaN ? QUIET_NAN : hi;
+    }
+
+    /**
+     * Subtraction kernel: [x0,x1]in - [y0,y1]in -> [r0,r1]in.
+     * A difference of equal infinities contributes [-∞, ∞].
+     *
+     * @param x0 Lower bound of the left operand
+     * @param x1 Upper bound of the left operand
+     * @param y0 Lower bound of the right operand
+     * @param y1 Upper bound of the right operand
+     * @param r0 Lower bound of the result
+     * @param r1 Upper bound of the result
+     */
+    static constexpr void subtractBounds(T x0, T x1, T y0, T y1, T& r0, T& r1) noexcept
+    {
+        const bool indeterminate0 = (x0 == y1) && (x0 == INF || x0 == -INF);
+        const bool indeterminate1 = (x1 == y0) && (x1 == INF || x1 == -INF);
+        const bool constant = ZEROINFINITY_IS_CONSTANT_EVALUATED();
+        const T d0 = (constant && indeterminate0) ? T(0) : x0 - y1;
+        const T d1 = (constant && indeterminate1) ? T(0) : x1 - y0;
+
+        T lo = indeterminate0 ? -INF : d0;
+        T hi = indeterminate0 ? INF : d0;
+        includeBounds(lo, hi, indeterminate1 ? -INF : d1, indeterminate1 ? INF : d1);
+
+        const bool isNaN = (x0 != x0) || (x1 != x1) || (y0 != y0) || (y1 != y1);
+
+        r0 = isNaN ? QUIET_NAN : lo;
+        r1 = isNaN ? QUIET_NAN : hi;
+    }
+
+    /**
+     * Division kernel: [x0,x1]in / [y0,y1]in -> [r0,r1]in.
+     * Forms the reciprocal of [y0, y1] by the case analysis documented at
+     * operator/ and multiplies it into [x0, x1]. Every case is a select, so
+     * the kernel has no data-dependent branches.
+     *
+     * @param x0 Lower bound of the dividend
+     * @param x1 Upper bound of the dividend
+     * @param y0 Lower bound of the divisor
+     * @param y1 Upper bound of the divisor
+     * @param r0 Lower bound of the result
+     * @param r1 Upper bound of the result
+     */
+    static constexpr void divideBounds(T x0, T x1, T y0, T y1, T& r0, T& r1) noexcept
+    {
+        // Divisor is the point [0, 0]: by convention, division returns the full hull.
+        const bool pointZero = (y0 == 0.0) && (y1 == 0.0);
+
+        // The reciprocal's lower bound is 1/y1 unless the divisor reaches zero
+        // from below or spans it; the upper bound is 1/y0 unless the divisor
+        // reaches zero from above or spans it. For y0 < 0 < y1 the exact
+        // reciprocal (-∞, 1/y0] ∪ [1/y1, +∞) is replaced by its convex hull
+        // [-∞, +∞], which is sound but not tight (paper §4.4, Limitation 2).
+        const bool finiteLo = (y0 >= 0.0) || (y1 < 0.0);
+        const bool finiteHi = (y1 <= 0.0) || (y0 > 0.0);
+        T q0{};
+        T q1{};
+        if (ZEROINFINITY_IS_CONSTANT_EVALUATED())
+        {
+            // Division by zero is not a constant expression.
+            q0 = (finiteLo && !pointZero) ? T(1) / y1 : -INF;
+            q1 = (finiteHi && !pointZero) ? T(1) / y0 : INF;
+        }
+        else
+        {
+            // Dividing by a signed zero yields the infinite bounds without a
+            // select on the quotient, which keeps the kernel vectorizable.
+            q0 = T(1) / (finiteLo ? y1 : T(-0.0));
+            q1 = T(1) / (finiteHi ? y0 : T(0));
+        }
+
+        T lo{};
+        T hi{};
+        multiplyBounds(x0, x1, q0, q1, lo, hi);
+
+        const bool isNaN = (x0 != x0) || (x1 != x1) || (y0 != y0) || (y1 != y1);
+
+        r0 = isNaN ? QUIET_NAN : (pointZero ? -INF : lo);
+        r1 = isNaN ? QUIET_NAN : (pointZero ? INF : hi);
+    }
+
+    /**
+     * Absolute value kernel: |[a0,a1]in| -> [r0,r1]in, by order (see abs()).
+     *
+     * @param a0 Lower bound of the operand
+     * @param a1 Upper bound of the operand
+     * @param r0 Lower bound of the result
+     * @param r1 Upper bound of the result
+     */
+    static constexpr void absBounds(T a0, T a1, T& r0, T& r1) noexcept
+    {
+        const bool nonNegative = (a0 >= 0.0);
+        const bool nonPositive = (a1 <= 0.0);
+        const T spanHi = (-a0 < a1) ? a1 : -a0;
+
+        const bool isNaN = (a0 != a0) || (a1 != a1);
+
+        r0 = isNaN ? QUIET_NAN : (nonNegative ? a0 : (nonPositive ? -a1 : T(0)));
+        r1 = isNaN ? QUIET_NAN : (nonNegative ? a1 : (nonPositive ? -a0 : spanHi));
+    }
+
+    /**
+     * Square kernel: [a0,a1]in^2 -> [r0,r1]in, the squared bounds of
+     * |[a0,a1]in|. No 0·∞ corner can arise, since both factors are equal.
+     *
+     * @param a0 Lower bound of the operand
+     * @param a1 Upper bound of the operand
+     * @param r0 Lower bound of the result
+     * @param r1 Upper bound of the result
+     */
+    static constexpr void sqrBounds(T a0, T a1, T& r0, T& r1) noexcept
+    {
+        T m0{};
+        T m1{};
+        absBounds(a0, a1, m0, m1);
+
+        r0 = m0 * m0;
+        r1 = m1 * m1;
+    }
+
+    /**
+     * Fused multiply-add kernel: [x0,x1]in * [y0,y1]in + [z0,z1]in -> [r0,r1]in.
+     * Bit-identical to multiplyBounds() followed by addBounds().
+     *
+     * @param x0 Lower bound of the left factor
+     * @param x1 Upper bound of the left factor
+     * @param y0 Lower bound of the right factor
+     * @param y1 Upper bound of the right factor
+     * @param z0 Lower bound of the addend
+     * @param z1 Upper bound of the addend
+     * @param r0 Lower bound of the result
+     * @param r1 Upper bound of the result
+     */
+    static constexpr void fmaBounds(T x0, T x1, T y0, T y1, T z0, T z1, T& r0, T& r1) noexcept
+    {
+        T p0{};
+        T p1{};
+        productHull(x0, x1, y0, y1, p0, p1);
+
+        T lo{};
+        T hi{};
+        sumHull(p0, p1, z0, z1, lo, hi);
+
+        const bool isNaN = (x0 != x0) | (x1 != x1) | (y0 != y0) | (y1 != y1) | (z0 != z0) | (z1 != z1);
+
+        r0 = isNaN ? QUIET_NAN : lo;
+        r1 = isNaN ? QUIET_NAN : hi;
+    }
+
+    /**
+     * x^n for a non-negative integer n by repeated squaring.
+     *
+     * @param x Base
+     * @param n Exponent
+     * @return x^n
      */
-    IntervalNumber pow(const IntervalNumber& exponent) const noexcept
+    static constexpr T powUnsigned(T x, unsigned long long n) noexcept
     {
-        const double bLo = m_interval[0u];
-        const double bHi = m_interval[1u];
-        const double eLo = exponent.m_interval[0u];
-        const double eHi = exponent.m_interval[1u];
+        T result = T(1);
+        while (n != 0u)
+        {
+            if ((n & 1u) != 0u)
+            {
+                result *= x;
+            }
+            n >>= 1u;
+            if (n != 0u)
+            {
+                x *= x;
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * x^n for an integer n by repeated squaring. A negative power is the
+     * reciprocal of x^|n| while that stays a normal number, and otherwise
+     * (1/x)^|n|, so powers near underflow do not overflow to a zero.
+     *
+     * @param x Base
+     * @param negative Whether the exponent is negative
+     * @param magnitude |n|
+     * @return x^n
+     */
+    static constexpr T powSigned(T x, bool negative, unsigned long long magnitude) noexcept
+    {
+        if (!negative)
+        {
+            return powUnsigned(x, magnitude);
+        }
+
+        const T power = powUnsigned(x, magnitude);
+        const bool normal = (power >= std::numeric_limits<T>::min() && power <= std::numeric_limits<T>::max()) ||
+                            (power <= -std::numeric_limits<T>::min() && power >= -std::numeric_limits<T>::max());
+
+        return normal ? T(1) / power : powUnsigned(T(1) / x, magnitude);
+    }
+
+    /**
+     * Integer power kernel: [bLo,bHi]in ^ n -> [r0,r1]in.
+     * See pown(). A base corner that overflows during squaring makes the
+     * call non-constant at compile time.
+     *
+     * @param bLo Lower bound of the base
+     * @param bHi Upper bound of the base
+     * @param n Integer exponent
+     * @param r0 Lower bound of the result
+     * @param r1 Upper bound of the result
+     */
+    static constexpr void pownBounds(T bLo, T bHi, long long n, T& r0, T& r1) noexcept
+    {
+        r0 = QUIET_NAN;
+        r1 = QUIET_NAN;
+
+        const bool baseContainsZero = (bLo <= 0.0 && bHi >= 0.0);
+
+        // NaN propagation and admissible domain (paper Def. 4.7, cases (iii)
+        // and (iv)): a negative exponent needs a base that excludes zero.
+        if ((bLo != bLo) || (bHi != bHi) || (n < 0 && baseContainsZero))
+        {
+            return;
+        }
+
+        T lo = INF;
+        T hi = -INF;
+
+        // Indeterminate corners (0, 0) and (+/-inf, 0).
+        const bool baseContainsInf = (bHi == INF) || (bLo == -INF);
+        if (n == 0 && (baseContainsZero || baseContainsInf))
+        {
+            includeBounds(lo, hi, T(0), INF);
+        }
+
+        // Corner values; the magnitude is taken before negation so that
+        // LLONG_MIN does not overflow.
+        const unsigned long long magnitude = (n < 0) ? (0ull - static_cast<unsigned long long>(n)) : static_cast<unsigned long long>(n);
+        const T cLo = powSigned(bLo, n < 0, magnitude);
+        const T cHi = powSigned(bHi, n < 0, magnitude);
+        includeBounds(lo, hi, cLo, cLo);
+        includeBounds(lo, hi, cHi, cHi);
+
+        // Interior minimum of an even positive power over a zero-spanning base.
+        if (n > 0 && (n % 2) == 0 && bLo < 0.0 && bHi > 0.0)
+        {
+            includeBounds(lo, hi, T(0), T(0));
+        }
+
+        r0 = lo;
+        r1 = hi;
+    }
+
+    /**
+     * Power kernel: [bLo,bHi]in ^ [eLo,eHi]in -> [r0,r1]in.
+     * See pow() for the admissible domain and the indeterminate corners.
+     * Integer point exponents up to POW_SQUARING_LIMIT go to pownBounds(),
+     * other finite point exponents to powPointBounds() and the rest,
+     * larger integers included, to powCornerBounds().
+     *
+     * @param bLo Lower bound of the base
+     * @param bHi Upper bound of the base
+     * @param eLo Lower bound of the exponent
+     * @param eHi Upper bound of the exponent
+     * @param r0 Lower bound of the result
+     * @param r1 Upper bound of the result
+     */
+    static void powBounds(T bLo, T bHi, T eLo, T eHi, T& r0, T& r1) noexcept
+    {
+        if (eLo == eHi && std::isfinite(eLo))
+        {
+            if (std::floor(eLo) != eLo)
+            {
+                powPointBounds(bLo, bHi, eLo, r0, r1);
+
+                return;
+            }
+            if (std::fabs(eLo) <= T(POW_SQUARING_LIMIT))
+            {
+                pownBounds(bLo, bHi, static_cast<long long>(eLo), r0, r1);
+
+                return;
+            }
+        }
+
+        powCornerBounds(bLo, bHi, eLo, eHi, r0, r1);
+    }
+
+    /**
+     * Power kernel for a finite, non-integer point exponent e. Such an
+     * exponent is admissible only for a non-negative base (paper Def. 4.7,
+     * cases (i) and (ii)), where x^e is monotone, and reaches no
+     * indeterminate corner, so the two endpoint powers bound the result.
+     * Bit-identical to powCornerBounds() for [e, e]in.
+     *
+     * @param bLo Lower bound of the base
+     * @param bHi Upper bound of the base
+     * @param e Exponent
+     * @param r0 Lower bound of the result
+     * @param r1 Upper bound of the result
+     */
+    static void powPointBounds(T bLo, T bHi, T e, T& r0, T& r1) noexcept
+    {
+        r0 = QUIET_NAN;
+        r1 = QUIET_NAN;
+
+        if ((bHi != bHi) || !(bLo > 0.0 || (bLo >= 0.0 && e >= 0.0)))
+        {
+            return;
+        }
+
+        const T cLo = std::pow(bLo, e);
+        const T cHi = std::pow(bHi, e);
+        r0 = std::min(cLo, cHi);
+        r1 = std::max(cLo, cHi);
+    }
+
+    /**
+     * Power kernel for any exponent interval: std::pow at the four corners
+     * plus the indeterminate corners and the even-power interior minimum.
+     *
+     * @param bLo Lower bound of the base
+     * @param bHi Upper bound of the base
+     * @param eLo Lower bound of the exponent
+     * @param eHi Upper bound of the exponent
+     * @param r0 Lower bound of the result
+     * @param r1 Upper bound of the result
+     */
+    static void powCornerBounds(T bLo, T bHi, T eLo, T eHi, T& r0, T& r1) noexcept
+    {
+        r0 = QUIET_NAN;
+        r1 = QUIET_NAN;
 
         // NaN propagation.
         if (std::isnan(bLo) || std::isnan(bHi) || std::isnan(eLo) || std::isnan(eHi))
         {
-            return IntervalNumber(QUIET_NAN);
+            return;
         }
 
         // Admissible domain (paper Def. 4.7). Exponentiation is partial; for
@@ -474,10 +1299,11 @@ public:
 
         if (!admissible)
         {
-            return IntervalNumber(QUIET_NAN);
+            return;
         }
 
-        std::set<double> results{};
+        T lo = INF;
+        T hi = -INF;
 
         // Value map V^ at the indeterminate-form corners reachable within
         // I x E: (0,0), (1, +/-inf) and (+/-inf, 0). Whenever such a corner
@@ -491,8 +1317,7 @@ public:
             (baseContainsOne  && expContainsInf)  ||   // (1, +/-inf)
             (baseContainsInf  && expContainsZero))     // (+/-inf, 0)
         {
-            results.insert(0.0);
-            results.insert(INF);
+            includeBounds(lo, hi, T(0), INF);
         }
 
         // Endpoint (corner) values. On the admissible domain (x, y) -> x^y is
@@ -501,14 +1326,16 @@ public:
         // minimum of an even positive-integer power over a zero-spanning base,
         // handled separately below. No corner can be NaN on the admissible
         // domain (negative bases occur only with integer exponents).
+        const T base[2u] = {bLo, bHi};
+        const T power[2u] = {eLo, eHi};
         for (std::size_t i = 0u; i < 2u; i++)
         {
             for (std::size_t j = 0u; j < 2u; j++)
             {
-                const double r = std::pow(m_interval[i], exponent.m_interval[j]);
+                const T r = std::pow(base[i], power[j]);
                 if (!std::isnan(r))
                 {
-                    results.insert(r);
+                    includeBounds(lo, hi, r, r);
                 }
             }
         }
@@ -517,21 +1344,31 @@ public:
         // base interval that strictly spans zero (paper Def. 4.7, reduction
         // to corner formulas, even-exponent case).
         if (exponentIsPointInteger && eLo > 0.0 && bLo < 0.0 && bHi > 0.0 &&
-            std::fmod(eLo, 2.0) == 0.0)
+            std::fmod(eLo, T(2)) == 0.0)
         {
-            results.insert(0.0);
+            includeBounds(lo, hi, T(0), T(0));
         }
 
-        if (results.empty())
+        if (lo <= hi)
         {
-            return IntervalNumber(QUIET_NAN);
+            r0 = lo;
+            r1 = hi;
         }
-
-        return IntervalNumber(*results.begin(), *results.rbegin());
     }
 
 };
 
+/**
+ * Interval number with double endpoints.
+ */
+using IntervalNumber = IntervalNumberT<double>;
+
+// Foundation intervals (paper §3.4): Ω = 0·∞ (Rule I), -Ω = 0·(-∞) (Rule II)
+// and the full hull Ω~ = [-∞, ∞]in taken by 0/0 and ∞-∞.
+static constexpr IntervalNumber OMEGA{0.0, INF};
+static constexpr IntervalNumber NEGATIVE_OMEGA{-INF, 0.0};
+static constexpr IntervalNumber OMEGA_TILDE{-INF, INF};
+
 /**
  * Global multiplication operator (scalar * interval).
  * 
@@ -539,9 +1376,10 @@ public:
  * @param other Interval
  * @return Resulting interval
  */
-IntervalNumber operator*(double x, const IntervalNumber& other) noexcept
+template<typename T>
+constexpr IntervalNumberT<T> operator*(typename IntervalNumberT<T>::value_type x, const IntervalNumberT<T>& other) noexcept
 {
-    return IntervalNumber(x) * other;
+    return IntervalNumberT<T>(x) * other;
 }
 
 /**
@@ -551,9 +1389,10 @@ IntervalNumber operator*(double x, const IntervalNumber& other) noexcept
  * @param other Interval
  * @return Resulting interval
  */
-IntervalNumber operator+(double x, const IntervalNumber& other) noexcept
+template<typename T>
+constexpr IntervalNumberT<T> operator+(typename IntervalNumberT<T>::value_type x, const IntervalNumberT<T>& other) noexcept
 {
-    return IntervalNumber(x) + other;
+    return IntervalNumberT<T>(x) + other;
 }
 
 /**
@@ -563,9 +1402,10 @@ IntervalNumber operator+(double x, const IntervalNumber& other) noexcept
  * @param other Interval
  * @return Resulting interval
  */
-IntervalNumber operator-(double x, const IntervalNumber& other) noexcept
+template<typename T>
+constexpr IntervalNumberT<T> operator-(typename IntervalNumberT<T>::value_type x, const IntervalNumberT<T>& other) noexcept
 {
-    return IntervalNumber(x) - other;
+    return IntervalNumberT<T>(x) - other;
 }
 
 /**
@@ -575,9 +1415,10 @@ IntervalNumber operator-(double x, const IntervalNumber& other) noexcept
  * @param other Interval
  * @return Resulting interval
  */
-IntervalNumber operator/(double x, const IntervalNumber& other) noexcept
+template<typename T>
+constexpr IntervalNumberT<T> operator/(typename IntervalNumberT<T>::value_type x, const IntervalNumberT<T>& other) noexcept
 {
-    return IntervalNumber(x) / other;
+    return IntervalNumberT<T>(x) / other;
 }
 
 /**
@@ -586,11 +1427,75 @@ IntervalNumber operator/(double x, const IntervalNumber& other) noexcept
  * @param other Interval
  * @return Absolute value as interval
  */
-IntervalNumber abs(const IntervalNumber& other) noexcept
+template<typename T>
+constexpr IntervalNumberT<T> abs(const IntervalNumberT<T>& other) noexcept
 {
     return other.abs();
 }
 
+/**
+ * Global square function.
+ *
+ * @param other Interval
+ * @return Square as interval
+ */
+template<typename T>
+constexpr IntervalNumberT<T> sqr(const IntervalNumberT<T>& other) noexcept
+{
+    return other.sqr();
+}
+
+/**
+ * Global fused multiply-add function: a * b + c.
+ *
+ * @param a Left factor
+ * @param b Right factor
+ * @param c Addend
+ * @return Resulting interval
+ */
+template<typename T>
+constexpr IntervalNumberT<T> fma(const IntervalNumberT<T>& a, const IntervalNumberT<T>& b, const IntervalNumberT<T>& c) noexcept
+{
+    return a.fma(b, c);
+}
+
+/**
+ * Dot product x[0]·y[0] + ... + x[count-1]·y[count-1].
+ *
+ * The products are summed in DOT_LANES partial sums, partial sum j taking
+ * the products j, j + DOT_LANES, j + 2·DOT_LANES, ... in order, starting
+ * from [0, 0]in. The partial sums are then added left to right. The
+ * bracketing depends only on count, and the IntervalArray overload uses the
+ * same one, so both give identical results.
+ *
+ * @param x Left operands
+ * @param y Right operands
+ * @param count Number of products
+ * @return The dot product; [0, 0]in for count 0
+ */
+template<typename T>
+constexpr IntervalNumberT<T> dot(const IntervalNumberT<T>* x, const IntervalNumberT<T>* y, std::size_t count) noexcept
+{
+    constexpr std::size_t LANES = IntervalNumberT<T>::DOT_LANES;
+
+    T lo[LANES]{};
+    T hi[LANES]{};
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        const std::size_t lane = i % LANES;
+        IntervalNumberT<T>::fmaBounds(x[i].getX0(), x[i].getX1(), y[i].getX0(), y[i].getX1(), lo[lane], hi[lane], lo[lane], hi[lane]);
+    }
+
+    T r0 = lo[0u];
+    T r1 = hi[0u];
+    for (std::size_t lane = 1u; lane < LANES; lane++)
+    {
+        IntervalNumberT<T>::addBounds(r0, r1, lo[lane], hi[lane], r0, r1);
+    }
+
+    return IntervalNumberT<T>(r0, r1);
+}
+
 /**
  * Global power function (interval ^ scalar).
  * Scalar exponent is converted to interval [exponent, exponent]in.
@@ -599,9 +1504,10 @@ IntervalNumber abs(const IntervalNumber& other) noexcept
  * @param exponent Scalar exponent
  * @return Resulting interval
  */
-IntervalNumber pow(const IntervalNumber& base, double exponent) noexcept
+template<typename T>
+IntervalNumberT<T> pow(const IntervalNumberT<T>& base, typename IntervalNumberT<T>::value_type exponent) noexcept
 {
-    return base.pow(IntervalNumber(exponent));
+    return base.pow(IntervalNumberT<T>(exponent));
 }
 
 /**
@@ -611,9 +1517,35 @@ IntervalNumber pow(const IntervalNumber& base, double exponent) noexcept
  * @param exponent Exponent interval
  * @return Resulting interval
  */
-IntervalNumber pow(const IntervalNumber& base, const IntervalNumber& exponent) noexcept
+template<typename T>
+IntervalNumberT<T> pow(const IntervalNumberT<T>& base, const IntervalNumberT<T>& exponent) noexcept
 {
     return base.pow(exponent);
 }
 
+/**
+ * Global integer power function (interval ^ integer).
+ *
+ * @param base Base interval
+ * @param n Integer exponent
+ * @return Resulting interval
+ */
+template<typename T>
+constexpr IntervalNumberT<T> pown(const IntervalNumberT<T>& base, long long n) noexcept
+{
+    return base.pown(n);
+}
+
+/**
+ * Global integer power function with a compile-time exponent, pow<N>(base).
+ *
+ * @param base Base interval
+ * @return Resulting interval
+ */
+template<long long N, typename T>
+constexpr IntervalNumberT<T> pow(const IntervalNumberT<T>& base) noexcept
+{
+    return base.template pow<N>();
+}
+
 #endif /* INTERVALNUMBER_HPP_ */
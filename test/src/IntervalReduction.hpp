@@ -0,0 +1,312 @@
+#ifndef INTERVALREDUCTION_HPP_
+#define INTERVALREDUCTION_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "IntervalArray.hpp"
+#include "IntervalNumber.hpp"
+
+// Deterministic parallel reductions.
+//
+// Interval multiplication is not associative once 0 and ∞ meet (paper §5.2:
+// (-1·0)·(-∞) = -Ω but -1·(0·(-∞)) = Ω), and neither is floating-point
+// addition. A reduction therefore depends on how its operands are
+// bracketed. The functions below take the bracketing as an explicit policy;
+// the bracketing is a function of the element count and the policy only,
+// never of the number of threads, so results are bit-identical for every
+// thread count. Threads only decide who evaluates which fixed subtree or
+// block.
+
+/**
+ * Bracketing of a reduction x[0] op x[1] op ... op x[n-1].
+ */
+class BracketingPolicy {
+
+public:
+
+    /**
+     * Bracketing shapes.
+     */
+    enum class Kind {
+        LeftFold,       // (((x0 op x1) op x2) ... ). Inherently sequential.
+        BalancedTree,   // Range [b, e) splits at b + (e - b) / 2, recursively.
+        FixedBlock      // Left fold within blocks of blockSize, then a left fold of the block results.
+    };
+
+private:
+
+    // Bracketing shape.
+    Kind m_kind{Kind::LeftFold};
+
+    // Elements per block of FixedBlock.
+    std::size_t m_blockSize{1u};
+
+    BracketingPolicy(Kind kind, std::size_t blockSize) noexcept :
+        m_kind{kind}, m_blockSize{blockSize}
+    {
+    }
+
+public:
+
+    /**
+     * Sequential left fold.
+     *
+     * @return The policy
+     */
+    static BracketingPolicy leftFold() noexcept
+    {
+        return BracketingPolicy(Kind::LeftFold, 1u);
+    }
+
+    /**
+     * Balanced binary tree, split at the midpoint of every range.
+     *
+     * @return The policy
+     */
+    static BracketingPolicy balancedTree() noexcept
+    {
+        return BracketingPolicy(Kind::BalancedTree, 1u);
+    }
+
+    /**
+     * Left fold within consecutive blocks of blockSize elements, then a left
+     * fold of the block results.
+     *
+     * @param blockSize Elements per block; 0 is treated as 1
+     * @return The policy
+     */
+    static BracketingPolicy fixedBlock(std::size_t blockSize) noexcept
+    {
+        return BracketingPolicy(Kind::FixedBlock, std::max<std::size_t>(blockSize, 1u));
+    }
+
+    /**
+     * Gets the bracketing shape.
+     *
+     * @return The shape
+     */
+    Kind kind() const noexcept
+    {
+        return m_kind;
+    }
+
+    /**
+     * Gets the block size of FixedBlock.
+     *
+     * @return Elements per block
+     */
+    std::size_t blockSize() const noexcept
+    {
+        return m_blockSize;
+    }
+
+};
+
+/**
+ * Runs f(task) for task = 0 .. tasks-1 on up to threads threads. Each thread
+ * takes a contiguous range of tasks; the calling thread takes the first.
+ *
+ * @param tasks Number of tasks
+ * @param threads Number of threads; 0 selects std::thread::hardware_concurrency()
+ * @param f Function called once per task
+ */
+template<typename Function>
+void parallelFor(std::size_t tasks, std::size_t threads, const Function& f)
+{
+    if (threads == 0u)
+    {
+        threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1u);
+    }
+    threads = std::min(threads, tasks);
+
+    auto runRange = [&](std::size_t thread) {
+        const std::size_t begin = tasks * thread / threads;
+        const std::size_t end = tasks * (thread + 1u) / threads;
+        for (std::size_t task = begin; task < end; task++)
+        {
+            f(task);
+        }
+    };
+
+    std::vector<std::thread> workers{};
+    workers.reserve(threads);
+    for (std::size_t thread = 1u; thread < threads; thread++)
+    {
+        workers.emplace_back(runRange, thread);
+    }
+    if (threads > 0u)
+    {
+        runRange(0u);
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+// Helpers of reduceProduct() and reduceSum().
+
+// Signature of the endpoint kernels, e.g. IntervalNumber::multiplyBounds.
+using ReductionKernel = void (*)(double x0, double x1, double y0, double y1, double& r0, double& r1);
+
+// Left fold of [begin, end), which must not be empty.
+inline void foldIntervals(const double* lower, const double* upper, std::size_t begin, std::size_t end, ReductionKernel kernel, double& r0, double& r1) noexcept
+{
+    r0 = lower[begin];
+    r1 = upper[begin];
+    for (std::size_t i = begin + 1u; i < end; i++)
+    {
+        kernel(r0, r1, lower[i], upper[i], r0, r1);
+    }
+}
+
+// Balanced tree over [begin, end), which must not be empty.
+inline void treeIntervals(const double* lower, const double* upper, std::size_t begin, std::size_t end, ReductionKernel kernel, double& r0, double& r1) noexcept
+{
+    if (end - begin == 1u)
+    {
+        r0 = lower[begin];
+        r1 = upper[begin];
+        return;
+    }
+
+    const std::size_t middle = begin + (end - begin) / 2u;
+    double a0{};
+    double a1{};
+    double b0{};
+    double b1{};
+    treeIntervals(lower, upper, begin, middle, kernel, a0, a1);
+    treeIntervals(lower, upper, middle, end, kernel, b0, b1);
+    kernel(a0, a1, b0, b1, r0, r1);
+}
+
+// Collects the subtrees at the given depth of the balanced tree over
+// [begin, end); ranges of a single element end the descent early.
+inline void collectSubtrees(std::size_t begin, std::size_t end, std::size_t depth, std::vector<std::size_t>& bounds)
+{
+    if (depth == 0u || end - begin == 1u)
+    {
+        bounds.push_back(end);
+        return;
+    }
+
+    const std::size_t middle = begin + (end - begin) / 2u;
+    collectSubtrees(begin, middle, depth - 1u, bounds);
+    collectSubtrees(middle, end, depth - 1u, bounds);
+}
+
+// Combines the subtree results collected by collectSubtrees() along the
+// same tree. next is the index of the next unused subtree result.
+inline void combineSubtrees(std::size_t begin, std::size_t end, std::size_t depth, const std::vector<double>& lower, const std::vector<double>& upper,
+                            std::size_t& next, ReductionKernel kernel, double& r0, double& r1) noexcept
+{
+    if (depth == 0u || end - begin == 1u)
+    {
+        r0 = lower[next];
+        r1 = upper[next];
+        next++;
+        return;
+    }
+
+    const std::size_t middle = begin + (end - begin) / 2u;
+    double a0{};
+    double a1{};
+    double b0{};
+    double b1{};
+    combineSubtrees(begin, middle, depth - 1u, lower, upper, next, kernel, a0, a1);
+    combineSubtrees(middle, end, depth - 1u, lower, upper, next, kernel, b0, b1);
+    kernel(a0, a1, b0, b1, r0, r1);
+}
+
+inline IntervalNumber reduceIntervals(const IntervalArray& x, const IntervalNumber& identity, ReductionKernel kernel, BracketingPolicy policy, std::size_t threads)
+{
+    const std::size_t count = x.size();
+    if (count == 0u)
+    {
+        return identity;
+    }
+
+    const double* lower = x.lower();
+    const double* upper = x.upper();
+    double r0{};
+    double r1{};
+
+    switch (policy.kind())
+    {
+        case BracketingPolicy::Kind::LeftFold:
+        {
+            foldIntervals(lower, upper, 0u, count, kernel, r0, r1);
+            break;
+        }
+        case BracketingPolicy::Kind::BalancedTree:
+        {
+            // Subtrees of depth 6 give up to 64 tasks for load balancing;
+            // the depth affects the distribution of work, not the tree.
+            const std::size_t depth = 6u;
+            std::vector<std::size_t> bounds{0u};
+            collectSubtrees(0u, count, depth, bounds);
+
+            const std::size_t tasks = bounds.size() - 1u;
+            std::vector<double> partialLower(tasks);
+            std::vector<double> partialUpper(tasks);
+            parallelFor(tasks, threads, [&](std::size_t task) {
+                treeIntervals(lower, upper, bounds[task], bounds[task + 1u], kernel, partialLower[task], partialUpper[task]);
+            });
+
+            std::size_t next = 0u;
+            combineSubtrees(0u, count, depth, partialLower, partialUpper, next, kernel, r0, r1);
+            break;
+        }
+        case BracketingPolicy::Kind::FixedBlock:
+        {
+            const std::size_t blockSize = policy.blockSize();
+            const std::size_t blocks = count / blockSize + ((count % blockSize != 0u) ? 1u : 0u);
+            std::vector<double> partialLower(blocks);
+            std::vector<double> partialUpper(blocks);
+            parallelFor(blocks, threads, [&](std::size_t block) {
+                const std::size_t begin = block * blockSize;
+                foldIntervals(lower, upper, begin, begin + std::min(blockSize, count - begin), kernel, partialLower[block], partialUpper[block]);
+            });
+
+            foldIntervals(partialLower.data(), partialUpper.data(), 0u, blocks, kernel, r0, r1);
+            break;
+        }
+    }
+
+    return IntervalNumber(r0, r1);
+}
+
+/**
+ * Product of all intervals, bracketed by policy.
+ * The result is bit-identical for every thread count.
+ *
+ * @param x The factors
+ * @param policy Bracketing of the product
+ * @param threads Number of threads; 0 selects std::thread::hardware_concurrency().
+ *                Ignored by BracketingPolicy::leftFold().
+ * @return The product; [1, 1]in for an empty array
+ */
+inline IntervalNumber reduceProduct(const IntervalArray& x, BracketingPolicy policy, std::size_t threads = 0u)
+{
+    return reduceIntervals(x, IntervalNumber(1.0), IntervalNumber::multiplyBounds, policy, threads);
+}
+
+/**
+ * Sum of all intervals, bracketed by policy.
+ * The result is bit-identical for every thread count.
+ *
+ * @param x The summands
+ * @param policy Bracketing of the sum
+ * @param threads Number of threads; 0 selects std::thread::hardware_concurrency().
+ *                Ignored by BracketingPolicy::leftFold().
+ * @return The sum; [0, 0]in for an empty array
+ */
+inline IntervalNumber reduceSum(const IntervalArray& x, BracketingPolicy policy, std::size_t threads = 0u)
+{
+    return reduceIntervals(x, IntervalNumber(0.0), IntervalNumber::addBounds, policy, threads);
+}
+
+#endif /* INTERVALREDUCTION_HPP_ */
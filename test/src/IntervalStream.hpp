@@ -0,0 +1,385 @@
+#ifndef INTERVALSTREAM_HPP_
+#define INTERVALSTREAM_HPP_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ExpressionTape.hpp"
+#include "IntervalArray.hpp"
+#include "IntervalText.hpp"
+
+// Streaming evaluation of a formula over text intervals.
+//
+// Each input line holds one interval per input of the tape (see
+// parseIntervalLines()), and one result line is written per input line;
+// blank lines are skipped. The work runs in a three-stage pipeline:
+//
+//     reader -> workers -> writer
+//
+// The reader cuts the input into chunks of whole lines. The workers parse
+// a chunk, evaluate the tape over it and format the results. Parsing and
+// formatting cost far more than reading, so they run on the workers and
+// scale with them. The writer writes the chunks in input order. At most
+// chunksInFlight chunks exist at once: the reader waits for the writer
+// before it reads another, and a line longer than maxLineLength is an
+// error, so memory stays bounded for unbounded input. The output does not
+// depend on the number of workers.
+
+// Default bytes of input per chunk, rounded to whole lines.
+static constexpr std::size_t INTERVAL_STREAM_CHUNK = 1u << 20u;
+
+// Default longest input line in bytes, without the line feed.
+static constexpr std::size_t INTERVAL_STREAM_MAX_LINE = 1u << 20u;
+
+/**
+ * Options of evaluateIntervalStream().
+ */
+struct IntervalStreamOptions
+{
+    IntervalTextFormat format{IntervalTextFormat::Csv};     // Input and output format.
+    std::size_t threads{0u};                                // Workers; 0 selects std::thread::hardware_concurrency().
+    std::size_t chunkSize{INTERVAL_STREAM_CHUNK};           // Bytes of input per chunk.
+    std::size_t chunksInFlight{0u};                         // Chunks held at once; 0 selects twice the workers.
+    std::size_t maxLineLength{INTERVAL_STREAM_MAX_LINE};    // Longest input line in bytes.
+    bool detachReader{false};                               // On an error, do not wait for a reader blocked on input.
+};
+
+/**
+ * Three-stage pipeline of evaluateIntervalStream(). It is owned by a
+ * std::shared_ptr, so a detached reader can keep it alive.
+ */
+class IntervalStreamPipeline : public std::enable_shared_from_this<IntervalStreamPipeline> {
+
+private:
+
+    /**
+     * Chunk of lines on its way through the pipeline.
+     */
+    struct Chunk
+    {
+        std::string input{};
+        std::string output{};
+        std::size_t firstLine{0u};      // Line number of the first line, from 1.
+        std::size_t invalidLine{0u};    // Line number of the first invalid line; 0 if none.
+        std::size_t longLine{0u};       // Line number of a too long line after the input; 0 if none.
+        bool done{false};
+    };
+
+    const ExpressionTape& m_tape;
+    IntervalStreamOptions m_options;
+    std::FILE* m_input;
+    std::FILE* m_output;
+
+    // Ring of chunksInFlight slots; chunk i is in slot i % size.
+    std::vector<Chunk> m_chunks{};
+
+    std::mutex m_mutex{};
+    std::condition_variable m_slotFree{};
+    std::condition_variable m_workReady{};
+    std::condition_variable m_chunkDone{};
+
+    // Chunks read, chunks written, and chunks waiting for a worker.
+    std::size_t m_read{0u};
+    std::size_t m_written{0u};
+    std::deque<std::size_t> m_work{};
+
+    // The reader has read the whole input.
+    bool m_endOfInput{false};
+
+    // First error; stops every stage.
+    std::string m_error{};
+
+    void stop(const std::string& error)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_error = m_error.empty() ? error : m_error;
+        m_slotFree.notify_all();
+        m_workReady.notify_all();
+        m_chunkDone.notify_all();
+    }
+
+    // Cuts the input into chunks of whole lines. A line longer than
+    // maxLineLength ends the input; the chunk of the lines before it carries
+    // its number, so the writer reports it in order.
+    void read()
+    {
+        std::string pending{};
+        std::size_t line = 1u;
+        bool endOfFile = false;
+        bool longLine = false;
+
+        while (!longLine)
+        {
+            // Cuts after the last line feed within the chunk size, else after
+            // the first one; at the end of the input, after the rest.
+            std::size_t cut = std::string::npos;
+            if (endOfFile || pending.size() >= m_options.chunkSize)
+            {
+                cut = pending.rfind('\n', m_options.chunkSize - 1u);
+                cut = (cut != std::string::npos) ? cut : pending.find('\n');
+                cut = (cut != std::string::npos) ? cut + 1u : (endOfFile ? pending.size() : std::string::npos);
+
+                // A line without a line feed is not read beyond the limit.
+                cut = (cut == std::string::npos && pending.size() > m_options.maxLineLength) ? pending.size() : cut;
+            }
+            if (cut == std::string::npos)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (!m_error.empty())
+                    {
+                        return;
+                    }
+                }
+                const std::size_t size = pending.size();
+                pending.resize(size + m_options.chunkSize);
+                const std::size_t length = std::fread(&pending[size], 1u, m_options.chunkSize, m_input);
+                pending.resize(size + length);
+                if (length < m_options.chunkSize)
+                {
+                    if (std::ferror(m_input))
+                    {
+                        stop("cannot read the input");
+                        return;
+                    }
+                    endOfFile = true;
+                }
+                continue;
+            }
+            if (cut == 0u)
+            {
+                break;
+            }
+
+            std::size_t lines = 0u;
+            for (std::size_t begin = 0u; begin < cut; lines++)
+            {
+                const std::size_t end = std::min(pending.find('\n', begin), cut);
+                if (end - begin > m_options.maxLineLength)
+                {
+                    longLine = true;
+                    cut = begin;
+                    break;
+                }
+                begin = end + 1u;
+            }
+            lines -= (!longLine && pending[cut - 1u] != '\n') ? 1u : 0u;
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_slotFree.wait(lock, [this] { return !m_error.empty() || m_read - m_written < m_chunks.size(); });
+            if (!m_error.empty())
+            {
+                return;
+            }
+            Chunk& chunk = m_chunks[m_read % m_chunks.size()];
+            lock.unlock();
+
+            chunk.input.assign(pending, 0u, cut);
+            chunk.output.clear();
+            chunk.firstLine = line;
+            chunk.invalidLine = 0u;
+            chunk.longLine = longLine ? line + lines : 0u;
+            chunk.done = false;
+            line += lines;
+            pending.erase(0u, cut);
+
+            lock.lock();
+            m_work.push_back(m_read++);
+            m_workReady.notify_one();
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_endOfInput = true;
+        m_workReady.notify_all();
+        m_chunkDone.notify_all();
+    }
+
+    // Parses, evaluates and formats chunks.
+    void compute()
+    {
+        const std::size_t width = m_tape.inputs();
+        std::vector<std::vector<double>> lower(width);
+        std::vector<std::vector<double>> upper(width);
+        std::vector<IntervalArray> inputs(width);
+        IntervalArray result{};
+
+        while (true)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workReady.wait(lock, [this] { return !m_error.empty() || !m_work.empty() || m_endOfInput; });
+            if (!m_error.empty() || m_work.empty())
+            {
+                return;
+            }
+            Chunk& chunk = m_chunks[m_work.front() % m_chunks.size()];
+            m_work.pop_front();
+            lock.unlock();
+
+            for (std::size_t k = 0u; k < width; k++)
+            {
+                lower[k].clear();
+                upper[k].clear();
+            }
+            const char* first = chunk.input.data();
+            const char* invalid = nullptr;
+            if (parseIntervalLines(first, first + chunk.input.size(), m_options.format, width, lower.data(), upper.data(), &invalid))
+            {
+                for (std::size_t k = 0u; k < width; k++)
+                {
+                    inputs[k].resize(lower[k].size());
+                    std::copy(lower[k].begin(), lower[k].end(), inputs[k].lower());
+                    std::copy(upper[k].begin(), upper[k].end(), inputs[k].upper());
+                }
+                m_tape.evaluate(inputs, result);
+
+                chunk.output.resize(result.size() * INTERVAL_TEXT_LINE_LENGTH);
+                char* p = &chunk.output[0];
+                for (std::size_t i = 0u; i < result.size(); i++)
+                {
+                    p = formatIntervalLine(p, result.lower()[i], result.upper()[i], m_options.format);
+                }
+                chunk.output.resize(static_cast<std::size_t>(p - chunk.output.data()));
+            }
+            else
+            {
+                chunk.invalidLine = chunk.firstLine + static_cast<std::size_t>(std::count(first, invalid, '\n'));
+            }
+
+            lock.lock();
+            chunk.done = true;
+            m_chunkDone.notify_all();
+        }
+    }
+
+    // Writes the chunks in input order.
+    void write()
+    {
+        while (true)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_chunkDone.wait(lock, [this] {
+                return !m_error.empty() || (m_written < m_read && m_chunks[m_written % m_chunks.size()].done) || (m_endOfInput && m_written == m_read);
+            });
+            if (!m_error.empty() || m_written == m_read)
+            {
+                return;
+            }
+            Chunk& chunk = m_chunks[m_written % m_chunks.size()];
+            lock.unlock();
+
+            if (chunk.invalidLine != 0u)
+            {
+                stop("invalid intervals in line " + std::to_string(chunk.invalidLine));
+                return;
+            }
+            if (std::fwrite(chunk.output.data(), 1u, chunk.output.size(), m_output) != chunk.output.size())
+            {
+                stop("cannot write the output");
+                return;
+            }
+            if (chunk.longLine != 0u)
+            {
+                stop("line " + std::to_string(chunk.longLine) + " is longer than " + std::to_string(m_options.maxLineLength) + " bytes");
+                return;
+            }
+
+            lock.lock();
+            m_written++;
+            m_slotFree.notify_one();
+        }
+    }
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param tape The formula
+     * @param input Input text
+     * @param output Output text
+     * @param options Options
+     */
+    IntervalStreamPipeline(const ExpressionTape& tape, std::FILE* input, std::FILE* output, const IntervalStreamOptions& options) :
+        m_tape{tape}, m_options{options}, m_input{input}, m_output{output}
+    {
+        m_options.chunkSize = std::max<std::size_t>(m_options.chunkSize, 1u);
+        m_options.maxLineLength = std::max<std::size_t>(m_options.maxLineLength, 1u);
+    }
+
+    /**
+     * Runs the pipeline until the input ends or an error occurs. The
+     * calling thread is the writer. With detachReader, an error returns
+     * without waiting for the reader, which may be blocked on input.
+     *
+     * @param error Description of the first error
+     * @return false on a read, parse or write error
+     */
+    bool run(std::string& error)
+    {
+        std::size_t workers = (m_options.threads == 0u) ? std::max<std::size_t>(std::thread::hardware_concurrency(), 1u) : m_options.threads;
+        const std::size_t slots = (m_options.chunksInFlight == 0u) ? 2u * workers : m_options.chunksInFlight;
+        workers = std::min(workers, slots);
+        m_chunks.resize(slots);
+
+        std::thread reader([self = shared_from_this()] { self->read(); });
+        std::vector<std::thread> computers{};
+        computers.reserve(workers);
+        for (std::size_t i = 0u; i < workers; i++)
+        {
+            computers.emplace_back(&IntervalStreamPipeline::compute, this);
+        }
+        write();
+
+        for (auto& computer : computers)
+        {
+            computer.join();
+        }
+        std::unique_lock<std::mutex> lock(m_mutex);
+        error = m_error;
+        lock.unlock();
+        if (m_options.detachReader && !error.empty())
+        {
+            reader.detach();
+        }
+        else
+        {
+            reader.join();
+            error = m_error;
+        }
+
+        return error.empty() && (std::fflush(m_output) == 0);
+    }
+
+};
+
+/**
+ * Evaluates a formula over every line of a text stream and writes one
+ * result interval per line.
+ *
+ * @param tape The formula
+ * @param input Input text, one interval per input of the tape per line.
+ *              With options.detachReader it must stay open after an error,
+ *              until the program exits
+ * @param output Output text, one interval per line
+ * @param options Options
+ * @param error Description of the first error, with the line number for
+ *              invalid input and for a line longer than
+ *              options.maxLineLength
+ * @return false on a read, parse or write error
+ */
+inline bool evaluateIntervalStream(const ExpressionTape& tape, std::FILE* input, std::FILE* output, const IntervalStreamOptions& options, std::string& error)
+{
+    const auto pipeline = std::make_shared<IntervalStreamPipeline>(tape, input, output, options);
+
+    return pipeline->run(error);
+}
+
+#endif /* INTERVALSTREAM_HPP_ */
@@ -0,0 +1,426 @@
+#ifndef INTERVALTEXT_HPP_
+#define INTERVALTEXT_HPP_
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "IntervalArray.hpp"
+#include "IntervalNumber.hpp"
+#include "IntervalReduction.hpp"
+
+// Text interval datasets, one interval per line.
+//
+//     CSV:     x0,x1
+//     NDJSON:  [x0,x1]
+//
+// Endpoints are written like IntervalNumber::endpointToChars(): the
+// shortest decimal that reads back to the same double, so a written file
+// reads back bit for bit. JSON has no infinities or NaN, so NDJSON writes
+// them as the strings "inf", "-inf" and "nan", and reads these strings,
+// bare inf and nan, and null as NaN. A CSV line with a single field is a
+// point interval. Blank lines and a '\r' before the line feed are
+// accepted; a header line is not. parseIntervalLines() also reads several
+// intervals per line, x0,x1,y0,y1 or [x0,x1,y0,y1], one per column.
+//
+// Formatting and parsing work on independent chunks of lines on several
+// threads with std::to_chars and std::from_chars, which neither allocate
+// nor depend on the locale. The chunks are joined in order, so the text
+// and the intervals do not depend on the number of threads. Nothing
+// throws: failures are reported by the return values.
+
+/**
+ * Text formats of interval datasets.
+ */
+enum class IntervalTextFormat {
+    Csv,
+    Ndjson
+};
+
+// Intervals formatted by one task.
+static constexpr std::size_t INTERVAL_TEXT_CHUNK = 16384u;
+
+// Bytes of text parsed by one task, rounded to whole lines.
+static constexpr std::size_t INTERVAL_TEXT_SEGMENT = 1u << 20u;
+
+// Maximum length of a line, including the quotes of non-finite NDJSON
+// endpoints and the line feed.
+static constexpr std::size_t INTERVAL_TEXT_LINE_LENGTH = 2u * IntervalNumber::ENDPOINT_TEXT_LENGTH + 8u;
+
+/**
+ * Writes an endpoint, quoted if quoteNonFinite is set and it is not finite.
+ * The buffer must hold ENDPOINT_TEXT_LENGTH + 2 characters.
+ *
+ * @param p Start of the buffer
+ * @param x The endpoint
+ * @param quoteNonFinite Quote ±∞ and NaN
+ * @return One past the last character written
+ */
+inline char* formatIntervalEndpoint(char* p, double x, bool quoteNonFinite) noexcept
+{
+    const bool quote = quoteNonFinite && !std::isfinite(x);
+
+    // Writes the quotes without a branch; an unquoted one is overwritten.
+    *p = '"';
+    p += quote;
+    p = IntervalNumber::endpointToChars(p, p + IntervalNumber::ENDPOINT_TEXT_LENGTH, x).ptr;
+    *p = '"';
+    p += quote;
+
+    return p;
+}
+
+/**
+ * Writes one line. The buffer must hold INTERVAL_TEXT_LINE_LENGTH
+ * characters.
+ *
+ * @param p Start of the buffer
+ * @param x0 Lower bound
+ * @param x1 Upper bound
+ * @param format Text format
+ * @return One past the line feed
+ */
+inline char* formatIntervalLine(char* p, double x0, double x1, IntervalTextFormat format) noexcept
+{
+    const bool json = (format == IntervalTextFormat::Ndjson);
+
+    *p = '[';
+    p += json;
+    p = formatIntervalEndpoint(p, x0, json);
+    *p++ = ',';
+    p = formatIntervalEndpoint(p, x1, json);
+    *p = ']';
+    p += json;
+    *p++ = '\n';
+
+    return p;
+}
+
+/**
+ * Formats intervals in chunks of INTERVAL_TEXT_CHUNK, one chunk per task.
+ *
+ * @param lower count lower bounds
+ * @param upper count upper bounds
+ * @param count Number of intervals
+ * @param format Text format
+ * @param threads Number of threads; 0 selects std::thread::hardware_concurrency()
+ * @param chunks The text of each chunk
+ */
+inline void formatIntervalChunks(const double* lower, const double* upper, std::size_t count, IntervalTextFormat format, std::size_t threads,
+                                 std::vector<std::string>& chunks)
+{
+    chunks.resize((count + INTERVAL_TEXT_CHUNK - 1u) / INTERVAL_TEXT_CHUNK);
+
+    parallelFor(chunks.size(), threads, [&](std::size_t chunk) {
+        const std::size_t begin = chunk * INTERVAL_TEXT_CHUNK;
+        const std::size_t end = std::min(begin + INTERVAL_TEXT_CHUNK, count);
+        std::string& text = chunks[chunk];
+
+        text.resize((end - begin) * INTERVAL_TEXT_LINE_LENGTH);
+        char* p = &text[0];
+        for (std::size_t i = begin; i < end; i++)
+        {
+            p = formatIntervalLine(p, lower[i], upper[i], format);
+        }
+        text.resize(static_cast<std::size_t>(p - text.data()));
+    });
+}
+
+/**
+ * Formats an array of intervals, one line per interval.
+ *
+ * @param x The intervals
+ * @param format Text format
+ * @param text The text; replaced
+ * @param threads Number of threads; 0 selects std::thread::hardware_concurrency()
+ */
+inline void formatIntervals(const IntervalArray& x, IntervalTextFormat format, std::string& text, std::size_t threads = 0u)
+{
+    std::vector<std::string> chunks{};
+    formatIntervalChunks(x.lower(), x.upper(), x.size(), format, threads, chunks);
+
+    std::size_t length = 0u;
+    for (const auto& chunk : chunks)
+    {
+        length += chunk.size();
+    }
+    text.clear();
+    text.reserve(length);
+    for (const auto& chunk : chunks)
+    {
+        text += chunk;
+    }
+}
+
+/**
+ * Reads an endpoint of a line.
+ *
+ * @param p Start of the endpoint
+ * @param last End of the text
+ * @param format Text format
+ * @param x The endpoint read
+ * @return One past the endpoint, or nullptr on failure
+ */
+inline const char* parseIntervalEndpoint(const char* p, const char* last, IntervalTextFormat format, double& x) noexcept
+{
+    if (format == IntervalTextFormat::Ndjson && p != last)
+    {
+        if (*p == '"')
+        {
+            const std::from_chars_result read = IntervalNumber::endpointFromChars(p + 1, last, x);
+
+            return (read.ec == std::errc{} && read.ptr != last && *read.ptr == '"') ? read.ptr + 1 : nullptr;
+        }
+        if (last - p >= 4 && std::memcmp(p, "null", 4u) == 0)
+        {
+            x = QUIET_NAN;
+
+            return p + 4;
+        }
+    }
+    const std::from_chars_result read = IntervalNumber::endpointFromChars(p, last, x);
+
+    return (read.ec == std::errc{}) ? read.ptr : nullptr;
+}
+
+/**
+ * Skips spaces and tabs.
+ *
+ * @param p Start of the text
+ * @param last End of the text
+ * @return The first other character, or last
+ */
+inline const char* skipIntervalTextBlanks(const char* p, const char* last) noexcept
+{
+    while (p != last && (*p == ' ' || *p == '\t'))
+    {
+        p++;
+    }
+
+    return p;
+}
+
+/**
+ * Parses whole lines and appends the intervals. A line holds width
+ * intervals, x0,x1,y0,y1,... in CSV and [x0,x1,y0,y1,...] in NDJSON; a
+ * CSV line with width fields holds point intervals.
+ *
+ * @param first Start of the first line
+ * @param last End of the last line
+ * @param format Text format
+ * @param width Intervals per line
+ * @param lower width arrays of lower bounds, one per column; appended to
+ * @param upper width arrays of upper bounds, one per column; appended to
+ * @param invalidLine Start of the first invalid line on failure, if not nullptr
+ * @return false at the first invalid line
+ */
+inline bool parseIntervalLines(const char* first, const char* last, IntervalTextFormat format, std::size_t width, std::vector<double>* lower,
+                               std::vector<double>* upper, const char** invalidLine = nullptr)
+{
+    const bool json = (format == IntervalTextFormat::Ndjson);
+    std::vector<double> fields(2u * width);
+    const char* p = first;
+
+    while (p != last)
+    {
+        const char* line = p;
+        p = skipIntervalTextBlanks(p, last);
+        const bool blank = (p == last) || (*p == '\n') || (*p == '\r');
+
+        if (!blank)
+        {
+            // Fields up to the end of the line or the closing bracket.
+            std::size_t count = 0u;
+            bool good = !json || (*p == '[');
+            p = skipIntervalTextBlanks(p + json, last);
+            while (good)
+            {
+                double x{};
+                p = parseIntervalEndpoint(p, last, format, x);
+                good = (p != nullptr) && (count < fields.size());
+                if (good)
+                {
+                    fields[count++] = x;
+                    p = skipIntervalTextBlanks(p, last);
+                    if (p == last || *p != ',')
+                    {
+                        break;
+                    }
+                    p = skipIntervalTextBlanks(p + 1, last);
+                }
+            }
+            if (good && json)
+            {
+                good = (p != last && *p == ']');
+                p = good ? skipIntervalTextBlanks(p + 1, last) : p;
+            }
+            good = good && ((count == 2u * width) || (!json && count == width));
+            if (!good)
+            {
+                if (invalidLine != nullptr)
+                {
+                    *invalidLine = line;
+                }
+                return false;
+            }
+
+            const bool points = (count == width);
+            for (std::size_t k = 0u; k < width; k++)
+            {
+                const IntervalNumber interval = points ? IntervalNumber(fields[k]) : IntervalNumber(fields[2u * k], fields[2u * k + 1u]);
+                lower[k].push_back(interval.getX0());
+                upper[k].push_back(interval.getX1());
+            }
+        }
+
+        p = (p != last && *p == '\r') ? p + 1 : p;
+        if (p != last)
+        {
+            if (*p != '\n')
+            {
+                if (invalidLine != nullptr)
+                {
+                    *invalidLine = line;
+                }
+                return false;
+            }
+            p++;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Parses text with one interval per line. The text is split into segments
+ * of about INTERVAL_TEXT_SEGMENT bytes at line feeds, which are parsed
+ * concurrently.
+ *
+ * @param first Start of the text
+ * @param last End of the text
+ * @param format Text format
+ * @param result The intervals; empty on failure
+ * @param threads Number of threads; 0 selects std::thread::hardware_concurrency()
+ * @return false if a line is invalid
+ */
+inline bool parseIntervals(const char* first, const char* last, IntervalTextFormat format, IntervalArray& result, std::size_t threads = 0u)
+{
+    const std::size_t length = static_cast<std::size_t>(last - first);
+    const std::size_t segments = std::max<std::size_t>((length + INTERVAL_TEXT_SEGMENT - 1u) / INTERVAL_TEXT_SEGMENT, 1u);
+
+    // Segment s is [bounds[s], bounds[s + 1]); each bound but the first and
+    // the last follows a line feed.
+    std::vector<const char*> bounds(segments + 1u, last);
+    bounds[0u] = first;
+    for (std::size_t s = 1u; s < segments; s++)
+    {
+        const char* start = std::max(first + length * s / segments, bounds[s - 1u]);
+        const void* feed = (start != last) ? std::memchr(start, '\n', static_cast<std::size_t>(last - start)) : nullptr;
+        bounds[s] = (feed != nullptr) ? static_cast<const char*>(feed) + 1 : last;
+    }
+
+    std::vector<std::vector<double>> lower(segments);
+    std::vector<std::vector<double>> upper(segments);
+    std::vector<char> good(segments, 0);
+    parallelFor(segments, threads, [&](std::size_t s) {
+        // Shortest possible line "0,0\n".
+        lower[s].reserve(static_cast<std::size_t>(bounds[s + 1u] - bounds[s]) / 16u);
+        upper[s].reserve(lower[s].capacity());
+        good[s] = parseIntervalLines(bounds[s], bounds[s + 1u], format, 1u, &lower[s], &upper[s]);
+    });
+
+    std::vector<std::size_t> offsets(segments + 1u, 0u);
+    for (std::size_t s = 0u; s < segments; s++)
+    {
+        if (!good[s])
+        {
+            result.resize(0u);
+
+            return false;
+        }
+        offsets[s + 1u] = offsets[s] + lower[s].size();
+    }
+
+    result.resize(offsets[segments]);
+    parallelFor(segments, threads, [&](std::size_t s) {
+        std::copy(lower[s].begin(), lower[s].end(), result.lower() + offsets[s]);
+        std::copy(upper[s].begin(), upper[s].end(), result.upper() + offsets[s]);
+    });
+
+    return true;
+}
+
+/**
+ * Writes an array of intervals to a text file.
+ *
+ * @param path Path of the file; created or truncated
+ * @param x The intervals
+ * @param format Text format
+ * @param threads Number of threads; 0 selects std::thread::hardware_concurrency()
+ * @return true on success
+ */
+inline bool writeIntervalText(const char* path, const IntervalArray& x, IntervalTextFormat format, std::size_t threads = 0u)
+{
+    std::FILE* file = std::fopen(path, "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    // Formats and writes groups of chunks, so the text of the whole array
+    // is never held in memory at once.
+    const std::size_t group = 64u * INTERVAL_TEXT_CHUNK;
+    std::vector<std::string> chunks{};
+    bool good = true;
+    for (std::size_t begin = 0u; good && begin < x.size(); begin += group)
+    {
+        formatIntervalChunks(x.lower() + begin, x.upper() + begin, std::min(group, x.size() - begin), format, threads, chunks);
+        for (const auto& chunk : chunks)
+        {
+            good = good && (std::fwrite(chunk.data(), 1u, chunk.size(), file) == chunk.size());
+        }
+    }
+
+    return (std::fclose(file) == 0) && good;
+}
+
+/**
+ * Reads a text file with one interval per line.
+ *
+ * @param path Path of the file
+ * @param result The intervals; empty on failure
+ * @param format Text format
+ * @param threads Number of threads; 0 selects std::thread::hardware_concurrency()
+ * @return false if the file cannot be read or a line is invalid
+ */
+inline bool readIntervalText(const char* path, IntervalArray& result, IntervalTextFormat format, std::size_t threads = 0u)
+{
+    result.resize(0u);
+
+    std::FILE* file = std::fopen(path, "rb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    std::vector<char> text{};
+    bool good = (std::fseek(file, 0L, SEEK_END) == 0);
+    const long size = good ? std::ftell(file) : -1L;
+    good = good && (size >= 0L) && (std::fseek(file, 0L, SEEK_SET) == 0);
+    if (good)
+    {
+        text.resize(static_cast<std::size_t>(size));
+        good = (std::fread(text.data(), 1u, text.size(), file) == text.size());
+    }
+    std::fclose(file);
+
+    return good && parseIntervals(text.data(), text.data() + text.size(), format, result, threads);
+}
+
+#endif /* INTERVALTEXT_HPP_ */
@@ -0,0 +1,829 @@
+#ifndef INTERVALTRANSCENDENTAL_HPP_
+#define INTERVALTRANSCENDENTAL_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "IntervalArray.hpp"
+#include "IntervalNumber.hpp"
+
+// Elementary functions of intervals: exp, log, sqrt, sin, cos, atan, tanh.
+//
+// Every function encloses the exact range of the function over the interval
+// on the extended reals. Monotone functions take their limits at infinite
+// endpoints: exp(-∞) = 0, log(0) = -∞, atan(±∞) = ±π/2, tanh(±∞) = ±1.
+// sin and cos have no limit at ±∞, so any infinite endpoint gives [-1, 1].
+// log and sqrt are partial; an interval reaching below zero is outside their
+// domain and, as for pow(), the result is NaN. NaN propagates.
+//
+// The IntervalNumberT functions evaluate the endpoints with libm and move
+// each inexact result TRANSCENDENTAL_LIBM_ULPS outward, twice the largest
+// error glibc documents for these functions (two ulps, for tanh). Exact
+// results -- exp(0) = 1, log(1) = 0, sin(0) = 0, the limits at ±∞, sqrt of
+// a perfect square -- are not widened.
+//
+// The batch functions work on endpoint arrays without libm calls. The
+// kernels are branch-free polynomials on a reduced argument, so the loops
+// are vectorized like the arithmetic kernels. Each endpoint is widened by
+// TRANSCENDENTAL_ERROR relative to the result plus the smallest subnormal,
+// at least four times the rounding and truncation error of the kernel.
+// sin and cos reduce arguments up to TRANSCENDENTAL_SIN_LIMIT; beyond it the
+// batch result is [-1, 1]. sqrt uses the correctly rounded square root
+// instruction instead; with errno semantics GCC does not vectorize it, but
+// it is still faster than a polynomial.
+
+// Outward steps of a libm result in the scalar functions.
+static constexpr int TRANSCENDENTAL_LIBM_ULPS = 4;
+
+// Relative error bound of the batch kernels.
+static constexpr double TRANSCENDENTAL_ERROR = 0x1p-48;
+
+// Largest |x| reduced by the batch sin and cos kernels.
+static constexpr double TRANSCENDENTAL_SIN_LIMIT = 0x1p20;
+
+// Helpers of the scalar functions.
+
+/**
+ * Moves an endpoint TRANSCENDENTAL_LIBM_ULPS outward unless it is exact.
+ *
+ * @param r Endpoint as returned by libm
+ * @param exact true if r is the exact value
+ * @param down true for a lower bound
+ * @return The widened endpoint
+ */
+template<typename T>
+T transcendentalOutward(T r, bool exact, bool down) noexcept
+{
+    if (exact)
+    {
+        return r;
+    }
+
+    const T direction = down ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+    for (int i = 0; i < TRANSCENDENTAL_LIBM_ULPS; i++)
+    {
+        r = std::nextafter(r, direction);
+    }
+
+    return r;
+}
+
+/**
+ * Range of sin (first = 1) or cos (first = 0) over [x0, x1]. The extrema lie
+ * at jπ/2: maxima at j ≡ first, minima at j ≡ first + 2 (mod 4). Every j that
+ * may be in the interval counts, so a rounding error can only widen the
+ * result.
+ */
+template<typename T, typename Function>
+IntervalNumberT<T> transcendentalPeriodic(const IntervalNumberT<T>& x, const Function& f, T first) noexcept
+{
+    constexpr T HALF_PI = T(1.5707963267948966192313216916397514L);
+    constexpr T EPSILON = std::numeric_limits<T>::epsilon();
+
+    const T x0 = x.getX0();
+    const T x1 = x.getX1();
+    if (x0 != x0)
+    {
+        return x;
+    }
+    if (!std::isfinite(x0) || !std::isfinite(x1))
+    {
+        return IntervalNumberT<T>(T(-1), T(1));
+    }
+
+    const T t0 = x0 / HALF_PI;
+    const T t1 = x1 / HALF_PI;
+    const T jMin = std::ceil(t0 - T(8) * EPSILON * (T(1) + std::fabs(t0)));
+    const T jMax = std::floor(t1 + T(8) * EPSILON * (T(1) + std::fabs(t1)));
+
+    // First j >= jMin with j ≡ residue (mod 4).
+    auto contains = [&](T residue) {
+        T offset = std::fmod(residue - jMin, T(4));
+        offset = (offset < T(0)) ? offset + T(4) : offset;
+        return jMin + offset <= jMax;
+    };
+    const bool full = (jMax - jMin >= T(3));
+    const bool hasMaximum = full || contains(first);
+    const bool hasMinimum = full || contains(first + T(2));
+
+    const T v0 = f(x0);
+    const T v1 = f(x1);
+    const bool exact0 = (x0 == T(0));
+    const bool exact1 = (x1 == T(0));
+    T lo = std::min(transcendentalOutward(v0, exact0, true), transcendentalOutward(v1, exact1, true));
+    T hi = std::max(transcendentalOutward(v0, exact0, false), transcendentalOutward(v1, exact1, false));
+    lo = hasMinimum ? T(-1) : std::max(lo, T(-1));
+    hi = hasMaximum ? T(1) : std::min(hi, T(1));
+
+    return IntervalNumberT<T>(lo, hi);
+}
+
+/**
+ * Exponential: [exp(x0), exp(x1)]in, with exp(-∞) = 0 and exp(∞) = ∞.
+ *
+ * @param x Exponent
+ * @return Enclosure of exp over x
+ */
+template<typename T>
+IntervalNumberT<T> exp(const IntervalNumberT<T>& x) noexcept
+{
+    const T x0 = x.getX0();
+    const T x1 = x.getX1();
+    if (x0 != x0)
+    {
+        return x;
+    }
+
+    const T lo = transcendentalOutward(std::exp(x0), x0 == T(0) || std::isinf(x0), true);
+    const T hi = transcendentalOutward(std::exp(x1), x1 == T(0) || std::isinf(x1), false);
+
+    return IntervalNumberT<T>(std::max(lo, T(0)), hi);
+}
+
+/**
+ * Natural logarithm: [log(x0), log(x1)]in, with log(0) = -∞ and
+ * log(∞) = ∞. NaN if x0 < 0.
+ *
+ * @param x Argument
+ * @return Enclosure of log over x
+ */
+template<typename T>
+IntervalNumberT<T> log(const IntervalNumberT<T>& x) noexcept
+{
+    const T x0 = x.getX0();
+    const T x1 = x.getX1();
+    if (x0 != x0 || x0 < T(0))
+    {
+        return IntervalNumberT<T>(std::numeric_limits<T>::quiet_NaN());
+    }
+
+    const T lo = transcendentalOutward(std::log(x0), x0 == T(0) || x0 == T(1) || std::isinf(x0), true);
+    const T hi = transcendentalOutward(std::log(x1), x1 == T(0) || x1 == T(1) || std::isinf(x1), false);
+
+    return IntervalNumberT<T>(lo, hi);
+}
+
+/**
+ * Square root: [sqrt(x0), sqrt(x1)]in. NaN if x0 < 0.
+ *
+ * sqrt is correctly rounded, so an endpoint moves outward only on the side
+ * where the rounded root lies beyond the exact one.
+ *
+ * @param x Argument
+ * @return Enclosure of sqrt over x
+ */
+template<typename T>
+IntervalNumberT<T> sqrt(const IntervalNumberT<T>& x) noexcept
+{
+    // Below this magnitude the residual r·r - x may underflow to zero.
+    constexpr T EXACT_MIN = std::numeric_limits<T>::min() / std::numeric_limits<T>::epsilon() * T(4);
+
+    const T x0 = x.getX0();
+    const T x1 = x.getX1();
+    if (x0 != x0 || x0 < T(0))
+    {
+        return IntervalNumberT<T>(std::numeric_limits<T>::quiet_NaN());
+    }
+
+    // Sign of r·r - x: positive if the rounded root r is too large.
+    auto bound = [&](T a, bool down) {
+        const T r = std::sqrt(a);
+        if (a == T(0) || std::isinf(a))
+        {
+            return r;
+        }
+        const T residual = std::fma(r, r, -a);
+        const bool exact = (a >= EXACT_MIN) && (down ? residual <= T(0) : residual >= T(0));
+
+        return transcendentalOutward(r, exact, down);
+    };
+
+    return IntervalNumberT<T>(std::max(bound(x0, true), T(0)), bound(x1, false));
+}
+
+/**
+ * Sine. Any infinite endpoint gives [-1, 1].
+ *
+ * @param x Argument
+ * @return Enclosure of sin over x
+ */
+template<typename T>
+IntervalNumberT<T> sin(const IntervalNumberT<T>& x) noexcept
+{
+    return transcendentalPeriodic(x, [](T a) { return std::sin(a); }, T(1));
+}
+
+/**
+ * Cosine. Any infinite endpoint gives [-1, 1].
+ *
+ * @param x Argument
+ * @return Enclosure of cos over x
+ */
+template<typename T>
+IntervalNumberT<T> cos(const IntervalNumberT<T>& x) noexcept
+{
+    return transcendentalPeriodic(x, [](T a) { return std::cos(a); }, T(0));
+}
+
+/**
+ * Arc tangent: [atan(x0), atan(x1)]in, with atan(±∞) = ±π/2.
+ *
+ * @param x Argument
+ * @return Enclosure of atan over x
+ */
+template<typename T>
+IntervalNumberT<T> atan(const IntervalNumberT<T>& x) noexcept
+{
+    const T x0 = x.getX0();
+    const T x1 = x.getX1();
+    if (x0 != x0)
+    {
+        return x;
+    }
+
+    return IntervalNumberT<T>(transcendentalOutward(std::atan(x0), x0 == T(0), true), transcendentalOutward(std::atan(x1), x1 == T(0), false));
+}
+
+/**
+ * Hyperbolic tangent: [tanh(x0), tanh(x1)]in, with tanh(±∞) = ±1.
+ *
+ * @param x Argument
+ * @return Enclosure of tanh over x
+ */
+template<typename T>
+IntervalNumberT<T> tanh(const IntervalNumberT<T>& x) noexcept
+{
+    const T x0 = x.getX0();
+    const T x1 = x.getX1();
+    if (x0 != x0)
+    {
+        return x;
+    }
+
+    const T lo = transcendentalOutward(std::tanh(x0), x0 == T(0) || std::isinf(x0), true);
+    const T hi = transcendentalOutward(std::tanh(x1), x1 == T(0) || std::isinf(x1), false);
+
+    return IntervalNumberT<T>(std::max(lo, T(-1)), std::min(hi, T(1)));
+}
+
+// Helpers of the batch kernels. Integer conversions and rounding use the
+// magic constant 1.5·2^52 instead of std::floor and casts, which the
+// baseline x86-64 target cannot vectorize.
+
+static constexpr double TRANSCENDENTAL_MAGIC = 0x1.8p52;
+static constexpr double TRANSCENDENTAL_LOG2E = 1.4426950408889634074;
+static constexpr double TRANSCENDENTAL_LN2_HI = 0x1.62e42feep-1;        // 32 bits; n·LN2_HI is exact.
+static constexpr double TRANSCENDENTAL_LN2_LO = 0x1.a39ef35793c76p-33;
+static constexpr double TRANSCENDENTAL_PI_2 = 1.5707963267948966192;
+static constexpr double TRANSCENDENTAL_PI_4 = 0.78539816339744830962;
+static constexpr double TRANSCENDENTAL_2_PI = 0.63661977236758134308;
+static constexpr double TRANSCENDENTAL_PI_2_1 = 0x1.921fb544p0;         // 33 bits each; k·PI_2_i is exact.
+static constexpr double TRANSCENDENTAL_PI_2_2 = 0x1.0b4611a6p-34;
+static constexpr double TRANSCENDENTAL_PI_2_3 = 0x1.3198a2e037073p-69;
+static constexpr double TRANSCENDENTAL_DENORM = std::numeric_limits<double>::denorm_min();
+
+inline std::uint64_t transcendentalBits(double x) noexcept
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return bits;
+}
+
+inline double transcendentalFromBits(std::uint64_t bits) noexcept
+{
+    double x;
+    std::memcpy(&x, &bits, sizeof(x));
+    return x;
+}
+
+// Nearest integer of |x| < 2^51.
+inline double transcendentalRound(double x) noexcept
+{
+    return (x + TRANSCENDENTAL_MAGIC) - TRANSCENDENTAL_MAGIC;
+}
+
+// 2^n for an integer n in [-1022, 1023].
+inline double transcendentalPow2(double n) noexcept
+{
+    return transcendentalFromBits((transcendentalBits(n + (TRANSCENDENTAL_MAGIC + 1023.0)) - transcendentalBits(TRANSCENDENTAL_MAGIC)) << 52);
+}
+
+// e^r - 1 for |r| <= 0.35, Taylor polynomial to degree 13.
+inline double transcendentalExpm1Reduced(double r) noexcept
+{
+    double p = 1.0 / 6227020800.0;
+    p = p * r + 1.0 / 479001600.0;
+    p = p * r + 1.0 / 39916800.0;
+    p = p * r + 1.0 / 3628800.0;
+    p = p * r + 1.0 / 362880.0;
+    p = p * r + 1.0 / 40320.0;
+    p = p * r + 1.0 / 5040.0;
+    p = p * r + 1.0 / 720.0;
+    p = p * r + 1.0 / 120.0;
+    p = p * r + 1.0 / 24.0;
+    p = p * r + 1.0 / 6.0;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+
+    return p * r;
+}
+
+// Splits y = n·ln 2 + r with |r| <= 0.35; y within [-746, 710].
+inline double transcendentalExpReduce(double y, double& n) noexcept
+{
+    n = transcendentalRound(y * TRANSCENDENTAL_LOG2E);
+    return (y - n * TRANSCENDENTAL_LN2_HI) - n * TRANSCENDENTAL_LN2_LO;
+}
+
+// Widens a kernel result v with absolute error bound error.
+inline void transcendentalWiden(double v, double error, double& lo, double& hi) noexcept
+{
+    lo = v - error;
+    hi = v + error;
+}
+
+/**
+ * Batch exp endpoint kernel.
+ *
+ * @param x Argument
+ * @param lo Lower bound of exp(x)
+ * @param hi Upper bound of exp(x)
+ */
+inline void transcendentalExpKernel(double x, double& lo, double& hi) noexcept
+{
+    const double y = (x != x) ? 0.0 : std::min(std::max(x, -746.0), 710.0);
+    double n;
+    const double r = transcendentalExpReduce(y, n);
+
+    // Two scale factors keep both powers of two normal down to 2^-1076.
+    const double n1 = transcendentalRound(0.5 * n);
+    const double v = (1.0 + transcendentalExpm1Reduced(r)) * transcendentalPow2(n1) * transcendentalPow2(n - n1);
+
+    lo = v * (1.0 - TRANSCENDENTAL_ERROR) - TRANSCENDENTAL_DENORM;
+    hi = v * (1.0 + TRANSCENDENTAL_ERROR) + TRANSCENDENTAL_DENORM;
+    lo = std::min(std::max(lo, 0.0), std::numeric_limits<double>::max());
+
+    const bool exact = (x == 0.0) || (x == INF) || (x == -INF) || (x != x);
+    const double special = (x == 0.0) ? 1.0 : ((x == -INF) ? 0.0 : x);
+    lo = exact ? special : lo;
+    hi = exact ? special : hi;
+}
+
+/**
+ * Batch log endpoint kernel for x >= 0.
+ *
+ * @param x Argument
+ * @param lo Lower bound of log(x)
+ * @param hi Upper bound of log(x)
+ */
+inline void transcendentalLogKernel(double x, double& lo, double& hi) noexcept
+{
+    // x = m·2^e with m in [sqrt(1/2), sqrt(2)); subnormals are scaled first.
+    // The sign is dropped so that the NaN lanes of negative arguments stay
+    // cheap.
+    const double a = std::fabs(x);
+    const bool subnormal = (a < std::numeric_limits<double>::min());
+    const std::uint64_t bits = transcendentalBits(subnormal ? a * 0x1p54 : a);
+    double e = transcendentalFromBits(transcendentalBits(TRANSCENDENTAL_MAGIC) + (bits >> 52)) - TRANSCENDENTAL_MAGIC - (subnormal ? 1077.0 : 1023.0);
+    double m = transcendentalFromBits((bits & 0x000fffffffffffffu) | 0x3ff0000000000000u);
+    const bool high = (m > 1.4142135623730951);
+    m = high ? 0.5 * m : m;
+    e = high ? e + 1.0 : e;
+
+    // log(m) = 2·atanh(f), f = (m - 1)/(m + 1), |f| <= 0.172; odd series to f^21.
+    const double f = (m - 1.0) / (m + 1.0);
+    const double s = f * f;
+    double p = 1.0 / 21.0;
+    p = p * s + 1.0 / 19.0;
+    p = p * s + 1.0 / 17.0;
+    p = p * s + 1.0 / 15.0;
+    p = p * s + 1.0 / 13.0;
+    p = p * s + 1.0 / 11.0;
+    p = p * s + 1.0 / 9.0;
+    p = p * s + 1.0 / 7.0;
+    p = p * s + 1.0 / 5.0;
+    p = p * s + 1.0 / 3.0;
+    p = p * s + 1.0;
+    const double logM = 2.0 * f * p;
+
+    // |log m| <= ln(2)/2, so the sum does not cancel.
+    const double v = e * TRANSCENDENTAL_LN2_HI + (e * TRANSCENDENTAL_LN2_LO + logM);
+    const double error = TRANSCENDENTAL_ERROR * (std::fabs(e) * TRANSCENDENTAL_LN2_HI + std::fabs(logM));
+    transcendentalWiden(v, error, lo, hi);
+
+    const bool special = (x == 0.0) || (x == INF) || (x != x);
+    const double value = (x == 0.0) ? -INF : x;
+    lo = special ? value : lo;
+    hi = special ? value : hi;
+}
+
+/**
+ * Batch sqrt endpoint kernel for x >= 0. The square root instruction is
+ * correctly rounded, so the exact root lies within one ulp of it.
+ *
+ * @param x Argument
+ * @param lo Lower bound of sqrt(x)
+ * @param hi Upper bound of sqrt(x)
+ */
+inline void transcendentalSqrtKernel(double x, double& lo, double& hi) noexcept
+{
+    const double a = std::fabs(x);
+    const double v = std::sqrt(a);
+    const std::uint64_t bits = transcendentalBits(v);
+    lo = transcendentalFromBits(bits - 1u);
+    hi = transcendentalFromBits(bits + 1u);
+
+    // A root of at most 26 significant bits squares exactly. The low bits are
+    // tested as a double, since SSE2 has no 64-bit integer compare.
+    const bool shortRoot = (transcendentalFromBits((bits & 0x7ffffffu) | 0x3ff0000000000000u) == 1.0);
+    const bool root = shortRoot & (v * v == a) & (a >= std::numeric_limits<double>::min()) & (a < INF);
+    const bool exact = root | (a == 0.0) | (a == INF) | (x != x);
+    lo = exact ? v : lo;
+    hi = exact ? v : hi;
+}
+
+/**
+ * Batch sine/cosine endpoint kernel for |x| <= TRANSCENDENTAL_SIN_LIMIT:
+ * x = k·π/2 + r with |r| <= π/4.
+ *
+ * @param x Argument
+ * @param cosine true for cos(x), false for sin(x)
+ * @param k Quadrant index
+ * @param r Reduced argument
+ * @param lo Lower bound of the function at x
+ * @param hi Upper bound of the function at x
+ */
+inline void transcendentalSinCosKernel(double x, bool cosine, double& k, double& r, double& lo, double& hi) noexcept
+{
+    // Larger arguments give meaningless but harmless values, which the
+    // caller replaces. Clamping them would let GCC fold constant quadrants
+    // into selects it cannot vectorize.
+    k = transcendentalRound(x * TRANSCENDENTAL_2_PI);
+    r = ((x - k * TRANSCENDENTAL_PI_2_1) - k * TRANSCENDENTAL_PI_2_2) - k * TRANSCENDENTAL_PI_2_3;
+
+    const double s2 = r * r;
+    double sine = -1.0 / 121645100408832000.0;
+    sine = sine * s2 + 1.0 / 355687428096000.0;
+    sine = sine * s2 - 1.0 / 1307674368000.0;
+    sine = sine * s2 + 1.0 / 6227020800.0;
+    sine = sine * s2 - 1.0 / 39916800.0;
+    sine = sine * s2 + 1.0 / 362880.0;
+    sine = sine * s2 - 1.0 / 5040.0;
+    sine = sine * s2 + 1.0 / 120.0;
+    sine = sine * s2 - 1.0 / 6.0;
+    sine = r + r * s2 * sine;
+    double cosine2 = 1.0 / 2432902008176640000.0;
+    cosine2 = cosine2 * s2 - 1.0 / 6402373705728000.0;
+    cosine2 = cosine2 * s2 + 1.0 / 20922789888000.0;
+    cosine2 = cosine2 * s2 - 1.0 / 87178291200.0;
+    cosine2 = cosine2 * s2 + 1.0 / 479001600.0;
+    cosine2 = cosine2 * s2 - 1.0 / 3628800.0;
+    cosine2 = cosine2 * s2 + 1.0 / 40320.0;
+    cosine2 = cosine2 * s2 - 1.0 / 720.0;
+    cosine2 = cosine2 * s2 + 1.0 / 24.0;
+    cosine2 = 1.0 + s2 * (cosine2 * s2 - 0.5);
+
+    // Quadrant (k + 1 for cosine) mod 4: sin r, cos r, -sin r, -cos r.
+    const double kq = cosine ? k + 1.0 : k;
+    const double q = kq - 4.0 * transcendentalRound(0.25 * kq - 0.375);
+    const double v0 = ((q == 0.0) | (q == 2.0)) ? sine : cosine2;
+    const double v = (q >= 2.0) ? -v0 : v0;
+
+    // The truncation of π/2 after PI_2_3 shifts r by less than |k|·2^-100.
+    // The polynomials are exact at r = 0, which keeps sin(0) and cos(0) exact.
+    const double error = ((r == 0.0) ? 0.0 : TRANSCENDENTAL_ERROR * std::fabs(v) + TRANSCENDENTAL_DENORM) + std::fabs(k) * 0x1p-100;
+    transcendentalWiden(v, error, lo, hi);
+    lo = (x != x) ? x : lo;
+    hi = (x != x) ? x : hi;
+}
+
+/**
+ * Interval sine/cosine from the endpoint kernels. Extrema lie at jπ/2:
+ * maxima at j ≡ first, minima at j ≡ first + 2 (mod 4).
+ */
+inline void transcendentalPeriodicKernel(double x0, double x1, bool cosine, double& r0, double& r1) noexcept
+{
+    // Residues beyond this distance from zero are certainly nonzero.
+    constexpr double TOLERANCE = 0x1p-60;
+
+    double k0;
+    double k1;
+    double reduced0;
+    double reduced1;
+    double lo0;
+    double hi0;
+    double lo1;
+    double hi1;
+    transcendentalSinCosKernel(x0, cosine, k0, reduced0, lo0, hi0);
+    transcendentalSinCosKernel(x1, cosine, k1, reduced1, lo1, hi1);
+
+    const double jMin = (reduced0 <= TOLERANCE) ? k0 : k0 + 1.0;
+    const double jMax = (reduced1 >= -TOLERANCE) ? k1 : k1 - 1.0;
+    const double first = cosine ? 0.0 : 1.0;
+    auto contains = [&](double residue) {
+        const double offset = residue - jMin;
+        return jMin + (offset - 4.0 * transcendentalRound(0.25 * offset - 0.375)) <= jMax;
+    };
+
+    const bool full = !(std::fabs(x0) <= TRANSCENDENTAL_SIN_LIMIT) | !(std::fabs(x1) <= TRANSCENDENTAL_SIN_LIMIT) | (jMax - jMin >= 3.0);
+    const bool hasMaximum = full | contains(first);
+    const bool hasMinimum = full | contains(first + 2.0);
+
+    // Value selects; std::min on the locals would select between addresses.
+    const double lower = (lo1 < lo0) ? lo1 : lo0;
+    const double upper = (hi1 > hi0) ? hi1 : hi0;
+    const double lo = (hasMinimum | (lower < -1.0)) ? -1.0 : lower;
+    const double hi = (hasMaximum | (upper > 1.0)) ? 1.0 : upper;
+    const bool isNan = (x0 != x0);
+    r0 = isNan ? x0 : lo;
+    r1 = isNan ? x0 : hi;
+}
+
+/**
+ * Batch atan endpoint kernel.
+ *
+ * @param x Argument
+ * @param lo Lower bound of atan(x)
+ * @param hi Upper bound of atan(x)
+ */
+inline void transcendentalAtanKernel(double x, double& lo, double& hi) noexcept
+{
+    // atan|x| = π/2 - atan(1/|x|) above 1 and π/4 + atan((t-1)/(t+1)) above
+    // tan(π/8), leaving |u| <= 0.415.
+    const double a = std::fabs(x);
+    const bool inverse = (a > 1.0);
+    const double t = inverse ? 1.0 / a : a;
+    const bool shifted = (t > 0.41421356237309503);
+    const double u = shifted ? (t - 1.0) / (t + 1.0) : t;
+
+    // Odd series to u^43.
+    const double s = u * u;
+    double p = -1.0 / 43.0;
+    p = p * s + 1.0 / 41.0;
+    p = p * s - 1.0 / 39.0;
+    p = p * s + 1.0 / 37.0;
+    p = p * s - 1.0 / 35.0;
+    p = p * s + 1.0 / 33.0;
+    p = p * s - 1.0 / 31.0;
+    p = p * s + 1.0 / 29.0;
+    p = p * s - 1.0 / 27.0;
+    p = p * s + 1.0 / 25.0;
+    p = p * s - 1.0 / 23.0;
+    p = p * s + 1.0 / 21.0;
+    p = p * s - 1.0 / 19.0;
+    p = p * s + 1.0 / 17.0;
+    p = p * s - 1.0 / 15.0;
+    p = p * s + 1.0 / 13.0;
+    p = p * s - 1.0 / 11.0;
+    p = p * s + 1.0 / 9.0;
+    p = p * s - 1.0 / 7.0;
+    p = p * s + 1.0 / 5.0;
+    p = p * s - 1.0 / 3.0;
+    p = p * s + 1.0;
+    const double base = u * p;
+    const double shiftedBase = shifted ? TRANSCENDENTAL_PI_4 + base : base;
+    const double magnitude = inverse ? TRANSCENDENTAL_PI_2 - shiftedBase : shiftedBase;
+    const double v = (x < 0.0) ? -magnitude : magnitude;
+
+    const double error = (x == 0.0) ? 0.0 : TRANSCENDENTAL_ERROR * magnitude + TRANSCENDENTAL_DENORM;
+    transcendentalWiden(v, error, lo, hi);
+}
+
+/**
+ * Batch tanh endpoint kernel.
+ *
+ * @param x Argument
+ * @param lo Lower bound of tanh(x)
+ * @param hi Upper bound of tanh(x)
+ */
+inline void transcendentalTanhKernel(double x, double& lo, double& hi) noexcept
+{
+    // tanh|x| = m/(m + 2) with m = e^(2|x|) - 1 = 2^n·(e^r - 1) + (2^n - 1),
+    // n >= 0, so m does not cancel. tanh rounds to 1 long before |x| = 20.
+    const double a = std::min(std::fabs(x), 20.0);
+    double n;
+    const double r = transcendentalExpReduce(2.0 * a, n);
+    const double scale = transcendentalPow2(n);
+    const double m = scale * transcendentalExpm1Reduced(r) + (scale - 1.0);
+    const double magnitude = m / (m + 2.0);
+    const double v = (x < 0.0) ? -magnitude : magnitude;
+
+    const double error = (x == 0.0) ? 0.0 : TRANSCENDENTAL_ERROR * magnitude + TRANSCENDENTAL_DENORM;
+    transcendentalWiden(v, error, lo, hi);
+    lo = std::max(lo, -1.0);
+    hi = std::min(hi, 1.0);
+
+    const bool infinite = (x == INF) || (x == -INF);
+    lo = infinite ? v : lo;
+    hi = infinite ? v : hi;
+}
+
+/**
+ * Batch exponential: r[i] = exp(x[i]).
+ */
+inline void batchExp(const double* x0, const double* x1, double* r0, double* r1, std::size_t count) noexcept
+{
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        const double a0 = x0[i];
+        const double a1 = x1[i];
+        double lo;
+        double hi;
+        double unused;
+        transcendentalExpKernel(a0, lo, unused);
+        transcendentalExpKernel(a1, unused, hi);
+        r0[i] = lo;
+        r1[i] = hi;
+    }
+}
+
+/**
+ * Batch natural logarithm: r[i] = log(x[i]).
+ */
+inline void batchLog(const double* x0, const double* x1, double* r0, double* r1, std::size_t count) noexcept
+{
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        const double a0 = x0[i];
+        const double a1 = x1[i];
+        double lo;
+        double hi;
+        double unused;
+        transcendentalLogKernel(a0, lo, unused);
+        transcendentalLogKernel(a1, unused, hi);
+        const bool outside = !(a0 >= 0.0);
+        r0[i] = outside ? QUIET_NAN : lo;
+        r1[i] = outside ? QUIET_NAN : hi;
+    }
+}
+
+/**
+ * Batch square root: r[i] = sqrt(x[i]).
+ */
+inline void batchSqrt(const double* x0, const double* x1, double* r0, double* r1, std::size_t count) noexcept
+{
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        const double a0 = x0[i];
+        const double a1 = x1[i];
+        double lo;
+        double hi;
+        double unused;
+        transcendentalSqrtKernel(a0, lo, unused);
+        transcendentalSqrtKernel(a1, unused, hi);
+        const bool outside = !(a0 >= 0.0);
+        r0[i] = outside ? QUIET_NAN : lo;
+        r1[i] = outside ? QUIET_NAN : hi;
+    }
+}
+
+/**
+ * Batch sine: r[i] = sin(x[i]).
+ */
+inline void batchSin(const double* x0, const double* x1, double* r0, double* r1, std::size_t count) noexcept
+{
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        transcendentalPeriodicKernel(x0[i], x1[i], false, r0[i], r1[i]);
+    }
+}
+
+/**
+ * Batch cosine: r[i] = cos(x[i]).
+ */
+inline void batchCos(const double* x0, const double* x1, double* r0, double* r1, std::size_t count) noexcept
+{
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        transcendentalPeriodicKernel(x0[i], x1[i], true, r0[i], r1[i]);
+    }
+}
+
+/**
+ * Batch arc tangent: r[i] = atan(x[i]).
+ */
+inline void batchAtan(const double* x0, const double* x1, double* r0, double* r1, std::size_t count) noexcept
+{
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        const double a0 = x0[i];
+        const double a1 = x1[i];
+        double lo;
+        double hi;
+        double unused;
+        transcendentalAtanKernel(a0, lo, unused);
+        transcendentalAtanKernel(a1, unused, hi);
+        r0[i] = lo;
+        r1[i] = hi;
+    }
+}
+
+/**
+ * Batch hyperbolic tangent: r[i] = tanh(x[i]).
+ */
+inline void batchTanh(const double* x0, const double* x1, double* r0, double* r1, std::size_t count) noexcept
+{
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        const double a0 = x0[i];
+        const double a1 = x1[i];
+        double lo;
+        double hi;
+        double unused;
+        transcendentalTanhKernel(a0, lo, unused);
+        transcendentalTanhKernel(a1, unused, hi);
+        r0[i] = lo;
+        r1[i] = hi;
+    }
+}
+
+// IntervalArray functions. The result may be the operand.
+
+/**
+ * Element-wise exponential.
+ *
+ * @param x Arguments
+ * @param result Exponentials
+ */
+inline void exp(const IntervalArray& x, IntervalArray& result)
+{
+    result.resize(x.size());
+    batchExp(x.lower(), x.upper(), result.lower(), result.upper(), x.size());
+}
+
+/**
+ * Element-wise natural logarithm.
+ *
+ * @param x Arguments
+ * @param result Logarithms
+ */
+inline void log(const IntervalArray& x, IntervalArray& result)
+{
+    result.resize(x.size());
+    batchLog(x.lower(), x.upper(), result.lower(), result.upper(), x.size());
+}
+
+/**
+ * Element-wise square root.
+ *
+ * @param x Arguments
+ * @param result Square roots
+ */
+inline void sqrt(const IntervalArray& x, IntervalArray& result)
+{
+    result.resize(x.size());
+    batchSqrt(x.lower(), x.upper(), result.lower(), result.upper(), x.size());
+}
+
+/**
+ * Element-wise sine.
+ *
+ * @param x Arguments
+ * @param result Sines
+ */
+inline void sin(const IntervalArray& x, IntervalArray& result)
+{
+    result.resize(x.size());
+    batchSin(x.lower(), x.upper(), result.lower(), result.upper(), x.size());
+}
+
+/**
+ * Element-wise cosine.
+ *
+ * @param x Arguments
+ * @param result Cosines
+ */
+inline void cos(const IntervalArray& x, IntervalArray& result)
+{
+    result.resize(x.size());
+    batchCos(x.lower(), x.upper(), result.lower(), result.upper(), x.size());
+}
+
+/**
+ * Element-wise arc tangent.
+ *
+ * @param x Arguments
+ * @param result Arc tangents
+ */
+inline void atan(const IntervalArray& x, IntervalArray& result)
+{
+    result.resize(x.size());
+    batchAtan(x.lower(), x.upper(), result.lower(), result.upper(), x.size());
+}
+
+/**
+ * Element-wise hyperbolic tangent.
+ *
+ * @param x Arguments
+ * @param result Hyperbolic tangents
+ */
+inline void tanh(const IntervalArray& x, IntervalArray& result)
+{
+    result.resize(x.size());
+    batchTanh(x.lower(), x.upper(), result.lower(), result.upper(), x.size());
+}
+
+#endif /* INTERVALTRANSCENDENTAL_HPP_ */
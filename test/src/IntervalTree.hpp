@@ -0,0 +1,506 @@
+#ifndef INTERVALTREE_HPP_
+#define INTERVALTREE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "IntervalArray.hpp"
+#include "IntervalNumber.hpp"
+#include "IntervalReduction.hpp"
+
+// Static index of stored intervals for stabbing and overlap queries.
+//
+// The index is a centered interval tree whose centers are the lower bounds
+// of the stored intervals. The centers form a complete binary search tree
+// kept in Eytzinger order: node k has the children 2k and 2k + 1, so a query
+// walks down one array and the top levels share a few cache lines. Each
+// stored interval belongs to the first node on its search path whose center
+// it contains; its own lower bound guarantees there is one. A node keeps its
+// intervals twice, by ascending lower bound and by descending upper bound:
+//
+//     value < center:  report the node's intervals while lower <= value, go left
+//     value > center:  report the node's intervals while upper >= value, go right
+//     value = center:  report all of the node's intervals, stop
+//
+// A stabbing query therefore visits one path and every interval it touches
+// is reported, in O(log n + k) for k matches. An overlap query with [a, b]
+// reports the intervals containing a, then the intervals with a lower bound
+// in (a, b], found by an Eytzinger search over the same centers; each match
+// is reported once.
+//
+// Intervals are closed in the extended reals, so [0, ∞] contains ∞ and
+// overlaps [∞, ∞]. Endpoints are normalized like the IntervalNumber
+// constructor: swapped endpoints are ordered, and an interval with a NaN
+// endpoint is NaN. NaN intervals contain no value and overlap nothing, so
+// they are counted by size() but never reported; a NaN query matches
+// nothing. -0 and +0 are the same value. Matches are reported by their
+// index in the stored collection, in an order that depends only on the
+// stored intervals.
+
+// Queries per task of the batch queries.
+static constexpr std::size_t INTERVAL_TREE_BATCH = 1024u;
+
+/**
+ * Matches of a batch of queries. The matches of query q are
+ * indices[offsets[q]] to indices[offsets[q + 1] - 1].
+ */
+struct IntervalTreeMatches
+{
+    std::vector<std::size_t> offsets{};
+    std::vector<std::size_t> indices{};
+
+    /**
+     * Gets the number of matches of a query.
+     *
+     * @param query Index of the query
+     * @return Number of matches
+     */
+    std::size_t count(std::size_t query) const noexcept
+    {
+        return offsets[query + 1u] - offsets[query];
+    }
+};
+
+/**
+ * Static centered interval tree in Eytzinger order.
+ */
+class IntervalTree {
+
+private:
+
+    // Number of stored intervals, NaN intervals included.
+    std::size_t m_size{0u};
+
+    // Number of nodes: the stored intervals that are not NaN.
+    std::size_t m_nodes{0u};
+
+    /**
+     * Node of the tree. Two nodes fill a cache line, so siblings share one.
+     * Most node lists on a query path hold no match; the reach of the list
+     * tells so without loading it.
+     */
+    struct Node
+    {
+        double center;
+        double lowest;          // Lowest lower bound of the node list; ∞ if empty.
+        double highest;         // Highest upper bound of the node list; -∞ if empty.
+        std::size_t first;      // The intervals of node k are [first, m_tree[k + 1].first) of the node lists.
+    };
+
+    // Node k at [k], from 1; [0] is unused and [m_nodes + 1] ends the last list.
+    std::vector<Node, AlignedAllocator<Node>> m_tree{};
+
+    // Rank of the center of node k among the sorted lower bounds.
+    std::vector<std::size_t> m_ranks{};
+
+    /**
+     * Bound of a stored interval next to its index, so a scan reads one
+     * stream.
+     */
+    struct Entry
+    {
+        double bound;
+        std::size_t index;
+    };
+
+    // Node lists by ascending lower bound.
+    std::vector<Entry> m_byLower{};
+
+    // Node lists by descending upper bound.
+    std::vector<Entry> m_byUpper{};
+
+    // Lower bounds of all non-NaN intervals in ascending order, for overlap
+    // queries and the centers.
+    std::vector<Entry> m_sorted{};
+
+    /**
+     * Places the sorted lower bounds in Eytzinger order: an in-order walk of
+     * the complete tree visits them in ascending order.
+     *
+     * @param node Node to fill, from 1
+     * @param rank Next rank to place
+     */
+    void placeCenters(std::size_t node, std::size_t& rank)
+    {
+        if (node > m_nodes)
+        {
+            return;
+        }
+        placeCenters(2u * node, rank);
+        m_tree[node].center = m_sorted[rank].bound;
+        m_ranks[node] = rank;
+        rank++;
+        placeCenters(2u * node + 1u, rank);
+    }
+
+    /**
+     * Prefetches the grandchildren of a node, two cache lines, so the walk
+     * loads them while it compares at the node and its child.
+     *
+     * @param node The node, from 1
+     */
+    void prefetch(std::size_t node) const noexcept
+    {
+#if defined(__GNUC__)
+        if (4u * node + 3u <= m_nodes)
+        {
+            __builtin_prefetch(&m_tree[4u * node]);
+            __builtin_prefetch(&m_tree[4u * node + 2u]);
+        }
+#else
+        (void)node;
+#endif
+    }
+
+    /**
+     * Finds the node of an interval: the first node on its search path
+     * whose center it contains.
+     *
+     * @param x0 Lower bound, a center of the tree
+     * @param x1 Upper bound, not less than x0
+     * @return The node, from 1
+     */
+    std::size_t nodeOf(double x0, double x1) const noexcept
+    {
+        std::size_t node = 1u;
+        while (x1 < m_tree[node].center || x0 > m_tree[node].center)
+        {
+            node = 2u * node + ((x0 > m_tree[node].center) ? 1u : 0u);
+        }
+
+        return node;
+    }
+
+    /**
+     * Finds the rank of the first sorted lower bound greater than a value.
+     * The search is branch-free; the walk descends to a leaf, and the
+     * answer is the last node where it went left.
+     *
+     * @param value The value, not NaN
+     * @return The rank, m_nodes if no lower bound is greater
+     */
+    std::size_t rankAbove(double value) const noexcept
+    {
+        std::size_t node = 1u;
+        while (node <= m_nodes)
+        {
+            prefetch(node);
+            node = 2u * node + ((m_tree[node].center <= value) ? 1u : 0u);
+        }
+        // Strips the right turns, then the left turn after them.
+        while ((node & 1u) != 0u)
+        {
+            node >>= 1u;
+        }
+        node >>= 1u;
+
+        return (node == 0u) ? m_nodes : m_ranks[node];
+    }
+
+    /**
+     * Answers a batch of queries, INTERVAL_TREE_BATCH per task; the result
+     * does not depend on the number of threads.
+     *
+     * @param count Number of queries
+     * @param matches The matches of every query
+     * @param threads Number of threads; 0 selects std::thread::hardware_concurrency()
+     * @param query Appends the matches of query q to a vector
+     */
+    template<typename Function>
+    static void findBatch(std::size_t count, IntervalTreeMatches& matches, std::size_t threads, const Function& query)
+    {
+        const std::size_t tasks = (count + INTERVAL_TREE_BATCH - 1u) / INTERVAL_TREE_BATCH;
+        std::vector<std::vector<std::size_t>> found(tasks);
+
+        matches.offsets.assign(count + 1u, 0u);
+        parallelFor(tasks, threads, [&](std::size_t task) {
+            const std::size_t begin = task * INTERVAL_TREE_BATCH;
+            const std::size_t end = std::min(begin + INTERVAL_TREE_BATCH, count);
+            for (std::size_t q = begin; q < end; q++)
+            {
+                const std::size_t before = found[task].size();
+                query(q, found[task]);
+                matches.offsets[q + 1u] = found[task].size() - before;
+            }
+        });
+
+        for (std::size_t q = 0u; q < count; q++)
+        {
+            matches.offsets[q + 1u] += matches.offsets[q];
+        }
+        matches.indices.resize(matches.offsets[count]);
+        parallelFor(tasks, threads, [&](std::size_t task) {
+            std::copy(found[task].begin(), found[task].end(), matches.indices.begin() + static_cast<std::ptrdiff_t>(matches.offsets[task * INTERVAL_TREE_BATCH]));
+        });
+    }
+
+public:
+
+    /**
+     * Default constructor. Creates an empty index.
+     */
+    IntervalTree() = default;
+
+    /**
+     * Constructor. Indexes a collection of intervals.
+     *
+     * @param intervals The intervals
+     * @param threads Number of threads; 0 selects std::thread::hardware_concurrency()
+     */
+    explicit IntervalTree(const std::vector<IntervalNumber>& intervals, std::size_t threads = 0u)
+    {
+        IntervalArray x(intervals.size());
+        for (std::size_t i = 0u; i < intervals.size(); i++)
+        {
+            x.lower()[i] = intervals[i].getX0();
+            x.upper()[i] = intervals[i].getX1();
+        }
+        build(x.lower(), x.upper(), x.size(), threads);
+    }
+
+    /**
+     * Constructor. Indexes an array of intervals.
+     *
+     * @param intervals The intervals
+     * @param threads Number of threads; 0 selects std::thread::hardware_concurrency()
+     */
+    explicit IntervalTree(const IntervalArray& intervals, std::size_t threads = 0u)
+    {
+        build(intervals.lower(), intervals.upper(), intervals.size(), threads);
+    }
+
+    /**
+     * Indexes intervals from endpoint arrays and replaces the previous
+     * contents. Sorting runs on the calling thread; finding the node of
+     * every interval runs on the given threads.
+     *
+     * @param lower count lower bounds
+     * @param upper count upper bounds
+     * @param count Number of intervals
+     * @param threads Number of threads; 0 selects std::thread::hardware_concurrency()
+     */
+    void build(const double* lower, const double* upper, std::size_t count, std::size_t threads = 0u)
+    {
+        // Normalized upper bounds by stored index.
+        std::vector<double> x1(count);
+        m_sorted.clear();
+        m_sorted.reserve(count);
+        for (std::size_t i = 0u; i < count; i++)
+        {
+            const IntervalNumber x(lower[i], upper[i]);
+            x1[i] = x.getX1();
+            if (x.getX0() == x.getX0())
+            {
+                m_sorted.push_back(Entry{x.getX0(), i});
+            }
+        }
+        // Ties of the lower bound, -0 and +0 included, keep the stored order.
+        std::sort(m_sorted.begin(), m_sorted.end(),
+                  [](const Entry& a, const Entry& b) { return (a.bound < b.bound) || (a.bound == b.bound && a.index < b.index); });
+
+        m_size = count;
+        m_nodes = m_sorted.size();
+
+        m_tree.assign(m_nodes + 2u, Node{0.0, INF, -INF, 0u});
+        m_ranks.assign(m_nodes + 1u, 0u);
+        std::size_t rank = 0u;
+        placeCenters(1u, rank);
+
+        // The node of every interval, by rank.
+        std::vector<std::size_t> nodes(m_nodes);
+        const std::size_t tasks = (m_nodes + INTERVAL_TREE_BATCH - 1u) / INTERVAL_TREE_BATCH;
+        parallelFor(tasks, threads, [&](std::size_t task) {
+            const std::size_t end = std::min((task + 1u) * INTERVAL_TREE_BATCH, m_nodes);
+            for (std::size_t r = task * INTERVAL_TREE_BATCH; r < end; r++)
+            {
+                nodes[r] = nodeOf(m_sorted[r].bound, x1[m_sorted[r].index]);
+            }
+        });
+
+        // Counting sort by node; taking the ranks in order keeps every node
+        // list sorted by ascending lower bound.
+        std::vector<std::size_t> next(m_nodes + 2u, 0u);
+        for (std::size_t r = 0u; r < m_nodes; r++)
+        {
+            next[nodes[r] + 1u]++;
+        }
+        for (std::size_t k = 1u; k <= m_nodes; k++)
+        {
+            next[k + 1u] += next[k];
+            m_tree[k].first = next[k];
+        }
+        m_tree[m_nodes + 1u].first = m_nodes;
+        m_byLower.resize(m_nodes);
+        for (std::size_t r = 0u; r < m_nodes; r++)
+        {
+            Node& node = m_tree[nodes[r]];
+            node.lowest = std::min(node.lowest, m_sorted[r].bound);
+            node.highest = std::max(node.highest, x1[m_sorted[r].index]);
+            m_byLower[next[nodes[r]]++] = m_sorted[r];
+        }
+
+        m_byUpper.resize(m_nodes);
+        for (std::size_t slot = 0u; slot < m_nodes; slot++)
+        {
+            m_byUpper[slot] = Entry{x1[m_byLower[slot].index], m_byLower[slot].index};
+        }
+        for (std::size_t k = 1u; k <= m_nodes; k++)
+        {
+            std::sort(m_byUpper.begin() + static_cast<std::ptrdiff_t>(m_tree[k].first), m_byUpper.begin() + static_cast<std::ptrdiff_t>(m_tree[k + 1u].first),
+                      [](const Entry& a, const Entry& b) { return (a.bound > b.bound) || (a.bound == b.bound && a.index < b.index); });
+        }
+    }
+
+    /**
+     * Gets the number of stored intervals, NaN intervals included.
+     *
+     * @return Number of intervals
+     */
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+     * Calls a function with the index of every stored interval containing
+     * a value.
+     *
+     * @param value The value; NaN matches nothing
+     * @param f Called with each index
+     */
+    template<typename Function>
+    void forEachContaining(double value, const Function& f) const
+    {
+        if (value != value)
+        {
+            return;
+        }
+
+        std::size_t node = 1u;
+        while (node <= m_nodes)
+        {
+            prefetch(node);
+            const Node& current = m_tree[node];
+            if (value < current.center)
+            {
+                if (current.lowest <= value)
+                {
+                    const std::size_t last = m_tree[node + 1u].first;
+                    for (std::size_t i = current.first; i < last && m_byLower[i].bound <= value; i++)
+                    {
+                        f(m_byLower[i].index);
+                    }
+                }
+                node = 2u * node;
+            }
+            else if (value > current.center)
+            {
+                if (current.highest >= value)
+                {
+                    const std::size_t last = m_tree[node + 1u].first;
+                    for (std::size_t i = current.first; i < last && m_byUpper[i].bound >= value; i++)
+                    {
+                        f(m_byUpper[i].index);
+                    }
+                }
+                node = 2u * node + 1u;
+            }
+            else
+            {
+                const std::size_t last = m_tree[node + 1u].first;
+                for (std::size_t i = current.first; i < last; i++)
+                {
+                    f(m_byLower[i].index);
+                }
+                break;
+            }
+        }
+    }
+
+    /**
+     * Calls a function with the index of every stored interval overlapping
+     * a query interval, that is, sharing at least one value with it.
+     *
+     * @param query The query; NaN matches nothing
+     * @param f Called with each index
+     */
+    template<typename Function>
+    void forEachOverlapping(const IntervalNumber& query, const Function& f) const
+    {
+        const double a = query.getX0();
+        const double b = query.getX1();
+        if (a != a)
+        {
+            return;
+        }
+
+        forEachContaining(a, f);
+        for (std::size_t r = rankAbove(a); r < m_nodes && m_sorted[r].bound <= b; r++)
+        {
+            f(m_sorted[r].index);
+        }
+    }
+
+    /**
+     * Appends the index of every stored interval containing a value.
+     *
+     * @param value The value; NaN matches nothing
+     * @param result The indices are appended here
+     * @return Number of appended indices
+     */
+    std::size_t findContaining(double value, std::vector<std::size_t>& result) const
+    {
+        const std::size_t before = result.size();
+        forEachContaining(value, [&result](std::size_t i) { result.push_back(i); });
+
+        return result.size() - before;
+    }
+
+    /**
+     * Appends the index of every stored interval overlapping a query
+     * interval.
+     *
+     * @param query The query; NaN matches nothing
+     * @param result The indices are appended here
+     * @return Number of appended indices
+     */
+    std::size_t findOverlapping(const IntervalNumber& query, std::vector<std::size_t>& result) const
+    {
+        const std::size_t before = result.size();
+        forEachOverlapping(query, [&result](std::size_t i) { result.push_back(i); });
+
+        return result.size() - before;
+    }
+
+    /**
+     * Finds the stored intervals containing each of a batch of values.
+     *
+     * @param values count values
+     * @param count Number of values
+     * @param matches The matches of every value, in the order of the single queries
+     * @param threads Number of threads; 0 selects std::thread::hardware_concurrency()
+     */
+    void findContaining(const double* values, std::size_t count, IntervalTreeMatches& matches, std::size_t threads = 0u) const
+    {
+        findBatch(count, matches, threads, [this, values](std::size_t q, std::vector<std::size_t>& found) { findContaining(values[q], found); });
+    }
+
+    /**
+     * Finds the stored intervals overlapping each of a batch of query
+     * intervals. Query endpoints are normalized like the stored ones.
+     *
+     * @param queries The query intervals
+     * @param matches The matches of every query, in the order of the single queries
+     * @param threads Number of threads; 0 selects std::thread::hardware_concurrency()
+     */
+    void findOverlapping(const IntervalArray& queries, IntervalTreeMatches& matches, std::size_t threads = 0u) const
+    {
+        findBatch(queries.size(), matches, threads, [this, &queries](std::size_t q, std::vector<std::size_t>& found) {
+            findOverlapping(IntervalNumber(queries.lower()[q], queries.upper()[q]), found);
+        });
+    }
+
+};
+
+#endif /* INTERVALTREE_HPP_ */
@@ -0,0 +1,482 @@
+#ifndef MULTIINTERVAL_HPP_
+#define MULTIINTERVAL_HPP_
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+#include "IntervalNumber.hpp"
+
+// Unions of up to K disjoint intervals.
+//
+// Dividing by an interval that strictly contains zero has the exact
+// reciprocal (-∞, 1/y0] ∪ [1/y1, +∞). IntervalNumber has to replace it by
+// the hull [-∞, ∞] (paper §4.4, Limitation 2); MultiInterval keeps both
+// branches as separate pieces. Pieces live in inline storage, so no
+// operation allocates.
+//
+// An operation applies the IntervalNumber operation to every pair of
+// pieces, so each piece follows the indeterminate form rules of the paper.
+// The results are sorted, overlapping or touching pieces are merged, and
+// while more than K pieces remain the two neighbours with the smallest gap
+// are merged. For single-piece operands hull() of every result equals the
+// IntervalNumber result; chains of operations can be tighter, because gaps
+// survive from one operation to the next.
+
+/**
+ * Union of up to K disjoint intervals [a0, a1]in ∪ [b0, b1]in ∪ ..., sorted
+ * by their bounds. If any piece is NaN, the multi-interval is a single NaN
+ * piece.
+ */
+template<typename T, std::size_t K>
+class MultiIntervalT {
+
+    static_assert(K >= 1u, "MultiIntervalT needs room for at least one piece");
+
+public:
+
+    // Endpoint type.
+    using value_type = T;
+
+    // Type of a piece.
+    using Piece = IntervalNumberT<T>;
+
+    // Maximum number of pieces.
+    static constexpr std::size_t CAPACITY = K;
+
+private:
+
+    // Pieces, sorted and disjoint; only the first m_count are used.
+    std::array<Piece, K> m_pieces{};
+
+    // Number of pieces; at least 1.
+    std::size_t m_count{1u};
+
+    /**
+     * Normalizes count unsorted, possibly overlapping pieces into a
+     * multi-interval of at most K pieces.
+     *
+     * @param pieces The pieces; reordered in place
+     * @param count Number of pieces; at least 1 and at most N
+     * @return The multi-interval
+     */
+    template<std::size_t N>
+    static MultiIntervalT fromPieces(std::array<Piece, N>& pieces, std::size_t count) noexcept
+    {
+        MultiIntervalT result{};
+
+        for (std::size_t i = 0u; i < count; i++)
+        {
+            if (pieces[i].getX0() != pieces[i].getX0())
+            {
+                result.m_pieces[0u] = pieces[i];
+
+                return result;
+            }
+        }
+
+        // Insertion sort by the lower bound; count is at most 2·K².
+        for (std::size_t i = 1u; i < count; i++)
+        {
+            const Piece piece = pieces[i];
+            std::size_t j = i;
+            while (j > 0u && piece.getX0() < pieces[j - 1u].getX0())
+            {
+                pieces[j] = pieces[j - 1u];
+                j--;
+            }
+            pieces[j] = piece;
+        }
+
+        // Merge overlapping and touching pieces.
+        std::size_t merged = 0u;
+        for (std::size_t i = 0u; i < count; i++)
+        {
+            if (merged > 0u && pieces[i].getX0() <= pieces[merged - 1u].getX1())
+            {
+                if (pieces[i].getX1() > pieces[merged - 1u].getX1())
+                {
+                    pieces[merged - 1u] = Piece(pieces[merged - 1u].getX0(), pieces[i].getX1());
+                }
+                continue;
+            }
+            pieces[merged] = pieces[i];
+            merged++;
+        }
+
+        // Close the smallest gaps until the pieces fit. The gaps between the
+        // first merged pieces are indexed below last < N.
+        while (merged > K)
+        {
+            const std::size_t last = std::min(merged, N) - 1u;
+            std::size_t closest = 0u;
+            for (std::size_t i = 1u; i < last; i++)
+            {
+                if (pieces[i + 1u].getX0() - pieces[i].getX1() < pieces[closest + 1u].getX0() - pieces[closest].getX1())
+                {
+                    closest = i;
+                }
+            }
+            pieces[closest] = Piece(pieces[closest].getX0(), pieces[closest + 1u].getX1());
+            for (std::size_t i = closest + 1u; i < last; i++)
+            {
+                pieces[i] = pieces[i + 1u];
+            }
+            merged = last;
+        }
+
+        for (std::size_t i = 0u; i < merged; i++)
+        {
+            result.m_pieces[i] = pieces[i];
+        }
+        result.m_count = merged;
+
+        return result;
+    }
+
+    /**
+     * Applies a piece operation to every pair of pieces of x and y.
+     *
+     * @param x Left operand
+     * @param y Right operand
+     * @param operation Function (a, b, out) writing 1 or 2 pieces to out and
+     *                  returning their number
+     * @return The normalized union of all results
+     */
+    template<typename Operation>
+    static MultiIntervalT combine(const MultiIntervalT& x, const MultiIntervalT& y, const Operation& operation) noexcept
+    {
+        std::array<Piece, 2u * K * K> pieces{};
+        std::size_t count = 0u;
+        for (std::size_t i = 0u; i < x.m_count; i++)
+        {
+            for (std::size_t j = 0u; j < y.m_count; j++)
+            {
+                count += operation(x.m_pieces[i], y.m_pieces[j], &pieces[count]);
+            }
+        }
+
+        return fromPieces(pieces, count);
+    }
+
+public:
+
+    /**
+     * Default constructor.
+     * Initializes the multi-interval to [0, 0]in.
+     */
+    MultiIntervalT() noexcept = default;
+
+    /**
+     * Single value constructor.
+     * Creates the point interval [x0, x0]in.
+     *
+     * @param x0 The single value for both endpoints
+     */
+    MultiIntervalT(T x0) noexcept :
+        m_pieces{}, m_count{1u}
+    {
+        m_pieces[0u] = Piece(x0);
+    }
+
+    /**
+     * Interval constructor.
+     * Creates the single piece [x0, x1]in.
+     *
+     * @param x0 Lower bound
+     * @param x1 Upper bound
+     */
+    MultiIntervalT(T x0, T x1) noexcept :
+        m_pieces{}, m_count{1u}
+    {
+        m_pieces[0u] = Piece(x0, x1);
+    }
+
+    /**
+     * Conversion constructor from a single interval.
+     *
+     * @param x The interval
+     */
+    MultiIntervalT(const Piece& x) noexcept :
+        m_pieces{}, m_count{1u}
+    {
+        m_pieces[0u] = x;
+    }
+
+    /**
+     * Gets the number of pieces.
+     *
+     * @return Number of pieces, 1 to K
+     */
+    std::size_t size() const noexcept
+    {
+        return m_count;
+    }
+
+    /**
+     * Gets a piece. Pieces are sorted by their bounds.
+     *
+     * @param i Index of the piece, less than size()
+     * @return The piece
+     */
+    const Piece& operator[](std::size_t i) const noexcept
+    {
+        return m_pieces[i];
+    }
+
+    /**
+     * Gets the convex hull of all pieces.
+     *
+     * @return [lowest bound, highest bound]in
+     */
+    Piece hull() const noexcept
+    {
+        return Piece(m_pieces[0u].getX0(), m_pieces[m_count - 1u].getX1());
+    }
+
+    /**
+     * Checks whether a value lies in one of the pieces.
+     *
+     * @param x The value
+     * @return true if some piece contains x
+     */
+    bool contains(T x) const noexcept
+    {
+        for (std::size_t i = 0u; i < m_count; i++)
+        {
+            if (m_pieces[i].getX0() <= x && x <= m_pieces[i].getX1())
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Converts the multi-interval to a string representation.
+     *
+     * @return String in format "[a0, a1]in ∪ [b0, b1]in"
+     */
+    std::string toString() const noexcept
+    {
+        std::string result = m_pieces[0u].toString();
+        for (std::size_t i = 1u; i < m_count; i++)
+        {
+            result += " ∪ " + m_pieces[i].toString();
+        }
+
+        return result;
+    }
+
+    /**
+     * Equality operator.
+     * Two multi-intervals are equal if all pieces match exactly.
+     *
+     * @param other The multi-interval to compare with
+     * @return true if multi-intervals are equal, false otherwise
+     */
+    bool operator==(const MultiIntervalT& other) const noexcept
+    {
+        if (m_count != other.m_count)
+        {
+            return false;
+        }
+        for (std::size_t i = 0u; i < m_count; i++)
+        {
+            if (m_pieces[i] != other.m_pieces[i])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * Inequality operator.
+     *
+     * @param other The multi-interval to compare with
+     * @return true if multi-intervals are not equal, false otherwise
+     */
+    bool operator!=(const MultiIntervalT& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    /**
+     * Set union. Beyond K pieces, the smallest gaps are closed.
+     *
+     * @param other The multi-interval to unite with
+     * @return Resulting multi-interval
+     */
+    MultiIntervalT unite(const MultiIntervalT& other) const noexcept
+    {
+        std::array<Piece, 2u * K> pieces{};
+        for (std::size_t i = 0u; i < m_count; i++)
+        {
+            pieces[i] = m_pieces[i];
+        }
+        for (std::size_t i = 0u; i < other.m_count; i++)
+        {
+            pieces[m_count + i] = other.m_pieces[i];
+        }
+
+        return fromPieces(pieces, m_count + other.m_count);
+    }
+
+    /**
+     * Multiplication; the union of the products of all pairs of pieces.
+     *
+     * @param other The multi-interval to multiply with
+     * @return Resulting multi-interval
+     */
+    MultiIntervalT operator*(const MultiIntervalT& other) const noexcept
+    {
+        return combine(*this, other, [](const Piece& a, const Piece& b, Piece* out) {
+            out[0u] = a * b;
+            return std::size_t{1u};
+        });
+    }
+
+    /**
+     * Addition; the union of the sums of all pairs of pieces.
+     *
+     * @param other The multi-interval to add
+     * @return Resulting multi-interval
+     */
+    MultiIntervalT operator+(const MultiIntervalT& other) const noexcept
+    {
+        return combine(*this, other, [](const Piece& a, const Piece& b, Piece* out) {
+            out[0u] = a + b;
+            return std::size_t{1u};
+        });
+    }
+
+    /**
+     * Subtraction; the union of the differences of all pairs of pieces.
+     *
+     * @param other The multi-interval to subtract
+     * @return Resulting multi-interval
+     */
+    MultiIntervalT operator-(const MultiIntervalT& other) const noexcept
+    {
+        return combine(*this, other, [](const Piece& a, const Piece& b, Piece* out) {
+            out[0u] = a - b;
+            return std::size_t{1u};
+        });
+    }
+
+    /**
+     * Division; the union of the quotients of all pairs of pieces.
+     *
+     * A divisor piece y0 < 0 < y1 is split into [y0, -0] and [0, y1], whose
+     * reciprocals are the two branches [-∞, 1/y0] and [1/y1, +∞]. All other
+     * divisor pieces, including [0, 0], divide as IntervalNumber does.
+     *
+     * @param other The multi-interval to divide by
+     * @return Resulting multi-interval
+     */
+    MultiIntervalT operator/(const MultiIntervalT& other) const noexcept
+    {
+        return combine(*this, other, [](const Piece& a, const Piece& b, Piece* out) {
+            if (b.getX0() < T(0) && b.getX1() > T(0))
+            {
+                out[0u] = a / Piece(b.getX0(), T(-0.0));
+                out[1u] = a / Piece(T(0), b.getX1());
+                return std::size_t{2u};
+            }
+            out[0u] = a / b;
+            return std::size_t{1u};
+        });
+    }
+
+    /**
+     * Absolute value; the union of the absolute values of all pieces.
+     *
+     * @return Resulting multi-interval
+     */
+    MultiIntervalT abs() const noexcept
+    {
+        std::array<Piece, K> pieces{};
+        for (std::size_t i = 0u; i < m_count; i++)
+        {
+            pieces[i] = m_pieces[i].abs();
+        }
+
+        return fromPieces(pieces, m_count);
+    }
+
+};
+
+/**
+ * Multi-interval of double endpoints with up to K pieces.
+ */
+template<std::size_t K>
+using MultiInterval = MultiIntervalT<double, K>;
+
+/**
+ * Global multiplication operator (interval * multi-interval).
+ *
+ * @param x Interval
+ * @param other Multi-interval
+ * @return Resulting multi-interval
+ */
+template<typename T, std::size_t K>
+MultiIntervalT<T, K> operator*(const IntervalNumberT<T>& x, const MultiIntervalT<T, K>& other) noexcept
+{
+    return MultiIntervalT<T, K>(x) * other;
+}
+
+/**
+ * Global addition operator (interval + multi-interval).
+ *
+ * @param x Interval
+ * @param other Multi-interval
+ * @return Resulting multi-interval
+ */
+template<typename T, std::size_t K>
+MultiIntervalT<T, K> operator+(const IntervalNumberT<T>& x, const MultiIntervalT<T, K>& other) noexcept
+{
+    return MultiIntervalT<T, K>(x) + other;
+}
+
+/**
+ * Global subtraction operator (interval - multi-interval).
+ *
+ * @param x Interval
+ * @param other Multi-interval
+ * @return Resulting multi-interval
+ */
+template<typename T, std::size_t K>
+MultiIntervalT<T, K> operator-(const IntervalNumberT<T>& x, const MultiIntervalT<T, K>& other) noexcept
+{
+    return MultiIntervalT<T, K>(x) - other;
+}
+
+/**
+ * Global division operator (interval / multi-interval).
+ *
+ * @param x Interval
+ * @param other Multi-interval
+ * @return Resulting multi-interval
+ */
+template<typename T, std::size_t K>
+MultiIntervalT<T, K> operator/(const IntervalNumberT<T>& x, const MultiIntervalT<T, K>& other) noexcept
+{
+    return MultiIntervalT<T, K>(x) / other;
+}
+
+/**
+ * Global absolute value function.
+ *
+ * @param other Multi-interval
+ * @return Absolute value as multi-interval
+ */
+template<typename T, std::size_t K>
+MultiIntervalT<T, K> abs(const MultiIntervalT<T, K>& other) noexcept
+{
+    return other.abs();
+}
+
+#endif /* MULTIINTERVAL_HPP_ */
@@ -0,0 +1,259 @@
+#ifndef PERFCOUNTERS_HPP_
+#define PERFCOUNTERS_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define ZEROINFINITY_PERF_EVENTS 1
+#else
+#define ZEROINFINITY_PERF_EVENTS 0
+#endif
+
+// Hardware performance counters around a region of interval work.
+//
+// PerfCounters opens one Linux perf_event counter per event for the calling
+// thread, user space only, so it works with the default
+// perf_event_paranoid setting. Counters the kernel or the container refuses
+// -- hardware events are commonly unavailable in virtual machines and
+// containers -- are reported as unavailable; the remaining ones still
+// count. On other platforms every counter is unavailable.
+//
+// Usage:
+//
+//     PerfCounters counters{};
+//     counters.start();
+//     divide(x, y, result);
+//     counters.stop();
+//     std::puts(counters.toJson("batch/divide", x.size()).c_str());
+
+/**
+ * Events measured by PerfCounters.
+ */
+enum class PerfEvent {
+    Cycles,
+    Instructions,
+    BranchMisses,
+    CacheMisses,
+    TaskClock       // Software event, in nanoseconds; available in most containers.
+};
+
+/**
+ * Number of PerfEvent values.
+ */
+static constexpr std::size_t PERF_EVENT_COUNT = 5u;
+
+/**
+ * Gets the JSON key of an event.
+ *
+ * @param event The event
+ * @return Lower-case name
+ */
+inline const char* toString(PerfEvent event) noexcept
+{
+    switch (event)
+    {
+        case PerfEvent::Cycles:
+            return "cycles";
+        case PerfEvent::Instructions:
+            return "instructions";
+        case PerfEvent::BranchMisses:
+            return "branch_misses";
+        case PerfEvent::CacheMisses:
+            return "cache_misses";
+        default:
+            return "task_clock_ns";
+    }
+}
+
+/**
+ * Set of performance counters for the calling thread.
+ */
+class PerfCounters {
+
+private:
+
+    // File descriptor per event; -1 if the event is unavailable.
+    std::array<int, PERF_EVENT_COUNT> m_descriptors{};
+
+    // Counts of the last start()/stop() region, scaled for multiplexing.
+    std::array<std::uint64_t, PERF_EVENT_COUNT> m_counts{};
+
+#if ZEROINFINITY_PERF_EVENTS
+    static int open(PerfEvent event) noexcept
+    {
+        perf_event_attr attributes{};
+        attributes.size = sizeof(attributes);
+        attributes.type = PERF_TYPE_HARDWARE;
+        switch (event)
+        {
+            case PerfEvent::Cycles:
+                attributes.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case PerfEvent::Instructions:
+                attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case PerfEvent::BranchMisses:
+                attributes.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+            case PerfEvent::CacheMisses:
+                attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+                break;
+            default:
+                attributes.type = PERF_TYPE_SOFTWARE;
+                attributes.config = PERF_COUNT_SW_TASK_CLOCK;
+                break;
+        }
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        const long descriptor = syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+
+        return static_cast<int>(descriptor);
+    }
+#endif
+
+public:
+
+    /**
+     * Opens the counters. Never fails; see available().
+     */
+    PerfCounters() noexcept
+    {
+        for (std::size_t i = 0u; i < PERF_EVENT_COUNT; i++)
+        {
+#if ZEROINFINITY_PERF_EVENTS
+            m_descriptors[i] = open(static_cast<PerfEvent>(i));
+#else
+            m_descriptors[i] = -1;
+#endif
+        }
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters()
+    {
+#if ZEROINFINITY_PERF_EVENTS
+        for (int descriptor : m_descriptors)
+        {
+            if (descriptor >= 0)
+            {
+                close(descriptor);
+            }
+        }
+#endif
+    }
+
+    /**
+     * Checks whether an event is counted.
+     *
+     * @param event The event
+     * @return true if the counter could be opened
+     */
+    bool available(PerfEvent event) const noexcept
+    {
+        return m_descriptors[static_cast<std::size_t>(event)] >= 0;
+    }
+
+    /**
+     * Resets and starts all available counters.
+     */
+    void start() noexcept
+    {
+        m_counts.fill(0u);
+#if ZEROINFINITY_PERF_EVENTS
+        for (int descriptor : m_descriptors)
+        {
+            if (descriptor >= 0)
+            {
+                ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+                ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    /**
+     * Stops all available counters and reads them. If the kernel
+     * multiplexed a counter, its count is extrapolated to the whole region.
+     */
+    void stop() noexcept
+    {
+#if ZEROINFINITY_PERF_EVENTS
+        for (int descriptor : m_descriptors)
+        {
+            if (descriptor >= 0)
+            {
+                ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+        for (std::size_t i = 0u; i < PERF_EVENT_COUNT; i++)
+        {
+            // value, time enabled, time running
+            std::uint64_t values[3u] = {0u, 0u, 0u};
+            if (m_descriptors[i] < 0 || ::read(m_descriptors[i], values, sizeof(values)) != static_cast<ssize_t>(sizeof(values)))
+            {
+                continue;
+            }
+            m_counts[i] = (values[2u] == 0u || values[2u] == values[1u]) ? values[0u] :
+                static_cast<std::uint64_t>(static_cast<double>(values[0u]) * static_cast<double>(values[1u]) / static_cast<double>(values[2u]));
+        }
+#endif
+    }
+
+    /**
+     * Gets the count of an event in the last start()/stop() region.
+     *
+     * @param event The event
+     * @return The count; 0 if the event is unavailable
+     */
+    std::uint64_t count(PerfEvent event) const noexcept
+    {
+        return m_counts[static_cast<std::size_t>(event)];
+    }
+
+    /**
+     * Formats the last region as a single-line JSON object: the region name,
+     * the number of intervals, and per event the total and the count per
+     * interval. Unavailable events are null.
+     *
+     * @param region Name of the region; must not need JSON escaping
+     * @param intervals Number of intervals processed in the region
+     * @return JSON object
+     */
+    std::string toJson(const std::string& region, std::size_t intervals) const
+    {
+        std::string json = "{\"region\": \"" + region + "\", \"intervals\": " + std::to_string(intervals);
+        for (std::size_t i = 0u; i < PERF_EVENT_COUNT; i++)
+        {
+            const std::string name = toString(static_cast<PerfEvent>(i));
+            if (m_descriptors[i] < 0)
+            {
+                json += ", \"" + name + "\": null, \"" + name + "_per_interval\": null";
+                continue;
+            }
+
+            char perInterval[32u];
+            std::snprintf(perInterval, sizeof(perInterval), "%.4g", intervals == 0u ? 0.0 : static_cast<double>(m_counts[i]) / static_cast<double>(intervals));
+            json += ", \"" + name + "\": " + std::to_string(m_counts[i]) + ", \"" + name + "_per_interval\": " + perInterval;
+        }
+        json += "}";
+
+        return json;
+    }
+
+};
+
+#endif /* PERFCOUNTERS_HPP_ */
@@ -0,0 +1,493 @@
+#ifndef PRODUCTPLANNER_HPP_
+#define PRODUCTPLANNER_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "IntervalNumber.hpp"
+#include "IntervalReduction.hpp"
+
+// Bracketing planner for product chains x[0] * x[1] * ... * x[n-1].
+//
+// Interval multiplication is not associative once 0 and ∞ meet (paper
+// §5.2), so the bracketing decides both the width of the product and
+// whether it blows up to Ω, -Ω or [-∞, ∞]. planProduct() searches for the
+// bracketing with the tightest hull, evaluateProduct() applies it.
+//
+// The search is a matrix-chain dynamic program over subchains. Two
+// reductions keep it fast on long chains:
+//
+//   - Run compression. A positive finite factor neither creates nor moves a
+//     0 or an ∞ in exact arithmetic and keeps the sign of every endpoint, so
+//     it is folded into its neighbouring run without changing the optimum.
+//     Chains that are entirely finite, or entirely zero-free, are
+//     associative in real arithmetic and become a single run. In floating
+//     point, an overflow creates an ∞ and an underflow a 0, so a factor is
+//     folded only while every corner product of the run stays within the
+//     normal range; otherwise it starts a new run. Only the remaining
+//     factors -- zeros, infinities, sign changes and range breaks -- enter
+//     the program separately, and real chains usually have few of those.
+//
+//   - Sign-class pruning. Every subchain keeps, per sign class of its result
+//     (class of each endpoint: -∞, < 0, 0, > 0, +∞), only the tightest
+//     bracketing, and drops candidates that contain another candidate. The
+//     class determines which indeterminate forms the subchain can produce
+//     with its neighbours, so the kept candidates cover all the blowups.
+//
+// The program is O(m³) in the number m of factors left after compression.
+// Beyond PRODUCT_PLAN_SEGMENT factors it runs on consecutive segments and
+// then on the segment products, which bounds the cost at
+// O(m · PRODUCT_PLAN_SEGMENT²) but finds the optimum only within segments.
+// Tightness is ranked by the number of infinite endpoints, then by width.
+// Ties go to the leftmost split, so the plan is deterministic, also with
+// the parallel variant, which fills each diagonal of the table on several
+// threads.
+
+/**
+ * Bracketing of a product chain, as a binary tree over the factor indices.
+ */
+class ProductPlan {
+
+public:
+
+    /**
+     * Tree node. A leaf is a run [begin, end) of factors multiplied left to
+     * right; an inner node multiplies the products of its two children.
+     */
+    struct Node
+    {
+        std::size_t begin;
+        std::size_t end;
+        std::size_t left;       // Child node of [begin, split); NONE for a leaf.
+        std::size_t right;      // Child node of [split, end); NONE for a leaf.
+    };
+
+    static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+
+private:
+
+    // Nodes in post order; the root is last.
+    std::vector<Node> m_nodes{};
+
+    IntervalNumber evaluateNode(std::size_t node, const std::vector<IntervalNumber>& factors) const noexcept
+    {
+        const Node& current = m_nodes[node];
+        if (current.left == NONE)
+        {
+            IntervalNumber product = factors[current.begin];
+            for (std::size_t i = current.begin + 1u; i < current.end; i++)
+            {
+                product = product * factors[i];
+            }
+
+            return product;
+        }
+
+        return evaluateNode(current.left, factors) * evaluateNode(current.right, factors);
+    }
+
+    void appendNode(std::size_t node, std::string& text) const
+    {
+        const Node& current = m_nodes[node];
+        if (current.left == NONE)
+        {
+            for (std::size_t i = current.begin; i < current.end; i++)
+            {
+                text += (i == current.begin) ? "" : " ";
+                text += std::to_string(i);
+            }
+            return;
+        }
+
+        text += "(";
+        appendNode(current.left, text);
+        text += ") (";
+        appendNode(current.right, text);
+        text += ")";
+    }
+
+public:
+
+    /**
+     * Adds a leaf for the run [begin, end).
+     *
+     * @param begin First factor
+     * @param end One past the last factor
+     * @return Index of the node
+     */
+    std::size_t addLeaf(std::size_t begin, std::size_t end)
+    {
+        m_nodes.push_back(Node{begin, end, NONE, NONE});
+
+        return m_nodes.size() - 1u;
+    }
+
+    /**
+     * Adds an inner node multiplying two existing nodes.
+     *
+     * @param left Node of the left factors
+     * @param right Node of the right factors, adjacent to left
+     * @return Index of the node
+     */
+    std::size_t addProduct(std::size_t left, std::size_t right)
+    {
+        m_nodes.push_back(Node{m_nodes[left].begin, m_nodes[right].end, left, right});
+
+        return m_nodes.size() - 1u;
+    }
+
+    /**
+     * Gets the nodes; the root is last.
+     *
+     * @return The nodes
+     */
+    const std::vector<Node>& nodes() const noexcept
+    {
+        return m_nodes;
+    }
+
+    /**
+     * Multiplies the factors with this bracketing.
+     *
+     * @param factors The chain the plan was made for
+     * @return The product; [1, 1]in for an empty plan
+     */
+    IntervalNumber evaluate(const std::vector<IntervalNumber>& factors) const noexcept
+    {
+        if (m_nodes.empty())
+        {
+            return IntervalNumber(1.0);
+        }
+
+        return evaluateNode(m_nodes.size() - 1u, factors);
+    }
+
+    /**
+     * Converts the plan to a string; runs are listed as space-separated
+     * factor indices, e.g. "(0 1) ((2) (3))".
+     *
+     * @return The bracketing
+     */
+    std::string toString() const
+    {
+        std::string text{};
+        if (!m_nodes.empty())
+        {
+            appendNode(m_nodes.size() - 1u, text);
+        }
+
+        return text;
+    }
+
+};
+
+// Helpers of planProduct().
+
+// Best bracketing of a subchain for one sign class of its product.
+struct ProductCandidate
+{
+    double x0;
+    double x1;
+    std::uint32_t split;        // First compressed factor of the right part; 0 for a single factor.
+    std::uint8_t signClass;
+    std::uint8_t leftSlot;      // Candidate index in the left part.
+    std::uint8_t rightSlot;     // Candidate index in the right part.
+};
+
+// Sign class of an interval: 5 * class(x0) + class(x1), with endpoint
+// classes -∞, < 0, 0, > 0, +∞.
+inline std::uint8_t productSignClass(double x0, double x1) noexcept
+{
+    auto endpointClass = [](double x) -> unsigned {
+        return (x == -INF) ? 0u : (x < 0.0) ? 1u : (x == 0.0) ? 2u : (x < INF) ? 3u : 4u;
+    };
+
+    return static_cast<std::uint8_t>(5u * endpointClass(x0) + endpointClass(x1));
+}
+
+// True if [a0, a1] is tighter than [b0, b1]: fewer infinite endpoints,
+// then smaller width.
+inline bool isTighterProduct(double a0, double a1, double b0, double b1) noexcept
+{
+    const int infiniteA = (std::isinf(a0) ? 1 : 0) + (std::isinf(a1) ? 1 : 0);
+    const int infiniteB = (std::isinf(b0) ? 1 : 0) + (std::isinf(b1) ? 1 : 0);
+    if (infiniteA != infiniteB)
+    {
+        return infiniteA < infiniteB;
+    }
+
+    return (a1 - a0) < (b1 - b0);
+}
+
+// Factor kinds for run compression.
+static constexpr unsigned PRODUCT_RUN_FINITE = 1u;
+static constexpr unsigned PRODUCT_RUN_ZERO_FREE = 2u;
+
+inline unsigned productRunKind(const IntervalNumber& factor) noexcept
+{
+    const double x0 = factor.getX0();
+    const double x1 = factor.getX1();
+
+    return (std::isfinite(x0) && std::isfinite(x1) ? PRODUCT_RUN_FINITE : 0u) | ((x0 > 0.0 || x1 < 0.0) ? PRODUCT_RUN_ZERO_FREE : 0u);
+}
+
+// True for a bounded factor with x0 > 0, which maps every sign class and
+// every 0·∞ case to itself and therefore can be multiplied in at any point.
+inline bool isPositiveFinite(const IntervalNumber& factor) noexcept
+{
+    return factor.getX0() > 0.0 && factor.getX1() < INF;
+}
+
+// True if no corner product of two factors leaves the normal range: every
+// product of finite nonzero endpoints has a magnitude in [min, max]. Only
+// then is a run folded, because an overflow creates an ∞ and an underflow a
+// 0 that another bracketing of the run might avoid.
+inline bool isNormalProduct(const IntervalNumber& a, const IntervalNumber& b) noexcept
+{
+    const double x[2u] = {a.getX0(), a.getX1()};
+    const double y[2u] = {b.getX0(), b.getX1()};
+    bool normal = true;
+    for (double u : x)
+    {
+        for (double v : y)
+        {
+            const double magnitude = std::fabs(u * v);
+            const bool exact = (u == 0.0) || (v == 0.0) || std::isinf(u) || std::isinf(v);
+            normal = normal && (exact || (magnitude >= std::numeric_limits<double>::min() && magnitude <= std::numeric_limits<double>::max()));
+        }
+    }
+
+    return normal;
+}
+
+// Index of subchain [i, j], i <= j, in the triangular table of candidates.
+inline std::size_t productCell(std::size_t i, std::size_t j) noexcept
+{
+    return j * (j + 1u) / 2u + i;
+}
+
+// Adds the plan of candidate slot of subchain [i, j] of a chain whose
+// factors are the plan nodes leaves.
+inline std::size_t buildProductPlan(ProductPlan& plan, const std::vector<std::vector<ProductCandidate>>& table, const std::vector<std::size_t>& leaves,
+                                    std::size_t i, std::size_t j, std::size_t slot)
+{
+    if (i == j)
+    {
+        return leaves[i];
+    }
+
+    const ProductCandidate& candidate = table[productCell(i, j)][slot];
+    const std::size_t left = buildProductPlan(plan, table, leaves, i, candidate.split - 1u, candidate.leftSlot);
+    const std::size_t right = buildProductPlan(plan, table, leaves, candidate.split, j, candidate.rightSlot);
+
+    return plan.addProduct(left, right);
+}
+
+// Most factors the dynamic program takes at once. Longer chains are planned
+// in segments of this length; see planProductChain().
+static constexpr std::size_t PRODUCT_PLAN_SEGMENT = 128u;
+
+/**
+ * Brackets a chain whose factors are existing plan nodes. Up to
+ * PRODUCT_PLAN_SEGMENT factors, the dynamic program finds the tightest
+ * bracketing. A longer chain is cut into consecutive segments of that
+ * length, each is bracketed optimally, and the segment products are
+ * bracketed the same way, so the cost stays O(m · PRODUCT_PLAN_SEGMENT²)
+ * but the plan is optimal only within each segment.
+ *
+ * @param plan The plan the nodes belong to
+ * @param values Product of each factor node
+ * @param leaves The factor nodes
+ * @param threads Threads for the dynamic program
+ * @param product The product of the whole chain under the returned node
+ * @return The root node of the chain
+ */
+inline std::size_t planProductChain(ProductPlan& plan, const std::vector<IntervalNumber>& values, const std::vector<std::size_t>& leaves, std::size_t threads,
+                                    IntervalNumber& product)
+{
+    const std::size_t count = values.size();
+    if (count > PRODUCT_PLAN_SEGMENT)
+    {
+        std::vector<IntervalNumber> segmentValues{};
+        std::vector<std::size_t> segmentLeaves{};
+        for (std::size_t first = 0u; first < count; first += PRODUCT_PLAN_SEGMENT)
+        {
+            const std::size_t last = std::min(first + PRODUCT_PLAN_SEGMENT, count);
+            const std::vector<IntervalNumber> subValues(values.begin() + static_cast<std::ptrdiff_t>(first), values.begin() + static_cast<std::ptrdiff_t>(last));
+            const std::vector<std::size_t> subLeaves(leaves.begin() + static_cast<std::ptrdiff_t>(first), leaves.begin() + static_cast<std::ptrdiff_t>(last));
+            IntervalNumber segmentProduct{};
+            segmentLeaves.push_back(planProductChain(plan, subValues, subLeaves, threads, segmentProduct));
+            segmentValues.push_back(segmentProduct);
+        }
+
+        return planProductChain(plan, segmentValues, segmentLeaves, threads, product);
+    }
+
+    // A NaN factor makes every bracketing NaN, a [-∞, ∞] factor every
+    // bracketing [-∞, ∞].
+    bool isTrivial = false;
+    for (const auto& factor : values)
+    {
+        isTrivial = isTrivial || std::isnan(factor.getX0()) || (factor.getX0() == -INF && factor.getX1() == INF);
+    }
+    if (count == 1u || isTrivial)
+    {
+        // Left fold of everything.
+        std::size_t node = leaves[0u];
+        product = values[0u];
+        for (std::size_t r = 1u; r < count; r++)
+        {
+            node = plan.addProduct(node, leaves[r]);
+            product = product * values[r];
+        }
+        return node;
+    }
+
+    // Candidates of every subchain [i, j].
+    std::vector<std::vector<ProductCandidate>> table(productCell(0u, count));
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        const double x0 = values[i].getX0();
+        const double x1 = values[i].getX1();
+        table[productCell(i, i)].push_back(ProductCandidate{x0, x1, 0u, productSignClass(x0, x1), 0u, 0u});
+    }
+
+    for (std::size_t length = 2u; length <= count; length++)
+    {
+        parallelFor(count - length + 1u, threads, [&](std::size_t i) {
+            const std::size_t j = i + length - 1u;
+
+            std::array<ProductCandidate, 25u> best{};
+            std::array<bool, 25u> found{};
+            for (std::size_t split = i + 1u; split <= j; split++)
+            {
+                const auto& left = table[productCell(i, split - 1u)];
+                const auto& right = table[productCell(split, j)];
+                for (std::size_t l = 0u; l < left.size(); l++)
+                {
+                    for (std::size_t r = 0u; r < right.size(); r++)
+                    {
+                        double x0{};
+                        double x1{};
+                        IntervalNumber::multiplyBounds(left[l].x0, left[l].x1, right[r].x0, right[r].x1, x0, x1);
+
+                        const std::uint8_t signClass = productSignClass(x0, x1);
+                        if (!found[signClass] || isTighterProduct(x0, x1, best[signClass].x0, best[signClass].x1))
+                        {
+                            found[signClass] = true;
+                            best[signClass] = ProductCandidate{x0, x1, static_cast<std::uint32_t>(split), signClass,
+                                                               static_cast<std::uint8_t>(l), static_cast<std::uint8_t>(r)};
+                        }
+                    }
+                }
+            }
+
+            // Multiplication is inclusion isotone: A ⊆ B implies A·C ⊆ B·C.
+            // A candidate that contains another one can therefore never
+            // lead to a tighter product and is dropped.
+            auto& cell = table[productCell(i, j)];
+            for (std::size_t c = 0u; c < best.size(); c++)
+            {
+                bool dominated = !found[c];
+                for (std::size_t other = 0u; other < best.size() && !dominated; other++)
+                {
+                    dominated = found[other] && other != c && best[c].x0 <= best[other].x0 && best[other].x1 <= best[c].x1;
+                }
+                if (!dominated)
+                {
+                    cell.push_back(best[c]);
+                }
+            }
+        });
+    }
+
+    const auto& root = table[productCell(0u, count - 1u)];
+    std::size_t bestSlot = 0u;
+    for (std::size_t slot = 1u; slot < root.size(); slot++)
+    {
+        if (isTighterProduct(root[slot].x0, root[slot].x1, root[bestSlot].x0, root[bestSlot].x1))
+        {
+            bestSlot = slot;
+        }
+    }
+    product = IntervalNumber(root[bestSlot].x0, root[bestSlot].x1);
+
+    return buildProductPlan(plan, table, leaves, 0u, count - 1u, bestSlot);
+}
+
+/**
+ * Finds the bracketing of a product chain with the tightest hull.
+ * Runs in O(m^3) for m compressed factors up to PRODUCT_PLAN_SEGMENT, with
+ * m usually far below the chain length, and in O(m · PRODUCT_PLAN_SEGMENT²)
+ * beyond (see above).
+ *
+ * @param factors The chain
+ * @param threads Threads for the dynamic program; 0 selects
+ *                std::thread::hardware_concurrency(). The plan does not
+ *                depend on it.
+ * @return The plan; empty for an empty chain
+ */
+inline ProductPlan planProduct(const std::vector<IntervalNumber>& factors, std::size_t threads = 1u)
+{
+    ProductPlan plan{};
+    if (factors.empty())
+    {
+        return plan;
+    }
+
+    // Run compression: runs[r] .. runs[r + 1] is compressed factor r.
+    unsigned chainKind = PRODUCT_RUN_FINITE | PRODUCT_RUN_ZERO_FREE;
+    for (const auto& factor : factors)
+    {
+        chainKind &= productRunKind(factor);
+    }
+
+    std::vector<std::size_t> runs{0u};
+    std::vector<IntervalNumber> compressed{};
+    bool runIsPositive = false;
+    for (std::size_t i = 0u; i < factors.size(); i++)
+    {
+        const bool positive = isPositiveFinite(factors[i]);
+        if (i > 0u && (chainKind != 0u || positive || runIsPositive) && isNormalProduct(compressed.back(), factors[i]))
+        {
+            runIsPositive = runIsPositive && positive;
+            compressed.back() = compressed.back() * factors[i];
+            runs.back() = i + 1u;
+            continue;
+        }
+
+        runIsPositive = positive;
+        compressed.push_back(factors[i]);
+        runs.push_back(i + 1u);
+    }
+
+    std::vector<std::size_t> leaves(compressed.size());
+    for (std::size_t r = 0u; r < compressed.size(); r++)
+    {
+        leaves[r] = plan.addLeaf(runs[r], runs[r + 1u]);
+    }
+    IntervalNumber product{};
+    planProductChain(plan, compressed, leaves, threads, product);
+
+    return plan;
+}
+
+/**
+ * Multiplies a chain with the bracketing found by planProduct().
+ *
+ * @param factors The chain
+ * @param threads Threads for planning; see planProduct()
+ * @return The tightest product found; [1, 1]in for an empty chain
+ */
+inline IntervalNumber evaluateProduct(const std::vector<IntervalNumber>& factors, std::size_t threads = 1u)
+{
+    return planProduct(factors, threads).evaluate(factors);
+}
+
+#endif /* PRODUCTPLANNER_HPP_ */
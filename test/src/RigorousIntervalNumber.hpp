@@ -0,0 +1,768 @@
+#ifndef RIGOROUSINTERVALNUMBER_HPP_
+#define RIGOROUSINTERVALNUMBER_HPP_
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <string>
+
+#include "IntervalNumber.hpp"
+
+// Outward-rounded interval arithmetic.
+//
+// IntervalNumberT rounds every endpoint to nearest, so a computed interval
+// may miss the exact result by half an ulp at either end (paper §7.2,
+// limitation 6). RigorousIntervalNumberT evaluates the same operations and
+// then moves each finite endpoint one ulp outward -- but only when an
+// error-free transformation shows that the rounded endpoint is inexact:
+// TwoSum for sums and differences, a fused multiply-add for products and
+// reciprocals. Exact operations, which are common (small integers, powers
+// of two, zeros and infinities), therefore give the same tight intervals as
+// IntervalNumberT, and no floating-point environment is touched: there is
+// no fesetround() call and no global state.
+//
+// std::pow is not correctly rounded everywhere, so finite power endpoints
+// are always widened by one ulp; this is sound for implementations accurate
+// to within one ulp, as glibc's is.
+
+/**
+ * Interval number [x0, x1]in whose operations round outward, so the result
+ * encloses the exact extended-real result of the operation on the stored
+ * endpoints.
+ *
+ * Indeterminate forms follow the same rules as IntervalNumberT. Operands are
+ * taken as exact: a decimal such as 0.1 must be enclosed by the caller.
+ */
+template<typename T>
+class RigorousIntervalNumberT {
+
+public:
+
+    // Endpoint type.
+    using value_type = T;
+
+    // Round-to-nearest counterpart, whose kernels are reused.
+    using Nearest = IntervalNumberT<T>;
+
+private:
+
+    static constexpr T INF = std::numeric_limits<T>::infinity();
+    static constexpr T QUIET_NAN = std::numeric_limits<T>::quiet_NaN();
+    static constexpr T MAX = std::numeric_limits<T>::max();
+
+    // Below this magnitude the rounding error of a product may itself
+    // underflow, so fma() can no longer prove the product exact.
+    static constexpr T EXACT_PRODUCT_MIN = std::numeric_limits<T>::min() / std::numeric_limits<T>::epsilon() * T(4);
+
+    // Internal storage for interval endpoints [x0, x1]
+    std::array<T, 2u> m_interval{};
+
+    /**
+     * Validates and normalizes the interval to ensure x0 <= x1.
+     * If either bound is NaN, the entire interval becomes NaN.
+     */
+    void check() noexcept
+    {
+        if (m_interval[0u] > m_interval[1u])
+        {
+            auto x = m_interval[0u];
+            m_interval[0u] = m_interval[1u];
+            m_interval[1u] = x;
+        }
+
+        if (std::isnan(m_interval[0u]) || std::isnan(m_interval[1u]))
+        {
+            m_interval[0u] = QUIET_NAN;
+            m_interval[1u] = QUIET_NAN;
+        }
+    }
+
+public:
+
+    /**
+     * Default constructor.
+     * Initializes interval to [0, 0]in.
+     */
+    RigorousIntervalNumberT() noexcept = default;
+
+    /**
+     * Single value constructor.
+     * Creates a point interval [x0, x0]in.
+     *
+     * @param x0 The single value for both endpoints
+     */
+    RigorousIntervalNumberT(T x0) noexcept :
+        m_interval{x0, x0}
+    {
+        check();
+    }
+
+    /**
+     * Interval constructor.
+     * Creates an interval [x0, x1]in. Automatically ensures x0 <= x1.
+     *
+     * @param x0 Lower bound
+     * @param x1 Upper bound
+     */
+    RigorousIntervalNumberT(T x0, T x1) noexcept :
+        m_interval{x0, x1}
+    {
+        check();
+    }
+
+    /**
+     * Conversion constructor from a round-to-nearest interval.
+     *
+     * @param other The interval to convert
+     */
+    explicit RigorousIntervalNumberT(const Nearest& other) noexcept :
+        m_interval{other.getX0(), other.getX1()}
+    {
+    }
+
+    /**
+     * Converts to a round-to-nearest interval with the same endpoints.
+     *
+     * @return The interval as IntervalNumberT
+     */
+    Nearest toNearest() const noexcept
+    {
+        return Nearest(m_interval[0u], m_interval[1u]);
+    }
+
+    /**
+     * Gets the lower bound of the interval.
+     *
+     * @return The value x0
+     */
+    T getX0() const noexcept
+    {
+        return m_interval[0u];
+    }
+
+    /**
+     * Gets the upper bound of the interval.
+     *
+     * @return The value x1
+     */
+    T getX1() const noexcept
+    {
+        return m_interval[1u];
+    }
+
+    /**
+     * Converts the interval to a string representation.
+     *
+     * @return String in format "[x0, x1]in"
+     */
+    std::string toString() const noexcept
+    {
+        return toNearest().toString();
+    }
+
+    /**
+     * Equality operator.
+     * Two intervals are equal if both endpoints match exactly.
+     *
+     * @param other The interval to compare with
+     * @return true if intervals are equal, false otherwise
+     */
+    bool operator==(const RigorousIntervalNumberT& other) const noexcept
+    {
+        return (getX0() == other.getX0()) && (getX1() == other.getX1());
+    }
+
+    /**
+     * Inequality operator.
+     *
+     * @param other The interval to compare with
+     * @return true if intervals are not equal, false otherwise
+     */
+    bool operator!=(const RigorousIntervalNumberT& other) const noexcept
+    {
+        return (getX0() != other.getX0()) || (getX1() != other.getX1());
+    }
+
+    /**
+     * Interval multiplication with outward rounding.
+     *
+     * @param other The interval to multiply by
+     * @return Resulting interval
+     */
+    RigorousIntervalNumberT operator*(const RigorousIntervalNumberT& other) const noexcept
+    {
+        T r0{};
+        T r1{};
+        multiplyBounds(m_interval[0u], m_interval[1u], other.m_interval[0u], other.m_interval[1u], r0, r1);
+
+        return RigorousIntervalNumberT(r0, r1);
+    }
+
+    /**
+     * Scalar multiplication operator.
+     *
+     * @param x Scalar value
+     * @return Resulting interval
+     */
+    RigorousIntervalNumberT operator*(T x) const noexcept
+    {
+        return *this * RigorousIntervalNumberT(x);
+    }
+
+    /**
+     * Interval addition with outward rounding.
+     *
+     * @param other The interval to add
+     * @return Resulting interval
+     */
+    RigorousIntervalNumberT operator+(const RigorousIntervalNumberT& other) const noexcept
+    {
+        T r0{};
+        T r1{};
+        addBounds(m_interval[0u], m_interval[1u], other.m_interval[0u], other.m_interval[1u], r0, r1);
+
+        return RigorousIntervalNumberT(r0, r1);
+    }
+
+    /**
+     * Scalar addition operator.
+     *
+     * @param x Scalar value
+     * @return Resulting interval
+     */
+    RigorousIntervalNumberT operator+(T x) const noexcept
+    {
+        return *this + RigorousIntervalNumberT(x);
+    }
+
+    /**
+     * Interval subtraction with outward rounding.
+     *
+     * @param other The interval to subtract
+     * @return Resulting interval
+     */
+    RigorousIntervalNumberT operator-(const RigorousIntervalNumberT& other) const noexcept
+    {
+        T r0{};
+        T r1{};
+        subtractBounds(m_interval[0u], m_interval[1u], other.m_interval[0u], other.m_interval[1u], r0, r1);
+
+        return RigorousIntervalNumberT(r0, r1);
+    }
+
+    /**
+     * Scalar subtraction operator.
+     *
+     * @param x Scalar value
+     * @return Resulting interval
+     */
+    RigorousIntervalNumberT operator-(T x) const noexcept
+    {
+        return *this - RigorousIntervalNumberT(x);
+    }
+
+    /**
+     * Interval division with outward rounding.
+     *
+     * @param other The interval to divide by
+     * @return Resulting interval
+     */
+    RigorousIntervalNumberT operator/(const RigorousIntervalNumberT& other) const noexcept
+    {
+        T r0{};
+        T r1{};
+        divideBounds(m_interval[0u], m_interval[1u], other.m_interval[0u], other.m_interval[1u], r0, r1);
+
+        return RigorousIntervalNumberT(r0, r1);
+    }
+
+    /**
+     * Scalar division operator.
+     *
+     * @param x Scalar value
+     * @return Resulting interval
+     */
+    RigorousIntervalNumberT operator/(T x) const noexcept
+    {
+        return *this / RigorousIntervalNumberT(x);
+    }
+
+    /**
+     * Absolute value of interval. Exact, so no widening is needed.
+     *
+     * @return Absolute value as interval
+     */
+    RigorousIntervalNumberT abs() const noexcept
+    {
+        T r0{};
+        T r1{};
+        Nearest::absBounds(m_interval[0u], m_interval[1u], r0, r1);
+
+        return RigorousIntervalNumberT(r0, r1);
+    }
+
+    /**
+     * Power operation with outward rounding.
+     *
+     * @param exponent Exponent interval
+     * @return Resulting interval
+     */
+    RigorousIntervalNumberT pow(const RigorousIntervalNumberT& exponent) const noexcept
+    {
+        T r0{};
+        T r1{};
+        powBounds(m_interval[0u], m_interval[1u], exponent.m_interval[0u], exponent.m_interval[1u], r0, r1);
+
+        return RigorousIntervalNumberT(r0, r1);
+    }
+
+    // Directed rounding of single results. Each function receives the
+    // operands and the round-to-nearest result and returns the result
+    // rounded toward -∞ (Down) or +∞ (Up). Operations involving an infinite
+    // operand are exact in the extended reals and pass through unchanged.
+
+    /**
+     * Rounds the nearest sum s = a + b toward -∞.
+     *
+     * @param a Left operand
+     * @param b Right operand
+     * @param s Round-to-nearest sum
+     * @return Lower bound of a + b
+     */
+    static T sumDown(T a, T b, T s) noexcept
+    {
+        if (!std::isfinite(a) || !std::isfinite(b))
+        {
+            return s;
+        }
+        if (std::isinf(s))
+        {
+            return (s > 0.0) ? MAX : s;
+        }
+
+        return (sumError(a, b, s) < 0.0) ? std::nextafter(s, -INF) : s;
+    }
+
+    /**
+     * Rounds the nearest sum s = a + b toward +∞.
+     *
+     * @param a Left operand
+     * @param b Right operand
+     * @param s Round-to-nearest sum
+     * @return Upper bound of a + b
+     */
+    static T sumUp(T a, T b, T s) noexcept
+    {
+        if (!std::isfinite(a) || !std::isfinite(b))
+        {
+            return s;
+        }
+        if (std::isinf(s))
+        {
+            return (s < 0.0) ? -MAX : s;
+        }
+
+        return (sumError(a, b, s) > 0.0) ? std::nextafter(s, INF) : s;
+    }
+
+    /**
+     * Rounds the nearest product p = a * b toward -∞.
+     *
+     * @param a Left operand
+     * @param b Right operand
+     * @param p Round-to-nearest product
+     * @return Lower bound of a * b
+     */
+    static T productDown(T a, T b, T p) noexcept
+    {
+        if (!std::isfinite(a) || !std::isfinite(b) || a == 0.0 || b == 0.0)
+        {
+            return p;
+        }
+        if (std::isinf(p))
+        {
+            return (p > 0.0) ? MAX : p;
+        }
+        if (std::fabs(p) < EXACT_PRODUCT_MIN)
+        {
+            return std::nextafter(p, -INF);
+        }
+
+        return (std::fma(a, b, -p) < 0.0) ? std::nextafter(p, -INF) : p;
+    }
+
+    /**
+     * Rounds the nearest product p = a * b toward +∞.
+     *
+     * @param a Left operand
+     * @param b Right operand
+     * @param p Round-to-nearest product
+     * @return Upper bound of a * b
+     */
+    static T productUp(T a, T b, T p) noexcept
+    {
+        if (!std::isfinite(a) || !std::isfinite(b) || a == 0.0 || b == 0.0)
+        {
+            return p;
+        }
+        if (std::isinf(p))
+        {
+            return (p < 0.0) ? -MAX : p;
+        }
+        if (std::fabs(p) < EXACT_PRODUCT_MIN)
+        {
+            return std::nextafter(p, INF);
+        }
+
+        return (std::fma(a, b, -p) > 0.0) ? std::nextafter(p, INF) : p;
+    }
+
+    /**
+     * Rounds the nearest reciprocal q = 1 / y toward -∞.
+     *
+     * @param y Divisor
+     * @param q Round-to-nearest reciprocal
+     * @return Lower bound of 1 / y
+     */
+    static T reciprocalDown(T y, T q) noexcept
+    {
+        if (!std::isfinite(y) || y == 0.0)
+        {
+            return q;
+        }
+
+        // q·y - 1 has the sign of q - 1/y for y > 0 and the opposite sign
+        // for y < 0. It is exact unless q overflowed, where it is ±∞.
+        const T residual = std::fma(q, y, T(-1));
+        const bool above = (y > 0.0) ? (residual > 0.0) : (residual < 0.0);
+
+        return above ? std::nextafter(q, -INF) : q;
+    }
+
+    /**
+     * Rounds the nearest reciprocal q = 1 / y toward +∞.
+     *
+     * @param y Divisor
+     * @param q Round-to-nearest reciprocal
+     * @return Upper bound of 1 / y
+     */
+    static T reciprocalUp(T y, T q) noexcept
+    {
+        if (!std::isfinite(y) || y == 0.0)
+        {
+            return q;
+        }
+
+        const T residual = std::fma(q, y, T(-1));
+        const bool below = (y > 0.0) ? (residual < 0.0) : (residual > 0.0);
+
+        return below ? std::nextafter(q, INF) : q;
+    }
+
+    // Endpoint kernels, with the signatures of the IntervalNumberT kernels.
+
+    /**
+     * Multiplication kernel: [x0,x1]in * [y0,y1]in -> [r0,r1]in.
+     * Every ordinary endpoint product is rounded outward before it is folded
+     * into the hull; the 0·∞ candidates [0, ∞] and [-∞, 0] are exact.
+     *
+     * The endpoint classes select the corners through
+     * IntervalNumberT::productCornerTable(): without zero endpoints only the
+     * extreme corners are rounded, each only in the direction of its bound.
+     *
+     * @param x0 Lower bound of the left operand
+     * @param x1 Upper bound of the left operand
+     * @param y0 Lower bound of the right operand
+     * @param y1 Upper bound of the right operand
+     * @param r0 Lower bound of the result
+     * @param r1 Upper bound of the result
+     */
+    static void multiplyBounds(T x0, T x1, T y0, T y1, T& r0, T& r1) noexcept
+    {
+        T lo = INF;
+        T hi = -INF;
+
+        const unsigned corners = Nearest::productCornerTable()[Nearest::classIndex(x0, x1, y0, y1)];
+        if (corners == Nearest::ALL_CORNERS)
+        {
+            includeProduct(x0, y0, lo, hi);
+            includeProduct(x0, y1, lo, hi);
+            includeProduct(x1, y0, lo, hi);
+            includeProduct(x1, y1, lo, hi);
+        }
+        else
+        {
+            // No endpoint is zero, so there is no 0·∞ candidate and no zero product.
+            const T a[4u] = {x0, x0, x1, x1};
+            const T b[4u] = {y0, y1, y0, y1};
+            const unsigned lower0 = corners & 3u;
+            const unsigned lower1 = (corners >> 2u) & 3u;
+            const unsigned upper0 = (corners >> 4u) & 3u;
+            const unsigned upper1 = corners >> 6u;
+
+            const T lo0 = productDown(a[lower0], b[lower0], a[lower0] * b[lower0]);
+            const T lo1 = productDown(a[lower1], b[lower1], a[lower1] * b[lower1]);
+            const T hi0 = productUp(a[upper0], b[upper0], a[upper0] * b[upper0]);
+            const T hi1 = productUp(a[upper1], b[upper1], a[upper1] * b[upper1]);
+            lo = (lo1 < lo0) ? lo1 : lo0;
+            hi = (hi1 > hi0) ? hi1 : hi0;
+        }
+
+        const bool isNaN = std::isnan(x0) || std::isnan(x1) || std::isnan(y0) || std::isnan(y1);
+
+        r0 = isNaN ? QUIET_NAN : lo;
+        r1 = isNaN ? QUIET_NAN : hi;
+    }
+
+    /**
+     * Addition kernel: [x0,x1]in + [y0,y1]in -> [r0,r1]in.
+     *
+     * @param x0 Lower bound of the left operand
+     * @param x1 Upper bound of the left operand
+     * @param y0 Lower bound of the right operand
+     * @param y1 Upper bound of the right operand
+     * @param r0 Lower bound of the result
+     * @param r1 Upper bound of the result
+     */
+    static void addBounds(T x0, T x1, T y0, T y1, T& r0, T& r1) noexcept
+    {
+        Nearest::addBounds(x0, x1, y0, y1, r0, r1);
+
+        // The bounds are x0 + y0 and x1 + y1 unless an ∞-∞ hull replaced them.
+        if (r0 == x0 + y0)
+        {
+            r0 = sumDown(x0, y0, r0);
+        }
+        if (r1 == x1 + y1)
+        {
+            r1 = sumUp(x1, y1, r1);
+        }
+    }
+
+    /**
+     * Subtraction kernel: [x0,x1]in - [y0,y1]in -> [r0,r1]in.
+     *
+     * @param x0 Lower bound of the left operand
+     * @param x1 Upper bound of the left operand
+     * @param y0 Lower bound of the right operand
+     * @param y1 Upper bound of the right operand
+     * @param r0 Lower bound of the result
+     * @param r1 Upper bound of the result
+     */
+    static void subtractBounds(T x0, T x1, T y0, T y1, T& r0, T& r1) noexcept
+    {
+        Nearest::subtractBounds(x0, x1, y0, y1, r0, r1);
+
+        if (r0 == x0 - y1)
+        {
+            r0 = sumDown(x0, -y1, r0);
+        }
+        if (r1 == x1 - y0)
+        {
+            r1 = sumUp(x1, -y0, r1);
+        }
+    }
+
+    /**
+     * Division kernel: [x0,x1]in / [y0,y1]in -> [r0,r1]in.
+     * The reciprocal of the divisor is taken with the case analysis of
+     * IntervalNumberT, rounded outward, and multiplied with outward rounding.
+     *
+     * @param x0 Lower bound of the dividend
+     * @param x1 Upper bound of the dividend
+     * @param y0 Lower bound of the divisor
+     * @param y1 Upper bound of the divisor
+     * @param r0 Lower bound of the result
+     * @param r1 Upper bound of the result
+     */
+    static void divideBounds(T x0, T x1, T y0, T y1, T& r0, T& r1) noexcept
+    {
+        // 1 / [y0, y1] with every special case of the nearest kernel.
+        T q0{};
+        T q1{};
+        Nearest::divideBounds(T(1), T(1), y0, y1, q0, q1);
+
+        if (q0 == T(1) / y1)
+        {
+            q0 = reciprocalDown(y1, q0);
+        }
+        if (q1 == T(1) / y0)
+        {
+            q1 = reciprocalUp(y0, q1);
+        }
+
+        T lo{};
+        T hi{};
+        multiplyBounds(x0, x1, q0, q1, lo, hi);
+
+        const bool pointZero = (y0 == 0.0) && (y1 == 0.0);
+        const bool isNaN = std::isnan(x0) || std::isnan(x1) || std::isnan(y0) || std::isnan(y1);
+
+        r0 = isNaN ? QUIET_NAN : (pointZero ? -INF : lo);
+        r1 = isNaN ? QUIET_NAN : (pointZero ? INF : hi);
+    }
+
+    /**
+     * Power kernel: [bLo,bHi]in ^ [eLo,eHi]in -> [r0,r1]in.
+     * Finite bounds are widened by one ulp, except a zero lower bound over a
+     * non-negative base, which is exact. A bound that overflowed from finite
+     * operands is clamped to ±MAX.
+     *
+     * @param bLo Lower bound of the base
+     * @param bHi Upper bound of the base
+     * @param eLo Lower bound of the exponent
+     * @param eHi Upper bound of the exponent
+     * @param r0 Lower bound of the result
+     * @param r1 Upper bound of the result
+     */
+    static void powBounds(T bLo, T bHi, T eLo, T eHi, T& r0, T& r1) noexcept
+    {
+        // Always the std::pow corners: the integer fast path of
+        // Nearest::powBounds() squares, which may exceed one ulp.
+        Nearest::powCornerBounds(bLo, bHi, eLo, eHi, r0, r1);
+
+        if (std::isfinite(r0) && !(r0 == 0.0 && bLo >= 0.0))
+        {
+            r0 = std::nextafter(r0, -INF);
+        }
+        if (std::isfinite(r1))
+        {
+            r1 = std::nextafter(r1, INF);
+        }
+
+        // A finite power that overflowed lies beyond MAX, not at the
+        // infinity it rounded to, as in productDown() and productUp().
+        if (std::isfinite(bLo) && std::isfinite(bHi) && std::isfinite(eLo) && std::isfinite(eHi))
+        {
+            r0 = (r0 == INF) ? MAX : r0;
+            r1 = (r1 == -INF) ? -MAX : r1;
+        }
+    }
+
+private:
+
+    /**
+     * Rounding error of s = a + b by TwoSum: a + b = s + error exactly.
+     *
+     * @param a Left operand
+     * @param b Right operand
+     * @param s Round-to-nearest sum, finite
+     * @return The rounding error
+     */
+    static T sumError(T a, T b, T s) noexcept
+    {
+        const T bVirtual = s - a;
+        const T aVirtual = s - bVirtual;
+
+        return (a - aVirtual) + (b - bVirtual);
+    }
+
+    /**
+     * Folds the outward-rounded product a * b into the hull [lo, hi].
+     *
+     * @param a Left endpoint
+     * @param b Right endpoint
+     * @param lo Running lower bound
+     * @param hi Running upper bound
+     */
+    static void includeProduct(T a, T b, T& lo, T& hi) noexcept
+    {
+        T clo{};
+        T chi{};
+        Nearest::productBounds(a, b, clo, chi);
+
+        // clo == chi for an ordinary product; Rule I/II candidates are exact.
+        if (clo == chi)
+        {
+            clo = productDown(a, b, clo);
+            chi = productUp(a, b, chi);
+        }
+
+        Nearest::includeBounds(lo, hi, clo, chi);
+    }
+
+};
+
+/**
+ * Outward-rounded interval number with double endpoints.
+ */
+using RigorousIntervalNumber = RigorousIntervalNumberT<double>;
+
+/**
+ * Global multiplication operator (scalar * interval).
+ *
+ * @param x Scalar value
+ * @param other Interval
+ * @return Resulting interval
+ */
+template<typename T>
+RigorousIntervalNumberT<T> operator*(typename RigorousIntervalNumberT<T>::value_type x, const RigorousIntervalNumberT<T>& other) noexcept
+{
+    return RigorousIntervalNumberT<T>(x) * other;
+}
+
+/**
+ * Global addition operator (scalar + interval).
+ *
+ * @param x Scalar value
+ * @param other Interval
+ * @return Resulting interval
+ */
+template<typename T>
+RigorousIntervalNumberT<T> operator+(typename RigorousIntervalNumberT<T>::value_type x, const RigorousIntervalNumberT<T>& other) noexcept
+{
+    return RigorousIntervalNumberT<T>(x) + other;
+}
+
+/**
+ * Global subtraction operator (scalar - interval).
+ *
+ * @param x Scalar value
+ * @param other Interval
+ * @return Resulting interval
+ */
+template<typename T>
+RigorousIntervalNumberT<T> operator-(typename RigorousIntervalNumberT<T>::value_type x, const RigorousIntervalNumberT<T>& other) noexcept
+{
+    return RigorousIntervalNumberT<T>(x) - other;
+}
+
+/**
+ * Global division operator (scalar / interval).
+ *
+ * @param x Scalar value
+ * @param other Interval
+ * @return Resulting interval
+ */
+template<typename T>
+RigorousIntervalNumberT<T> operator/(typename RigorousIntervalNumberT<T>::value_type x, const RigorousIntervalNumberT<T>& other) noexcept
+{
+    return RigorousIntervalNumberT<T>(x) / other;
+}
+
+/**
+ * Global absolute value function.
+ *
+ * @param other Interval
+ * @return Absolute value as interval
+ */
+template<typename T>
+RigorousIntervalNumberT<T> abs(const RigorousIntervalNumberT<T>& other) noexcept
+{
+    return other.abs();
+}
+
+/**
+ * Global power function (interval ^ interval).
+ *
+ * @param base Base interval
+ * @param exponent Exponent interval
+ * @return Resulting interval
+ */
+template<typename T>
+RigorousIntervalNumberT<T> pow(const RigorousIntervalNumberT<T>& base, const RigorousIntervalNumberT<T>& exponent) noexcept
+{
+    return base.pow(exponent);
+}
+
+#endif /* RIGOROUSINTERVALNUMBER_HPP_ */
@@ -0,0 +1,471 @@
+#ifndef SIGNCLASSINTERVAL_HPP_
+#define SIGNCLASSINTERVAL_HPP_
+
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include "IntervalNumber.hpp"
+
+// Intervals whose sign class is part of the type.
+//
+// An IntervalNumber operation has to expect every endpoint class: 0·∞
+// corners, ∞-∞ sums, divisors reaching zero and NaN. When a quantity is
+// known to be strictly positive, non-negative or finite, most of these
+// cases cannot occur. SignClassIntervalT records that knowledge in the type,
+// so the operators select the single relevant case at compile time:
+//
+//   non-negative · non-negative   [x0·y0, x1·y1]
+//   finite · finite                four plain corners, no 0·∞ test
+//   x + y without opposite ∞       [x0 + y0, x1 + y1]
+//   non-negative / positive        x · [1/y1, 1/y0]
+//
+// Every result is bit-identical to the IntervalNumber operation on the same
+// endpoints. The type of a result carries the class that is guaranteed
+// after rounding: a positive product may underflow to zero, so it is only
+// non-negative, and a finite product may overflow, so it is a general
+// IntervalNumberT. Operations without a special case convert their operands
+// to IntervalNumberT, as does every conversion to IntervalNumberT.
+
+/**
+ * Sign class of an interval [x0, x1]in. No class admits NaN.
+ */
+enum class SignClass {
+    Finite,         // -∞ < x0 <= x1 < ∞.
+    NonNegative,    // 0 <= x0 <= x1 <= ∞.
+    Positive        // 0 < x0 <= x1 <= ∞.
+};
+
+/**
+ * Checks whether every interval of a class is non-negative.
+ *
+ * @param s The sign class
+ * @return true for NonNegative and Positive
+ */
+constexpr bool isNonNegativeClass(SignClass s) noexcept
+{
+    return s == SignClass::NonNegative || s == SignClass::Positive;
+}
+
+/**
+ * Checks whether every interval of class s also belongs to class t.
+ *
+ * @param s The narrower sign class
+ * @param t The wider sign class
+ * @return true if s is t or Positive is widened to NonNegative
+ */
+constexpr bool isSignSubclass(SignClass s, SignClass t) noexcept
+{
+    return s == t || (s == SignClass::Positive && t == SignClass::NonNegative);
+}
+
+/**
+ * Interval number [x0, x1]in of a known sign class S.
+ *
+ * The endpoints must belong to S; this is a precondition of the
+ * constructors and is not checked. admits() tests it.
+ */
+template<typename T, SignClass S>
+class SignClassIntervalT {
+
+public:
+
+    // Endpoint type.
+    using value_type = T;
+
+    // General interval type.
+    using Interval = IntervalNumberT<T>;
+
+    // Sign class of every value of this type.
+    static constexpr SignClass SIGN_CLASS = S;
+
+private:
+
+    // Lower bound.
+    T m_x0{};
+
+    // Upper bound.
+    T m_x1{};
+
+public:
+
+    /**
+     * Checks whether [x0, x1]in belongs to the sign class S.
+     *
+     * @param x0 Lower bound
+     * @param x1 Upper bound
+     * @return true if the endpoints satisfy the precondition of the constructors
+     */
+    static constexpr bool admits(T x0, T x1) noexcept
+    {
+        const T inf = std::numeric_limits<T>::infinity();
+        const bool ordered = (x0 <= x1);
+
+        if (S == SignClass::Finite)
+        {
+            return ordered && x0 > -inf && x1 < inf;
+        }
+
+        return ordered && ((S == SignClass::Positive) ? (x0 > T(0)) : (x0 >= T(0)));
+    }
+
+    /**
+     * Single value constructor.
+     * Creates the point interval [x0, x0]in.
+     *
+     * @param x0 The single value for both endpoints, in S
+     */
+    explicit constexpr SignClassIntervalT(T x0) noexcept :
+        m_x0{x0}, m_x1{x0}
+    {
+    }
+
+    /**
+     * Interval constructor.
+     * Creates the interval [x0, x1]in.
+     *
+     * @param x0 Lower bound
+     * @param x1 Upper bound, at least x0; [x0, x1] must be in S
+     */
+    constexpr SignClassIntervalT(T x0, T x1) noexcept :
+        m_x0{x0}, m_x1{x1}
+    {
+    }
+
+    /**
+     * Conversion constructor from a general interval in S.
+     *
+     * @param x The interval; must be in S
+     */
+    explicit constexpr SignClassIntervalT(const Interval& x) noexcept :
+        m_x0{x.getX0()}, m_x1{x.getX1()}
+    {
+    }
+
+    /**
+     * Conversion constructor from a narrower sign class, e.g. a positive
+     * interval to a non-negative one.
+     *
+     * @param x The interval
+     */
+    template<SignClass U, typename = std::enable_if_t<U != S && isSignSubclass(U, S)>>
+    constexpr SignClassIntervalT(const SignClassIntervalT<T, U>& x) noexcept :
+        m_x0{x.getX0()}, m_x1{x.getX1()}
+    {
+    }
+
+    /**
+     * Gets the lower bound of the interval.
+     *
+     * @return The value x0
+     */
+    constexpr T getX0() const noexcept
+    {
+        return m_x0;
+    }
+
+    /**
+     * Gets the upper bound of the interval.
+     *
+     * @return The value x1
+     */
+    constexpr T getX1() const noexcept
+    {
+        return m_x1;
+    }
+
+    /**
+     * Converts the interval to the general interval type.
+     *
+     * @return [x0, x1]in as IntervalNumberT
+     */
+    constexpr Interval interval() const noexcept
+    {
+        return Interval(m_x0, m_x1);
+    }
+
+    /**
+     * Implicit conversion to the general interval type.
+     *
+     * @return [x0, x1]in as IntervalNumberT
+     */
+    constexpr operator Interval() const noexcept
+    {
+        return interval();
+    }
+
+    /**
+     * Converts the interval to a string representation.
+     *
+     * @return String in format "[x0, x1]in"
+     */
+    std::string toString() const noexcept
+    {
+        return interval().toString();
+    }
+
+};
+
+/**
+ * Strictly positive interval with double endpoints; x1 may be +∞.
+ */
+using PositiveInterval = SignClassIntervalT<double, SignClass::Positive>;
+
+/**
+ * Non-negative interval with double endpoints; x1 may be +∞.
+ */
+using NonNegativeInterval = SignClassIntervalT<double, SignClass::NonNegative>;
+
+/**
+ * Finite interval with double endpoints.
+ */
+using FiniteInterval = SignClassIntervalT<double, SignClass::Finite>;
+
+/**
+ * Product of non-negative intervals: [x0·y0, x1·y1]. All corners are
+ * non-negative, so the outer corners are extreme; a 0·∞ corner gives the
+ * Rule I candidate [0, ∞], which these two corners already cover.
+ *
+ * @param x0 Lower bound of the left operand, at least 0
+ * @param x1 Upper bound of the left operand
+ * @param y0 Lower bound of the right operand, at least 0
+ * @param y1 Upper bound of the right operand
+ * @return The product; bit-identical to the IntervalNumberT product
+ */
+template<typename T>
+constexpr SignClassIntervalT<T, SignClass::NonNegative> signClassNonNegativeProduct(T x0, T x1, T y0, T y1) noexcept
+{
+    using Interval = IntervalNumberT<T>;
+
+    T lo{};
+    T hi{};
+    T clo{};
+    T chi{};
+    Interval::productBounds(x0, y0, lo, hi);
+    Interval::productBounds(x1, y1, clo, chi);
+    Interval::includeBounds(lo, hi, clo, chi);
+
+    return SignClassIntervalT<T, SignClass::NonNegative>(lo, hi);
+}
+
+/**
+ * Addition; x + y = [x0 + y0, x1 + y1]. No pair of sign classes has
+ * opposite infinities, so there is no ∞-∞ hull. The sum of non-negative
+ * intervals is non-negative, and positive if either operand is positive.
+ *
+ * @param x Left operand
+ * @param y Right operand
+ * @return The sum; a general interval unless both operands are non-negative
+ */
+template<typename T, SignClass S, SignClass U>
+constexpr auto operator+(const SignClassIntervalT<T, S>& x, const SignClassIntervalT<T, U>& y) noexcept
+{
+    // Folded like IntervalNumberT, so [-0, 0] + [0, 0] keeps the bound -0.
+    T lo = x.getX0() + y.getX0();
+    T hi = lo;
+    const T s1 = x.getX1() + y.getX1();
+    IntervalNumberT<T>::includeBounds(lo, hi, s1, s1);
+
+    if constexpr (isNonNegativeClass(S) && isNonNegativeClass(U))
+    {
+        constexpr SignClass SUM = (S == SignClass::Positive || U == SignClass::Positive) ? SignClass::Positive : SignClass::NonNegative;
+
+        return SignClassIntervalT<T, SUM>(lo, hi);
+    }
+    else
+    {
+        return IntervalNumberT<T>(lo, hi);
+    }
+}
+
+/**
+ * Subtraction; x - y = [x0 - y1, x1 - y0] unless both operands may reach
+ * +∞, which leaves the ∞-∞ case to IntervalNumberT.
+ *
+ * @param x Left operand
+ * @param y Right operand
+ * @return The difference
+ */
+template<typename T, SignClass S, SignClass U>
+constexpr IntervalNumberT<T> operator-(const SignClassIntervalT<T, S>& x, const SignClassIntervalT<T, U>& y) noexcept
+{
+    if constexpr (isNonNegativeClass(S) && isNonNegativeClass(U))
+    {
+        return x.interval() - y.interval();
+    }
+    else
+    {
+        T lo = x.getX0() - y.getX1();
+        T hi = lo;
+        const T d1 = x.getX1() - y.getX0();
+        IntervalNumberT<T>::includeBounds(lo, hi, d1, d1);
+
+        return IntervalNumberT<T>(lo, hi);
+    }
+}
+
+/**
+ * Multiplication. Non-negative operands need the two outer corners only;
+ * finite operands need all four corners but no 0·∞ test. Other pairs
+ * multiply as IntervalNumberT.
+ *
+ * @param x Left operand
+ * @param y Right operand
+ * @return The product; non-negative for non-negative operands, general otherwise
+ */
+template<typename T, SignClass S, SignClass U>
+constexpr auto operator*(const SignClassIntervalT<T, S>& x, const SignClassIntervalT<T, U>& y) noexcept
+{
+    if constexpr (isNonNegativeClass(S) && isNonNegativeClass(U))
+    {
+        return signClassNonNegativeProduct(x.getX0(), x.getX1(), y.getX0(), y.getX1());
+    }
+    else if constexpr (S == SignClass::Finite && U == SignClass::Finite)
+    {
+        // Finite corners never form 0·∞; fold them in the IntervalNumberT order.
+        const T p00 = x.getX0() * y.getX0();
+        const T p01 = x.getX0() * y.getX1();
+        const T p10 = x.getX1() * y.getX0();
+        const T p11 = x.getX1() * y.getX1();
+
+        T lo = p00;
+        T hi = p00;
+        IntervalNumberT<T>::includeBounds(lo, hi, p01, p01);
+        IntervalNumberT<T>::includeBounds(lo, hi, p10, p10);
+        IntervalNumberT<T>::includeBounds(lo, hi, p11, p11);
+
+        return IntervalNumberT<T>(lo, hi);
+    }
+    else
+    {
+        return x.interval() * y.interval();
+    }
+}
+
+/**
+ * Division. A non-negative dividend over a positive divisor is the product
+ * with the non-negative reciprocal [1/y1, 1/y0]; other pairs divide as
+ * IntervalNumberT.
+ *
+ * @param x Left operand
+ * @param y Right operand
+ * @return The quotient; non-negative for the special case, general otherwise
+ */
+template<typename T, SignClass S, SignClass U>
+constexpr auto operator/(const SignClassIntervalT<T, S>& x, const SignClassIntervalT<T, U>& y) noexcept
+{
+    if constexpr (isNonNegativeClass(S) && U == SignClass::Positive)
+    {
+        return signClassNonNegativeProduct(x.getX0(), x.getX1(), T(1) / y.getX1(), T(1) / y.getX0());
+    }
+    else
+    {
+        return x.interval() / y.interval();
+    }
+}
+
+/**
+ * Addition with a general interval.
+ *
+ * @param x Left operand
+ * @param y Right operand
+ * @return x + y as IntervalNumberT
+ */
+template<typename T, SignClass S>
+constexpr IntervalNumberT<T> operator+(const SignClassIntervalT<T, S>& x, const IntervalNumberT<T>& y) noexcept
+{
+    return x.interval() + y;
+}
+
+/**
+ * Addition with a general interval.
+ *
+ * @param x Left operand
+ * @param y Right operand
+ * @return x + y as IntervalNumberT
+ */
+template<typename T, SignClass S>
+constexpr IntervalNumberT<T> operator+(const IntervalNumberT<T>& x, const SignClassIntervalT<T, S>& y) noexcept
+{
+    return x + y.interval();
+}
+
+/**
+ * Subtraction with a general interval.
+ *
+ * @param x Left operand
+ * @param y Right operand
+ * @return x - y as IntervalNumberT
+ */
+template<typename T, SignClass S>
+constexpr IntervalNumberT<T> operator-(const SignClassIntervalT<T, S>& x, const IntervalNumberT<T>& y) noexcept
+{
+    return x.interval() - y;
+}
+
+/**
+ * Subtraction with a general interval.
+ *
+ * @param x Left operand
+ * @param y Right operand
+ * @return x - y as IntervalNumberT
+ */
+template<typename T, SignClass S>
+constexpr IntervalNumberT<T> operator-(const IntervalNumberT<T>& x, const SignClassIntervalT<T, S>& y) noexcept
+{
+    return x - y.interval();
+}
+
+/**
+ * Multiplication with a general interval.
+ *
+ * @param x Left operand
+ * @param y Right operand
+ * @return x * y as IntervalNumberT
+ */
+template<typename T, SignClass S>
+constexpr IntervalNumberT<T> operator*(const SignClassIntervalT<T, S>& x, const IntervalNumberT<T>& y) noexcept
+{
+    return x.interval() * y;
+}
+
+/**
+ * Multiplication with a general interval.
+ *
+ * @param x Left operand
+ * @param y Right operand
+ * @return x * y as IntervalNumberT
+ */
+template<typename T, SignClass S>
+constexpr IntervalNumberT<T> operator*(const IntervalNumberT<T>& x, const SignClassIntervalT<T, S>& y) noexcept
+{
+    return x * y.interval();
+}
+
+/**
+ * Division with a general interval.
+ *
+ * @param x Left operand
+ * @param y Right operand
+ * @return x / y as IntervalNumberT
+ */
+template<typename T, SignClass S>
+constexpr IntervalNumberT<T> operator/(const SignClassIntervalT<T, S>& x, const IntervalNumberT<T>& y) noexcept
+{
+    return x.interval() / y;
+}
+
+/**
+ * Division with a general interval.
+ *
+ * @param x Left operand
+ * @param y Right operand
+ * @return x / y as IntervalNumberT
+ */
+template<typename T, SignClass S>
+constexpr IntervalNumberT<T> operator/(const IntervalNumberT<T>& x, const SignClassIntervalT<T, S>& y) noexcept
+{
+    return x / y.interval();
+}
+
+#endif /* SIGNCLASSINTERVAL_HPP_ */
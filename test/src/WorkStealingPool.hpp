@@ -0,0 +1,228 @@
+#ifndef WORKSTEALINGPOOL_HPP_
+#define WORKSTEALINGPOOL_HPP_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Thread pool with per-thread task queues and work stealing.
+//
+// run() deals the tasks out to the queues in contiguous ranges and waits
+// until all are done. A thread takes tasks from the back of its own queue
+// and, once that is empty, steals from the front of the other queues, so
+// uneven task costs -- boxes that are pruned at once next to boxes that are
+// bisected deep down -- still keep every thread busy. The pool owns its
+// threads for its whole lifetime; the calling thread of run() works as
+// thread 0.
+
+/**
+ * Fixed-size work-stealing thread pool.
+ */
+class WorkStealingPool {
+
+private:
+
+    /**
+     * Task queue of one thread.
+     */
+    struct Queue
+    {
+        std::mutex mutex{};
+        std::deque<std::size_t> tasks{};
+    };
+
+    // One queue per thread, including the calling thread.
+    std::vector<std::unique_ptr<Queue>> m_queues{};
+
+    // Threads 1 .. size()-1.
+    std::vector<std::thread> m_workers{};
+
+    // Guards the fields below.
+    std::mutex m_mutex{};
+    std::condition_variable m_wake{};
+    std::condition_variable m_idle{};
+
+    // Function of the current run(); null between runs.
+    const std::function<void(std::size_t)>* m_function{nullptr};
+
+    // Incremented by every run().
+    std::size_t m_generation{0u};
+
+    // Workers that have not yet run out of tasks in the current run().
+    std::size_t m_busy{0u};
+
+    bool m_stop{false};
+
+    /**
+     * Takes the next task: the newest of the own queue, else the oldest of
+     * another queue.
+     *
+     * @param thread Index of the calling thread
+     * @param task The task
+     * @return false if all queues are empty
+     */
+    bool next(std::size_t thread, std::size_t& task)
+    {
+        const std::size_t threads = m_queues.size();
+        for (std::size_t k = 0u; k < threads; k++)
+        {
+            Queue& queue = *m_queues[(thread + k) % threads];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty())
+            {
+                continue;
+            }
+            if (k == 0u)
+            {
+                task = queue.tasks.back();
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+            }
+
+            return true;
+        }
+
+        return false;
+    }
+
+    void drain(std::size_t thread, const std::function<void(std::size_t)>& function)
+    {
+        std::size_t task{};
+        while (next(thread, task))
+        {
+            function(task);
+        }
+    }
+
+    void work(std::size_t thread)
+    {
+        std::size_t seen = 0u;
+        for (;;)
+        {
+            const std::function<void(std::size_t)>* function{nullptr};
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [&]() { return m_stop || m_generation != seen; });
+                if (m_stop)
+                {
+                    return;
+                }
+                seen = m_generation;
+                function = m_function;
+            }
+
+            drain(thread, *function);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_busy--;
+            if (m_busy == 0u)
+            {
+                m_idle.notify_all();
+            }
+        }
+    }
+
+public:
+
+    /**
+     * Starts the threads.
+     *
+     * @param threads Number of threads, including the caller of run();
+     *                0 selects std::thread::hardware_concurrency()
+     */
+    explicit WorkStealingPool(std::size_t threads = 0u)
+    {
+        if (threads == 0u)
+        {
+            threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1u);
+        }
+
+        for (std::size_t thread = 0u; thread < threads; thread++)
+        {
+            m_queues.push_back(std::make_unique<Queue>());
+        }
+        m_workers.reserve(threads - 1u);
+        for (std::size_t thread = 1u; thread < threads; thread++)
+        {
+            m_workers.emplace_back(&WorkStealingPool::work, this, thread);
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (auto& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    /**
+     * Gets the number of threads.
+     *
+     * @return Number of threads, including the caller of run()
+     */
+    std::size_t size() const noexcept
+    {
+        return m_queues.size();
+    }
+
+    /**
+     * Runs f(task) for task = 0 .. tasks-1 and waits for all of them. Which
+     * thread runs a task is unspecified; f must not call run().
+     *
+     * @param tasks Number of tasks
+     * @param f Function called once per task
+     */
+    template<typename Function>
+    void run(std::size_t tasks, const Function& f)
+    {
+        const std::function<void(std::size_t)> function = std::cref(f);
+
+        const std::size_t threads = m_queues.size();
+        for (std::size_t thread = 0u; thread < threads; thread++)
+        {
+            Queue& queue = *m_queues[thread];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            for (std::size_t task = tasks * thread / threads; task < tasks * (thread + 1u) / threads; task++)
+            {
+                queue.tasks.push_back(task);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_function = &function;
+            m_busy = m_workers.size();
+            m_generation++;
+        }
+        m_wake.notify_all();
+
+        drain(0u, function);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [&]() { return m_busy == 0u; });
+        m_function = nullptr;
+    }
+
+};
+
+#endif /* WORKSTEALINGPOOL_HPP_ */
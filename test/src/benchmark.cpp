@@ -0,0 +1,1254 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "CompressedIntervalArray.hpp"
+#include "DoubleDoubleInterval.hpp"
+#include "DoubleDoubleIntervalArray.hpp"
+#include "ExpressionParser.hpp"
+#include "ExpressionTape.hpp"
+#include "GlobalOptimizer.hpp"
+#include "IntervalArray.hpp"
+#include "IntervalExpression.hpp"
+#include "IntervalFile.hpp"
+#include "IntervalNumber.hpp"
+#include "IntervalReduction.hpp"
+#include "IntervalStream.hpp"
+#include "IntervalText.hpp"
+#include "IntervalTranscendental.hpp"
+#include "IntervalTree.hpp"
+#include "PerfCounters.hpp"
+#include "RigorousIntervalNumber.hpp"
+#include "SignClassInterval.hpp"
+
+// Timing of every IntervalNumber operation, scalar and batch.
+//
+// Each benchmark applies one operation to COUNT operand pairs per iteration
+// and reports time/op (time per interval operation) and items_per_second
+// (operations per second). Benchmarks are named <mode>/<operation>/<inputs>,
+// so a subset can be selected with --benchmark_filter, e.g.
+// --benchmark_filter=batch/divide.
+//
+// With --perf_counters the benchmarks are not run; instead every operation
+// is measured once with hardware performance counters (see PerfCounters.hpp)
+// and one JSON object per region is printed, with cycles, instructions,
+// branch misses and cache misses per interval. The batch_large regions work
+// on arrays far larger than the caches.
+
+namespace
+{
+
+// Operand pairs per benchmark iteration. Two arrays of COUNT intervals fit
+// in the L2 cache, so the numbers measure arithmetic, not memory.
+constexpr std::size_t COUNT = 4096u;
+
+// Passes over COUNT intervals per performance counter region.
+constexpr std::size_t PERF_PASSES = 256u;
+
+// Operand pairs of the batch_large performance counter regions.
+constexpr std::size_t LARGE_COUNT = 1u << 21u;
+
+/**
+ * Input distributions.
+ */
+enum class Inputs {
+    Finite,         // Finite endpoints of either sign.
+    ZeroSpanning,   // x0 < 0 < x1.
+    Infinite,       // Finite intervals, each endpoint infinite with probability 1/4.
+    Indeterminate   // Endpoints drawn mostly from {-∞, 0, 1, ∞}: 0·∞, ∞-∞, 0/0, 1^∞ corners.
+};
+
+const char* toString(Inputs inputs)
+{
+    switch (inputs)
+    {
+        case Inputs::Finite:
+            return "finite";
+        case Inputs::ZeroSpanning:
+            return "zero_spanning";
+        case Inputs::Infinite:
+            return "infinite";
+        default:
+            return "indeterminate";
+    }
+}
+
+/**
+ * Generates intervals of a distribution. The seed is fixed, so every run and
+ * every operation sees the same operands.
+ *
+ * @param inputs The distribution
+ * @param seed Random seed, to draw different left and right operands
+ * @param count Number of intervals
+ * @return The intervals
+ */
+std::vector<IntervalNumber> makeIntervals(Inputs inputs, unsigned seed, std::size_t count = COUNT)
+{
+    std::mt19937_64 generator{seed};
+    std::uniform_real_distribution<double> magnitude{0.001, 100.0};
+    std::uniform_int_distribution<int> quarter{0, 3};
+    std::bernoulli_distribution coin{0.5};
+
+    const double corners[4u] = {-INF, 0.0, 1.0, INF};
+
+    std::vector<IntervalNumber> intervals{};
+    intervals.reserve(count);
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        double x0 = coin(generator) ? magnitude(generator) : -magnitude(generator);
+        double x1 = coin(generator) ? magnitude(generator) : -magnitude(generator);
+
+        switch (inputs)
+        {
+            case Inputs::Finite:
+                break;
+            case Inputs::ZeroSpanning:
+                x0 = -magnitude(generator);
+                x1 = magnitude(generator);
+                break;
+            case Inputs::Infinite:
+                if (quarter(generator) == 0)
+                {
+                    x0 = -INF;
+                }
+                if (quarter(generator) == 0)
+                {
+                    x1 = INF;
+                }
+                break;
+            case Inputs::Indeterminate:
+                if (quarter(generator) != 0)
+                {
+                    x0 = corners[quarter(generator)];
+                }
+                if (quarter(generator) != 0)
+                {
+                    x1 = corners[quarter(generator)];
+                }
+                break;
+        }
+
+        intervals.emplace_back(x0, x1);
+    }
+
+    return intervals;
+}
+
+IntervalArray toArray(const std::vector<IntervalNumber>& intervals)
+{
+    IntervalArray array{};
+    array.reserve(intervals.size());
+    for (const auto& interval : intervals)
+    {
+        array.pushBack(interval);
+    }
+
+    return array;
+}
+
+// Reports the time per operation (printed as e.g. 2.5ns) and operations per
+// second for COUNT operations per iteration.
+void setCounters(benchmark::State& state)
+{
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(COUNT));
+    state.counters["time/op"] = benchmark::Counter(static_cast<double>(COUNT), benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+// COUNT copies of the point exponent [e, e]; built once per exponent.
+const IntervalArray& pointExponents(double e)
+{
+    static const IntervalArray integer = toArray(std::vector<IntervalNumber>(COUNT, IntervalNumber(3.0)));
+    static const IntervalArray real = toArray(std::vector<IntervalNumber>(COUNT, IntervalNumber(2.5)));
+
+    return (e == 3.0) ? integer : real;
+}
+
+// Operations. Each provides the scalar operator and the IntervalArray
+// batch function; unary operations ignore the right operand. The four
+// arithmetic operations also provide the RigorousIntervalNumber operator and
+// the DoubleDoubleInterval operator and batch function.
+
+struct Add
+{
+    static constexpr const char* NAME = "add";
+    static IntervalNumber scalar(const IntervalNumber& a, const IntervalNumber& b) { return a + b; }
+    static RigorousIntervalNumber rigorous(const RigorousIntervalNumber& a, const RigorousIntervalNumber& b) { return a + b; }
+    static void batch(const IntervalArray& x, const IntervalArray& y, IntervalArray& r) { add(x, y, r); }
+    static DoubleDoubleInterval doubleDouble(const DoubleDoubleInterval& a, const DoubleDoubleInterval& b) { return a + b; }
+    static void doubleDoubleBatch(const DoubleDoubleIntervalArray& x, const DoubleDoubleIntervalArray& y, DoubleDoubleIntervalArray& r) { add(x, y, r); }
+};
+
+struct Subtract
+{
+    static constexpr const char* NAME = "subtract";
+    static IntervalNumber scalar(const IntervalNumber& a, const IntervalNumber& b) { return a - b; }
+    static RigorousIntervalNumber rigorous(const RigorousIntervalNumber& a, const RigorousIntervalNumber& b) { return a - b; }
+    static void batch(const IntervalArray& x, const IntervalArray& y, IntervalArray& r) { subtract(x, y, r); }
+    static DoubleDoubleInterval doubleDouble(const DoubleDoubleInterval& a, const DoubleDoubleInterval& b) { return a - b; }
+    static void doubleDoubleBatch(const DoubleDoubleIntervalArray& x, const DoubleDoubleIntervalArray& y, DoubleDoubleIntervalArray& r) { subtract(x, y, r); }
+};
+
+struct Multiply
+{
+    static constexpr const char* NAME = "multiply";
+    static IntervalNumber scalar(const IntervalNumber& a, const IntervalNumber& b) { return a * b; }
+    static RigorousIntervalNumber rigorous(const RigorousIntervalNumber& a, const RigorousIntervalNumber& b) { return a * b; }
+    static void batch(const IntervalArray& x, const IntervalArray& y, IntervalArray& r) { multiply(x, y, r); }
+    static DoubleDoubleInterval doubleDouble(const DoubleDoubleInterval& a, const DoubleDoubleInterval& b) { return a * b; }
+    static void doubleDoubleBatch(const DoubleDoubleIntervalArray& x, const DoubleDoubleIntervalArray& y, DoubleDoubleIntervalArray& r) { multiply(x, y, r); }
+};
+
+struct Divide
+{
+    static constexpr const char* NAME = "divide";
+    static IntervalNumber scalar(const IntervalNumber& a, const IntervalNumber& b) { return a / b; }
+    static RigorousIntervalNumber rigorous(const RigorousIntervalNumber& a, const RigorousIntervalNumber& b) { return a / b; }
+    static void batch(const IntervalArray& x, const IntervalArray& y, IntervalArray& r) { divide(x, y, r); }
+    static DoubleDoubleInterval doubleDouble(const DoubleDoubleInterval& a, const DoubleDoubleInterval& b) { return a / b; }
+    static void doubleDoubleBatch(const DoubleDoubleIntervalArray& x, const DoubleDoubleIntervalArray& y, DoubleDoubleIntervalArray& r) { divide(x, y, r); }
+};
+
+struct Abs
+{
+    static constexpr const char* NAME = "abs";
+    static IntervalNumber scalar(const IntervalNumber& a, const IntervalNumber&) { return a.abs(); }
+    static void batch(const IntervalArray& x, const IntervalArray&, IntervalArray& r) { abs(x, r); }
+};
+
+struct Sqr
+{
+    static constexpr const char* NAME = "sqr";
+    static IntervalNumber scalar(const IntervalNumber& a, const IntervalNumber&) { return sqr(a); }
+    static void batch(const IntervalArray& x, const IntervalArray&, IntervalArray& r) { sqr(x, r); }
+};
+
+// a * b + a, with the left operand reused as the addend.
+struct Fma
+{
+    static constexpr const char* NAME = "fma";
+    static IntervalNumber scalar(const IntervalNumber& a, const IntervalNumber& b) { return fma(a, b, a); }
+    static void batch(const IntervalArray& x, const IntervalArray& y, IntervalArray& r) { fma(x, y, x, r); }
+};
+
+struct Pow
+{
+    static constexpr const char* NAME = "pow";
+    static IntervalNumber scalar(const IntervalNumber& a, const IntervalNumber& b) { return a.pow(b); }
+    static void batch(const IntervalArray& x, const IntervalArray& y, IntervalArray& r) { pow(x, y, r); }
+};
+
+// Point exponents, common in practice: an integer and a real one.
+struct PowInteger
+{
+    static constexpr const char* NAME = "pow_integer";
+    static IntervalNumber scalar(const IntervalNumber& a, const IntervalNumber&) { return pow(a, 3.0); }
+    static void batch(const IntervalArray& x, const IntervalArray&, IntervalArray& r) { pow(x, pointExponents(3.0), r); }
+};
+
+struct PowReal
+{
+    static constexpr const char* NAME = "pow_real";
+    static IntervalNumber scalar(const IntervalNumber& a, const IntervalNumber&) { return pow(a, 2.5); }
+    static void batch(const IntervalArray& x, const IntervalArray&, IntervalArray& r) { pow(x, pointExponents(2.5), r); }
+};
+
+struct PowConstant
+{
+    static constexpr const char* NAME = "pow_constant";
+    static IntervalNumber scalar(const IntervalNumber& a, const IntervalNumber&) { return pow<3>(a); }
+    static void batch(const IntervalArray& x, const IntervalArray&, IntervalArray& r) { pow(x, pointExponents(3.0), r); }
+};
+
+struct Exp
+{
+    static constexpr const char* NAME = "exp";
+    static IntervalNumber scalar(const IntervalNumber& a, const IntervalNumber&) { return exp(a); }
+    static void batch(const IntervalArray& x, const IntervalArray&, IntervalArray& r) { exp(x, r); }
+};
+
+struct Log
+{
+    static constexpr const char* NAME = "log";
+    static IntervalNumber scalar(const IntervalNumber& a, const IntervalNumber&) { return log(a); }
+    static void batch(const IntervalArray& x, const IntervalArray&, IntervalArray& r) { log(x, r); }
+};
+
+struct Sqrt
+{
+    static constexpr const char* NAME = "sqrt";
+    static IntervalNumber scalar(const IntervalNumber& a, const IntervalNumber&) { return sqrt(a); }
+    static void batch(const IntervalArray& x, const IntervalArray&, IntervalArray& r) { sqrt(x, r); }
+};
+
+struct Sin
+{
+    static constexpr const char* NAME = "sin";
+    static IntervalNumber scalar(const IntervalNumber& a, const IntervalNumber&) { return sin(a); }
+    static void batch(const IntervalArray& x, const IntervalArray&, IntervalArray& r) { sin(x, r); }
+};
+
+struct Cos
+{
+    static constexpr const char* NAME = "cos";
+    static IntervalNumber scalar(const IntervalNumber& a, const IntervalNumber&) { return cos(a); }
+    static void batch(const IntervalArray& x, const IntervalArray&, IntervalArray& r) { cos(x, r); }
+};
+
+struct Atan
+{
+    static constexpr const char* NAME = "atan";
+    static IntervalNumber scalar(const IntervalNumber& a, const IntervalNumber&) { return atan(a); }
+    static void batch(const IntervalArray& x, const IntervalArray&, IntervalArray& r) { atan(x, r); }
+};
+
+struct Tanh
+{
+    static constexpr const char* NAME = "tanh";
+    static IntervalNumber scalar(const IntervalNumber& a, const IntervalNumber&) { return tanh(a); }
+    static void batch(const IntervalArray& x, const IntervalArray&, IntervalArray& r) { tanh(x, r); }
+};
+
+template<typename Operation>
+void scalarBenchmark(benchmark::State& state, Inputs inputs)
+{
+    const auto x = makeIntervals(inputs, 1u);
+    const auto y = makeIntervals(inputs, 2u);
+    std::vector<IntervalNumber> result(COUNT);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0u; i < COUNT; i++)
+        {
+            result[i] = Operation::scalar(x[i], y[i]);
+        }
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+
+    setCounters(state);
+}
+
+template<typename Operation>
+void batchBenchmark(benchmark::State& state, Inputs inputs)
+{
+    const auto x = toArray(makeIntervals(inputs, 1u));
+    const auto y = toArray(makeIntervals(inputs, 2u));
+    IntervalArray result(COUNT);
+
+    for (auto _ : state)
+    {
+        Operation::batch(x, y, result);
+        benchmark::DoNotOptimize(result.lower());
+        benchmark::DoNotOptimize(result.upper());
+        benchmark::ClobberMemory();
+    }
+
+    setCounters(state);
+}
+
+template<typename Operation>
+void rigorousBenchmark(benchmark::State& state, Inputs inputs)
+{
+    std::vector<RigorousIntervalNumber> x{};
+    std::vector<RigorousIntervalNumber> y{};
+    for (const auto& a : makeIntervals(inputs, 1u))
+    {
+        x.push_back(RigorousIntervalNumber(a));
+    }
+    for (const auto& b : makeIntervals(inputs, 2u))
+    {
+        y.push_back(RigorousIntervalNumber(b));
+    }
+    std::vector<RigorousIntervalNumber> result(COUNT);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0u; i < COUNT; i++)
+        {
+            result[i] = Operation::rigorous(x[i], y[i]);
+        }
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+
+    setCounters(state);
+}
+
+template<typename Operation>
+void registerRigorous()
+{
+    for (auto inputs : {Inputs::Finite, Inputs::ZeroSpanning, Inputs::Infinite, Inputs::Indeterminate})
+    {
+        const std::string name = std::string("rigorous/") + Operation::NAME + "/" + toString(inputs);
+        benchmark::RegisterBenchmark(name.c_str(), rigorousBenchmark<Operation>, inputs);
+    }
+}
+
+// Double-double operands: the inputs divided by 3, so that most endpoints
+// carry a low part.
+static DoubleDoubleIntervalArray makeDoubleDoubleIntervals(Inputs inputs, std::uint32_t seed)
+{
+    const auto intervals = makeIntervals(inputs, seed);
+
+    DoubleDoubleIntervalArray array{};
+    array.reserve(intervals.size());
+    for (const auto& a : intervals)
+    {
+        array.pushBack(DoubleDoubleInterval(a) / 3.0);
+    }
+
+    return array;
+}
+
+template<typename Operation>
+void doubleDoubleBenchmark(benchmark::State& state, Inputs inputs, bool batch)
+{
+    const auto x = makeDoubleDoubleIntervals(inputs, 1u);
+    const auto y = makeDoubleDoubleIntervals(inputs, 2u);
+    DoubleDoubleIntervalArray result(COUNT);
+
+    for (auto _ : state)
+    {
+        if (batch)
+        {
+            Operation::doubleDoubleBatch(x, y, result);
+        }
+        else
+        {
+            for (std::size_t i = 0u; i < COUNT; i++)
+            {
+                result.set(i, Operation::doubleDouble(x.get(i), y.get(i)));
+            }
+        }
+        benchmark::DoNotOptimize(result.lowerHi());
+        benchmark::DoNotOptimize(result.upperHi());
+        benchmark::ClobberMemory();
+    }
+
+    setCounters(state);
+}
+
+template<typename Operation>
+void registerDoubleDouble()
+{
+    for (auto inputs : {Inputs::Finite, Inputs::ZeroSpanning, Inputs::Infinite, Inputs::Indeterminate})
+    {
+        const std::string prefix = std::string("doubledouble/") + Operation::NAME;
+        const std::string suffix = std::string("/") + toString(inputs);
+        benchmark::RegisterBenchmark((prefix + "/scalar" + suffix).c_str(), doubleDoubleBenchmark<Operation>, inputs, false);
+        benchmark::RegisterBenchmark((prefix + "/batch" + suffix).c_str(), doubleDoubleBenchmark<Operation>, inputs, true);
+    }
+}
+
+template<typename Operation>
+void registerOperation()
+{
+    for (auto inputs : {Inputs::Finite, Inputs::ZeroSpanning, Inputs::Infinite, Inputs::Indeterminate})
+    {
+        const std::string suffix = std::string("/") + Operation::NAME + "/" + toString(inputs);
+        benchmark::RegisterBenchmark(("scalar" + suffix).c_str(), scalarBenchmark<Operation>, inputs);
+        benchmark::RegisterBenchmark(("batch" + suffix).c_str(), batchBenchmark<Operation>, inputs);
+    }
+}
+
+template<typename Operation>
+void measureOperation(PerfCounters& counters)
+{
+    for (auto inputs : {Inputs::Finite, Inputs::ZeroSpanning, Inputs::Infinite, Inputs::Indeterminate})
+    {
+        const std::string suffix = std::string("/") + Operation::NAME + "/" + toString(inputs);
+
+        const auto x = makeIntervals(inputs, 1u);
+        const auto y = makeIntervals(inputs, 2u);
+        std::vector<IntervalNumber> result(COUNT);
+
+        counters.start();
+        for (std::size_t pass = 0u; pass < PERF_PASSES; pass++)
+        {
+            for (std::size_t i = 0u; i < COUNT; i++)
+            {
+                result[i] = Operation::scalar(x[i], y[i]);
+            }
+            benchmark::DoNotOptimize(result.data());
+            benchmark::ClobberMemory();
+        }
+        counters.stop();
+        std::printf("%s\n", counters.toJson("scalar" + suffix, PERF_PASSES * COUNT).c_str());
+
+        const auto xArray = toArray(x);
+        const auto yArray = toArray(y);
+        IntervalArray resultArray(COUNT);
+
+        counters.start();
+        for (std::size_t pass = 0u; pass < PERF_PASSES; pass++)
+        {
+            Operation::batch(xArray, yArray, resultArray);
+            benchmark::DoNotOptimize(resultArray.lower());
+            benchmark::ClobberMemory();
+        }
+        counters.stop();
+        std::printf("%s\n", counters.toJson("batch" + suffix, PERF_PASSES * COUNT).c_str());
+
+        const auto xLarge = toArray(makeIntervals(inputs, 1u, LARGE_COUNT));
+        const auto yLarge = toArray(makeIntervals(inputs, 2u, LARGE_COUNT));
+        IntervalArray resultLarge(LARGE_COUNT);
+
+        counters.start();
+        Operation::batch(xLarge, yLarge, resultLarge);
+        benchmark::DoNotOptimize(resultLarge.lower());
+        benchmark::ClobberMemory();
+        counters.stop();
+        std::printf("%s\n", counters.toJson("batch_large" + suffix, LARGE_COUNT).c_str());
+    }
+}
+
+// Parallel reductions over LARGE_COUNT intervals; the argument is the
+// number of threads. Wall-clock time, so the scaling is visible.
+void reductionBenchmark(benchmark::State& state, BracketingPolicy policy, bool product)
+{
+    const auto x = toArray(makeIntervals(Inputs::Finite, 1u, LARGE_COUNT));
+    const auto threads = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        auto result = product ? reduceProduct(x, policy, threads) : reduceSum(x, policy, threads);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(LARGE_COUNT));
+}
+
+void registerReductions()
+{
+    const std::pair<const char*, BracketingPolicy> policies[] = {
+        {"left_fold", BracketingPolicy::leftFold()},
+        {"balanced_tree", BracketingPolicy::balancedTree()},
+        {"fixed_block", BracketingPolicy::fixedBlock(4096u)}
+    };
+    for (const auto& policy : policies)
+    {
+        for (bool product : {true, false})
+        {
+            const std::string name = std::string("reduce/") + (product ? "product/" : "sum/") + policy.first;
+            benchmark::RegisterBenchmark(name.c_str(), reductionBenchmark, policy.second, product)
+                ->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+        }
+    }
+}
+
+// Interval files of LARGE_COUNT intervals in the working directory. The
+// write benchmark streams the file in chunks of COUNT; the others map the
+// file it leaves behind, which is then in the page cache.
+const char* const BENCHMARK_FILE_X = "interval_bench_x.zi";
+const char* const BENCHMARK_FILE_Y = "interval_bench_y.zi";
+
+bool writeIntervalFile(const char* path, const IntervalArray& x)
+{
+    IntervalFileWriter writer{};
+    bool good = writer.open(path);
+    for (std::size_t begin = 0u; begin < x.size(); begin += COUNT)
+    {
+        good = good && writer.append(x.lower() + begin, x.upper() + begin, std::min(COUNT, x.size() - begin));
+    }
+
+    return writer.close() && good;
+}
+
+void fileWriteBenchmark(benchmark::State& state)
+{
+    const auto x = toArray(makeIntervals(Inputs::Finite, 1u, LARGE_COUNT));
+    const auto y = toArray(makeIntervals(Inputs::Finite, 2u, LARGE_COUNT));
+
+    for (auto _ : state)
+    {
+        if (!writeIntervalFile(BENCHMARK_FILE_X, x))
+        {
+            state.SkipWithError("cannot write the interval file");
+            break;
+        }
+    }
+    if (!writeIntervalFile(BENCHMARK_FILE_Y, y))
+    {
+        state.SkipWithError("cannot write the interval file");
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(LARGE_COUNT));
+}
+
+void fileOpenBenchmark(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        MappedIntervalFile file{};
+        if (!file.open(BENCHMARK_FILE_X))
+        {
+            state.SkipWithError("run file/write first");
+            break;
+        }
+        benchmark::DoNotOptimize(file.lower(0u));
+    }
+}
+
+// Multiplication of LARGE_COUNT pairs, from the mapped files block by block
+// or from IntervalArrays in memory.
+void fileMultiplyBenchmark(benchmark::State& state, bool mapped)
+{
+    MappedIntervalFile fileX{};
+    MappedIntervalFile fileY{};
+    if (mapped && !(fileX.open(BENCHMARK_FILE_X) && fileY.open(BENCHMARK_FILE_Y)))
+    {
+        state.SkipWithError("run file/write first");
+        return;
+    }
+    const auto x = mapped ? IntervalArray{} : toArray(makeIntervals(Inputs::Finite, 1u, LARGE_COUNT));
+    const auto y = mapped ? IntervalArray{} : toArray(makeIntervals(Inputs::Finite, 2u, LARGE_COUNT));
+    IntervalArray result(LARGE_COUNT);
+
+    for (auto _ : state)
+    {
+        if (mapped)
+        {
+            for (std::size_t b = 0u; b < fileX.blockCount(); b++)
+            {
+                const std::size_t begin = b * fileX.blockSize();
+                intervalKernels().multiply(fileX.lower(b), fileX.upper(b), fileY.lower(b), fileY.upper(b), result.lower() + begin, result.upper() + begin,
+                                           fileX.blockLength(b));
+            }
+        }
+        else
+        {
+            multiply(x, y, result);
+        }
+        benchmark::DoNotOptimize(result.lower());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(LARGE_COUNT));
+}
+
+void registerFiles()
+{
+    benchmark::RegisterBenchmark("file/write", fileWriteBenchmark)->UseRealTime()->Unit(benchmark::kMillisecond);
+    benchmark::RegisterBenchmark("file/open", fileOpenBenchmark)->Unit(benchmark::kMicrosecond);
+    benchmark::RegisterBenchmark("file/multiply/mapped", fileMultiplyBenchmark, true)->Unit(benchmark::kMillisecond);
+    benchmark::RegisterBenchmark("file/multiply/memory", fileMultiplyBenchmark, false)->Unit(benchmark::kMillisecond);
+}
+
+// Formatting and parsing of LARGE_COUNT intervals as CSV or NDJSON text in
+// memory; the argument is the number of threads. bytes_per_second counts
+// the text. text/tostring appends toString() of each interval on one
+// thread for comparison.
+void textFormatBenchmark(benchmark::State& state, IntervalTextFormat format)
+{
+    const auto x = toArray(makeIntervals(Inputs::Finite, 1u, LARGE_COUNT));
+    const auto threads = static_cast<std::size_t>(state.range(0));
+    std::string text{};
+
+    for (auto _ : state)
+    {
+        formatIntervals(x, format, text, threads);
+        benchmark::DoNotOptimize(text.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(LARGE_COUNT));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(text.size()));
+}
+
+void textParseBenchmark(benchmark::State& state, IntervalTextFormat format)
+{
+    const auto x = toArray(makeIntervals(Inputs::Finite, 1u, LARGE_COUNT));
+    const auto threads = static_cast<std::size_t>(state.range(0));
+    std::string text{};
+    formatIntervals(x, format, text);
+    IntervalArray result{};
+
+    for (auto _ : state)
+    {
+        if (!parseIntervals(text.data(), text.data() + text.size(), format, result, threads))
+        {
+            state.SkipWithError("cannot parse the formatted text");
+            break;
+        }
+        benchmark::DoNotOptimize(result.lower());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(LARGE_COUNT));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(text.size()));
+}
+
+void textToStringBenchmark(benchmark::State& state)
+{
+    const auto x = makeIntervals(Inputs::Finite, 1u, LARGE_COUNT);
+    std::string text{};
+
+    for (auto _ : state)
+    {
+        text.clear();
+        for (const auto& interval : x)
+        {
+            text += interval.toString();
+            text += '\n';
+        }
+        benchmark::DoNotOptimize(text.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(LARGE_COUNT));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(text.size()));
+}
+
+void registerText()
+{
+    const std::pair<const char*, IntervalTextFormat> formats[] = {
+        {"csv", IntervalTextFormat::Csv},
+        {"ndjson", IntervalTextFormat::Ndjson}
+    };
+    for (const auto& format : formats)
+    {
+        benchmark::RegisterBenchmark((std::string("text/format/") + format.first).c_str(), textFormatBenchmark, format.second)
+            ->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark((std::string("text/parse/") + format.first).c_str(), textParseBenchmark, format.second)
+            ->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+    }
+    benchmark::RegisterBenchmark("text/tostring", textToStringBenchmark)->Unit(benchmark::kMillisecond);
+}
+
+// Streaming evaluation of x0 * x1 + sqr(x0) over LARGE_COUNT CSV lines of
+// two intervals, from a temporary file to another; the argument is the
+// number of workers.
+void streamBenchmark(benchmark::State& state)
+{
+    const auto x = toArray(makeIntervals(Inputs::Finite, 1u, LARGE_COUNT));
+    const auto y = toArray(makeIntervals(Inputs::Finite, 2u, LARGE_COUNT));
+    std::string text{};
+    std::vector<char> line(2u * INTERVAL_TEXT_LINE_LENGTH);
+    for (std::size_t i = 0u; i < LARGE_COUNT; i++)
+    {
+        char* p = formatIntervalLine(line.data(), x.lower()[i], x.upper()[i], IntervalTextFormat::Csv);
+        p[-1] = ',';
+        p = formatIntervalLine(p, y.lower()[i], y.upper()[i], IntervalTextFormat::Csv);
+        text.append(line.data(), p);
+    }
+
+    ExpressionTape tape{};
+    std::string error{};
+    parseExpression("x0 * x1 + sqr(x0)", tape, error);
+    IntervalStreamOptions options{};
+    options.threads = static_cast<std::size_t>(state.range(0));
+    std::FILE* input = std::tmpfile();
+    std::FILE* output = std::tmpfile();
+    if (input == nullptr || output == nullptr || std::fwrite(text.data(), 1u, text.size(), input) != text.size())
+    {
+        state.SkipWithError("cannot write a temporary file");
+    }
+
+    for (auto _ : state)
+    {
+        std::rewind(input);
+        std::rewind(output);
+        if (!evaluateIntervalStream(tape, input, output, options, error))
+        {
+            state.SkipWithError(error.c_str());
+            break;
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(LARGE_COUNT));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(text.size()));
+    if (input != nullptr)
+    {
+        std::fclose(input);
+    }
+    if (output != nullptr)
+    {
+        std::fclose(output);
+    }
+}
+
+void registerStream()
+{
+    benchmark::RegisterBenchmark("stream/csv", streamBenchmark)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+// Compression of LARGE_COUNT intervals on one thread; ratio is the raw
+// size over the compressed size. compressed/multiply decompresses both
+// operands block by block into buffers of one block and multiplies them.
+void compressBenchmark(benchmark::State& state, Inputs inputs)
+{
+    const auto x = toArray(makeIntervals(inputs, 1u, LARGE_COUNT));
+    CompressedIntervalArray column{};
+
+    for (auto _ : state)
+    {
+        column.compress(x, 1u);
+        benchmark::DoNotOptimize(column.compressedBytes());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(LARGE_COUNT));
+    state.counters["ratio"] = static_cast<double>(LARGE_COUNT * 2u * sizeof(double)) / static_cast<double>(column.compressedBytes());
+}
+
+void decompressBenchmark(benchmark::State& state, Inputs inputs)
+{
+    const auto x = toArray(makeIntervals(inputs, 1u, LARGE_COUNT));
+    CompressedIntervalArray column{};
+    column.compress(x);
+    IntervalArray result{};
+
+    for (auto _ : state)
+    {
+        column.decompress(result, 1u);
+        benchmark::DoNotOptimize(result.lower());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(LARGE_COUNT));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(LARGE_COUNT * 2u * sizeof(double)));
+    state.counters["ratio"] = static_cast<double>(LARGE_COUNT * 2u * sizeof(double)) / static_cast<double>(column.compressedBytes());
+}
+
+void compressedMultiplyBenchmark(benchmark::State& state, Inputs inputs)
+{
+    CompressedIntervalArray columnX{};
+    CompressedIntervalArray columnY{};
+    columnX.compress(toArray(makeIntervals(inputs, 1u, LARGE_COUNT)));
+    columnY.compress(toArray(makeIntervals(inputs, 2u, LARGE_COUNT)));
+    IntervalArray bufferX(columnX.blockSize());
+    IntervalArray bufferY(columnX.blockSize());
+    IntervalArray result(LARGE_COUNT);
+
+    for (auto _ : state)
+    {
+        for (std::size_t b = 0u; b < columnX.blockCount(); b++)
+        {
+            const std::size_t begin = b * columnX.blockSize();
+            columnX.decompressBlock(b, bufferX.lower(), bufferX.upper());
+            columnY.decompressBlock(b, bufferY.lower(), bufferY.upper());
+            intervalKernels().multiply(bufferX.lower(), bufferX.upper(), bufferY.lower(), bufferY.upper(), result.lower() + begin, result.upper() + begin,
+                                       columnX.blockLength(b));
+        }
+        benchmark::DoNotOptimize(result.lower());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(LARGE_COUNT));
+}
+
+void registerCompression()
+{
+    for (Inputs inputs : {Inputs::Finite, Inputs::Indeterminate})
+    {
+        const std::string suffix = std::string("/") + toString(inputs);
+        benchmark::RegisterBenchmark(("compressed/compress" + suffix).c_str(), compressBenchmark, inputs)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark(("compressed/decompress" + suffix).c_str(), decompressBenchmark, inputs)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark(("compressed/multiply" + suffix).c_str(), compressedMultiplyBenchmark, inputs)->Unit(benchmark::kMillisecond);
+    }
+}
+
+// Interval tree over LARGE_COUNT intervals of width up to 100 in [0, 1e6],
+// one in 65536 of them unbounded on one side, so a query matches about a
+// hundred intervals. tree/stab and tree/overlap answer COUNT queries on 1 to
+// 8 threads; tree/scan answers 16 queries by a linear scan for comparison.
+IntervalArray treeIntervals(unsigned seed, std::size_t count)
+{
+    std::mt19937_64 generator{seed};
+    std::uniform_real_distribution<double> position{0.0, 1e6};
+    std::uniform_real_distribution<double> width{0.0, 100.0};
+
+    IntervalArray x(count);
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        const double x0 = position(generator);
+        x.lower()[i] = ((i % 131072u) == 0u) ? -INF : x0;
+        x.upper()[i] = ((i % 131072u) == 65536u) ? INF : x0 + width(generator);
+    }
+
+    return x;
+}
+
+void treeBuildBenchmark(benchmark::State& state)
+{
+    const IntervalArray x = treeIntervals(1u, LARGE_COUNT);
+    IntervalTree tree{};
+
+    for (auto _ : state)
+    {
+        tree.build(x.lower(), x.upper(), x.size(), 1u);
+        benchmark::DoNotOptimize(tree.size());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(LARGE_COUNT));
+}
+
+void treeQueryBenchmark(benchmark::State& state, bool overlap)
+{
+    const IntervalTree tree(treeIntervals(1u, LARGE_COUNT));
+    const IntervalArray queries = treeIntervals(2u, COUNT);
+    const std::size_t threads = static_cast<std::size_t>(state.range(0));
+    IntervalTreeMatches matches{};
+
+    for (auto _ : state)
+    {
+        if (overlap)
+        {
+            tree.findOverlapping(queries, matches, threads);
+        }
+        else
+        {
+            tree.findContaining(queries.lower(), COUNT, matches, threads);
+        }
+        benchmark::DoNotOptimize(matches.indices.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(COUNT));
+    state.counters["matches"] = static_cast<double>(matches.indices.size()) / static_cast<double>(COUNT);
+}
+
+void treeScanBenchmark(benchmark::State& state)
+{
+    const IntervalArray x = treeIntervals(1u, LARGE_COUNT);
+    const IntervalArray queries = treeIntervals(2u, 16u);
+    std::vector<std::size_t> found{};
+
+    for (auto _ : state)
+    {
+        found.clear();
+        for (std::size_t q = 0u; q < queries.size(); q++)
+        {
+            const double value = queries.lower()[q];
+            for (std::size_t i = 0u; i < x.size(); i++)
+            {
+                if (x.lower()[i] <= value && x.upper()[i] >= value)
+                {
+                    found.push_back(i);
+                }
+            }
+        }
+        benchmark::DoNotOptimize(found.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(queries.size()));
+}
+
+void registerTree()
+{
+    benchmark::RegisterBenchmark("tree/build", treeBuildBenchmark)->Unit(benchmark::kMillisecond);
+    benchmark::RegisterBenchmark("tree/stab", treeQueryBenchmark, false)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMicrosecond);
+    benchmark::RegisterBenchmark("tree/overlap", treeQueryBenchmark, true)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMicrosecond);
+    benchmark::RegisterBenchmark("tree/scan", treeScanBenchmark)->Unit(benchmark::kMillisecond);
+}
+
+// Dot product of COUNT pairs, as a left fold of the operators and with
+// dot() over an IntervalArray.
+void dotBenchmark(benchmark::State& state, Inputs inputs, bool batch)
+{
+    const auto x = makeIntervals(inputs, 1u);
+    const auto y = makeIntervals(inputs, 2u);
+    const IntervalArray xArray = toArray(x);
+    const IntervalArray yArray = toArray(y);
+
+    for (auto _ : state)
+    {
+        IntervalNumber result{};
+        if (batch)
+        {
+            result = dot(xArray, yArray);
+        }
+        else
+        {
+            for (std::size_t i = 0u; i < COUNT; i++)
+            {
+                result = result + x[i] * y[i];
+            }
+        }
+        benchmark::DoNotOptimize(result);
+    }
+
+    setCounters(state);
+}
+
+void registerDots()
+{
+    for (auto inputs : {Inputs::Finite, Inputs::ZeroSpanning, Inputs::Infinite, Inputs::Indeterminate})
+    {
+        const std::string suffix = std::string("/") + toString(inputs);
+        benchmark::RegisterBenchmark(("dot/operators" + suffix).c_str(), dotBenchmark, inputs, false);
+        benchmark::RegisterBenchmark(("dot/batch" + suffix).c_str(), dotBenchmark, inputs, true);
+    }
+}
+
+// The same operation on the same intervals, as IntervalNumber and as a
+// sign-class type. Positive operands are the magnitudes of finite inputs.
+
+struct SignClassAdd
+{
+    static constexpr const char* NAME = "add";
+    template<typename X>
+    static auto apply(const X& a, const X& b) { return a + b; }
+};
+
+struct SignClassMultiply
+{
+    static constexpr const char* NAME = "multiply";
+    template<typename X>
+    static auto apply(const X& a, const X& b) { return a * b; }
+};
+
+struct SignClassDivide
+{
+    static constexpr const char* NAME = "divide";
+    template<typename X>
+    static auto apply(const X& a, const X& b) { return a / b; }
+};
+
+template<typename Operation, typename X>
+void signClassBenchmark(benchmark::State& state, bool positive)
+{
+    std::vector<X> x{};
+    std::vector<X> y{};
+    for (unsigned seed = 1u; seed <= 2u; seed++)
+    {
+        for (const auto& a : makeIntervals(Inputs::Finite, seed))
+        {
+            const IntervalNumber operand = positive ? IntervalNumber(std::fabs(a.getX0()), std::fabs(a.getX1())) : a;
+            (seed == 1u ? x : y).push_back(X(operand.getX0(), operand.getX1()));
+        }
+    }
+    std::vector<decltype(Operation::apply(x[0u], y[0u]))> result(COUNT, Operation::apply(x[0u], y[0u]));
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0u; i < COUNT; i++)
+        {
+            result[i] = Operation::apply(x[i], y[i]);
+        }
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+
+    setCounters(state);
+}
+
+template<typename Operation>
+void registerSignClass(bool finite)
+{
+    const std::string prefix = std::string("signclass/") + Operation::NAME;
+    benchmark::RegisterBenchmark((prefix + "/positive/general").c_str(), signClassBenchmark<Operation, IntervalNumber>, true);
+    benchmark::RegisterBenchmark((prefix + "/positive/tagged").c_str(), signClassBenchmark<Operation, PositiveInterval>, true);
+    if (finite)
+    {
+        benchmark::RegisterBenchmark((prefix + "/finite/general").c_str(), signClassBenchmark<Operation, IntervalNumber>, false);
+        benchmark::RegisterBenchmark((prefix + "/finite/tagged").c_str(), signClassBenchmark<Operation, FiniteInterval>, false);
+    }
+}
+
+// A formula of products, quotients and powers over COUNT input pairs,
+// evaluated with the operators, with an ExpressionTape and with expression
+// templates.
+auto benchmarkFormula = [](const auto& x) {
+    return x[0] * x[1] / (x[0] + 2.0) - pow(x[1], 3.0) * x[0] + abs(x[1]) / x[0];
+};
+
+void formulaOperatorsBenchmark(benchmark::State& state, Inputs inputs)
+{
+    const auto x = makeIntervals(inputs, 1u);
+    const auto y = makeIntervals(inputs, 2u);
+    std::vector<IntervalNumber> result(COUNT);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0u; i < COUNT; i++)
+        {
+            result[i] = benchmarkFormula(std::array<IntervalNumber, 2u>{x[i], y[i]});
+        }
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+
+    setCounters(state);
+}
+
+void formulaTapeBenchmark(benchmark::State& state, Inputs inputs)
+{
+    const std::vector<IntervalArray> x{toArray(makeIntervals(inputs, 1u)), toArray(makeIntervals(inputs, 2u))};
+    const auto tape = ExpressionTape::record(2u, benchmarkFormula);
+    IntervalArray result(COUNT);
+
+    for (auto _ : state)
+    {
+        tape.evaluate(x, result);
+        benchmark::DoNotOptimize(result.lower());
+        benchmark::DoNotOptimize(result.upper());
+        benchmark::ClobberMemory();
+    }
+
+    setCounters(state);
+}
+
+void formulaExpressionBenchmark(benchmark::State& state, Inputs inputs)
+{
+    const IntervalArray x = toArray(makeIntervals(inputs, 1u));
+    const IntervalArray y = toArray(makeIntervals(inputs, 2u));
+    IntervalArray result(COUNT);
+
+    for (auto _ : state)
+    {
+        assign(benchmarkFormula(std::array<ArrayTerminal, 2u>{lazy(x), lazy(y)}), result);
+        benchmark::DoNotOptimize(result.lower());
+        benchmark::DoNotOptimize(result.upper());
+        benchmark::ClobberMemory();
+    }
+
+    setCounters(state);
+}
+
+void registerFormulas()
+{
+    for (auto inputs : {Inputs::Finite, Inputs::ZeroSpanning, Inputs::Infinite, Inputs::Indeterminate})
+    {
+        const std::string suffix = std::string("/") + toString(inputs);
+        benchmark::RegisterBenchmark(("formula/operators" + suffix).c_str(), formulaOperatorsBenchmark, inputs);
+        benchmark::RegisterBenchmark(("formula/tape" + suffix).c_str(), formulaTapeBenchmark, inputs);
+        benchmark::RegisterBenchmark(("formula/expression" + suffix).c_str(), formulaExpressionBenchmark, inputs);
+    }
+}
+
+// Branch-and-bound minimization of the six-hump camel function; the
+// argument is the number of threads. Every thread count does the same
+// search, so the times compare directly.
+void optimizerBenchmark(benchmark::State& state)
+{
+    auto objective = [](const std::vector<IntervalNumber>& v) {
+        const IntervalNumber& x = v[0];
+        const IntervalNumber& y = v[1];
+        return 4.0 * pown(x, 2) - 2.1 * pown(x, 4) + pown(x, 6) / 3.0 + x * y - 4.0 * pown(y, 2) + 4.0 * pown(y, 4);
+    };
+
+    OptimizerOptions options{};
+    options.tolerance = 1e-4;
+    options.threads = static_cast<std::size_t>(state.range(0));
+
+    std::size_t boxes = 0u;
+    for (auto _ : state)
+    {
+        auto result = minimizeGlobal(objective, {IntervalNumber(-3.0, 3.0), IntervalNumber(-2.0, 2.0)}, options);
+        benchmark::DoNotOptimize(result);
+        boxes = result.bisectedBoxes;
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(boxes));
+}
+
+// Removes --perf_counters from the arguments.
+bool takePerfCountersFlag(int& argc, char** argv)
+{
+    bool found = false;
+    int kept = 0;
+    for (int i = 0; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--perf_counters") == 0)
+        {
+            found = true;
+            continue;
+        }
+        argv[kept++] = argv[i];
+    }
+    argc = kept;
+
+    return found;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    if (takePerfCountersFlag(argc, argv))
+    {
+        PerfCounters counters{};
+        if (!counters.available(PerfEvent::Cycles))
+        {
+            std::fprintf(stderr, "Hardware performance counters unavailable; their values are null.\n");
+        }
+
+        measureOperation<Add>(counters);
+        measureOperation<Subtract>(counters);
+        measureOperation<Multiply>(counters);
+        measureOperation<Divide>(counters);
+        measureOperation<Abs>(counters);
+        measureOperation<Sqr>(counters);
+        measureOperation<Fma>(counters);
+        measureOperation<Pow>(counters);
+        measureOperation<PowInteger>(counters);
+        measureOperation<PowReal>(counters);
+        measureOperation<PowConstant>(counters);
+        measureOperation<Exp>(counters);
+        measureOperation<Log>(counters);
+        measureOperation<Sqrt>(counters);
+        measureOperation<Sin>(counters);
+        measureOperation<Cos>(counters);
+        measureOperation<Atan>(counters);
+        measureOperation<Tanh>(counters);
+
+        return 0;
+    }
+
+    registerOperation<Add>();
+    registerOperation<Subtract>();
+    registerOperation<Multiply>();
+    registerOperation<Divide>();
+    registerOperation<Abs>();
+    registerOperation<Sqr>();
+    registerOperation<Fma>();
+    registerOperation<Pow>();
+    registerOperation<PowInteger>();
+    registerOperation<PowReal>();
+    registerOperation<PowConstant>();
+    registerOperation<Exp>();
+    registerOperation<Log>();
+    registerOperation<Sqrt>();
+    registerOperation<Sin>();
+    registerOperation<Cos>();
+    registerOperation<Atan>();
+    registerOperation<Tanh>();
+    registerRigorous<Add>();
+    registerRigorous<Subtract>();
+    registerRigorous<Multiply>();
+    registerRigorous<Divide>();
+    registerDoubleDouble<Add>();
+    registerDoubleDouble<Subtract>();
+    registerDoubleDouble<Multiply>();
+    registerDoubleDouble<Divide>();
+    registerSignClass<SignClassAdd>(true);
+    registerSignClass<SignClassMultiply>(true);
+    registerSignClass<SignClassDivide>(false);
+    registerReductions();
+    registerFiles();
+    registerText();
+    registerStream();
+    registerCompression();
+    registerTree();
+    registerDots();
+    registerFormulas();
+    benchmark::RegisterBenchmark("optimize/six_hump_camel", optimizerBenchmark)
+        ->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,195 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "ExpressionParser.hpp"
+#include "IntervalStream.hpp"
+
+// interval_eval: evaluates a formula over intervals read as text.
+//
+//     interval_eval [options] [--] FORMULA [FILE]
+//
+// Reads FILE, or standard input without FILE or with "-", and writes one
+// result interval per input line to standard output. Each input line holds
+// one interval per input x0, x1, ... of the formula; see
+// ExpressionParser.hpp for the formula syntax and IntervalText.hpp for the
+// line formats. An argument that is not an option, such as '-x0 + 1', is
+// the formula; after "--" every argument is. Exits with 0 on success, 1 on
+// invalid input or an I/O error, and 2 on invalid arguments.
+
+namespace {
+
+const char* const USAGE =
+    "usage: interval_eval [options] [--] FORMULA [FILE]\n"
+    "\n"
+    "Evaluates FORMULA with IntervalNumber semantics for every line of FILE,\n"
+    "or of standard input, and writes one result interval per line.\n"
+    "\n"
+    "  FORMULA            e.g. 'x0 * x1 + sqr(x0) / 2' over inputs x0, x1, ...\n"
+    "  --format FORMAT    csv (x0,x1,y0,y1 per line, default) or ndjson ([x0,x1,y0,y1])\n"
+    "  --threads N        compute workers; 0 (default) uses every core\n"
+    "  --chunk BYTES      input bytes per chunk (default 1048576)\n"
+    "  --in-flight N      chunks held at once; 0 (default) is twice the workers\n"
+    "  --max-line BYTES   longest input line (default 1048576)\n"
+    "  --print-tape       print the compiled instructions and exit\n"
+    "  --                 end of options; use it before a formula like '-x0'\n";
+
+bool parseCount(const char* text, std::size_t& count)
+{
+    char* end = nullptr;
+    const unsigned long long value = std::strtoull(text, &end, 10);
+    if (end == text || *end != '\0' || text[0] == '-')
+    {
+        return false;
+    }
+    count = static_cast<std::size_t>(value);
+
+    return true;
+}
+
+int usage(const char* message)
+{
+    std::fprintf(stderr, "interval_eval: %s\n\n%s", message, USAGE);
+
+    return 2;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    IntervalStreamOptions options{};
+    bool printTape = false;
+    const char* formula = nullptr;
+    const char* path = nullptr;
+    bool acceptOptions = true;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* argument = argv[i];
+        const bool hasValue = (i + 1 < argc);
+
+        if (!acceptOptions || argument[0] != '-' || argument[1] == '\0')
+        {
+            if (formula == nullptr)
+            {
+                formula = argument;
+            }
+            else if (path == nullptr)
+            {
+                path = argument;
+            }
+            else
+            {
+                return usage("too many arguments");
+            }
+        }
+        else if (std::strcmp(argument, "--") == 0)
+        {
+            acceptOptions = false;
+        }
+        else if (std::strcmp(argument, "--help") == 0 || std::strcmp(argument, "-h") == 0)
+        {
+            std::fputs(USAGE, stdout);
+            return 0;
+        }
+        else if (std::strcmp(argument, "--format") == 0 && hasValue)
+        {
+            const char* format = argv[++i];
+            if (std::strcmp(format, "csv") != 0 && std::strcmp(format, "ndjson") != 0)
+            {
+                return usage("unknown format");
+            }
+            options.format = (std::strcmp(format, "csv") == 0) ? IntervalTextFormat::Csv : IntervalTextFormat::Ndjson;
+        }
+        else if (std::strcmp(argument, "--threads") == 0 && hasValue)
+        {
+            if (!parseCount(argv[++i], options.threads))
+            {
+                return usage("invalid thread count");
+            }
+        }
+        else if (std::strcmp(argument, "--chunk") == 0 && hasValue)
+        {
+            if (!parseCount(argv[++i], options.chunkSize) || options.chunkSize == 0u)
+            {
+                return usage("invalid chunk size");
+            }
+        }
+        else if (std::strcmp(argument, "--in-flight") == 0 && hasValue)
+        {
+            if (!parseCount(argv[++i], options.chunksInFlight))
+            {
+                return usage("invalid number of chunks");
+            }
+        }
+        else if (std::strcmp(argument, "--max-line") == 0 && hasValue)
+        {
+            if (!parseCount(argv[++i], options.maxLineLength) || options.maxLineLength == 0u)
+            {
+                return usage("invalid line length");
+            }
+        }
+        else if (std::strcmp(argument, "--print-tape") == 0)
+        {
+            printTape = true;
+        }
+        else if (argument[1] == '-')
+        {
+            return usage((std::string("unknown or incomplete option ") + argument).c_str());
+        }
+        else if (formula == nullptr)
+        {
+            // A single '-' that is no option starts a formula, e.g. '-x0 + 1'.
+            formula = argument;
+        }
+        else
+        {
+            return usage((std::string("unknown option ") + argument).c_str());
+        }
+    }
+    if (formula == nullptr)
+    {
+        return usage("missing formula");
+    }
+
+    ExpressionTape tape{};
+    std::string error{};
+    if (!parseExpression(formula, tape, error))
+    {
+        std::fprintf(stderr, "interval_eval: %s\n", error.c_str());
+        return 2;
+    }
+    if (printTape)
+    {
+        std::printf("%zu inputs, %zu registers\n%s", tape.inputs(), tape.registers(), tape.toString().c_str());
+        return 0;
+    }
+
+    std::FILE* input = stdin;
+    if (path != nullptr && std::strcmp(path, "-") != 0)
+    {
+        input = std::fopen(path, "rb");
+        if (input == nullptr)
+        {
+            std::fprintf(stderr, "interval_eval: cannot open %s\n", path);
+            return 1;
+        }
+    }
+
+    // An error exits at once, even while the reader waits for more input,
+    // so the input is left open then.
+    options.detachReader = true;
+    if (!evaluateIntervalStream(tape, input, stdout, options, error))
+    {
+        std::fprintf(stderr, "interval_eval: %s\n", error.empty() ? "cannot write the output" : error.c_str());
+        return 1;
+    }
+    if (input != stdin)
+    {
+        std::fclose(input);
+    }
+
+    return 0;
+}
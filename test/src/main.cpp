@@ -1,9 +1,35 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <limits>
+#include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
+#include "CompressedIntervalArray.hpp"
+#include "DoubleDoubleInterval.hpp"
+#include "DoubleDoubleIntervalArray.hpp"
+#include "ExpressionParser.hpp"
+#include "ExpressionTape.hpp"
+#include "GlobalOptimizer.hpp"
+#include "IntervalArray.hpp"
+#include "IntervalDispatch.hpp"
+#include "IntervalExpression.hpp"
+#include "IntervalFile.hpp"
 #include "IntervalNumber.hpp"
+#include "IntervalReduction.hpp"
+#include "IntervalStream.hpp"
+#include "IntervalText.hpp"
+#include "IntervalTranscendental.hpp"
+#include "IntervalTree.hpp"
+#include "MultiInterval.hpp"
+#include "PerfCounters.hpp"
+#include "ProductPlanner.hpp"
+#include "RigorousIntervalNumber.hpp"
+#include "SignClassInterval.hpp"
 
 // Basic tests regarding numeric limits in C++.
 
@@ -1161,6 +1187,2670 @@ TEST(IntervalNumber, PowerAdmissible_NonNegativeBase_NonNegativeExponentInterval
     EXPECT_EQ(result.getX1(), 8.0);
 }
 
+// ---------------------------------------------------------------------
+// Compile-time evaluation. Construction, comparison, + - * /, abs and the
+// integer power are constexpr, so the classical-forms table (paper §6.3)
+// is checked by the compiler.
+// ---------------------------------------------------------------------
+
+static_assert(IntervalNumber(0.0) * IntervalNumber(INF) == OMEGA, "0 * inf = Omega (Rule I)");
+static_assert(IntervalNumber(0.0) * IntervalNumber(-INF) == NEGATIVE_OMEGA, "0 * -inf = -Omega (Rule II)");
+static_assert(IntervalNumber(0.0) / IntervalNumber(0.0) == OMEGA_TILDE, "0 / 0 = [-inf, inf]");
+static_assert(IntervalNumber(INF) - IntervalNumber(INF) == OMEGA_TILDE, "inf - inf = [-inf, inf]");
+static_assert(IntervalNumber(INF) / IntervalNumber(INF) == OMEGA, "inf / inf = Omega");
+static_assert(IntervalNumber(0.0).pown(0) == OMEGA, "0^0 = Omega");
+static_assert(IntervalNumber(INF).pown(0) == OMEGA, "inf^0 = Omega");
+
+TEST(IntervalNumber, ConstexprArithmetic)
+{
+    constexpr IntervalNumber a{-1.0};
+    constexpr IntervalNumber b{0.0};
+    constexpr IntervalNumber c{-INF};
+
+    // Non-associativity (paper §5.2), folded at compile time.
+    constexpr auto left = (a * b) * c;
+    constexpr auto right = a * (b * c);
+    static_assert(left == NEGATIVE_OMEGA, "(-1 * 0) * -inf");
+    static_assert(right == OMEGA, "-1 * (0 * -inf)");
+
+    constexpr auto quotient = IntervalNumber(1.0) / IntervalNumber(0.0, 2.0);
+    constexpr auto span = abs(IntervalNumber(-3.0, 2.0)) + 1.0;
+
+    EXPECT_EQ(quotient, IntervalNumber(0.5, INF));
+    EXPECT_EQ(span, IntervalNumber(1.0, 4.0));
+    EXPECT_NE(left, right);
+}
+
+TEST(IntervalNumber, ConstexprNaNPropagation)
+{
+    constexpr auto result = IntervalNumber(QUIET_NAN) * IntervalNumber(2.0);
+
+    EXPECT_TRUE(std::isnan(result.getX0()));
+    EXPECT_TRUE(std::isnan(result.getX1()));
+}
+
+TEST(IntervalNumber, IntegerPowerAgreesWithPow)
+{
+    constexpr auto even = IntervalNumber(-2.0, 3.0).pown(2);
+    constexpr auto odd = pown(IntervalNumber(-2.0, 3.0), 3);
+    constexpr auto negative = IntervalNumber(2.0, 4.0).pown(-1);
+    static_assert(even == IntervalNumber(0.0, 9.0), "interior minimum of an even power");
+
+    EXPECT_EQ(even, IntervalNumber(-2.0, 3.0).pow(2.0));
+    EXPECT_EQ(odd, IntervalNumber(-8.0, 27.0));
+    EXPECT_EQ(negative, IntervalNumber(0.25, 0.5));
+    EXPECT_EQ(IntervalNumber(2.0).pown(10), IntervalNumber(1024.0));
+
+    // Outside the admissible domain: negative exponent, zero in the base.
+    const auto undefined = IntervalNumber(-1.0, 4.0).pown(-2);
+    EXPECT_TRUE(std::isnan(undefined.getX0()));
+    EXPECT_TRUE(std::isnan(undefined.getX1()));
+}
+
+// ---------------------------------------------------------------------
+// Endpoint types. IntervalNumberT<float> and IntervalNumberT<long double>
+// apply the same rules as IntervalNumber; conversions between endpoint
+// types round outward.
+// ---------------------------------------------------------------------
+
+static_assert(IntervalNumberT<float>(0.0f) * IntervalNumberT<float>(std::numeric_limits<float>::infinity()) ==
+              IntervalNumberT<float>(0.0f, std::numeric_limits<float>::infinity()), "0 * inf = Omega in float");
+
+template<typename T>
+void expectIndeterminateForms()
+{
+    using Interval = IntervalNumberT<T>;
+    const T inf = std::numeric_limits<T>::infinity();
+
+    EXPECT_EQ(Interval(T(0)) * Interval(inf), Interval(T(0), inf));
+    EXPECT_EQ(Interval(T(0)) * Interval(-inf), Interval(-inf, T(0)));
+    EXPECT_EQ(Interval(inf) - Interval(inf), Interval(-inf, inf));
+    EXPECT_EQ(Interval(-inf) + Interval(inf), Interval(-inf, inf));
+    EXPECT_EQ(Interval(T(0)) / Interval(T(0)), Interval(-inf, inf));
+    EXPECT_EQ(Interval(inf) / Interval(inf), Interval(T(0), inf));
+    EXPECT_EQ(T(1) / Interval(T(0), T(2)), Interval(T(0.5), inf));
+    EXPECT_EQ(T(1) / Interval(T(-1), T(1)), Interval(-inf, inf));
+    EXPECT_EQ(pow(Interval(T(0)), T(0)), Interval(T(0), inf));
+    EXPECT_EQ(abs(Interval(-inf, T(0))), Interval(T(0), inf));
+
+    const auto undefined = Interval(std::numeric_limits<T>::quiet_NaN()) * Interval(T(2));
+    EXPECT_TRUE(std::isnan(undefined.getX0()));
+    EXPECT_TRUE(std::isnan(undefined.getX1()));
+}
+
+TEST(IntervalNumberT, FloatIndeterminateForms)
+{
+    expectIndeterminateForms<float>();
+}
+
+TEST(IntervalNumberT, LongDoubleIndeterminateForms)
+{
+    expectIndeterminateForms<long double>();
+}
+
+TEST(IntervalNumberT, NarrowingConversionRoundsOutward)
+{
+    const IntervalNumberT<float> tenth{IntervalNumber(0.1)};
+    EXPECT_LT(tenth.getX0(), tenth.getX1());
+    EXPECT_LE(static_cast<double>(tenth.getX0()), 0.1);
+    EXPECT_GE(static_cast<double>(tenth.getX1()), 0.1);
+
+    // Representable bounds and infinities convert exactly.
+    EXPECT_EQ(IntervalNumberT<float>(IntervalNumber(0.5, INF)), IntervalNumberT<float>(0.5f, std::numeric_limits<float>::infinity()));
+
+    // Beyond the float range.
+    const IntervalNumberT<float> huge{IntervalNumber(1e300)};
+    EXPECT_EQ(huge.getX0(), std::numeric_limits<float>::max());
+    EXPECT_EQ(huge.getX1(), std::numeric_limits<float>::infinity());
+
+    // Below the smallest subnormal: the enclosure keeps the value off zero.
+    const IntervalNumberT<float> tiny{IntervalNumber(1e-300)};
+    EXPECT_EQ(tiny.getX0(), 0.0f);
+    EXPECT_GT(tiny.getX1(), 0.0f);
+
+    const IntervalNumberT<float> undefined{IntervalNumber(QUIET_NAN)};
+    EXPECT_TRUE(std::isnan(undefined.getX0()));
+}
+
+TEST(IntervalNumberT, WideningConversionIsExact)
+{
+    const IntervalNumberT<float> narrow{0.1f, 0.3f};
+    const IntervalNumber wide{narrow};
+    const IntervalNumberT<long double> wider{wide};
+
+    EXPECT_EQ(wide, IntervalNumber(0.1f, 0.3f));
+    EXPECT_EQ(wider.getX0(), static_cast<long double>(0.1f));
+    EXPECT_EQ(IntervalNumberT<float>(wider), narrow);
+}
+
+// ---------------------------------------------------------------------
+// Outward rounding. RigorousIntervalNumber widens an endpoint by one ulp
+// only when the rounded endpoint is inexact, so the result encloses the
+// exact result and exact operations stay tight.
+// ---------------------------------------------------------------------
+
+TEST(RigorousIntervalNumber, ExactOperationsStayTight)
+{
+    const RigorousIntervalNumber a{1.0, 2.0};
+    const RigorousIntervalNumber b{3.0, 4.0};
+
+    EXPECT_EQ(a + b, RigorousIntervalNumber(4.0, 6.0));
+    EXPECT_EQ(a - b, RigorousIntervalNumber(-3.0, -1.0));
+    EXPECT_EQ(a * b, RigorousIntervalNumber(3.0, 8.0));
+    EXPECT_EQ(1.0 / RigorousIntervalNumber(2.0, 4.0), RigorousIntervalNumber(0.25, 0.5));
+    EXPECT_EQ(abs(RigorousIntervalNumber(-3.0, 2.0)), RigorousIntervalNumber(0.0, 3.0));
+}
+
+TEST(RigorousIntervalNumber, InexactResultsEncloseExactValue)
+{
+    // 0.1 + 0.2 is exact in long double, which has 11 more significand bits.
+    const auto sum = RigorousIntervalNumber(0.1) + RigorousIntervalNumber(0.2);
+    EXPECT_EQ(std::nextafter(sum.getX0(), INF), sum.getX1());
+    EXPECT_LT(static_cast<long double>(sum.getX0()), 0.1L + static_cast<long double>(0.2));
+    EXPECT_GT(static_cast<long double>(sum.getX1()), 0.1L + static_cast<long double>(0.2));
+
+    // fma(a, b, -c) has the sign of a * b - c.
+    const auto product = RigorousIntervalNumber(0.1) * RigorousIntervalNumber(0.3);
+    EXPECT_GT(std::fma(0.1, 0.3, -product.getX0()), 0.0);
+    EXPECT_LT(std::fma(0.1, 0.3, -product.getX1()), 0.0);
+
+    const auto third = 1.0 / RigorousIntervalNumber(3.0);
+    EXPECT_LT(std::fma(third.getX0(), 3.0, -1.0), 0.0);
+    EXPECT_GT(std::fma(third.getX1(), 3.0, -1.0), 0.0);
+
+    const auto root = pow(RigorousIntervalNumber(2.0), RigorousIntervalNumber(0.5));
+    EXPECT_LT(root.getX0() * root.getX0(), 2.0);
+    EXPECT_GT(root.getX1() * root.getX1(), 2.0);
+}
+
+TEST(RigorousIntervalNumber, OverflowKeepsFiniteBound)
+{
+    const double max = std::numeric_limits<double>::max();
+
+    EXPECT_EQ(RigorousIntervalNumber(max) * 2.0, RigorousIntervalNumber(max, INF));
+    EXPECT_EQ(RigorousIntervalNumber(-max) - RigorousIntervalNumber(max), RigorousIntervalNumber(-INF, -max));
+
+    const auto tiny = RigorousIntervalNumber(1e-200) * RigorousIntervalNumber(1e-200);
+    EXPECT_LE(tiny.getX0(), 0.0);
+    EXPECT_GT(tiny.getX1(), 0.0);
+
+    // Overflowing powers of a finite base keep ±MAX as the finite bound.
+    EXPECT_EQ(RigorousIntervalNumber(1e200, 1e201).pow(2.0), RigorousIntervalNumber(max, INF));
+    EXPECT_EQ(RigorousIntervalNumber(-1e201, -1e200).pow(3.0), RigorousIntervalNumber(-INF, -max));
+    EXPECT_EQ(RigorousIntervalNumber(2.0, 4.0).pow(RigorousIntervalNumber(1100.0, 1200.0)), RigorousIntervalNumber(max, INF));
+}
+
+TEST(RigorousIntervalNumber, IndeterminateFormsMatchNearest)
+{
+    EXPECT_EQ(RigorousIntervalNumber(0.0) * RigorousIntervalNumber(INF), RigorousIntervalNumber(OMEGA));
+    EXPECT_EQ(RigorousIntervalNumber(0.0) * RigorousIntervalNumber(-INF), RigorousIntervalNumber(NEGATIVE_OMEGA));
+    EXPECT_EQ(RigorousIntervalNumber(INF) - RigorousIntervalNumber(INF), RigorousIntervalNumber(OMEGA_TILDE));
+    EXPECT_EQ(RigorousIntervalNumber(0.0) / RigorousIntervalNumber(0.0), RigorousIntervalNumber(OMEGA_TILDE));
+    EXPECT_EQ(RigorousIntervalNumber(1.0) / RigorousIntervalNumber(0.0, 2.0), RigorousIntervalNumber(0.5, INF));
+    EXPECT_EQ(pow(RigorousIntervalNumber(0.0), RigorousIntervalNumber(0.0)), RigorousIntervalNumber(OMEGA));
+
+    const auto undefined = RigorousIntervalNumber(QUIET_NAN) + RigorousIntervalNumber(1.0);
+    EXPECT_TRUE(std::isnan(undefined.getX0()));
+    EXPECT_TRUE(std::isnan(undefined.getX1()));
+}
+
+// ---------------------------------------------------------------------
+// Batch kernels on IntervalArray (structure of arrays). The batch
+// operations must reproduce the scalar operators bit for bit, including
+// NaN results and the sign of zero, for every combination of special
+// endpoint values.
+// ---------------------------------------------------------------------
+
+static bool sameBits(double a, double b)
+{
+    return (std::isnan(a) && std::isnan(b)) || (std::memcmp(&a, &b, sizeof(double)) == 0);
+}
+
+static std::vector<IntervalNumber> sampleIntervals()
+{
+    const std::vector<double> values{-INF, -2.0, -1.0, -0.5, -0.0, 0.0, 0.5, 1.0, 2.0, 3.0, INF, QUIET_NAN};
+
+    std::vector<IntervalNumber> intervals{};
+    for (std::size_t i = 0u; i < values.size(); i++)
+    {
+        for (std::size_t k = i; k < values.size(); k++)
+        {
+            intervals.push_back(IntervalNumber(values[i], values[k]));
+        }
+    }
+
+    return intervals;
+}
+
+// Builds operand arrays holding every ordered pair of sample intervals.
+static void samplePairs(IntervalArray& x, IntervalArray& y)
+{
+    const auto intervals = sampleIntervals();
+    for (const auto& a : intervals)
+    {
+        for (const auto& b : intervals)
+        {
+            x.pushBack(a);
+            y.pushBack(b);
+        }
+    }
+}
+
+TEST(IntervalArray, StoresBoundsInAlignedArrays)
+{
+    IntervalArray array{IntervalNumber(1.0, 2.0), IntervalNumber(0.0, INF)};
+    array.pushBack(IntervalNumber(-INF, 0.0));
+
+    EXPECT_EQ(array.size(), 3u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(array.lower()) % 64u, 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(array.upper()) % 64u, 0u);
+    EXPECT_EQ(array.lower()[1], 0.0);
+    EXPECT_EQ(array.upper()[1], INF);
+    EXPECT_EQ(array.get(2), IntervalNumber(-INF, 0.0));
+
+    array.set(0, IntervalNumber(5.0));
+    EXPECT_EQ(array.get(0), IntervalNumber(5.0, 5.0));
+}
+
+TEST(IntervalArray, BatchArithmeticMatchesScalarOperators)
+{
+    IntervalArray x{};
+    IntervalArray y{};
+    samplePairs(x, y);
+
+    IntervalArray sum{};
+    IntervalArray difference{};
+    IntervalArray product{};
+    IntervalArray quotient{};
+    add(x, y, sum);
+    subtract(x, y, difference);
+    multiply(x, y, product);
+    divide(x, y, quotient);
+
+    for (std::size_t i = 0u; i < x.size(); i++)
+    {
+        const auto a = x.get(i);
+        const auto b = y.get(i);
+
+        EXPECT_TRUE(sameBits(sum.lower()[i], (a + b).getX0()) && sameBits(sum.upper()[i], (a + b).getX1()));
+        EXPECT_TRUE(sameBits(difference.lower()[i], (a - b).getX0()) && sameBits(difference.upper()[i], (a - b).getX1()));
+        EXPECT_TRUE(sameBits(product.lower()[i], (a * b).getX0()) && sameBits(product.upper()[i], (a * b).getX1()));
+        EXPECT_TRUE(sameBits(quotient.lower()[i], (a / b).getX0()) && sameBits(quotient.upper()[i], (a / b).getX1()));
+    }
+}
+
+TEST(IntervalArray, BatchAbsAndPowMatchScalarOperators)
+{
+    IntervalArray x{};
+    IntervalArray y{};
+    samplePairs(x, y);
+
+    IntervalArray absolute{};
+    IntervalArray power{};
+    abs(x, absolute);
+    pow(x, y, power);
+
+    for (std::size_t i = 0u; i < x.size(); i++)
+    {
+        const auto a = x.get(i);
+        const auto b = y.get(i);
+
+        EXPECT_TRUE(sameBits(absolute.lower()[i], a.abs().getX0()) && sameBits(absolute.upper()[i], a.abs().getX1()));
+        EXPECT_TRUE(sameBits(power.lower()[i], a.pow(b).getX0()) && sameBits(power.upper()[i], a.pow(b).getX1()));
+    }
+}
+
+TEST(IntervalArray, BatchMultiplicationIndeterminateForms)
+{
+    IntervalArray x{IntervalNumber(0.0), IntervalNumber(0.0), IntervalNumber(-1.0)};
+    IntervalArray y{IntervalNumber(INF), IntervalNumber(-INF), IntervalNumber(-INF, 0.0)};
+
+    // In place: the result may alias an operand.
+    multiply(x, y, x);
+
+    EXPECT_EQ(x.get(0), IntervalNumber(0.0, INF));       // Rule I
+    EXPECT_EQ(x.get(1), IntervalNumber(-INF, 0.0));      // Rule II
+    EXPECT_EQ(x.get(2), IntervalNumber(0.0, INF));
+}
+
+// ---------------------------------------------------------------------
+// Runtime CPU dispatch. Every kernel variant the executing CPU supports
+// must agree bit for bit with the scalar operators.
+// ---------------------------------------------------------------------
+
+TEST(IntervalDispatch, EveryVariantMatchesScalarOperators)
+{
+    IntervalArray x{};
+    IntervalArray y{};
+    samplePairs(x, y);
+
+    for (auto isa : {IntervalIsa::Scalar, IntervalIsa::Baseline, IntervalIsa::Avx2, IntervalIsa::Avx512})
+    {
+        if (!isIntervalIsaSupported(isa))
+        {
+            continue;
+        }
+
+        const auto& kernels = intervalKernels(isa);
+        EXPECT_EQ(kernels.isa, isa);
+
+        IntervalArray product(x.size());
+        IntervalArray quotient(x.size());
+        IntervalArray power(x.size());
+        IntervalArray square(x.size());
+        IntervalArray fused(x.size());
+        kernels.multiply(x.lower(), x.upper(), y.lower(), y.upper(), product.lower(), product.upper(), x.size());
+        kernels.divide(x.lower(), x.upper(), y.lower(), y.upper(), quotient.lower(), quotient.upper(), x.size());
+        kernels.pow(x.lower(), x.upper(), y.lower(), y.upper(), power.lower(), power.upper(), x.size());
+        kernels.sqr(x.lower(), x.upper(), square.lower(), square.upper(), x.size());
+        kernels.fma(x.lower(), x.upper(), y.lower(), y.upper(), x.lower(), x.upper(), fused.lower(), fused.upper(), x.size());
+
+        for (std::size_t i = 0u; i < x.size(); i++)
+        {
+            const auto a = x.get(i);
+            const auto b = y.get(i);
+
+            EXPECT_TRUE(sameBits(product.lower()[i], (a * b).getX0()) && sameBits(product.upper()[i], (a * b).getX1())) << toString(isa);
+            EXPECT_TRUE(sameBits(quotient.lower()[i], (a / b).getX0()) && sameBits(quotient.upper()[i], (a / b).getX1())) << toString(isa);
+            EXPECT_TRUE(sameBits(power.lower()[i], a.pow(b).getX0()) && sameBits(power.upper()[i], a.pow(b).getX1())) << toString(isa);
+            EXPECT_TRUE(sameBits(square.lower()[i], a.sqr().getX0()) && sameBits(square.upper()[i], a.sqr().getX1())) << toString(isa);
+            EXPECT_TRUE(sameBits(fused.lower()[i], (a * b + a).getX0()) && sameBits(fused.upper()[i], (a * b + a).getX1())) << toString(isa);
+        }
+
+        // The finite pairs only; any infinite product makes the sum [-∞, ∞].
+        std::vector<IntervalNumber> finiteX{};
+        std::vector<IntervalNumber> finiteY{};
+        IntervalArray finiteArrayX{};
+        IntervalArray finiteArrayY{};
+        for (std::size_t i = 0u; i < x.size(); i++)
+        {
+            if (std::isfinite(x.lower()[i]) && std::isfinite(x.upper()[i]) && std::isfinite(y.lower()[i]) && std::isfinite(y.upper()[i]))
+            {
+                finiteX.push_back(x.get(i));
+                finiteY.push_back(y.get(i));
+                finiteArrayX.pushBack(x.get(i));
+                finiteArrayY.pushBack(y.get(i));
+            }
+        }
+        double d0{};
+        double d1{};
+        kernels.dot(finiteArrayX.lower(), finiteArrayX.upper(), finiteArrayY.lower(), finiteArrayY.upper(), finiteArrayX.size(), d0, d1);
+        const auto expected = dot(finiteX.data(), finiteY.data(), finiteX.size());
+        EXPECT_TRUE(sameBits(d0, expected.getX0()) && sameBits(d1, expected.getX1())) << toString(isa);
+    }
+}
+
+TEST(IntervalDispatch, ForcedVariantIsUsedByIntervalArray)
+{
+    const auto previous = intervalKernels().isa;
+
+    EXPECT_TRUE(isIntervalIsaSupported(bestIntervalIsa()));
+    EXPECT_TRUE(selectIntervalIsa(IntervalIsa::Scalar));
+    EXPECT_EQ(intervalKernels().isa, IntervalIsa::Scalar);
+
+    IntervalArray x{IntervalNumber(2.0, 3.0)};
+    IntervalArray y{IntervalNumber(0.0, 4.0)};
+    IntervalArray result{};
+    divide(x, y, result);
+
+    EXPECT_EQ(result.get(0), IntervalNumber(0.5, INF));
+
+    EXPECT_TRUE(selectIntervalIsa(previous));
+    EXPECT_EQ(intervalKernels().isa, previous);
+}
+
+// ---------------------------------------------------------------------
+// Deterministic reductions. The bracketing policy fixes the result; the
+// number of threads must not change a single bit.
+// ---------------------------------------------------------------------
+
+TEST(IntervalReduction, PoliciesFixTheBracketing)
+{
+    // Paper §5.2: (-1 * 0) * -inf = -Omega, -1 * (0 * -inf) = Omega.
+    const IntervalArray x{IntervalNumber(-1.0), IntervalNumber(0.0), IntervalNumber(-INF)};
+
+    EXPECT_EQ(reduceProduct(x, BracketingPolicy::leftFold()), NEGATIVE_OMEGA);
+    EXPECT_EQ(reduceProduct(x, BracketingPolicy::balancedTree()), OMEGA);
+    EXPECT_EQ(reduceProduct(x, BracketingPolicy::fixedBlock(2u)), NEGATIVE_OMEGA);
+    EXPECT_EQ(reduceProduct(x, BracketingPolicy::fixedBlock(1u)), NEGATIVE_OMEGA);
+
+    EXPECT_EQ(reduceProduct(IntervalArray{}, BracketingPolicy::balancedTree()), IntervalNumber(1.0));
+    EXPECT_EQ(reduceSum(IntervalArray{}, BracketingPolicy::fixedBlock(8u)), IntervalNumber(0.0));
+
+    // A block larger than the array is one block.
+    EXPECT_EQ(reduceProduct(x, BracketingPolicy::fixedBlock(SIZE_MAX)), NEGATIVE_OMEGA);
+    EXPECT_EQ(reduceSum(IntervalArray{IntervalNumber(1.0), IntervalNumber(2.0, 3.0)}, BracketingPolicy::fixedBlock(SIZE_MAX), 4u), IntervalNumber(3.0, 4.0));
+}
+
+TEST(IntervalReduction, ThreadCountDoesNotChangeResult)
+{
+    // Factors near 1 keep the product finite; zeros and infinities make the
+    // result depend on the bracketing.
+    const double values[] = {-1.0, 0.0, INF, -INF, 0.5, -2.0, 1.0000001, -0.9999999, 3.0, -0.0};
+    IntervalArray x{};
+    IntervalArray y{};
+    for (std::size_t i = 0u; i < 10007u; i++)
+    {
+        const double a = values[(i * 7u) % 10u];
+        const double b = values[(i * 3u + 1u) % 10u];
+        x.pushBack((i % 97u == 0u) ? IntervalNumber(a, b) : IntervalNumber(1.0 + 1e-3 * static_cast<double>(i % 13u), 1.01));
+        y.pushBack(IntervalNumber(0.1 * static_cast<double>(i % 31u) - 1.5, 0.1 * static_cast<double>(i % 17u)));
+    }
+
+    for (auto policy : {BracketingPolicy::leftFold(), BracketingPolicy::balancedTree(), BracketingPolicy::fixedBlock(64u)})
+    {
+        const auto product = reduceProduct(x, policy, 1u);
+        const auto sum = reduceSum(y, policy, 1u);
+        for (std::size_t threads : {2u, 3u, 4u, 7u, 16u})
+        {
+            const auto parallelProduct = reduceProduct(x, policy, threads);
+            const auto parallelSum = reduceSum(y, policy, threads);
+            EXPECT_TRUE(sameBits(parallelProduct.getX0(), product.getX0()) && sameBits(parallelProduct.getX1(), product.getX1())) << threads;
+            EXPECT_TRUE(sameBits(parallelSum.getX0(), sum.getX0()) && sameBits(parallelSum.getX1(), sum.getX1())) << threads;
+        }
+    }
+}
+
+TEST(IntervalReduction, BalancedTreeMatchesExplicitBracketing)
+{
+    IntervalArray x{};
+    std::vector<IntervalNumber> factors{};
+    for (std::size_t i = 0u; i < 5u; i++)
+    {
+        factors.emplace_back(0.1 * static_cast<double>(i) - 0.2, 0.3 * static_cast<double>(i) + 0.1);
+        x.pushBack(factors.back());
+    }
+
+    // [0, 5) splits into [0, 2) and [2, 5); [2, 5) into [2, 3) and [3, 5).
+    const auto expected = (factors[0] * factors[1]) * (factors[2] * (factors[3] * factors[4]));
+    const auto expectedSum = (factors[0] + factors[1]) + (factors[2] + (factors[3] + factors[4]));
+
+    EXPECT_EQ(reduceProduct(x, BracketingPolicy::balancedTree(), 4u), expected);
+    EXPECT_EQ(reduceSum(x, BracketingPolicy::balancedTree(), 4u), expectedSum);
+}
+
+// ---------------------------------------------------------------------
+// Bracketing planner. The plan must give the tightest product over all
+// bracketings and must not depend on the number of planning threads.
+// ---------------------------------------------------------------------
+
+// Products of factors[i..j] under every bracketing.
+static std::vector<IntervalNumber> allBracketings(const std::vector<IntervalNumber>& factors, std::size_t i, std::size_t j)
+{
+    if (i == j)
+    {
+        return {factors[i]};
+    }
+
+    std::vector<IntervalNumber> products{};
+    for (std::size_t split = i + 1u; split <= j; split++)
+    {
+        for (const auto& left : allBracketings(factors, i, split - 1u))
+        {
+            for (const auto& right : allBracketings(factors, split, j))
+            {
+                products.push_back(left * right);
+            }
+        }
+    }
+
+    return products;
+}
+
+TEST(ProductPlanner, AvoidsBlowupOfLeftFold)
+{
+    const std::vector<IntervalNumber> factors{IntervalNumber(-1.0), IntervalNumber(2.0, 3.0), IntervalNumber(0.0, 1.0), IntervalNumber(-INF), IntervalNumber(-1.0)};
+
+    IntervalNumber leftFold = factors[0];
+    for (std::size_t i = 1u; i < factors.size(); i++)
+    {
+        leftFold = leftFold * factors[i];
+    }
+
+    const auto plan = planProduct(factors);
+
+    EXPECT_EQ(leftFold, OMEGA_TILDE);
+    EXPECT_EQ(plan.evaluate(factors), NEGATIVE_OMEGA);
+    EXPECT_EQ(evaluateProduct(factors), NEGATIVE_OMEGA);
+    EXPECT_EQ(evaluateProduct({}), IntervalNumber(1.0));
+}
+
+TEST(ProductPlanner, MatchesExhaustiveSearch)
+{
+    const IntervalNumber pool[] = {IntervalNumber(-INF), IntervalNumber(-1.0), IntervalNumber(0.0), IntervalNumber(1.0), IntervalNumber(INF),
+                                   IntervalNumber(-1.0, 2.0), IntervalNumber(0.0, INF), IntervalNumber(-INF, 0.0), IntervalNumber(2.0, 3.0),
+                                   IntervalNumber(0.0, 1.0), IntervalNumber(-2.0, 0.0), IntervalNumber(-3.0, -0.5)};
+
+    std::uint32_t state = 12345u;
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8u;
+    };
+
+    for (std::size_t chain = 0u; chain < 500u; chain++)
+    {
+        std::vector<IntervalNumber> factors{};
+        const std::size_t count = 2u + next() % 6u;
+        for (std::size_t i = 0u; i < count; i++)
+        {
+            factors.push_back(pool[next() % 12u]);
+        }
+
+        IntervalNumber tightest = factors[0];
+        bool first = true;
+        for (const auto& product : allBracketings(factors, 0u, count - 1u))
+        {
+            if (first || isTighterProduct(product.getX0(), product.getX1(), tightest.getX0(), tightest.getX1()))
+            {
+                tightest = product;
+                first = false;
+            }
+        }
+
+        const auto planned = evaluateProduct(factors);
+        EXPECT_FALSE(isTighterProduct(tightest.getX0(), tightest.getX1(), planned.getX0(), planned.getX1()))
+            << planProduct(factors).toString() << " gives " << planned.toString() << ", " << tightest.toString() << " is possible";
+    }
+}
+
+TEST(ProductPlanner, LongChainsAndThreads)
+{
+    // Mostly positive finite factors, which are folded into runs, with zeros,
+    // infinities and sign changes in between.
+    std::vector<IntervalNumber> factors{};
+    for (std::size_t i = 0u; i < 3000u; i++)
+    {
+        switch (i % 50u)
+        {
+            case 7u:
+                factors.emplace_back(0.0, 1.0);
+                break;
+            case 19u:
+                factors.emplace_back(-INF, -2.0);
+                break;
+            case 31u:
+                factors.emplace_back(-1.0);
+                break;
+            default:
+                factors.emplace_back(1.0, 1.0 + 1e-4 * static_cast<double>(i % 7u));
+                break;
+        }
+    }
+
+    const auto plan = planProduct(factors, 1u);
+    const auto parallelPlan = planProduct(factors, 4u);
+
+    EXPECT_EQ(plan.toString(), parallelPlan.toString());
+    EXPECT_LT(plan.nodes().size(), factors.size() / 4u);
+    EXPECT_EQ(plan.nodes().back().begin, 0u);
+    EXPECT_EQ(plan.nodes().back().end, factors.size());
+    EXPECT_EQ(plan.evaluate(factors), parallelPlan.evaluate(factors));
+}
+
+TEST(ProductPlanner, KeepsOverflowOutOfRunsAndBoundsLongChains)
+{
+    // All finite, but 1e300 · 1e300 overflows: folding the chain into one
+    // left-to-right run would give [∞, ∞].
+    const std::vector<IntervalNumber> factors{IntervalNumber(1e300), IntervalNumber(1e300), IntervalNumber(1e-300), IntervalNumber(1e-300)};
+    const auto bracketed = factors[0] * (factors[1] * factors[2]) * factors[3];
+    const auto planned = evaluateProduct(factors);
+    EXPECT_TRUE(std::isfinite(planned.getX0()) && std::isfinite(planned.getX1())) << planned.toString();
+    EXPECT_FALSE(isTighterProduct(bracketed.getX0(), bracketed.getX1(), planned.getX0(), planned.getX1()));
+    EXPECT_NEAR(planned.getX0(), 1.0, 1e-12);
+
+    // The same for underflow toward a false zero.
+    const std::vector<IntervalNumber> tiny{IntervalNumber(1e-300), IntervalNumber(1e-300), IntervalNumber(1e300), IntervalNumber(-1.0, 2.0)};
+    const auto tinyPlanned = evaluateProduct(tiny);
+    EXPECT_NEAR(tinyPlanned.getX0(), -1e-300, 1e-310);
+    EXPECT_NEAR(tinyPlanned.getX1(), 2e-300, 1e-310);
+
+    // No factor folds into a run, so the program sees every factor; beyond
+    // PRODUCT_PLAN_SEGMENT it plans segments and still covers the chain.
+    const IntervalNumber pool[] = {IntervalNumber(-1.0, 2.0), IntervalNumber(0.0, INF), IntervalNumber(-INF, -1.0), IntervalNumber(-3.0, 0.0)};
+    std::vector<IntervalNumber> chain{};
+    for (std::size_t i = 0u; i < 1000u; i++)
+    {
+        chain.push_back(pool[(i * 7u + i / 3u) % 4u]);
+    }
+    const auto plan = planProduct(chain, 1u);
+    EXPECT_EQ(plan.nodes().size(), 2u * chain.size() - 1u);
+    EXPECT_EQ(plan.nodes().back().begin, 0u);
+    EXPECT_EQ(plan.nodes().back().end, chain.size());
+    EXPECT_EQ(plan.toString(), planProduct(chain, 3u).toString());
+}
+
+// ---------------------------------------------------------------------
+// MultiInterval. Division by a zero-spanning divisor keeps both branches
+// of the reciprocal; hull() agrees with IntervalNumber.
+// ---------------------------------------------------------------------
+
+TEST(MultiInterval, ZeroSpanningDivisorKeepsBothBranches)
+{
+    const MultiInterval<2> q = MultiInterval<2>(1.0) / MultiInterval<2>(-1.0, 2.0);
+
+    ASSERT_EQ(q.size(), 2u);
+    EXPECT_EQ(q[0], IntervalNumber(-INF, -1.0));
+    EXPECT_EQ(q[1], IntervalNumber(0.5, INF));
+    EXPECT_FALSE(q.contains(0.0));
+    EXPECT_EQ(q.hull(), IntervalNumber(1.0) / IntervalNumber(-1.0, 2.0));
+
+    // The gap survives later operations.
+    EXPECT_EQ(abs(q), MultiInterval<2>(0.5, INF));
+    EXPECT_EQ((q * 2.0)[1], IntervalNumber(1.0, INF));
+}
+
+TEST(MultiInterval, HullMatchesIntervalNumber)
+{
+    const auto intervals = sampleIntervals();
+
+    auto expectSameHull = [](const MultiInterval<3>& multi, const IntervalNumber& expected) {
+        EXPECT_TRUE(sameBits(multi.hull().getX0(), expected.getX0()) && sameBits(multi.hull().getX1(), expected.getX1()))
+            << multi.toString() << " vs " << expected.toString();
+    };
+
+    for (const auto& x : intervals)
+    {
+        for (const auto& y : intervals)
+        {
+            const MultiInterval<3> mx(x);
+            const MultiInterval<3> my(y);
+            expectSameHull(mx + my, x + y);
+            expectSameHull(mx - my, x - y);
+            expectSameHull(mx * my, x * y);
+            expectSameHull(mx / my, x / y);
+        }
+    }
+}
+
+TEST(MultiInterval, MergesSmallestGapBeyondCapacity)
+{
+    const MultiInterval<2> x = MultiInterval<2>(0.0, 1.0).unite(MultiInterval<2>(7.0, 8.0));
+    ASSERT_EQ(x.size(), 2u);
+
+    // Gaps of width 1 and 4: the narrower one closes.
+    const MultiInterval<2> y = x.unite(MultiInterval<2>(2.0, 3.0));
+    ASSERT_EQ(y.size(), 2u);
+    EXPECT_EQ(y[0], IntervalNumber(0.0, 3.0));
+    EXPECT_EQ(y[1], IntervalNumber(7.0, 8.0));
+
+    // Overlapping pieces always merge; a single piece holds the hull.
+    EXPECT_EQ(x.unite(MultiInterval<2>(0.5, 7.5)), MultiInterval<2>(0.0, 8.0));
+    EXPECT_EQ(MultiInterval<1>(1.0) / MultiInterval<1>(-1.0, 2.0), MultiInterval<1>(-INF, INF));
+
+    // NaN absorbs every other piece.
+    const MultiInterval<2> nan = x + MultiInterval<2>(QUIET_NAN);
+    EXPECT_EQ(nan.size(), 1u);
+    EXPECT_TRUE(std::isnan(nan[0].getX0()));
+}
+
+// ---------------------------------------------------------------------
+// Global optimizer. The enclosure must contain the minimum, Ω lower bounds
+// must never prune the minimizer, and the result must not depend on the
+// number of threads.
+// ---------------------------------------------------------------------
+
+// Six-hump camel function; global minimum -1.0316284534898774 at
+// (±0.0898420131, ∓0.7126564032).
+static IntervalNumber sixHumpCamel(const std::vector<IntervalNumber>& v)
+{
+    const IntervalNumber& x = v[0];
+    const IntervalNumber& y = v[1];
+
+    return 4.0 * pown(x, 2) - 2.1 * pown(x, 4) + pown(x, 6) / 3.0 + x * y - 4.0 * pown(y, 2) + 4.0 * pown(y, 4);
+}
+
+TEST(GlobalOptimizer, EnclosesGlobalMinimum)
+{
+    OptimizerOptions options{};
+    options.tolerance = 1e-4;
+
+    const auto result = minimizeGlobal(sixHumpCamel, {IntervalNumber(-3.0, 3.0), IntervalNumber(-2.0, 2.0)}, options);
+
+    EXPECT_TRUE(result.complete);
+    EXPECT_LE(result.minimum.getX0(), -1.0316284534898774);
+    EXPECT_GE(result.minimum.getX1(), -1.0316284534898774);
+    EXPECT_LT(result.minimum.getX1() - result.minimum.getX0(), 1e-3);
+    EXPECT_NEAR(std::abs(result.minimizer[0]), 0.0898420131, 1e-3);
+    EXPECT_NEAR(std::abs(result.minimizer[1]), 0.7126564032, 1e-3);
+    EXPECT_GT(result.prunedBoxes, 0u);
+}
+
+TEST(GlobalOptimizer, ThreadCountDoesNotChangeResult)
+{
+    OptimizerOptions options{};
+    options.tolerance = 1e-3;
+    options.batchSize = 16u;
+    options.threads = 1u;
+
+    const auto reference = minimizeGlobal(sixHumpCamel, {IntervalNumber(-3.0, 3.0), IntervalNumber(-2.0, 2.0)}, options);
+
+    for (std::size_t threads : {2u, 3u, 8u})
+    {
+        options.threads = threads;
+        const auto result = minimizeGlobal(sixHumpCamel, {IntervalNumber(-3.0, 3.0), IntervalNumber(-2.0, 2.0)}, options);
+
+        EXPECT_EQ(result.minimum, reference.minimum) << threads;
+        EXPECT_EQ(result.minimizer, reference.minimizer) << threads;
+        EXPECT_EQ(result.bisectedBoxes, reference.bisectedBoxes) << threads;
+        EXPECT_EQ(result.prunedBoxes, reference.prunedBoxes) << threads;
+        EXPECT_EQ(result.rounds, reference.rounds) << threads;
+    }
+}
+
+TEST(GlobalOptimizer, OmegaLowerBoundsAreSound)
+{
+    // x·(1/x) is 1 for x > 0; over [0, h] it evaluates to Ω = [0, ∞]
+    // (0·∞, Rule I), a lower bound of 0 that must not prune.
+    OptimizerOptions options{};
+    options.tolerance = 1e-3;
+
+    const auto ratio = minimizeGlobal([](const std::vector<IntervalNumber>& v) { return v[0] * (1.0 / v[0]); }, {IntervalNumber(0.0, 4.0)}, options);
+    EXPECT_EQ(ratio.minimum.getX0(), 0.0);
+    EXPECT_NEAR(ratio.minimum.getX1(), 1.0, 1e-15);
+
+    // -x·(1/x) over [0, h] is -Ω = [-∞, 0]; the search cannot bound it.
+    const auto negative = minimizeGlobal([](const std::vector<IntervalNumber>& v) { return -1.0 * v[0] * (1.0 / v[0]); }, {IntervalNumber(0.0, 4.0)}, options);
+    EXPECT_EQ(negative.minimum, IntervalNumber(-INF, -1.0));
+
+    // The limit on bisected boxes leaves the search incomplete but sound.
+    options.maxBoxes = 10u;
+    const auto limited = minimizeGlobal(sixHumpCamel, {IntervalNumber(-3.0, 3.0), IntervalNumber(-2.0, 2.0)}, options);
+    EXPECT_FALSE(limited.complete);
+    EXPECT_EQ(limited.bisectedBoxes, 10u);
+    EXPECT_LE(limited.minimum.getX0(), -1.0316284534898774);
+}
+
+// ---------------------------------------------------------------------
+// Expression tape. A recorded formula must reproduce the operators bit for
+// bit and reuse registers once their values are dead.
+// ---------------------------------------------------------------------
+
+TEST(ExpressionTape, MatchesOperatorsBitForBit)
+{
+    auto formula = [](const auto& x) {
+        return (x[0] * x[1] - 1.0 / x[1]) / pow(x[0], x[1]) + abs(2.0 - x[0]) * pow(x[1], 3.0);
+    };
+    const auto tape = ExpressionTape::record(2u, formula);
+
+    const auto intervals = sampleIntervals();
+    std::vector<IntervalArray> inputs(2u);
+    for (const auto& x : intervals)
+    {
+        for (const auto& y : intervals)
+        {
+            inputs[0].pushBack(x);
+            inputs[1].pushBack(y);
+        }
+    }
+    IntervalArray result{};
+    tape.evaluate(inputs, result);
+
+    ASSERT_EQ(result.size(), intervals.size() * intervals.size());
+    for (std::size_t i = 0u; i < result.size(); i++)
+    {
+        const auto expected = formula(std::vector<IntervalNumber>{inputs[0].get(i), inputs[1].get(i)});
+        EXPECT_TRUE(sameBits(result.lower()[i], expected.getX0()) && sameBits(result.upper()[i], expected.getX1()))
+            << inputs[0].get(i).toString() << ", " << inputs[1].get(i).toString() << ": " << result.get(i).toString() << " vs " << expected.toString();
+    }
+}
+
+TEST(ExpressionTape, ReusesDeadRegisters)
+{
+    // A chain keeps a single value live; the last instruction writes the output.
+    const auto chain = ExpressionTape::record(1u, [](const std::vector<TapeValue>& x) {
+        TapeValue y = x[0] * x[0];
+        for (int i = 0; i < 100; i++)
+        {
+            y = y * x[0] + 1.0;
+        }
+        return y;
+    });
+    EXPECT_EQ(chain.instructions().size(), 201u);
+    EXPECT_EQ(chain.registers(), 1u);
+    EXPECT_EQ(chain.instructions().back().result, ExpressionTape::NONE);
+
+    // Unused nodes are dropped.
+    const auto pruned = ExpressionTape::record(2u, [](const std::vector<TapeValue>& x) {
+        const TapeValue unused = x[0] / x[1];
+        (void)unused;
+        return x[1] * 2.0;
+    });
+    EXPECT_EQ(pruned.toString(), "out = x1 * c0\n");
+    EXPECT_EQ(pruned.evaluate({IntervalNumber(0.0), IntervalNumber(-1.0, INF)}), IntervalNumber(-2.0, INF));
+}
+
+TEST(ExpressionTape, HandlesChunkTailsAndBareInputs)
+{
+    const std::size_t count = 3u * ExpressionTape::CHUNK_SIZE + 7u;
+    std::vector<IntervalArray> inputs(1u);
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        inputs[0].pushBack(IntervalNumber(static_cast<double>(i) - 500.0, static_cast<double>(i)));
+    }
+
+    IntervalArray result{};
+    ExpressionTape::record(1u, [](const std::vector<TapeValue>& x) { return 1.0 / x[0]; }).evaluate(inputs, result);
+    ASSERT_EQ(result.size(), count);
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        EXPECT_EQ(result.get(i), 1.0 / inputs[0].get(i));
+    }
+
+    ExpressionTape::record(1u, [](const std::vector<TapeValue>& x) { return x[0]; }).evaluate(inputs, result);
+    EXPECT_EQ(result.get(count - 1u), inputs[0].get(count - 1u));
+}
+
+// ---------------------------------------------------------------------
+// Expression templates. Deferred evaluation must keep the bracketing of
+// the eager operators and reproduce them bit for bit.
+// ---------------------------------------------------------------------
+
+TEST(IntervalExpression, MatchesEagerOperatorsBitForBit)
+{
+    const auto intervals = sampleIntervals();
+
+    auto expectSameBits = [](const IntervalNumber& lazyResult, const IntervalNumber& eager) {
+        EXPECT_TRUE(sameBits(lazyResult.getX0(), eager.getX0()) && sameBits(lazyResult.getX1(), eager.getX1()))
+            << lazyResult.toString() << " vs " << eager.toString();
+    };
+
+    for (const auto& a : intervals)
+    {
+        for (const auto& b : intervals)
+        {
+            for (const auto& c : intervals)
+            {
+                expectSameBits((lazy(a) * b + c) / a, (a * b + c) / a);
+                expectSameBits(pow(abs(lazy(a) - b), c) * 2.0, pow(abs(a - b), c) * 2.0);
+            }
+            expectSameBits(pown(lazy(a) / b, 3) - 1.0, pown(a / b, 3) - 1.0);
+        }
+    }
+}
+
+TEST(IntervalExpression, KeepsBracketing)
+{
+    // Paper §5.2: (-1·0)·(-∞) = -Ω but -1·(0·(-∞)) = Ω.
+    const IntervalNumber minusOne(-1.0);
+    const IntervalNumber zero(0.0);
+    const IntervalNumber minusInfinity(-INF);
+
+    const IntervalNumber left = lazy(minusOne) * zero * minusInfinity;
+    const IntervalNumber right = lazy(minusOne) * (lazy(zero) * minusInfinity);
+
+    EXPECT_EQ(left, NEGATIVE_OMEGA);
+    EXPECT_EQ(right, OMEGA);
+    EXPECT_EQ(evaluate(lazy(minusOne) * zero * minusInfinity), minusOne * zero * minusInfinity);
+}
+
+TEST(IntervalExpression, AssignsArraysInOnePass)
+{
+    const auto intervals = sampleIntervals();
+    const std::size_t count = 3u * EXPRESSION_BLOCK + 5u;
+    IntervalArray x{};
+    IntervalArray y{};
+    IntervalArray z{};
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        x.pushBack(intervals[i % intervals.size()]);
+        y.pushBack(intervals[(7u * i + 3u) % intervals.size()]);
+        z.pushBack(intervals[(13u * i + 5u) % intervals.size()]);
+    }
+
+    IntervalArray result{};
+    assign((lazy(x) * y + z) / x - 2.0, result);
+    ASSERT_EQ(result.size(), count);
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        const auto expected = (x.get(i) * y.get(i) + z.get(i)) / x.get(i) - 2.0;
+        EXPECT_TRUE(sameBits(result.lower()[i], expected.getX0()) && sameBits(result.upper()[i], expected.getX1())) << i;
+    }
+
+    // The result may be one of the operands.
+    assign((lazy(x) * y + z) / x - 2.0, x);
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        EXPECT_TRUE(sameBits(x.lower()[i], result.lower()[i]) && sameBits(x.upper()[i], result.upper()[i])) << i;
+    }
+}
+
+// ---------------------------------------------------------------------
+// Transcendental functions. Scalar and batch results must enclose the
+// exact range and take the limits at infinite endpoints.
+// ---------------------------------------------------------------------
+
+// An elementary function: IntervalNumber function, batch kernel,
+// IntervalArray function and long double reference.
+struct TranscendentalCase
+{
+    const char* name;
+    IntervalNumber (*scalar)(const IntervalNumber&);
+    void (*batch)(const double*, const double*, double*, double*, std::size_t);
+    void (*array)(const IntervalArray&, IntervalArray&);
+    long double (*reference)(long double);
+};
+
+enum TranscendentalIndex : std::size_t { EXP, LOG, SQRT, SIN, COS, ATAN, TANH };
+
+static std::vector<TranscendentalCase> transcendentalCases()
+{
+    return {
+        {"exp", [](const IntervalNumber& x) { return exp(x); }, batchExp, [](const IntervalArray& x, IntervalArray& r) { exp(x, r); }, [](long double x) { return std::exp(x); }},
+        {"log", [](const IntervalNumber& x) { return log(x); }, batchLog, [](const IntervalArray& x, IntervalArray& r) { log(x, r); }, [](long double x) { return std::log(x); }},
+        {"sqrt", [](const IntervalNumber& x) { return sqrt(x); }, batchSqrt, [](const IntervalArray& x, IntervalArray& r) { sqrt(x, r); }, [](long double x) { return std::sqrt(x); }},
+        {"sin", [](const IntervalNumber& x) { return sin(x); }, batchSin, [](const IntervalArray& x, IntervalArray& r) { sin(x, r); }, [](long double x) { return std::sin(x); }},
+        {"cos", [](const IntervalNumber& x) { return cos(x); }, batchCos, [](const IntervalArray& x, IntervalArray& r) { cos(x, r); }, [](long double x) { return std::cos(x); }},
+        {"atan", [](const IntervalNumber& x) { return atan(x); }, batchAtan, [](const IntervalArray& x, IntervalArray& r) { atan(x, r); }, [](long double x) { return std::atan(x); }},
+        {"tanh", [](const IntervalNumber& x) { return tanh(x); }, batchTanh, [](const IntervalArray& x, IntervalArray& r) { tanh(x, r); }, [](long double x) { return std::tanh(x); }},
+    };
+}
+
+// Evaluates a transcendental case on one interval, scalar or batch.
+static IntervalNumber evaluateTranscendental(const TranscendentalCase& c, const IntervalNumber& x, bool batch)
+{
+    if (!batch)
+    {
+        return c.scalar(x);
+    }
+
+    const double x0 = x.getX0();
+    const double x1 = x.getX1();
+    double r0;
+    double r1;
+    c.batch(&x0, &x1, &r0, &r1, 1u);
+
+    return IntervalNumber(r0, r1);
+}
+
+TEST(Transcendental, InfiniteEndpointsTakeLimits)
+{
+    const auto cases = transcendentalCases();
+    const long double HALF_PI = 1.5707963267948966192313216916397514L;
+
+    for (bool batch : {false, true})
+    {
+        auto f = [&](std::size_t c, const IntervalNumber& x) { return evaluateTranscendental(cases[c], x, batch); };
+
+        EXPECT_EQ(f(EXP, OMEGA_TILDE), OMEGA);
+        EXPECT_EQ(f(EXP, IntervalNumber(-INF)), IntervalNumber(0.0));
+        EXPECT_EQ(f(EXP, IntervalNumber(0.0)), IntervalNumber(1.0));
+
+        // log([0, 2]) = [-∞, log 2].
+        const auto logarithm = f(LOG, IntervalNumber(0.0, 2.0));
+        EXPECT_EQ(logarithm.getX0(), -INF);
+        EXPECT_GE(static_cast<long double>(logarithm.getX1()), std::log(2.0L));
+        EXPECT_LT(logarithm.getX1(), std::log(2.0) + 1e-13);
+        EXPECT_EQ(f(LOG, OMEGA), OMEGA_TILDE);
+        EXPECT_EQ(f(LOG, IntervalNumber(1.0)), IntervalNumber(0.0));
+        EXPECT_TRUE(std::isnan(f(LOG, IntervalNumber(-1.0, 2.0)).getX0()));
+
+        EXPECT_EQ(f(SQRT, OMEGA), OMEGA);
+        EXPECT_EQ(f(SQRT, IntervalNumber(4.0, 9.0)), IntervalNumber(2.0, 3.0));
+        EXPECT_TRUE(std::isnan(f(SQRT, NEGATIVE_OMEGA).getX0()));
+
+        EXPECT_EQ(f(SIN, OMEGA), IntervalNumber(-1.0, 1.0));
+        EXPECT_EQ(f(COS, NEGATIVE_OMEGA), IntervalNumber(-1.0, 1.0));
+        EXPECT_EQ(f(SIN, IntervalNumber(0.0)), IntervalNumber(0.0));
+        EXPECT_EQ(f(COS, IntervalNumber(0.0)), IntervalNumber(1.0));
+
+        const auto angle = f(ATAN, OMEGA_TILDE);
+        EXPECT_LE(static_cast<long double>(angle.getX0()), -HALF_PI);
+        EXPECT_GE(static_cast<long double>(angle.getX1()), HALF_PI);
+        EXPECT_LT(angle.getX1(), std::atan(INF) + 1e-13);
+
+        EXPECT_EQ(f(TANH, OMEGA_TILDE), IntervalNumber(-1.0, 1.0));
+        EXPECT_EQ(f(TANH, IntervalNumber(0.0)), IntervalNumber(0.0));
+
+        for (std::size_t c = 0u; c < cases.size(); c++)
+        {
+            const auto result = f(c, IntervalNumber(QUIET_NAN));
+            EXPECT_TRUE(std::isnan(result.getX0()) && std::isnan(result.getX1())) << cases[c].name;
+        }
+    }
+}
+
+TEST(Transcendental, EnclosesRangeAndStaysTight)
+{
+    const auto cases = transcendentalCases();
+
+    // Extrema inside the interval: sin has its maximum at π/2, cos its
+    // minimum at π.
+    for (bool batch : {false, true})
+    {
+        EXPECT_EQ(evaluateTranscendental(cases[SIN], IntervalNumber(1.0, 2.0), batch).getX1(), 1.0);
+        EXPECT_LT(evaluateTranscendental(cases[SIN], IntervalNumber(1.7, 1.8), batch).getX1(), 1.0);
+        EXPECT_EQ(evaluateTranscendental(cases[COS], IntervalNumber(3.0, 3.5), batch).getX0(), -1.0);
+        EXPECT_EQ(evaluateTranscendental(cases[COS], IntervalNumber(-7.0, 0.0), batch), IntervalNumber(-1.0, 1.0));
+    }
+
+    const double scales[4u] = {1e-9, 1.0, 40.0, 3e4};
+    const double widths[4u] = {0.0, 1e-7, 0.5, 3.0};
+    for (std::size_t index = 0u; index < cases.size(); index++)
+    {
+        const auto& c = cases[index];
+        const bool positive = (index == LOG) || (index == SQRT);
+        for (double scale : scales)
+        {
+            for (int k = -30; k <= 30; k++)
+            {
+                for (double width : widths)
+                {
+                    const double centre = positive ? std::fabs(k * 0.173 * scale) : k * 0.173 * scale;
+                    const IntervalNumber x(centre, centre + width * scale);
+                    const auto scalar = evaluateTranscendental(c, x, false);
+                    const auto batch = evaluateTranscendental(c, x, true);
+
+                    for (int j = 0; j <= 8; j++)
+                    {
+                        const double point = std::min(x.getX0() + (x.getX1() - x.getX0()) * j / 8.0, x.getX1());
+                        const long double exact = c.reference(point);
+                        EXPECT_TRUE(scalar.getX0() <= exact && exact <= scalar.getX1()) << c.name << " " << x.toString() << " at " << point;
+                        EXPECT_TRUE(batch.getX0() <= exact && exact <= batch.getX1()) << c.name << " " << x.toString() << " at " << point;
+                    }
+
+                    // The batch kernels give up a few ulps, not more.
+                    if (std::isfinite(scalar.getX0()) && std::isfinite(scalar.getX1()))
+                    {
+                        const double slack = 1e-13 * (std::fabs(scalar.getX0()) + std::fabs(scalar.getX1())) + 1e-300;
+                        EXPECT_GE(batch.getX0(), scalar.getX0() - slack) << c.name << " " << x.toString();
+                        EXPECT_LE(batch.getX1(), scalar.getX1() + slack) << c.name << " " << x.toString();
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(Transcendental, EndpointTypesAndArrays)
+{
+    using Float = IntervalNumberT<float>;
+    using LongDouble = IntervalNumberT<long double>;
+
+    const Float e = exp(Float(1.0f));
+    EXPECT_LT(static_cast<long double>(e.getX0()), std::exp(1.0L));
+    EXPECT_GT(static_cast<long double>(e.getX1()), std::exp(1.0L));
+    EXPECT_EQ(sin(Float(-std::numeric_limits<float>::infinity(), 0.0f)), Float(-1.0f, 1.0f));
+    EXPECT_EQ(sqrt(LongDouble(0.25L, 16.0L)), LongDouble(0.5L, 4.0L));
+    EXPECT_EQ(log(LongDouble(0.0L, 1.0L)), LongDouble(-std::numeric_limits<long double>::infinity(), 0.0L));
+
+    // The IntervalArray functions run the batch kernels; the result may be
+    // the operand.
+    const auto intervals = sampleIntervals();
+    const auto cases = transcendentalCases();
+    for (const auto& c : cases)
+    {
+        IntervalArray x{};
+        for (const auto& interval : intervals)
+        {
+            x.pushBack(interval);
+        }
+        IntervalArray result{};
+        c.array(x, result);
+        c.array(x, x);
+
+        ASSERT_EQ(result.size(), intervals.size());
+        for (std::size_t i = 0u; i < intervals.size(); i++)
+        {
+            const auto expected = evaluateTranscendental(c, intervals[i], true);
+            EXPECT_TRUE(sameBits(result.lower()[i], expected.getX0()) && sameBits(result.upper()[i], expected.getX1())) << c.name << " " << i;
+            EXPECT_TRUE(sameBits(x.lower()[i], expected.getX0()) && sameBits(x.upper()[i], expected.getX1())) << c.name << " " << i;
+
+            // NaN exactly where the scalar function gives NaN.
+            EXPECT_EQ(std::isnan(expected.getX0()), std::isnan(c.scalar(intervals[i]).getX0())) << c.name << " " << intervals[i].toString();
+        }
+    }
+}
+
+// ---------------------------------------------------------------------
+// Point exponents. pow() evaluates an integer point like pown() and a real
+// point from the two endpoint powers; both must give the result of the
+// general corner kernel.
+// ---------------------------------------------------------------------
+
+TEST(PowPointExponent, RealPointMatchesCornerKernel)
+{
+    const auto intervals = sampleIntervals();
+    const std::vector<double> exponents{0.5, 2.5, -0.5, -2.5, 1e-3, 1e300, -1e300, 0x1p62};
+    for (const auto& base : intervals)
+    {
+        for (double e : exponents)
+        {
+            double r0{};
+            double r1{};
+            double c0{};
+            double c1{};
+            IntervalNumber::powBounds(base.getX0(), base.getX1(), e, e, r0, r1);
+            IntervalNumber::powCornerBounds(base.getX0(), base.getX1(), e, e, c0, c1);
+            EXPECT_TRUE(sameBits(r0, c0) && sameBits(r1, c1)) << base.toString() << " ^ " << e;
+        }
+    }
+}
+
+TEST(PowPointExponent, IntegerPointMatchesCornerKernel)
+{
+    // The sample endpoints are small integers and halves, so every power
+    // below is exact and squaring agrees with std::pow bit for bit.
+    const auto intervals = sampleIntervals();
+    for (const auto& base : intervals)
+    {
+        for (long long n = -4; n <= 7; n++)
+        {
+            const double e = static_cast<double>(n);
+            double c0{};
+            double c1{};
+            IntervalNumber::powCornerBounds(base.getX0(), base.getX1(), e, e, c0, c1);
+            const auto result = base.pow(e);
+            EXPECT_TRUE(sameBits(result.getX0(), c0) && sameBits(result.getX1(), c1)) << base.toString() << " ^ " << n;
+            EXPECT_TRUE(sameBits(result.getX0(), base.pown(n).getX0()) && sameBits(result.getX1(), base.pown(n).getX1()));
+        }
+    }
+
+    // Inexact powers up to the squaring limit stay within a few ulps of
+    // std::pow.
+    const double epsilon = std::numeric_limits<double>::epsilon();
+    for (long long n : {17ll, -17ll, IntervalNumber::POW_SQUARING_LIMIT, -IntervalNumber::POW_SQUARING_LIMIT})
+    {
+        const double e = static_cast<double>(n);
+        const auto power = IntervalNumber(1.1, 1.3).pow(e);
+        EXPECT_NEAR(power.getX0(), std::min(std::pow(1.1, e), std::pow(1.3, e)), 8.0 * epsilon * power.getX0()) << n;
+        EXPECT_NEAR(power.getX1(), std::max(std::pow(1.1, e), std::pow(1.3, e)), 8.0 * epsilon * power.getX1()) << n;
+    }
+
+    // Larger exponents keep std::pow, whose error does not grow with n.
+    EXPECT_EQ(IntervalNumber(1.0000000001).pow(1e12).getX0(), std::pow(1.0000000001, 1e12));
+    EXPECT_EQ(IntervalNumber(1.0000001).pow(1e9).getX1(), std::pow(1.0000001, 1e9));
+    EXPECT_EQ(IntervalNumber(10.0).pow(-310.0).getX0(), std::pow(10.0, -310.0));
+    EXPECT_EQ(IntervalNumber(2.0).pow(-1074.0).getX0(), std::pow(2.0, -1074.0));
+
+    // Negative powers near underflow do not overflow to zero on the way.
+    EXPECT_EQ(IntervalNumber(2.0).pown(-1074).getX0(), std::pow(2.0, -1074.0));
+    EXPECT_NEAR(IntervalNumber(10.0).pown(-310).getX0(), 1e-310, 1e-310 * 1e-12);
+    EXPECT_EQ(IntervalNumber(-2.0).pow(-63.0).getX0(), -std::pow(2.0, -63.0));
+    EXPECT_NEAR(IntervalNumber(1e5).pow(-64.0).getX0(), 1e-320, 1e-323);
+    EXPECT_GT(IntervalNumber(1e5).pow(-64.0).getX0(), 0.0);
+}
+
+TEST(PowPointExponent, CompileTimeExponent)
+{
+    static_assert(pow<3>(IntervalNumber(-2.0, 3.0)) == IntervalNumber(-8.0, 27.0), "odd power");
+    static_assert(pow<2>(IntervalNumber(-2.0, 3.0)) == IntervalNumber(0.0, 9.0), "interior minimum of an even power");
+    static_assert(IntervalNumber(2.0, 4.0).pow<-1>() == IntervalNumber(0.25, 0.5), "reciprocal");
+    static_assert(pow<0>(IntervalNumber(0.0, INF)) == IntervalNumber(0.0, INF), "0^0 and inf^0 give Omega");
+
+    const auto intervals = sampleIntervals();
+    for (const auto& base : intervals)
+    {
+        const auto result = pow<5>(base);
+        EXPECT_TRUE(sameBits(result.getX0(), base.pown(5).getX0()) && sameBits(result.getX1(), base.pown(5).getX1())) << base.toString();
+    }
+
+    // The rigorous type keeps the std::pow corners and widens them.
+    const auto rigorous = RigorousIntervalNumber(1.1, 1.3).pow(17.0);
+    EXPECT_LE(rigorous.getX0(), std::pow(static_cast<long double>(1.1), 17.0L));
+    EXPECT_GE(rigorous.getX1(), std::pow(static_cast<long double>(1.3), 17.0L));
+}
+
+// ---------------------------------------------------------------------
+// Square, fused multiply-add and dot product. sqr() follows pown(2); fma()
+// and dot() must give the operators' results for their bracketing.
+// ---------------------------------------------------------------------
+
+TEST(SqrFmaDot, SquareIsTighterThanProduct)
+{
+    static_assert(sqr(IntervalNumber(-1.0, 2.0)) == IntervalNumber(0.0, 4.0), "zero-spanning square");
+    static_assert(sqr(IntervalNumber(-INF, -2.0)) == IntervalNumber(4.0, INF), "negative square");
+    EXPECT_EQ(IntervalNumber(-1.0, 2.0) * IntervalNumber(-1.0, 2.0), IntervalNumber(-2.0, 4.0));
+
+    const auto intervals = sampleIntervals();
+    IntervalArray x{};
+    for (const auto& a : intervals)
+    {
+        x.pushBack(a);
+    }
+    IntervalArray squares{};
+    sqr(x, squares);
+
+    for (std::size_t i = 0u; i < intervals.size(); i++)
+    {
+        const auto& a = intervals[i];
+        const auto square = a.sqr();
+        EXPECT_TRUE(sameBits(square.getX0(), a.pown(2).getX0()) && sameBits(square.getX1(), a.pown(2).getX1())) << a.toString();
+        EXPECT_TRUE(sameBits(squares.lower()[i], square.getX0()) && sameBits(squares.upper()[i], square.getX1())) << a.toString();
+
+        const auto product = a * a;
+        if (!std::isnan(product.getX0()))
+        {
+            EXPECT_GE(square.getX0(), product.getX0()) << a.toString();
+            EXPECT_LE(square.getX1(), product.getX1()) << a.toString();
+        }
+    }
+}
+
+TEST(SqrFmaDot, FmaMatchesOperatorsBitForBit)
+{
+    static_assert(fma(IntervalNumber(0.0), IntervalNumber(INF), IntervalNumber(1.0)) == IntervalNumber(1.0, INF), "0·∞ + 1");
+    static_assert(fma(IntervalNumber(2.0), IntervalNumber(INF), IntervalNumber(-INF)) == IntervalNumber(-INF, INF), "∞ - ∞");
+
+    const auto intervals = sampleIntervals();
+    for (const auto& a : intervals)
+    {
+        for (const auto& b : intervals)
+        {
+            for (const auto& c : intervals)
+            {
+                const auto fused = fma(a, b, c);
+                const auto expected = a * b + c;
+                EXPECT_TRUE(sameBits(fused.getX0(), expected.getX0()) && sameBits(fused.getX1(), expected.getX1()))
+                    << a.toString() << " * " << b.toString() << " + " << c.toString();
+            }
+        }
+    }
+
+    // Blocks of the batch kernel and the aliased result.
+    IntervalArray x{};
+    IntervalArray y{};
+    samplePairs(x, y);
+    IntervalArray z{};
+    for (std::size_t i = 0u; i < x.size(); i++)
+    {
+        z.pushBack(intervals[(i * 7u) % intervals.size()]);
+    }
+    IntervalArray result{};
+    fma(x, y, z, result);
+    fma(x, y, z, z);
+
+    ASSERT_EQ(result.size(), x.size());
+    for (std::size_t i = 0u; i < x.size(); i++)
+    {
+        const auto expected = x.get(i) * y.get(i) + intervals[(i * 7u) % intervals.size()];
+        EXPECT_TRUE(sameBits(result.lower()[i], expected.getX0()) && sameBits(result.upper()[i], expected.getX1())) << i;
+        EXPECT_TRUE(sameBits(z.lower()[i], expected.getX0()) && sameBits(z.upper()[i], expected.getX1())) << i;
+    }
+}
+
+TEST(SqrFmaDot, DotUsesFixedLaneBracketing)
+{
+    constexpr IntervalNumber a[2u]{IntervalNumber(0.0), IntervalNumber(1.0, 2.0)};
+    constexpr IntervalNumber b[2u]{IntervalNumber(INF), IntervalNumber(-1.0, 3.0)};
+    static_assert(dot(a, b, 2u) == IntervalNumber(-2.0, INF), "Ω + [-2, 6]");
+    static_assert(dot(a, b, 0u) == IntervalNumber(0.0), "empty sum");
+
+    // Every count up to three blocks, with special values mixed in.
+    const auto intervals = sampleIntervals();
+    constexpr std::size_t LANES = IntervalNumber::DOT_LANES;
+    for (std::size_t count = 0u; count <= 3u * LANES + 1u; count++)
+    {
+        for (std::size_t offset : {0u, 5u, 40u})
+        {
+            std::vector<IntervalNumber> x{};
+            std::vector<IntervalNumber> y{};
+            for (std::size_t i = 0u; i < count; i++)
+            {
+                x.push_back(intervals[(offset + i) % 41u]);
+                y.push_back(intervals[(offset + 3u * i) % 41u]);
+            }
+
+            IntervalNumber partial[LANES]{};
+            for (std::size_t i = 0u; i < count; i++)
+            {
+                partial[i % LANES] = partial[i % LANES] + x[i] * y[i];
+            }
+            IntervalNumber expected = partial[0u];
+            for (std::size_t lane = 1u; lane < LANES; lane++)
+            {
+                expected = expected + partial[lane];
+            }
+
+            const auto result = dot(x.data(), y.data(), count);
+            IntervalArray xArray{};
+            IntervalArray yArray{};
+            for (std::size_t i = 0u; i < count; i++)
+            {
+                xArray.pushBack(x[i]);
+                yArray.pushBack(y[i]);
+            }
+            const auto batch = dot(xArray, yArray);
+
+            EXPECT_TRUE(sameBits(result.getX0(), expected.getX0()) && sameBits(result.getX1(), expected.getX1())) << count << " " << offset;
+            EXPECT_TRUE(sameBits(batch.getX0(), expected.getX0()) && sameBits(batch.getX1(), expected.getX1())) << count << " " << offset;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------
+// Endpoint classes. The class index of two operands selects the corners
+// of a product; the rounded product must not depend on the selection.
+// ---------------------------------------------------------------------
+
+TEST(EndpointClasses, ClassifiesEveryEndpoint)
+{
+    static_assert(IntervalNumber::endpointClass(-INF) == IntervalNumber::CLASS_NEGATIVE_INF, "-inf");
+    static_assert(IntervalNumber::endpointClass(-2.0) == IntervalNumber::CLASS_NEGATIVE, "negative");
+    static_assert(IntervalNumber::endpointClass(-0.0) == IntervalNumber::CLASS_ZERO, "negative zero");
+    static_assert(IntervalNumber::endpointClass(0.0) == IntervalNumber::CLASS_ZERO, "zero");
+    static_assert(IntervalNumber::endpointClass(1e-310) == IntervalNumber::CLASS_POSITIVE, "subnormal");
+    static_assert(IntervalNumber::endpointClass(INF) == IntervalNumber::CLASS_POSITIVE_INF, "+inf");
+    EXPECT_EQ(IntervalNumber::endpointClass(QUIET_NAN), IntervalNumber::CLASS_NAN);
+
+    static_assert(IntervalNumber::classIndex(-INF, -INF, -INF, -INF) == 0u, "first index");
+    static_assert(IntervalNumber::classIndex(1.0, INF, -1.0, 0.0) == ((3u * 6u + 4u) * 6u + 1u) * 6u + 2u, "base-6 digits");
+    EXPECT_EQ(IntervalNumber::classIndex(QUIET_NAN, QUIET_NAN, QUIET_NAN, QUIET_NAN), 1295u);
+}
+
+TEST(EndpointClasses, CornerTableSelectsExtremeCorners)
+{
+    const auto& table = IntervalNumber::productCornerTable();
+    const auto intervals = sampleIntervals();
+
+    for (const auto& x : intervals)
+    {
+        for (const auto& y : intervals)
+        {
+            const unsigned corners = table[IntervalNumber::classIndex(x.getX0(), x.getX1(), y.getX0(), y.getX1())];
+            EXPECT_EQ(corners == 0u, std::isnan(x.getX0()) || std::isnan(x.getX1()) || std::isnan(y.getX0()) || std::isnan(y.getX1()));
+            if (corners == IntervalNumber::ALL_CORNERS || corners == 0u)
+            {
+                continue;
+            }
+
+            const double a[4u] = {x.getX0(), x.getX0(), x.getX1(), x.getX1()};
+            const double b[4u] = {y.getX0(), y.getX1(), y.getX0(), y.getX1()};
+            const double lo = std::min(a[corners & 3u] * b[corners & 3u], a[(corners >> 2u) & 3u] * b[(corners >> 2u) & 3u]);
+            const double hi = std::max(a[(corners >> 4u) & 3u] * b[(corners >> 4u) & 3u], a[corners >> 6u] * b[corners >> 6u]);
+
+            EXPECT_EQ(IntervalNumber(lo, hi), x * y) << x.toString() << " * " << y.toString();
+        }
+    }
+}
+
+TEST(EndpointClasses, RigorousProductMatchesFourCorners)
+{
+    const std::vector<double> values{-INF, -1e300, -3.0, -1.0 / 3.0, -1e-200, -0.0, 0.0, 1e-200, 0.1, 1.0, 7.0, 1e300, INF, QUIET_NAN};
+
+    for (std::size_t i = 0u; i < values.size(); i++)
+    {
+        for (std::size_t k = i; k < values.size(); k++)
+        {
+            for (std::size_t m = 0u; m < values.size(); m++)
+            {
+                for (std::size_t n = m; n < values.size(); n++)
+                {
+                    const RigorousIntervalNumber x{values[i], values[k]};
+                    const RigorousIntervalNumber y{values[m], values[n]};
+
+                    // Every corner rounded in both directions, as before the corner table.
+                    const double a[4u] = {values[i], values[i], values[k], values[k]};
+                    const double b[4u] = {values[m], values[n], values[m], values[n]};
+                    double lo = INF;
+                    double hi = -INF;
+                    for (unsigned c = 0u; c < 4u; c++)
+                    {
+                        double clo{};
+                        double chi{};
+                        IntervalNumber::productBounds(a[c], b[c], clo, chi);
+                        if (clo == chi)
+                        {
+                            clo = RigorousIntervalNumber::productDown(a[c], b[c], clo);
+                            chi = RigorousIntervalNumber::productUp(a[c], b[c], chi);
+                        }
+                        IntervalNumber::includeBounds(lo, hi, clo, chi);
+                    }
+                    const bool isNaN = std::isnan(values[i]) || std::isnan(values[k]) || std::isnan(values[m]) || std::isnan(values[n]);
+
+                    const auto product = x * y;
+                    EXPECT_TRUE(sameBits(product.getX0(), isNaN ? QUIET_NAN : lo) && sameBits(product.getX1(), isNaN ? QUIET_NAN : hi))
+                        << x.toString() << " * " << y.toString();
+                }
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------
+// Sign-class intervals. The class in the type selects one case at compile
+// time; the result must equal the IntervalNumber operation bit for bit.
+// ---------------------------------------------------------------------
+
+TEST(SignClassInterval, ResultTypesFollowClasses)
+{
+    constexpr PositiveInterval p{2.0, 4.0};
+    constexpr NonNegativeInterval n{0.0, INF};
+    constexpr FiniteInterval f{-1.0, 3.0};
+
+    static_assert(std::is_same<decltype(p + p), PositiveInterval>::value, "positive sum");
+    static_assert(std::is_same<decltype(p + n), PositiveInterval>::value, "positive plus non-negative");
+    static_assert(std::is_same<decltype(n + n), NonNegativeInterval>::value, "non-negative sum");
+    static_assert(std::is_same<decltype(p * p), NonNegativeInterval>::value, "a positive product may underflow");
+    static_assert(std::is_same<decltype(n / p), NonNegativeInterval>::value, "non-negative quotient");
+    static_assert(std::is_same<decltype(f * f), IntervalNumber>::value, "a finite product may overflow");
+    static_assert(std::is_same<decltype(p - p), IntervalNumber>::value, "difference");
+    static_assert(std::is_same<decltype(p / f), IntervalNumber>::value, "general quotient");
+
+    static_assert(IntervalNumber(p * p) == IntervalNumber(4.0, 16.0), "outer corners");
+    static_assert(IntervalNumber(n * NonNegativeInterval(0.0)) == IntervalNumber(OMEGA), "Rule I");
+    static_assert(IntervalNumber(PositiveInterval(1.0) / p) == IntervalNumber(0.25, 0.5), "reciprocal");
+    static_assert(f * f == IntervalNumber(-3.0, 9.0), "four corners");
+
+    EXPECT_TRUE(PositiveInterval::admits(1e-300, INF));
+    EXPECT_FALSE(PositiveInterval::admits(0.0, 1.0));
+    EXPECT_TRUE(NonNegativeInterval::admits(-0.0, 0.0));
+    EXPECT_FALSE(FiniteInterval::admits(1.0, INF));
+    EXPECT_FALSE(FiniteInterval::admits(QUIET_NAN, 1.0));
+}
+
+TEST(SignClassInterval, MatchesIntervalNumberBitForBit)
+{
+    std::vector<double> values{};
+    for (const double v : {-INF, -1e300, -3.0, -1.0 / 3.0, -1e-310, -0.0, 0.0, 1e-310, 1e-200, 0.1, 1.0, 7.0, 1e300, INF})
+    {
+        values.push_back(v);
+    }
+
+    const auto same = [](const IntervalNumber& a, const IntervalNumber& b) {
+        return sameBits(a.getX0(), b.getX0()) && sameBits(a.getX1(), b.getX1());
+    };
+
+    std::size_t positive = 0u;
+    std::size_t finite = 0u;
+    for (std::size_t i = 0u; i < values.size(); i++)
+    {
+        for (std::size_t k = i; k < values.size(); k++)
+        {
+            for (std::size_t m = 0u; m < values.size(); m++)
+            {
+                for (std::size_t n = m; n < values.size(); n++)
+                {
+                    const IntervalNumber x{values[i], values[k]};
+                    const IntervalNumber y{values[m], values[n]};
+
+                    if (NonNegativeInterval::admits(values[i], values[k]) && NonNegativeInterval::admits(values[m], values[n]))
+                    {
+                        const NonNegativeInterval a{values[i], values[k]};
+                        const NonNegativeInterval b{values[m], values[n]};
+                        EXPECT_TRUE(same(a + b, x + y)) << x.toString() << " + " << y.toString();
+                        EXPECT_TRUE(same(a - b, x - y)) << x.toString() << " - " << y.toString();
+                        EXPECT_TRUE(same(a * b, x * y)) << x.toString() << " * " << y.toString();
+                        if (PositiveInterval::admits(values[m], values[n]))
+                        {
+                            const PositiveInterval c{values[m], values[n]};
+                            EXPECT_TRUE(same(a / c, x / y)) << x.toString() << " / " << y.toString();
+                            EXPECT_TRUE(same(c * c, y * y)) << y.toString();
+                            positive++;
+                        }
+                    }
+                    if (FiniteInterval::admits(values[i], values[k]))
+                    {
+                        const FiniteInterval a{values[i], values[k]};
+                        if (FiniteInterval::admits(values[m], values[n]))
+                        {
+                            const FiniteInterval b{values[m], values[n]};
+                            EXPECT_TRUE(same(a + b, x + y)) << x.toString() << " + " << y.toString();
+                            EXPECT_TRUE(same(a - b, x - y)) << x.toString() << " - " << y.toString();
+                            EXPECT_TRUE(same(a * b, x * y)) << x.toString() << " * " << y.toString();
+                            finite++;
+                        }
+                        if (NonNegativeInterval::admits(values[m], values[n]))
+                        {
+                            const NonNegativeInterval b{values[m], values[n]};
+                            EXPECT_TRUE(same(a + b, x + y)) << x.toString() << " + " << y.toString();
+                            EXPECT_TRUE(same(a - b, x - y)) << x.toString() << " - " << y.toString();
+                            EXPECT_TRUE(same(b - a, y - x)) << y.toString() << " - " << x.toString();
+                            EXPECT_TRUE(same(a * b, x * y)) << x.toString() << " * " << y.toString();
+                        }
+                    }
+                }
+            }
+        }
+    }
+    EXPECT_GT(positive, 0u);
+    EXPECT_GT(finite, 0u);
+}
+
+TEST(SignClassInterval, ConvertsImplicitly)
+{
+    const PositiveInterval p{0.5, 2.0};
+    const NonNegativeInterval n = p;
+    const IntervalNumber general = p;
+
+    EXPECT_EQ(n.getX0(), 0.5);
+    EXPECT_EQ(general, IntervalNumber(0.5, 2.0));
+
+    // Functions and operators taking IntervalNumber accept every class.
+    const auto width = [](const IntervalNumber& x) { return x.getX1() - x.getX0(); };
+    EXPECT_EQ(width(FiniteInterval(-3.0, 1.0)), 4.0);
+    EXPECT_EQ(p * IntervalNumber(-1.0, 1.0), IntervalNumber(-2.0, 2.0));
+    EXPECT_EQ(IntervalNumber(INF) - NonNegativeInterval(0.0, INF), IntervalNumber(OMEGA_TILDE));
+    EXPECT_EQ(IntervalNumber(1.0) / FiniteInterval(-1.0, 1.0), IntervalNumber(-INF, INF));
+    EXPECT_EQ(NonNegativeInterval(0.0) * IntervalNumber(INF), IntervalNumber(OMEGA));
+}
+
+// ---------------------------------------------------------------------
+// Double-double intervals. Results must enclose the exact result, stay
+// within a few 2^-100 of it, resolve the indeterminate forms like
+// IntervalNumber, and come out of every batch kernel bit for bit.
+// ---------------------------------------------------------------------
+
+TEST(DoubleDoubleInterval, EnclosesTightly)
+{
+    const DoubleDoubleInterval third = DoubleDoubleInterval(1.0) / DoubleDoubleInterval(3.0);
+    const DoubleDoubleInterval one = third * 3.0;
+
+    // 1/3 needs the low part; 3 · [1/3] encloses 1 to about 2^-100.
+    EXPECT_NE(third.getX0().getLo(), 0.0);
+    EXPECT_TRUE(one.getX0() < DoubleDouble(1.0) && DoubleDouble(1.0) < one.getX1());
+    EXPECT_LT(DoubleDouble::add(one.getX1(), -one.getX0()).getHi(), 1e-29);
+    EXPECT_EQ(one.toNearest(), IntervalNumber(std::nextafter(1.0, 0.0), std::nextafter(1.0, 2.0)));
+
+    // Sums and products of doubles are exact.
+    const DoubleDoubleInterval sum = DoubleDoubleInterval(1.0) + 1e-20;
+    EXPECT_EQ(sum.getX0(), sum.getX1());
+    EXPECT_EQ(sum.getX0().getHi(), 1.0);
+    EXPECT_EQ(sum.getX0().getLo(), 1e-20);
+    const DoubleDoubleInterval product = DoubleDoubleInterval(0.1) * 0.1;
+    EXPECT_EQ(product.getX0(), product.getX1());
+    EXPECT_EQ(product.getX0().getLo(), std::fma(0.1, 0.1, -0.1 * 0.1));
+
+    // An overflowing product keeps a finite lower bound.
+    const DoubleDoubleInterval overflow = DoubleDoubleInterval(1e300) * 1e10;
+    EXPECT_GT(overflow.getX0().getHi(), 1.79e308);
+    EXPECT_EQ(overflow.getX1().getHi(), INF);
+    EXPECT_EQ((-1e300 * DoubleDoubleInterval(1e10)).getX0().getHi(), -INF);
+}
+
+TEST(DoubleDoubleInterval, ResolvesIndeterminateFormsLikeIntervalNumber)
+{
+    static_assert(DoubleDoubleInterval::RELATIVE_ERROR == 0x1p-100, "error bound");
+
+    EXPECT_EQ((DoubleDoubleInterval(0.0) * DoubleDoubleInterval(INF)).toNearest(), OMEGA);
+    EXPECT_EQ((DoubleDoubleInterval(0.0) * DoubleDoubleInterval(-INF)).toNearest(), NEGATIVE_OMEGA);
+    EXPECT_EQ((DoubleDoubleInterval(INF) - DoubleDoubleInterval(INF)).toNearest(), OMEGA_TILDE);
+    EXPECT_EQ((DoubleDoubleInterval(0.0) / DoubleDoubleInterval(0.0)).toNearest(), OMEGA_TILDE);
+    EXPECT_EQ((DoubleDoubleInterval(1.0) / DoubleDoubleInterval(-1.0, 1.0)).toNearest(), OMEGA_TILDE);
+    EXPECT_EQ((DoubleDoubleInterval(1.0) / DoubleDoubleInterval(0.0, 4.0)).toNearest(), IntervalNumber(0.25, INF));
+
+    // The sample endpoints are small binary fractions: sums and products are
+    // exact, and a quotient is at most one ulp from the round-to-nearest one.
+    const auto intervals = sampleIntervals();
+    for (const auto& a : intervals)
+    {
+        for (const auto& b : intervals)
+        {
+            const DoubleDoubleInterval x{a};
+            const DoubleDoubleInterval y{b};
+            const IntervalNumber results[3u]{(x + y).toNearest(), (x - y).toNearest(), (x * y).toNearest()};
+            const IntervalNumber expected[3u]{a + b, a - b, a * b};
+            for (std::size_t i = 0u; i < 3u; i++)
+            {
+                EXPECT_TRUE(sameBits(results[i].getX0(), expected[i].getX0()) || results[i].getX0() == expected[i].getX0()) << a.toString() << ", " << b.toString();
+                EXPECT_TRUE(sameBits(results[i].getX1(), expected[i].getX1()) || results[i].getX1() == expected[i].getX1()) << a.toString() << ", " << b.toString();
+            }
+
+            const IntervalNumber quotient = (x / y).toNearest();
+            const IntervalNumber q = a / b;
+            EXPECT_EQ(std::isnan(quotient.getX0()), std::isnan(q.getX0()));
+            if (!std::isnan(q.getX0()))
+            {
+                EXPECT_TRUE(quotient.getX0() <= q.getX0() && quotient.getX0() >= std::nextafter(q.getX0(), -INF)) << a.toString() << " / " << b.toString();
+                EXPECT_TRUE(quotient.getX1() >= q.getX1() && quotient.getX1() <= std::nextafter(q.getX1(), INF)) << a.toString() << " / " << b.toString();
+            }
+        }
+    }
+}
+
+TEST(DoubleDoubleIntervalArray, EveryVariantMatchesOperators)
+{
+    IntervalArray pairsX{};
+    IntervalArray pairsY{};
+    samplePairs(pairsX, pairsY);
+
+    // Divide by 3 and 7 so that most endpoints carry a low part.
+    DoubleDoubleIntervalArray x(pairsX.size());
+    DoubleDoubleIntervalArray y(pairsY.size());
+    for (std::size_t i = 0u; i < x.size(); i++)
+    {
+        x.set(i, DoubleDoubleInterval(pairsX.get(i)) / 3.0);
+        y.set(i, DoubleDoubleInterval(pairsY.get(i)) / 7.0);
+    }
+
+    const auto same = [](const DoubleDouble& a, const DoubleDouble& b) { return sameBits(a.getHi(), b.getHi()) && sameBits(a.getLo(), b.getLo()); };
+
+    for (auto isa : {IntervalIsa::Scalar, IntervalIsa::Baseline, IntervalIsa::Avx2, IntervalIsa::Avx512})
+    {
+        if (!isIntervalIsaSupported(isa))
+        {
+            continue;
+        }
+
+        const auto& kernels = doubleDoubleKernels(isa);
+        DoubleDoubleIntervalArray sum(x.size());
+        DoubleDoubleIntervalArray difference(x.size());
+        DoubleDoubleIntervalArray product(x.size());
+        DoubleDoubleIntervalArray quotient(x.size());
+        kernels.add(x, y, sum);
+        kernels.subtract(x, y, difference);
+        kernels.multiply(x, y, product);
+        kernels.divide(x, y, quotient);
+
+        for (std::size_t i = 0u; i < x.size(); i++)
+        {
+            const auto a = x.get(i);
+            const auto b = y.get(i);
+            const DoubleDoubleInterval results[4u]{sum.get(i), difference.get(i), product.get(i), quotient.get(i)};
+            const DoubleDoubleInterval expected[4u]{a + b, a - b, a * b, a / b};
+            for (std::size_t k = 0u; k < 4u; k++)
+            {
+                EXPECT_TRUE(same(results[k].getX0(), expected[k].getX0()) && same(results[k].getX1(), expected[k].getX1()))
+                    << toString(isa) << " " << k << ": " << a.toString() << ", " << b.toString();
+            }
+        }
+    }
+
+    // The result may be an operand.
+    DoubleDoubleIntervalArray z{DoubleDoubleInterval(1.0, 2.0)};
+    multiply(z, z, z);
+    EXPECT_EQ(z.get(0u), DoubleDoubleInterval(1.0, 4.0));
+}
+
+// ---------------------------------------------------------------------
+// Binary interval files. Endpoints must round-trip bit for bit, the mapped
+// blocks must feed the batch kernels in place, and invalid files must be
+// rejected.
+// ---------------------------------------------------------------------
+
+static std::string intervalFilePath(const char* name)
+{
+    return testing::TempDir() + name;
+}
+
+TEST(IntervalFile, RoundTripsBitForBit)
+{
+    const auto intervals = sampleIntervals();
+    const std::string path = intervalFilePath("round_trip.zi");
+
+    // A block size of 16 splits the samples into several blocks and a
+    // partial last block.
+    IntervalFileWriter writer(16u);
+    ASSERT_TRUE(writer.open(path.c_str()));
+    for (const auto& interval : intervals)
+    {
+        EXPECT_TRUE(writer.append(interval));
+    }
+    EXPECT_EQ(writer.size(), intervals.size());
+    EXPECT_TRUE(writer.close());
+
+    MappedIntervalFile file{};
+    ASSERT_TRUE(file.open(path.c_str()));
+    EXPECT_EQ(file.size(), intervals.size());
+    EXPECT_EQ(file.blockCount(), (intervals.size() + 15u) / 16u);
+    EXPECT_EQ(file.blockLength(file.blockCount() - 1u), intervals.size() % 16u);
+    for (std::size_t i = 0u; i < intervals.size(); i++)
+    {
+        EXPECT_TRUE(sameBits(file.get(i).getX0(), intervals[i].getX0()) && sameBits(file.get(i).getX1(), intervals[i].getX1())) << intervals[i].toString();
+    }
+    for (std::size_t b = 0u; b < file.blockCount(); b++)
+    {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(file.lower(b)) % INTERVAL_FILE_ALIGNMENT, 0u);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(file.upper(b)) % INTERVAL_FILE_ALIGNMENT, 0u);
+    }
+
+    // float endpoints use their own endpoint type.
+    IntervalFileWriterT<float> floatWriter{};
+    ASSERT_TRUE(floatWriter.open(path.c_str()));
+    EXPECT_TRUE(floatWriter.append(IntervalNumberT<float>(-0.0f, std::numeric_limits<float>::infinity())));
+    EXPECT_TRUE(floatWriter.close());
+    MappedIntervalFileT<float> floatFile{};
+    ASSERT_TRUE(floatFile.open(path.c_str()));
+    EXPECT_EQ(floatFile.header().endpointType, static_cast<std::uint32_t>(IntervalEndpointType::Float32));
+    EXPECT_TRUE(std::signbit(floatFile.get(0u).getX0()));
+    EXPECT_EQ(floatFile.get(0u).getX1(), std::numeric_limits<float>::infinity());
+}
+
+TEST(IntervalFile, BatchKernelsReadMappedBlocks)
+{
+    IntervalArray x{};
+    IntervalArray y{};
+    samplePairs(x, y);
+    const std::string pathX = intervalFilePath("batch_x.zi");
+    const std::string pathY = intervalFilePath("batch_y.zi");
+
+    // Streamed in uneven chunks.
+    IntervalFileWriter writerX(256u);
+    IntervalFileWriter writerY(256u);
+    ASSERT_TRUE(writerX.open(pathX.c_str()) && writerY.open(pathY.c_str()));
+    for (std::size_t begin = 0u; begin < x.size(); begin += 1000u)
+    {
+        const std::size_t count = std::min<std::size_t>(1000u, x.size() - begin);
+        EXPECT_TRUE(writerX.append(x.lower() + begin, x.upper() + begin, count));
+        EXPECT_TRUE(writerY.append(y.lower() + begin, y.upper() + begin, count));
+    }
+    EXPECT_TRUE(writerX.close() && writerY.close());
+
+    MappedIntervalFile fileX{};
+    MappedIntervalFile fileY{};
+    ASSERT_TRUE(fileX.open(pathX.c_str()) && fileY.open(pathY.c_str()));
+    ASSERT_EQ(fileX.size(), x.size());
+
+    IntervalArray expected{};
+    multiply(x, y, expected);
+    IntervalArray product(fileX.blockSize());
+    for (std::size_t b = 0u; b < fileX.blockCount(); b++)
+    {
+        const std::size_t length = fileX.blockLength(b);
+        intervalKernels().multiply(fileX.lower(b), fileX.upper(b), fileY.lower(b), fileY.upper(b), product.lower(), product.upper(), length);
+        for (std::size_t i = 0u; i < length; i++)
+        {
+            const auto e = expected.get(b * fileX.blockSize() + i);
+            EXPECT_TRUE(sameBits(product.lower()[i], e.getX0()) && sameBits(product.upper()[i], e.getX1()));
+        }
+    }
+}
+
+TEST(IntervalFile, RejectsInvalidFiles)
+{
+    const std::string path = intervalFilePath("invalid.zi");
+    MappedIntervalFile file{};
+
+    EXPECT_FALSE(file.open(intervalFilePath("missing.zi").c_str()));
+    EXPECT_FALSE(file.isOpen());
+
+    // Endpoint type mismatch.
+    IntervalFileWriterT<float> floatWriter{};
+    ASSERT_TRUE(floatWriter.open(path.c_str()));
+    EXPECT_TRUE(floatWriter.append(IntervalNumberT<float>(1.0f, 2.0f)));
+    EXPECT_TRUE(floatWriter.close());
+    EXPECT_FALSE(file.open(path.c_str()));
+
+    // Truncated: the header claims more intervals than the file holds.
+    {
+        IntervalFileWriter writer{};
+        ASSERT_TRUE(writer.open(path.c_str()));
+        EXPECT_TRUE(writer.append(IntervalNumber(1.0, 2.0)));
+        EXPECT_TRUE(writer.close());
+    }
+    ASSERT_TRUE(file.open(path.c_str()));
+    file.close();
+    IntervalFileHeader header{};
+    std::FILE* stream = std::fopen(path.c_str(), "r+b");
+    ASSERT_NE(stream, nullptr);
+    ASSERT_EQ(std::fread(&header, sizeof(header), 1u, stream), 1u);
+    header.count = 100u;
+    std::fseek(stream, 0L, SEEK_SET);
+    std::fwrite(&header, sizeof(header), 1u, stream);
+    std::fclose(stream);
+    EXPECT_FALSE(file.open(path.c_str()));
+
+    // A block size so large that the block count would wrap to zero.
+    {
+        IntervalFileWriter writer{};
+        ASSERT_TRUE(writer.open(path.c_str()));
+        for (std::size_t i = 0u; i < 17u; i++)
+        {
+            EXPECT_TRUE(writer.append(IntervalNumber(static_cast<double>(i))));
+        }
+        EXPECT_TRUE(writer.close());
+    }
+    stream = std::fopen(path.c_str(), "r+b");
+    ASSERT_NE(stream, nullptr);
+    ASSERT_EQ(std::fread(&header, sizeof(header), 1u, stream), 1u);
+    header.blockSize = 0xFFFFFFFFFFFFFFF0u;
+    std::fseek(stream, 0L, SEEK_SET);
+    std::fwrite(&header, sizeof(header), 1u, stream);
+    std::fclose(stream);
+    EXPECT_FALSE(file.open(path.c_str()));
+
+    // Unknown version and a file that is not an interval file.
+    header.count = 1u;
+    header.blockSize = INTERVAL_FILE_BLOCK_SIZE;
+    header.version = INTERVAL_FILE_VERSION + 1u;
+    stream = std::fopen(path.c_str(), "r+b");
+    ASSERT_NE(stream, nullptr);
+    std::fwrite(&header, sizeof(header), 1u, stream);
+    std::fclose(stream);
+    EXPECT_FALSE(file.open(path.c_str()));
+    stream = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(stream, nullptr);
+    std::fputs("[0.000000, inf]in\n", stream);
+    std::fclose(stream);
+    EXPECT_FALSE(file.open(path.c_str()));
+
+    // Until the writer is closed the file reads as empty.
+    IntervalFileWriter unfinished{};
+    ASSERT_TRUE(unfinished.open(path.c_str()));
+    EXPECT_TRUE(unfinished.append(IntervalNumber(1.0, 2.0)));
+    std::fflush(nullptr);
+    ASSERT_TRUE(file.open(path.c_str()));
+    EXPECT_EQ(file.size(), 0u);
+}
+
+// ---------------------------------------------------------------------
+// Text formatting and parsing. Written text must read back bit for bit,
+// for single intervals and for CSV and NDJSON datasets, independently of
+// the number of threads.
+// ---------------------------------------------------------------------
+
+// Intervals from pseudo-random bit patterns, which include subnormals, ±∞
+// and NaN, followed by the samples.
+static IntervalArray randomBitIntervals(std::size_t count)
+{
+    IntervalArray x{};
+    std::uint64_t state = 0x9E3779B97F4A7C15u;
+    auto next = [&state]() {
+        state = state * 6364136223846793005u + 1442695040888963407u;
+        const std::uint64_t bits = state ^ (state >> 29u);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    };
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        const double x0 = next();
+        x.pushBack(IntervalNumber(x0, next()));
+    }
+    for (const auto& interval : sampleIntervals())
+    {
+        x.pushBack(interval);
+    }
+
+    return x;
+}
+
+TEST(IntervalText, CharsRoundTripBitForBit)
+{
+    const IntervalArray x = randomBitIntervals(10000u);
+    char text[IntervalNumber::TEXT_LENGTH];
+
+    for (std::size_t i = 0u; i < x.size(); i++)
+    {
+        const std::to_chars_result written = x.get(i).toChars(text, text + sizeof(text));
+        ASSERT_EQ(written.ec, std::errc{});
+        IntervalNumber read{};
+        const std::from_chars_result parsed = IntervalNumber::fromChars(text, written.ptr, read);
+        ASSERT_EQ(parsed.ec, std::errc{}) << std::string(text, written.ptr);
+        EXPECT_EQ(parsed.ptr, written.ptr);
+        EXPECT_TRUE(sameBits(read.getX0(), x.get(i).getX0()) && sameBits(read.getX1(), x.get(i).getX1())) << std::string(text, written.ptr);
+    }
+
+    // The longest endpoints fit into TEXT_LENGTH; toString() is the same
+    // text and no longer rounds to six decimals.
+    const IntervalNumber longest(-2.2250738585072014e-308, -1.7976931348623157e308);
+    const std::to_chars_result written = longest.toChars(text, text + sizeof(text));
+    EXPECT_EQ(written.ec, std::errc{});
+    EXPECT_EQ(std::string(text, written.ptr), longest.toString());
+    EXPECT_EQ(IntervalNumber(-INF, 0.1).toString(), "[-inf, 0.1]in");
+    EXPECT_EQ(IntervalNumber(QUIET_NAN).toString(), "[nan, nan]in");
+    EXPECT_EQ(IntervalNumber(1.0).toChars(text, text + 7).ec, std::errc::value_too_large);
+
+    // Other endpoint types use their own shortest representation.
+    IntervalNumberT<float> f{};
+    const std::string floatText = IntervalNumberT<float>(0.1f, 3.4028235e38f).toString();
+    EXPECT_EQ(floatText, "[0.1, 3.4028235e+38]in");
+    EXPECT_EQ(IntervalNumberT<float>::fromChars(floatText.data(), floatText.data() + floatText.size(), f).ec, std::errc{});
+    EXPECT_EQ(f, IntervalNumberT<float>(0.1f, 3.4028235e38f));
+    IntervalNumberT<long double> l{};
+    const std::string longText = IntervalNumberT<long double>(-0.1L, 1.0L / 3.0L).toString();
+    EXPECT_EQ(IntervalNumberT<long double>::fromChars(longText.data(), longText.data() + longText.size(), l).ec, std::errc{});
+    EXPECT_EQ(l, IntervalNumberT<long double>(-0.1L, 1.0L / 3.0L));
+}
+
+TEST(IntervalText, ParsesIntervalSyntax)
+{
+    struct Case {
+        const char* text;
+        IntervalNumber expected;
+        std::size_t length;
+    };
+    const Case valid[] = {
+        {"[-inf, inf]in", IntervalNumber(-INF, INF), 13u},
+        {" [ 0 ,1e3 ] tail", IntervalNumber(0.0, 1000.0), 11u},
+        {"[2,1]", IntervalNumber(1.0, 2.0), 5u},
+        {"[+1.5, Infinity]in", IntervalNumber(1.5, INF), 18u},
+        {"-0.25", IntervalNumber(-0.25), 5u},
+        {"INF", IntervalNumber(INF), 3u},
+        {"0x10", IntervalNumber(0.0), 1u}
+    };
+    for (const auto& c : valid)
+    {
+        IntervalNumber x{};
+        const std::from_chars_result read = IntervalNumber::fromChars(c.text, c.text + std::strlen(c.text), x);
+        EXPECT_EQ(read.ec, std::errc{}) << c.text;
+        EXPECT_EQ(x, c.expected) << c.text;
+        EXPECT_EQ(static_cast<std::size_t>(read.ptr - c.text), c.length) << c.text;
+    }
+
+    IntervalNumber nan{};
+    const char* nanText = "[nan, 1]in";
+    EXPECT_EQ(IntervalNumber::fromChars(nanText, nanText + std::strlen(nanText), nan).ec, std::errc{});
+    EXPECT_TRUE(std::isnan(nan.getX0()) && std::isnan(nan.getX1()));
+
+    // Failures leave the interval unchanged.
+    const char* invalid[] = {"", "  ", "[1 2]", "[1,", "[1, 2", "x", "[, 2]", "++1", "+-1", "[1, 2)in"};
+    for (const char* text : invalid)
+    {
+        IntervalNumber x(7.0);
+        const std::from_chars_result read = IntervalNumber::fromChars(text, text + std::strlen(text), x);
+        EXPECT_EQ(read.ec, std::errc::invalid_argument) << text;
+        EXPECT_EQ(read.ptr, text) << text;
+        EXPECT_EQ(x, IntervalNumber(7.0)) << text;
+    }
+    IntervalNumber x(7.0);
+    const char* overflow = "[1, 1e400]";
+    EXPECT_EQ(IntervalNumber::fromChars(overflow, overflow + std::strlen(overflow), x).ec, std::errc::result_out_of_range);
+    EXPECT_EQ(x, IntervalNumber(7.0));
+}
+
+TEST(IntervalText, CsvAndNdjsonRoundTripOnAnyThreadCount)
+{
+    // Several MiB of text, so parsing splits it into several segments.
+    const IntervalArray x = randomBitIntervals(150000u);
+    const IntervalTextFormat formats[] = {IntervalTextFormat::Csv, IntervalTextFormat::Ndjson};
+
+    for (auto format : formats)
+    {
+        std::string text{};
+        std::string parallelText{};
+        formatIntervals(x, format, text, 1u);
+        formatIntervals(x, format, parallelText, 4u);
+        EXPECT_EQ(text, parallelText);
+
+        for (std::size_t threads : {1u, 3u})
+        {
+            IntervalArray y{};
+            ASSERT_TRUE(parseIntervals(text.data(), text.data() + text.size(), format, y, threads));
+            ASSERT_EQ(y.size(), x.size());
+            for (std::size_t i = 0u; i < x.size(); i++)
+            {
+                ASSERT_TRUE(sameBits(y.lower()[i], x.lower()[i]) && sameBits(y.upper()[i], x.upper()[i])) << i;
+            }
+        }
+
+        const std::string path = intervalFilePath(format == IntervalTextFormat::Csv ? "intervals.csv" : "intervals.ndjson");
+        IntervalArray y{};
+        ASSERT_TRUE(writeIntervalText(path.c_str(), x, format));
+        ASSERT_TRUE(readIntervalText(path.c_str(), y, format));
+        EXPECT_EQ(y.size(), x.size());
+    }
+
+    IntervalArray pair{IntervalNumber(-INF, 0.5), IntervalNumber(QUIET_NAN)};
+    std::string text{};
+    formatIntervals(pair, IntervalTextFormat::Csv, text);
+    EXPECT_EQ(text, "-inf,0.5\nnan,nan\n");
+    formatIntervals(pair, IntervalTextFormat::Ndjson, text);
+    EXPECT_EQ(text, "[\"-inf\",0.5]\n[\"nan\",\"nan\"]\n");
+
+    // Hand-written text: CRLF, blank lines, point intervals and JSON null.
+    const std::string csv = "1,2\r\n\n 3 \r\n-inf , 4\n5,4";
+    IntervalArray y{};
+    ASSERT_TRUE(parseIntervals(csv.data(), csv.data() + csv.size(), IntervalTextFormat::Csv, y));
+    ASSERT_EQ(y.size(), 4u);
+    EXPECT_EQ(y.get(1u), IntervalNumber(3.0));
+    EXPECT_EQ(y.get(2u), IntervalNumber(-INF, 4.0));
+    EXPECT_EQ(y.get(3u), IntervalNumber(4.0, 5.0));
+    const std::string ndjson = "[ \"-inf\" , 1 ]\r\n[null,2]\n\n[0,\"inf\"]\n";
+    ASSERT_TRUE(parseIntervals(ndjson.data(), ndjson.data() + ndjson.size(), IntervalTextFormat::Ndjson, y));
+    ASSERT_EQ(y.size(), 3u);
+    EXPECT_EQ(y.get(0u), IntervalNumber(-INF, 1.0));
+    EXPECT_TRUE(std::isnan(y.get(1u).getX0()));
+    EXPECT_EQ(y.get(2u), IntervalNumber(0.0, INF));
+
+    // Invalid lines fail and leave the result empty.
+    const std::string invalid[] = {"1,2\nx0,x1\n", "1,2,3\n", "1;2\n"};
+    for (const auto& bad : invalid)
+    {
+        EXPECT_FALSE(parseIntervals(bad.data(), bad.data() + bad.size(), IntervalTextFormat::Csv, y)) << bad;
+        EXPECT_EQ(y.size(), 0u);
+    }
+    const std::string badJson[] = {"[1]\n", "[1,2\n", "1,2\n", "[\"1,2]\n"};
+    for (const auto& bad : badJson)
+    {
+        EXPECT_FALSE(parseIntervals(bad.data(), bad.data() + bad.size(), IntervalTextFormat::Ndjson, y)) << bad;
+    }
+    EXPECT_FALSE(readIntervalText(intervalFilePath("missing.csv").c_str(), y, IntervalTextFormat::Csv));
+}
+
+// ---------------------------------------------------------------------
+// Formulas as text and streaming evaluation. A parsed formula must give the
+// bits of the operators, with C++ precedence and grouping, and the stream
+// must keep the input order for any number of workers.
+// ---------------------------------------------------------------------
+
+TEST(ExpressionParser, MatchesOperatorsBitForBit)
+{
+    struct Case {
+        const char* text;
+        IntervalNumber (*formula)(const IntervalNumber& x, const IntervalNumber& y);
+    };
+    const Case cases[] = {
+        {"(x0 * x1 - 1 / x1) / pow(x0, x1) + abs(2 - x0) * x1 ^ 3",
+         [](const IntervalNumber& x, const IntervalNumber& y) { return (x * y - 1.0 / y) / x.pow(y) + (2.0 - x).abs() * y.pow(3.0); }},
+        {"x0 - x1 - x0 / x1 / 2", [](const IntervalNumber& x, const IntervalNumber& y) { return ((x - y) - (x / y) / 2.0); }},
+        {"-x^2 + sqr(x1)", [](const IntervalNumber& x, const IntervalNumber& y) { return -1.0 * x.pow(2.0) + y.pow(2.0); }},
+        {"2 ^ x1 ^ 0.5 * +inf", [](const IntervalNumber&, const IntervalNumber& y) { return IntervalNumber(2.0).pow(y.pow(0.5)) * INF; }}
+    };
+
+    IntervalArray x{};
+    IntervalArray y{};
+    samplePairs(x, y);
+    for (const auto& c : cases)
+    {
+        ExpressionTape tape{};
+        std::string error{};
+        ASSERT_TRUE(parseExpression(c.text, tape, error)) << c.text << ": " << error;
+        EXPECT_EQ(tape.inputs(), 2u) << c.text;
+
+        IntervalArray result{};
+        tape.evaluate({x, y}, result);
+        for (std::size_t i = 0u; i < x.size(); i++)
+        {
+            const IntervalNumber expected = c.formula(x.get(i), y.get(i));
+            EXPECT_TRUE(sameBits(result.lower()[i], expected.getX0()) && sameBits(result.upper()[i], expected.getX1()))
+                << c.text << " at " << x.get(i).toString() << ", " << y.get(i).toString() << ": " << result.get(i).toString() << " vs " << expected.toString();
+        }
+    }
+
+    // 'x' is x0, and a formula without inputs still takes one.
+    ExpressionTape tape{};
+    std::string error{};
+    ASSERT_TRUE(parseExpression("x * 0", tape, error));
+    EXPECT_EQ(tape.evaluate({IntervalNumber(0.0, INF)}), OMEGA);
+    ASSERT_TRUE(parseExpression(" 1.5e1 ", tape, error));
+    EXPECT_EQ(tape.inputs(), 1u);
+    EXPECT_EQ(tape.evaluate({IntervalNumber(7.0)}), IntervalNumber(15.0));
+}
+
+TEST(ExpressionParser, ReportsErrorsWithColumns)
+{
+    const std::pair<const char*, const char*> invalid[] = {
+        {"", "unexpected end at column 1"},
+        {"x0 +", "unexpected end at column 5"},
+        {"x0 x1", "unexpected input at column 4"},
+        {"(x0 * 2", "expected ')' at column 8"},
+        {"pow(x0)", "expected ',' at column 7"},
+        {"y + 1", "unknown name 'y' at column 1"},
+        {"x01", "unknown name 'x01' at column 1"},
+        {"x0 % 2", "unexpected '%' at column 4"},
+        {"abs x0", "expected '(' at column 5"},
+        {"1e400", "invalid number at column 1"}
+    };
+
+    for (const auto& c : invalid)
+    {
+        ExpressionTape tape = ExpressionTape::record(3u, [](const std::vector<TapeValue>& x) { return x[2]; });
+        std::string error{};
+        EXPECT_FALSE(parseExpression(c.first, tape, error)) << c.first;
+        EXPECT_EQ(error, c.second) << c.first;
+        EXPECT_EQ(tape.inputs(), 3u) << c.first;
+    }
+}
+
+TEST(ExpressionParser, LimitsNestingDepth)
+{
+    const std::size_t limit = EXPRESSION_MAX_DEPTH;
+    const std::string open(limit - 1u, '(');
+    const std::string close(limit - 1u, ')');
+    const std::string tooDeep[] = {
+        std::string(20000u, '('),
+        std::string(20000u, '-') + "x0",
+        std::string(limit, '(') + "x0" + std::string(limit, ')')
+    };
+
+    ExpressionTape tape{};
+    std::string error{};
+    ASSERT_TRUE(parseExpression("-x0 + 1", tape, error)) << error;
+    EXPECT_EQ(tape.evaluate({IntervalNumber(2.0, 3.0)}), IntervalNumber(-2.0, -1.0));
+    EXPECT_TRUE(parseExpression(open + "x0" + close, tape, error)) << error;
+    EXPECT_FALSE(parseExpression(open + "-x0" + close, tape, error));
+
+    for (const std::string& formula : tooDeep)
+    {
+        EXPECT_FALSE(parseExpression(formula, tape, error));
+        EXPECT_EQ(error, "formula nested too deeply at column " + std::to_string(limit + 1u));
+    }
+}
+
+// Writes text to a temporary file and rewinds it.
+static std::FILE* temporaryText(const std::string& text)
+{
+    std::FILE* file = std::tmpfile();
+    if (file != nullptr)
+    {
+        std::fwrite(text.data(), 1u, text.size(), file);
+        std::rewind(file);
+    }
+
+    return file;
+}
+
+// Reads a file from the start.
+static std::string readText(std::FILE* file)
+{
+    std::string text{};
+    char buffer[4096];
+    std::rewind(file);
+    for (std::size_t length; (length = std::fread(buffer, 1u, sizeof(buffer), file)) > 0u;)
+    {
+        text.append(buffer, length);
+    }
+
+    return text;
+}
+
+TEST(IntervalStream, KeepsInputOrderOnAnyWorkerCount)
+{
+    IntervalArray x{};
+    IntervalArray y{};
+    samplePairs(x, y);
+    // Lines "x0,x1,y0,y1".
+    std::string input{};
+    char line[2u * INTERVAL_TEXT_LINE_LENGTH];
+    for (std::size_t i = 0u; i < x.size(); i++)
+    {
+        char* p = formatIntervalLine(line, x.lower()[i], x.upper()[i], IntervalTextFormat::Csv);
+        p[-1] = ',';
+        p = formatIntervalLine(p, y.lower()[i], y.upper()[i], IntervalTextFormat::Csv);
+        input.append(line, p);
+    }
+
+    ExpressionTape tape{};
+    std::string error{};
+    ASSERT_TRUE(parseExpression("x0 * x1 + sqr(x0)", tape, error));
+    IntervalArray expected{};
+    tape.evaluate({x, y}, expected);
+    std::string expectedText{};
+    formatIntervals(expected, IntervalTextFormat::Csv, expectedText);
+
+    // Chunks of a few lines, so workers finish out of order.
+    for (std::size_t threads : {1u, 2u, 5u})
+    {
+        IntervalStreamOptions options{};
+        options.threads = threads;
+        options.chunkSize = 100u;
+        options.chunksInFlight = 3u;
+        std::FILE* in = temporaryText(input);
+        std::FILE* out = std::tmpfile();
+        ASSERT_TRUE(in != nullptr && out != nullptr);
+        EXPECT_TRUE(evaluateIntervalStream(tape, in, out, options, error)) << error;
+        EXPECT_EQ(readText(out), expectedText) << threads;
+        std::fclose(in);
+        std::fclose(out);
+    }
+
+    // An invalid line stops the stream and is reported by number; chunks
+    // before it are written.
+    IntervalStreamOptions options{};
+    options.threads = 2u;
+    options.chunkSize = 8u;
+    std::FILE* in = temporaryText("1,2,3,4\r\n\n5,6\n7,8,9\n1,1,1,1\n");
+    std::FILE* out = std::tmpfile();
+    ASSERT_TRUE(in != nullptr && out != nullptr);
+    EXPECT_FALSE(evaluateIntervalStream(tape, in, out, options, error));
+    EXPECT_EQ(error, "invalid intervals in line 4");
+    EXPECT_EQ(readText(out), "4,12\n55,55\n");
+    std::fclose(in);
+    std::fclose(out);
+}
+
+TEST(IntervalStream, RejectsLongLinesAndStopsWithoutTheReader)
+{
+    ExpressionTape tape{};
+    std::string error{};
+    ASSERT_TRUE(parseExpression("x0 * x1", tape, error));
+
+    // A line longer than the limit is reported after the lines before it,
+    // whether or not it ends; an unterminated one is not read to its end.
+    IntervalStreamOptions options{};
+    options.threads = 2u;
+    options.chunkSize = 8u;
+    options.maxLineLength = 16u;
+    const std::string inputs[] = {
+        "1,2,3,4\n" + std::string(40u, '1') + "\n5,6,7,8\n",
+        "1,2,3,4\n" + std::string(100000u, '1'),
+        "1,2,3,4\n1,1,1,1\n" + std::string(17u, ' ') + "\n"
+    };
+    const std::size_t lines[] = {2u, 2u, 3u};
+    for (std::size_t i = 0u; i < 3u; i++)
+    {
+        std::FILE* in = temporaryText(inputs[i]);
+        std::FILE* out = std::tmpfile();
+        ASSERT_TRUE(in != nullptr && out != nullptr);
+        EXPECT_FALSE(evaluateIntervalStream(tape, in, out, options, error));
+        EXPECT_EQ(error, "line " + std::to_string(lines[i]) + " is longer than 16 bytes");
+        EXPECT_EQ(readText(out), (i < 2u) ? "3,8\n" : "3,8\n1,1\n");
+        EXPECT_LT(std::ftell(in), 1000L) << i;
+        std::fclose(in);
+        std::fclose(out);
+    }
+
+#if ZEROINFINITY_MMAP
+    // The writer of the pipe stays idle after an invalid line; with
+    // detachReader the error returns while the reader still waits.
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    const char text[] = "1,2,3,4\nbad\n";
+    ASSERT_EQ(write(fds[1], text, sizeof(text) - 1u), static_cast<ssize_t>(sizeof(text) - 1u));
+    std::FILE* in = fdopen(fds[0], "rb");
+    std::FILE* out = std::tmpfile();
+    ASSERT_TRUE(in != nullptr && out != nullptr);
+    options.chunkSize = 4u;
+    options.detachReader = true;
+    EXPECT_FALSE(evaluateIntervalStream(tape, in, out, options, error));
+    EXPECT_EQ(error, "invalid intervals in line 2");
+    EXPECT_EQ(readText(out), "3,8\n");
+    std::fclose(out);
+    // The reader sees the end of the pipe and stops; in stays open for it.
+    close(fds[1]);
+#endif
+}
+
+// ---------------------------------------------------------------------
+// Compressed interval columns. Every bit pattern must round-trip, special
+// and repeated intervals must shrink, and damaged files must be rejected.
+// ---------------------------------------------------------------------
+
+TEST(CompressedIntervalArray, RoundTripsBitForBit)
+{
+    IntervalArray x = randomBitIntervals(10000u);
+
+    // Bit patterns the constructor would normalize: -0 in Ω, a signalling
+    // NaN and a NaN paired with a number.
+    const std::size_t size = x.size();
+    x.resize(size + 3u);
+    x.lower()[size] = -0.0;
+    x.upper()[size] = INF;
+    x.lower()[size + 1u] = std::numeric_limits<double>::signaling_NaN();
+    x.upper()[size + 1u] = std::numeric_limits<double>::signaling_NaN();
+    x.lower()[size + 2u] = QUIET_NAN;
+    x.upper()[size + 2u] = 1.0;
+
+    CompressedIntervalArray column(1000u);
+    column.compress(x, 1u);
+    CompressedIntervalArray parallelColumn(1000u);
+    parallelColumn.compress(x, 3u);
+    EXPECT_EQ(column.size(), x.size());
+    EXPECT_EQ(column.blockCount(), (x.size() + 999u) / 1000u);
+    EXPECT_EQ(column.blockLength(column.blockCount() - 1u), x.size() % 1000u);
+    EXPECT_EQ(column.compressedBytes(), parallelColumn.compressedBytes());
+
+    for (std::size_t threads : {1u, 4u})
+    {
+        IntervalArray y{};
+        column.decompress(y, threads);
+        ASSERT_EQ(y.size(), x.size());
+        for (std::size_t i = 0u; i < x.size(); i++)
+        {
+            ASSERT_TRUE(sameBits(y.lower()[i], x.lower()[i]) && sameBits(y.upper()[i], x.upper()[i])) << i;
+        }
+    }
+
+    // Random bits do not compress, but grow by at most a control byte per
+    // value and the class nibbles.
+    EXPECT_LE(column.compressedBytes(), x.size() * 18u + x.size() / 2u + column.blockCount() * 32u);
+
+    // An oversized block is clamped and still holds every interval.
+    CompressedIntervalArray huge(SIZE_MAX);
+    huge.compress(x.lower(), x.upper(), 3u);
+    EXPECT_EQ(huge.blockSize(), COMPRESSED_INTERVAL_MAX_BLOCK_SIZE);
+    EXPECT_EQ(huge.blockCount(), 1u);
+    IntervalArray y{};
+    huge.decompress(y);
+    ASSERT_EQ(y.size(), 3u);
+    for (std::size_t i = 0u; i < 3u; i++)
+    {
+        EXPECT_TRUE(sameBits(y.lower()[i], x.lower()[i]) && sameBits(y.upper()[i], x.upper()[i])) << i;
+    }
+}
+
+TEST(CompressedIntervalArray, ShrinksSpecialAndRepeatedIntervals)
+{
+    // Archive-like data: points, indeterminate forms, and narrow intervals
+    // around slowly changing values on a 1/1024 grid.
+    IntervalArray x{};
+    for (std::size_t i = 0u; i < 20000u; i++)
+    {
+        const double center = std::floor(1000.0 + std::sin(static_cast<double>(i) * 0.01) * 100.0) / 1024.0;
+        switch (i % 5u)
+        {
+            case 0u:
+                x.pushBack(IntervalNumber(center));
+                break;
+            case 1u:
+                x.pushBack(OMEGA);
+                break;
+            case 2u:
+                x.pushBack((i % 2u == 0u) ? NEGATIVE_OMEGA : OMEGA_TILDE);
+                break;
+            default:
+                x.pushBack(IntervalNumber(center, center + 0.25));
+                break;
+        }
+    }
+
+    CompressedIntervalArray column{};
+    column.compress(x);
+    EXPECT_LT(column.compressedBytes() * 4u, x.size() * 2u * sizeof(double));
+
+    IntervalArray y{};
+    column.decompress(y);
+    ASSERT_EQ(y.size(), x.size());
+    for (std::size_t i = 0u; i < x.size(); i++)
+    {
+        ASSERT_TRUE(sameBits(y.lower()[i], x.lower()[i]) && sameBits(y.upper()[i], x.upper()[i])) << i;
+    }
+}
+
+TEST(CompressedIntervalArray, FilesFeedBatchKernelsAndRejectDamage)
+{
+    IntervalArray x{};
+    IntervalArray y{};
+    samplePairs(x, y);
+    CompressedIntervalArray columnX(64u);
+    CompressedIntervalArray columnY(64u);
+    columnX.compress(x);
+    columnY.compress(y);
+    const std::string pathX = intervalFilePath("compressed_x.zic");
+    const std::string pathY = intervalFilePath("compressed_y.zic");
+    ASSERT_TRUE(columnX.write(pathX.c_str()) && columnY.write(pathY.c_str()));
+
+    CompressedIntervalArray readX{};
+    CompressedIntervalArray readY{};
+    ASSERT_TRUE(readX.read(pathX.c_str()) && readY.read(pathY.c_str()));
+    EXPECT_EQ(readX.size(), x.size());
+    EXPECT_EQ(readX.blockSize(), 64u);
+
+    // Block by block through buffers of one block.
+    IntervalArray expected{};
+    multiply(x, y, expected);
+    IntervalArray bufferX(readX.blockSize());
+    IntervalArray bufferY(readX.blockSize());
+    IntervalArray product(readX.blockSize());
+    for (std::size_t b = 0u; b < readX.blockCount(); b++)
+    {
+        const std::size_t length = readX.blockLength(b);
+        readX.decompressBlock(b, bufferX.lower(), bufferX.upper());
+        readY.decompressBlock(b, bufferY.lower(), bufferY.upper());
+        intervalKernels().multiply(bufferX.lower(), bufferX.upper(), bufferY.lower(), bufferY.upper(), product.lower(), product.upper(), length);
+        for (std::size_t i = 0u; i < length; i++)
+        {
+            const auto e = expected.get(b * readX.blockSize() + i);
+            EXPECT_TRUE(sameBits(product.lower()[i], e.getX0()) && sameBits(product.upper()[i], e.getX1()));
+        }
+    }
+
+    // A damaged control byte, a truncated file and a foreign file.
+    std::FILE* stream = std::fopen(pathX.c_str(), "r+b");
+    ASSERT_NE(stream, nullptr);
+    const long control = static_cast<long>(sizeof(CompressedIntervalFileHeader) + (readX.blockCount() + 1u) * sizeof(std::uint64_t) + 16u + 32u);
+    std::fseek(stream, control, SEEK_SET);
+    std::fputc(0x99, stream);
+    std::fclose(stream);
+    EXPECT_FALSE(readX.read(pathX.c_str()));
+    EXPECT_EQ(readX.size(), 0u);
+    stream = std::fopen(pathY.c_str(), "r+b");
+    ASSERT_NE(stream, nullptr);
+    std::fseek(stream, 0L, SEEK_END);
+    const long size = std::ftell(stream);
+    std::fclose(stream);
+    std::vector<char> bytes(static_cast<std::size_t>(size));
+    stream = std::fopen(pathY.c_str(), "rb");
+    ASSERT_EQ(std::fread(bytes.data(), 1u, bytes.size(), stream), bytes.size());
+    std::fclose(stream);
+    stream = std::fopen(pathY.c_str(), "wb");
+    std::fwrite(bytes.data(), 1u, bytes.size() - 1u, stream);
+    std::fclose(stream);
+    EXPECT_FALSE(readY.read(pathY.c_str()));
+    EXPECT_FALSE(readY.read(intervalFilePath("missing.zic").c_str()));
+    IntervalFileWriter writer{};
+    ASSERT_TRUE(writer.open(pathY.c_str()) && writer.append(IntervalNumber(1.0)) && writer.close());
+    EXPECT_FALSE(readY.read(pathY.c_str()));
+
+    // A count that wraps the block count to zero, and a count that does not
+    // match the intervals of the last block.
+    CompressedIntervalFileHeader header{};
+    std::memcpy(header.magic, COMPRESSED_INTERVAL_MAGIC, sizeof(header.magic));
+    header.version = COMPRESSED_INTERVAL_VERSION;
+    header.byteOrder = INTERVAL_FILE_BYTE_ORDER;
+    header.count = UINT64_MAX;
+    header.blockSize = 2u;
+    const std::uint64_t offset = 0u;
+    stream = std::fopen(pathY.c_str(), "wb");
+    ASSERT_NE(stream, nullptr);
+    std::fwrite(&header, sizeof(header), 1u, stream);
+    std::fwrite(&offset, sizeof(offset), 1u, stream);
+    std::fclose(stream);
+    EXPECT_FALSE(readY.read(pathY.c_str()));
+    EXPECT_EQ(readY.size(), 0u);
+    CompressedIntervalArray odd(2u);
+    odd.compress(x.lower(), x.upper(), 3u);
+    ASSERT_TRUE(odd.write(pathY.c_str()) && readY.read(pathY.c_str()));
+    stream = std::fopen(pathY.c_str(), "r+b");
+    ASSERT_NE(stream, nullptr);
+    header.count = 4u;
+    std::fseek(stream, static_cast<long>(offsetof(CompressedIntervalFileHeader, count)), SEEK_SET);
+    std::fwrite(&header.count, sizeof(header.count), 1u, stream);
+    std::fclose(stream);
+    EXPECT_FALSE(readY.read(pathY.c_str()));
+}
+
+// ---------------------------------------------------------------------
+// Interval tree. Every query must report exactly the intervals a linear
+// scan finds, including infinite endpoints, NaN intervals and ties.
+// ---------------------------------------------------------------------
+
+// Intervals with endpoints from a few values, so many endpoints tie and
+// many intervals overlap; the sample intervals add ±∞, Ω and NaN.
+static IntervalArray tiedIntervals(std::size_t count)
+{
+    static const double ENDPOINTS[9u] = {-INF, -2.0, -1.0, -0.0, 0.0, 0.5, 1.0, 3.0, INF};
+
+    IntervalArray x{};
+    std::uint64_t state = 0x2545F4914F6CDD1Du;
+    auto next = [&state]() {
+        state = state * 6364136223846793005u + 1442695040888963407u;
+        return ENDPOINTS[(state >> 33u) % 9u];
+    };
+    for (std::size_t i = 0u; i < count; i++)
+    {
+        const double x0 = next();
+        x.pushBack(IntervalNumber(x0, next()));
+    }
+    for (const auto& interval : sampleIntervals())
+    {
+        x.pushBack(interval);
+    }
+
+    return x;
+}
+
+// Indices of the intervals sharing a value with [a, b], by linear scan.
+static std::vector<std::size_t> overlappingByScan(const IntervalArray& x, double a, double b)
+{
+    std::vector<std::size_t> result{};
+    for (std::size_t i = 0u; i < x.size(); i++)
+    {
+        if (x.lower()[i] <= b && x.upper()[i] >= a)
+        {
+            result.push_back(i);
+        }
+    }
+
+    return result;
+}
+
+static std::vector<std::size_t> sorted(std::vector<std::size_t> indices)
+{
+    std::sort(indices.begin(), indices.end());
+
+    return indices;
+}
+
+TEST(IntervalTree, StabbingMatchesLinearScan)
+{
+    const IntervalArray x = tiedIntervals(2000u);
+    const IntervalTree tree(x);
+    EXPECT_EQ(tree.size(), x.size());
+
+    for (double value : {-INF, -3.0, -2.0, -1.5, -1.0, -0.0, 0.0, 0.25, 0.5, 1.0, 2.0, 3.0, 1e300, INF})
+    {
+        std::vector<std::size_t> found{};
+        const std::size_t count = tree.findContaining(value, found);
+        EXPECT_EQ(count, found.size());
+        EXPECT_EQ(sorted(found), overlappingByScan(x, value, value)) << "value " << value;
+    }
+
+    // Ω contains ∞, and NaN contains nothing.
+    const IntervalTree omega(std::vector<IntervalNumber>{OMEGA, NEGATIVE_OMEGA, IntervalNumber(QUIET_NAN), IntervalNumber(-0.0)});
+    std::vector<std::size_t> found{};
+    omega.findContaining(INF, found);
+    EXPECT_EQ(found, std::vector<std::size_t>{0u});
+    found.clear();
+    omega.findContaining(0.0, found);
+    EXPECT_EQ(sorted(found), (std::vector<std::size_t>{0u, 1u, 3u}));
+    EXPECT_EQ(omega.findContaining(QUIET_NAN, found), 0u);
+
+    const IntervalTree empty{};
+    EXPECT_EQ(empty.findContaining(0.0, found), 0u);
+    EXPECT_EQ(empty.findOverlapping(OMEGA_TILDE, found), 0u);
+}
+
+TEST(IntervalTree, OverlapMatchesLinearScan)
+{
+    const IntervalArray x = tiedIntervals(2000u);
+    const IntervalTree tree(x, 3u);
+    const double endpoints[] = {-INF, -2.0, -0.5, 0.0, 0.5, 1.0, 2.0, 3.0, INF};
+
+    for (double a : endpoints)
+    {
+        for (double b : endpoints)
+        {
+            if (a > b)
+            {
+                continue;
+            }
+            std::vector<std::size_t> found{};
+            tree.findOverlapping(IntervalNumber(a, b), found);
+            EXPECT_EQ(sorted(found), overlappingByScan(x, a, b)) << "[" << a << ", " << b << "]";
+        }
+    }
+
+    // Unsorted endpoints are ordered, a NaN endpoint makes a NaN interval.
+    IntervalArray raw{};
+    raw.resize(3u);
+    raw.lower()[0u] = 2.0;
+    raw.upper()[0u] = 1.0;
+    raw.lower()[1u] = 0.0;
+    raw.upper()[1u] = QUIET_NAN;
+    raw.lower()[2u] = 1.5;
+    raw.upper()[2u] = INF;
+    const IntervalTree rawTree(raw);
+    std::vector<std::size_t> found{};
+    rawTree.findOverlapping(IntervalNumber(-INF, 1.0), found);
+    EXPECT_EQ(found, std::vector<std::size_t>{0u});
+    found.clear();
+    rawTree.findOverlapping(IntervalNumber(INF), found);
+    EXPECT_EQ(found, std::vector<std::size_t>{2u});
+    EXPECT_EQ(rawTree.findOverlapping(IntervalNumber(QUIET_NAN), found), 0u);
+}
+
+TEST(IntervalTree, BatchQueriesAgreeOnAnyThreadCount)
+{
+    const IntervalArray x = tiedIntervals(3000u);
+    const IntervalTree tree(x);
+
+    // More queries than one batch task, with NaN and infinite queries.
+    std::vector<double> values{};
+    IntervalArray queries{};
+    for (std::size_t i = 0u; i < 1500u; i++)
+    {
+        values.push_back(((i % 2u) == 0u) ? x.lower()[i] : x.upper()[i]);
+        queries.pushBack(IntervalNumber(x.lower()[i], x.upper()[i]));
+    }
+    values.push_back(QUIET_NAN);
+    queries.pushBack(IntervalNumber(QUIET_NAN));
+    values.push_back(INF);
+    queries.pushBack(OMEGA);
+
+    std::vector<std::size_t> expectedStab{};
+    std::vector<std::size_t> expectedOverlap{};
+    std::vector<std::size_t> stabOffsets{0u};
+    std::vector<std::size_t> overlapOffsets{0u};
+    for (std::size_t q = 0u; q < values.size(); q++)
+    {
+        tree.findContaining(values[q], expectedStab);
+        stabOffsets.push_back(expectedStab.size());
+        tree.findOverlapping(IntervalNumber(queries.lower()[q], queries.upper()[q]), expectedOverlap);
+        overlapOffsets.push_back(expectedOverlap.size());
+    }
+
+    for (std::size_t threads : {1u, 2u, 3u, 8u})
+    {
+        IntervalTreeMatches stab{};
+        tree.findContaining(values.data(), values.size(), stab, threads);
+        EXPECT_EQ(stab.offsets, stabOffsets) << threads << " threads";
+        EXPECT_EQ(stab.indices, expectedStab) << threads << " threads";
+
+        IntervalTreeMatches overlap{};
+        tree.findOverlapping(queries, overlap, threads);
+        EXPECT_EQ(overlap.offsets, overlapOffsets) << threads << " threads";
+        EXPECT_EQ(overlap.indices, expectedOverlap) << threads << " threads";
+        EXPECT_EQ(overlap.count(7u), overlapOffsets[8u] - overlapOffsets[7u]);
+    }
+
+    // A tree built on several threads is the same tree.
+    const IntervalTree parallelTree(x, 4u);
+    IntervalTreeMatches overlap{};
+    parallelTree.findOverlapping(queries, overlap, 2u);
+    EXPECT_EQ(overlap.indices, expectedOverlap);
+}
+
+// ---------------------------------------------------------------------
+// Performance counters. Whether hardware counters are available depends on
+// the machine, so the tests only check consistent behavior either way.
+// ---------------------------------------------------------------------
+
+TEST(PerfCounters, CountsOrReportsUnavailable)
+{
+    PerfCounters counters{};
+
+    IntervalArray x{IntervalNumber(1.0, 2.0), IntervalNumber(0.0), IntervalNumber(-INF, 3.0)};
+    IntervalArray y{IntervalNumber(3.0, 4.0), IntervalNumber(INF), IntervalNumber(0.0, 1.0)};
+    IntervalArray result{};
+
+    counters.start();
+    divide(x, y, result);
+    counters.stop();
+
+    for (std::size_t i = 0u; i < PERF_EVENT_COUNT; i++)
+    {
+        const auto event = static_cast<PerfEvent>(i);
+        if (!counters.available(event))
+        {
+            EXPECT_EQ(counters.count(event), 0u) << toString(event);
+        }
+    }
+    if (counters.available(PerfEvent::Instructions))
+    {
+        EXPECT_GT(counters.count(PerfEvent::Instructions), 0u);
+    }
+}
+
+TEST(PerfCounters, FormatsJsonWithNullForUnavailable)
+{
+    PerfCounters counters{};
+    counters.start();
+    counters.stop();
+
+    const auto json = counters.toJson("batch/divide", 3u);
+
+    EXPECT_EQ(json.rfind("{\"region\": \"batch/divide\", \"intervals\": 3, ", 0u), 0u);
+    EXPECT_EQ(json.back(), '}');
+    for (std::size_t i = 0u; i < PERF_EVENT_COUNT; i++)
+    {
+        const auto event = static_cast<PerfEvent>(i);
+        const std::string key = std::string("\"") + toString(event) + "_per_interval\": ";
+        ASSERT_NE(json.find(key), std::string::npos) << key;
+        EXPECT_EQ(json.find(key + "null") != std::string::npos, !counters.available(event)) << key;
+    }
+}
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);